@@ -19,47 +19,91 @@ using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop
 using namespace Microsoft::TeamFoundation::Migration::Toolkit;
 using namespace Microsoft::TeamFoundation::Migration::Toolkit::Services;
 
-Change::Change(ChangeSet^ changeset, String^ changePath, svn_log_changed_path2_t* changeDetail)
+//The layout of svn_log_changed_path2_t since subversion 1.7. The headers the adapter is compiled against do not declare the trailing members yet
+//and they must only be read if the loaded library is new enough. See SubversionClient::ReportsModifications
+struct changed_path_1_7_t
 {
-	if(nullptr == changeset)
+	char action;
+	const char *copyfrom_path;
+	svn_revnum_t copyfrom_rev;
+	svn_node_kind_t node_kind;
+	int text_modified;
+	int props_modified;
+};
+
+//The values of svn_tristate_t
+static const int TristateFalse = 2;
+static const int TristateTrue = 3;
+
+static Nullable<bool>
+ParseTristate(int value)
+{
+	switch(value)
 	{
-		throw gcnew ArgumentNullException("changeSet");
+	case TristateFalse:
+		return Nullable<bool>(false);
+	case TristateTrue:
+		return Nullable<bool>(true);
+	default:
+		return Nullable<bool>();
 	}
+}
+
+Change::Change(ChangeSet^ changeset, String^ fullServerPath, String^ copyFromPath, long copyFromRevision, Microsoft::TeamFoundation::Migration::Toolkit::Services::ContentType^ contentType, Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel::ChangeAction changeAction)
+{
+	m_changeset = changeset;
+	m_fullServerPath = fullServerPath;
+
+	m_copyFromPath = copyFromPath;
+	m_copyFromRevision = copyFromRevision;
+	
+	m_itemType = contentType;
+	m_changeAction = changeAction;
+}
 
-	if(String::IsNullOrEmpty(changePath))
+Change::Change(ChangeSet^ changeset, String^ fullServerPath, Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel::ChangeAction changeAction, svn_node_kind_t nodeKind, String^ copyFromFullServerPath, long copyFromRevision)
+{
+	if(nullptr == changeset)
 	{
-		throw gcnew ArgumentNullException("changePath");
+		throw gcnew ArgumentNullException("changeSet");
 	}
 
-	if(NULL == changeDetail)
+	if(String::IsNullOrEmpty(fullServerPath))
 	{
-		throw gcnew ArgumentNullException("changeDetail");
+		throw gcnew ArgumentNullException("fullServerPath");
 	}
 
 	m_changeset = changeset;
-	m_copyFromRevision = changeDetail->copyfrom_rev;
+	m_fullServerPath = fullServerPath;
+	m_changeAction = changeAction;
+	m_nodeKind = nodeKind;
 
-	m_fullServerPath = Utils::Combine(changeset->Client->RepositoryRoot->ToString(), changePath);
+	m_copyFromRevision = copyFromRevision;
 	if (IsCopy)
 	{
-		String^ path = Utils::ConvertUTF8ToString((const char*)changeDetail->copyfrom_path);
-		m_copyFromFullServerPath = Utils::Combine(changeset->Client->RepositoryRoot->ToString(), path);
+		m_copyFromFullServerPath = copyFromFullServerPath;
 	}
-
-	m_changeAction = ParseChangeActionChar(changeDetail->action, IsCopy);
-	m_nodeKind = changeDetail->node_kind;
 }
 
-Change::Change(ChangeSet^ changeset, String^ fullServerPath, String^ copyFromPath, long copyFromRevision, Microsoft::TeamFoundation::Migration::Toolkit::Services::ContentType^ contentType, Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel::ChangeAction changeAction)
+void
+Change::ToRecord(const char* changePath, svn_log_changed_path2_t* changeDetail, ChangeBuffer::Record& record)
 {
-	m_changeset = changeset;
-	m_fullServerPath = fullServerPath;
+	record.action = changeDetail->action;
+	record.nodeKind = changeDetail->node_kind;
+	record.copyFromRevision = changeDetail->copyfrom_rev;
+	record.path = changePath;
+	record.copyFromPath = (changeDetail->copyfrom_rev > 0 && NULL != changeDetail->copyfrom_path) ? changeDetail->copyfrom_path : "";
+	record.textModified = -1;
+	record.propsModified = -1;
 
-	m_copyFromPath = copyFromPath;
-	m_copyFromRevision = copyFromRevision;
-	
-	m_itemType = contentType;
-	m_changeAction = changeAction;
+	if(SubversionClient::ReportsModifications)
+	{
+		changed_path_1_7_t* details = (changed_path_1_7_t*)changeDetail;
+		Nullable<bool> textModified = ParseTristate(details->text_modified);
+		Nullable<bool> propsModified = ParseTristate(details->props_modified);
+		record.textModified = textModified.HasValue ? (textModified.Value ? 1 : 0) : -1;
+		record.propsModified = propsModified.HasValue ? (propsModified.Value ? 1 : 0) : -1;
+	}
 }
 
 ChangeAction 
@@ -124,6 +168,22 @@ Change::ItemType::get()
 	return m_itemType;
 }
 
+svn_node_kind_t
+Change::NodeKind::get()
+{
+	if(nullptr == m_itemType)
+	{
+		return m_nodeKind;
+	}
+
+	if(WellKnownContentType::VersionControlledFolder == m_itemType)
+	{
+		return svn_node_dir;
+	}
+
+	return svn_node_file;
+}
+
 ChangeAction 
 Change::ChangeAction::get()
 {
@@ -164,6 +224,52 @@ Change::CopyFromPath::get()
 	return m_copyFromPath;
 }
 
+Nullable<bool>
+Change::TextModification::get()
+{
+	return m_textModified;
+}
+
+void
+Change::TextModification::set(Nullable<bool> value)
+{
+	m_textModified = value;
+}
+
+Nullable<bool>
+Change::PropertyModification::get()
+{
+	return m_propsModified;
+}
+
+void
+Change::PropertyModification::set(Nullable<bool> value)
+{
+	m_propsModified = value;
+}
+
+bool 
+Change::TextModified::get()
+{
+	if(!m_textModified.HasValue && ObjectModel::ChangeAction::Modify == m_changeAction && nullptr != m_changeset)
+	{
+		m_changeset->ApplyModifications(this);
+	}
+
+	return !m_textModified.HasValue || m_textModified.Value;
+}
+
+bool 
+Change::PropsModified::get()
+{
+	if(!m_propsModified.HasValue && ObjectModel::ChangeAction::Modify == m_changeAction && nullptr != m_changeset)
+	{
+		m_changeset->ApplyModifications(this);
+	}
+
+	return !m_propsModified.HasValue || m_propsModified.Value;
+}
+
 bool 
 Change::IsCopy::get()
 {
@@ -2,6 +2,7 @@
 
 #include <svn_client.h>
 #include "ChangeAction.h"
+#include "ChangeBuffer.h"
 
 using namespace System;
 using namespace System::Collections::Generic;
@@ -40,18 +41,65 @@ namespace Microsoft
 									String^ m_copyFromFullServerPath;
 									String^ m_copyFromPath;
 
-									ChangeAction ParseChangeActionChar(char actionChar, bool isCopy);
+									Nullable<bool> m_textModified;
+									Nullable<bool> m_propsModified;
+
 									ContentType^ ParseContentType(svn_node_kind_t nodeKind);
 									
 								internal:
 
 									/// <summary>
-									/// Create a new Change Object
+									/// Create a new Change Object from already decoded values
 									/// </summary>
 									/// <param name="changeSet">The changeset to which this change belongs to</param>
-									/// <param name="changePath">The relative item path within the repository</param>
+									/// <param name="fullServerPath">The full path of the item in the subversion repository</param>
+									/// <param name="changeAction">The actual change of this item</param>
+									/// <param name="nodeKind">The node kind reported by subversion; svn_node_unknown if it has to be queried on demand</param>
+									/// <param name="copyFromFullServerPath">The full path of the item from which this item was copied from; null if this is not a copy</param>
+									/// <param name="copyFromRevision">The revision from which this item has been copied from</param>
+									Change(ChangeSet^ changeset, String^ fullServerPath, Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel::ChangeAction changeAction, svn_node_kind_t nodeKind, String^ copyFromFullServerPath, long copyFromRevision);
+
+									/// <summary>
+									/// Encodes a changed path as it is reported by subversion without allocating any managed objects
+									/// </summary>
+									/// <param name="changePath">The relative item path within the repository in UTF-8</param>
 									/// <param name="changeDetail">Additional attributes of this change like the change action</param>
-									Change(ChangeSet^ changeset, String^ changePath, svn_log_changed_path2_t* changeDetail);
+									/// <param name="record">The record that receives the change</param>
+									static void ToRecord(const char* changePath, svn_log_changed_path2_t* changeDetail, Helpers::ChangeBuffer::Record& record);
+
+									/// <summary>
+									/// Converts the change action character of subversion
+									/// </summary>
+									/// <param name="actionChar">The action as it is reported by subversion</param>
+									/// <param name="isCopy">Determines whether the item has a copy relation</param>
+									/// <exception cref="NotSupportedException">Will be thrown if subversion reported an unsupported change action</exception>
+									static Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel::ChangeAction ParseChangeActionChar(char actionChar, bool isCopy);
+
+									/// <summary>
+									/// Gets the node kind of the item without querying the repository for unknown kinds
+									/// </summary>
+									property svn_node_kind_t NodeKind
+									{
+										svn_node_kind_t get();
+									}
+
+									/// <summary>
+									/// Gets or sets whether the text of the item has been modified; no value if this is not known
+									/// </summary>
+									property Nullable<bool> TextModification
+									{
+										Nullable<bool> get();
+										void set(Nullable<bool> value);
+									}
+
+									/// <summary>
+									/// Gets or sets whether the properties of the item have been modified; no value if this is not known
+									/// </summary>
+									property Nullable<bool> PropertyModification
+									{
+										Nullable<bool> get();
+										void set(Nullable<bool> value);
+									}
 
 								public:
 									/// <summary>
@@ -153,6 +201,24 @@ namespace Microsoft
 									{
 										long get();
 									}
+
+									/// <summary>
+									/// Gets whether the text of the item has been modified. A property only modification like a <c>svn:mergeinfo</c> update returns false.
+									/// If the subversion libraries do not report the modifications, the modified files of the changeset are compared to the previous revision once. 
+									/// An item whose modifications cannot be determined is treated as modified
+									/// </summary>
+									property bool TextModified
+									{
+										bool get();
+									}
+
+									/// <summary>
+									/// Gets whether the properties of the item have been modified. An item whose modifications cannot be determined is treated as modified
+									/// </summary>
+									property bool PropsModified
+									{
+										bool get();
+									}
 							};
 						}
 					}
@@ -0,0 +1,517 @@
+#include "stdafx.h"
+
+#include <algorithm>
+#include <cstring>
+#include "Change.h"
+#include "ChangeBatch.h"
+#include "ChangeSet.h"
+#include "SubversionClient.h"
+#include "Utils.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Runtime::InteropServices;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+//Orders the changes of a builder by the UTF-8 bytes of their paths. This places every folder before all items below of it
+struct HeapOrder
+{
+	const std::vector<char>* heap;
+	const std::vector<int>* offsets;
+
+	bool operator()(int x, int y) const
+	{
+		return strcmp(&(*heap)[(*offsets)[x]], &(*heap)[(*offsets)[y]]) < 0;
+	}
+};
+
+ChangeBatch::ChangeBatch(ChangeSet^ changeset, int count, array<Byte>^ actions, array<Byte>^ nodeKinds, array<int>^ copyFromRevisions, array<int>^ pathOffsets,
+	array<int>^ copyFromPathOffsets, array<SByte>^ textModifications, array<SByte>^ propertyModifications, array<Byte>^ heap)
+{
+	m_changeset = changeset;
+	m_start = 0;
+	m_count = count;
+
+	m_actions = actions;
+	m_nodeKinds = nodeKinds;
+	m_copyFromRevisions = copyFromRevisions;
+	m_pathOffsets = pathOffsets;
+	m_copyFromPathOffsets = copyFromPathOffsets;
+	m_textModifications = textModifications;
+	m_propertyModifications = propertyModifications;
+	m_heap = heap;
+}
+
+ChangeBatch::ChangeBatch(ChangeBatch^ batch, int start, int count)
+{
+	if(nullptr == batch)
+	{
+		throw gcnew ArgumentNullException("batch");
+	}
+
+	if(start < 0 || count < 0 || start + count > batch->m_count)
+	{
+		throw gcnew ArgumentOutOfRangeException("count");
+	}
+
+	m_changeset = batch->m_changeset;
+	m_start = batch->m_start + start;
+	m_count = count;
+
+	m_actions = batch->m_actions;
+	m_nodeKinds = batch->m_nodeKinds;
+	m_copyFromRevisions = batch->m_copyFromRevisions;
+	m_pathOffsets = batch->m_pathOffsets;
+	m_copyFromPathOffsets = batch->m_copyFromPathOffsets;
+	m_textModifications = batch->m_textModifications;
+	m_propertyModifications = batch->m_propertyModifications;
+	m_heap = batch->m_heap;
+}
+
+int
+ChangeBatch::ToPosition(int index)
+{
+	if(index < 0 || index >= m_count)
+	{
+		throw gcnew ArgumentOutOfRangeException("index");
+	}
+
+	return m_start + index;
+}
+
+String^
+ChangeBatch::ReadPath(int offset)
+{
+	int length = Array::IndexOf<Byte>(m_heap, 0, offset) - offset;
+	return System::Text::Encoding::UTF8->GetString(m_heap, offset, length);
+}
+
+std::string
+ChangeBatch::ReadBytes(int offset)
+{
+	pin_ptr<Byte> data = &m_heap[offset];
+	return std::string((const char*)data);
+}
+
+Nullable<bool>
+ChangeBatch::ToModification(SByte value)
+{
+	if(value < 0)
+	{
+		return Nullable<bool>();
+	}
+
+	return Nullable<bool>(1 == value);
+}
+
+int
+ChangeBatch::Count::get()
+{
+	return m_count;
+}
+
+bool
+ChangeBatch::IsReadOnly::get()
+{
+	return true;
+}
+
+Change^
+ChangeBatch::default::get(int index)
+{
+	int position = ToPosition(index);
+
+	Change^ change = gcnew Change(m_changeset, GetFullServerPath(index), (ObjectModel::ChangeAction)m_actions[position], (svn_node_kind_t)m_nodeKinds[position], GetCopyFromFullServerPath(index), m_copyFromRevisions[position]);
+	change->TextModification = ToModification(m_textModifications[position]);
+	change->PropertyModification = ToModification(m_propertyModifications[position]);
+
+	return change;
+}
+
+void
+ChangeBatch::default::set(int index, Change^ value)
+{
+	throw gcnew NotSupportedException();
+}
+
+ObjectModel::ChangeAction
+ChangeBatch::GetChangeAction(int index)
+{
+	return (ObjectModel::ChangeAction)m_actions[ToPosition(index)];
+}
+
+svn_node_kind_t
+ChangeBatch::GetNodeKind(int index)
+{
+	return (svn_node_kind_t)m_nodeKinds[ToPosition(index)];
+}
+
+void
+ChangeBatch::SetNodeKind(int index, svn_node_kind_t nodeKind)
+{
+	m_nodeKinds[ToPosition(index)] = (Byte)nodeKind;
+}
+
+bool
+ChangeBatch::IsCopy(int index)
+{
+	return m_copyFromRevisions[ToPosition(index)] > 0;
+}
+
+long
+ChangeBatch::GetCopyFromRevision(int index)
+{
+	return m_copyFromRevisions[ToPosition(index)];
+}
+
+std::string
+ChangeBatch::GetPath(int index)
+{
+	return ReadBytes(m_pathOffsets[ToPosition(index)]);
+}
+
+std::string
+ChangeBatch::GetCopyFromPath(int index)
+{
+	int offset = m_copyFromPathOffsets[ToPosition(index)];
+	return offset < 0 ? std::string() : ReadBytes(offset);
+}
+
+String^
+ChangeBatch::GetFullServerPath(int index)
+{
+	return Utils::Combine(m_changeset->Client->RepositoryRoot->ToString(), ReadPath(m_pathOffsets[ToPosition(index)]));
+}
+
+String^
+ChangeBatch::GetCopyFromFullServerPath(int index)
+{
+	int offset = m_copyFromPathOffsets[ToPosition(index)];
+	if(offset < 0)
+	{
+		return nullptr;
+	}
+
+	return Utils::Combine(m_changeset->Client->RepositoryRoot->ToString(), ReadPath(offset));
+}
+
+Nullable<bool>
+ChangeBatch::GetTextModification(int index)
+{
+	return ToModification(m_textModifications[ToPosition(index)]);
+}
+
+Nullable<bool>
+ChangeBatch::GetPropertyModification(int index)
+{
+	return ToModification(m_propertyModifications[ToPosition(index)]);
+}
+
+int
+ChangeBatch::IndexOf(Change^ item)
+{
+	if(nullptr == item)
+	{
+		return -1;
+	}
+
+	//The change objects are created on demand. Therefore a change is identified by its values instead of its reference
+	for(int i = 0; i < m_count; i++)
+	{
+		if(item->ChangeAction == GetChangeAction(i) && String::Equals(item->FullServerPath, GetFullServerPath(i), StringComparison::Ordinal))
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+bool
+ChangeBatch::Contains(Change^ item)
+{
+	return IndexOf(item) >= 0;
+}
+
+void
+ChangeBatch::CopyTo(array<Change^>^ target, int arrayIndex)
+{
+	if(nullptr == target)
+	{
+		throw gcnew ArgumentNullException("target");
+	}
+
+	if(arrayIndex < 0 || arrayIndex + m_count > target->Length)
+	{
+		throw gcnew ArgumentOutOfRangeException("arrayIndex");
+	}
+
+	for(int i = 0; i < m_count; i++)
+	{
+		target[arrayIndex + i] = this->default[i];
+	}
+}
+
+void
+ChangeBatch::Insert(int index, Change^ item)
+{
+	throw gcnew NotSupportedException();
+}
+
+void
+ChangeBatch::RemoveAt(int index)
+{
+	throw gcnew NotSupportedException();
+}
+
+void
+ChangeBatch::Add(Change^ item)
+{
+	throw gcnew NotSupportedException();
+}
+
+void
+ChangeBatch::Clear()
+{
+	throw gcnew NotSupportedException();
+}
+
+bool
+ChangeBatch::Remove(Change^ item)
+{
+	throw gcnew NotSupportedException();
+}
+
+IEnumerator<Change^>^
+ChangeBatch::GetEnumerator()
+{
+	return gcnew ChangeBatchEnumerator(this);
+}
+
+System::Collections::IEnumerator^
+ChangeBatch::GetEnumeratorNonGeneric()
+{
+	return GetEnumerator();
+}
+
+ChangeBatchEnumerator::ChangeBatchEnumerator(ChangeBatch^ batch)
+{
+	m_batch = batch;
+	m_index = -1;
+}
+
+ChangeBatchEnumerator::~ChangeBatchEnumerator()
+{
+}
+
+bool
+ChangeBatchEnumerator::MoveNext()
+{
+	if(m_index + 1 >= m_batch->Count)
+	{
+		m_index = m_batch->Count;
+		m_current = nullptr;
+		return false;
+	}
+
+	m_index++;
+	m_current = m_batch[m_index];
+	return true;
+}
+
+void
+ChangeBatchEnumerator::Reset()
+{
+	m_index = -1;
+	m_current = nullptr;
+}
+
+Change^
+ChangeBatchEnumerator::Current::get()
+{
+	return m_current;
+}
+
+Object^
+ChangeBatchEnumerator::CurrentNonGeneric::get()
+{
+	return m_current;
+}
+
+ChangeBatchBuilder::ChangeBatchBuilder(ChangeSet^ changeset, int capacity)
+{
+	if(nullptr == changeset)
+	{
+		throw gcnew ArgumentNullException("changeset");
+	}
+
+	m_changeset = changeset;
+	m_count = 0;
+
+	m_actions = gcnew array<Byte>(0);
+	m_nodeKinds = gcnew array<Byte>(0);
+	m_copyFromRevisions = gcnew array<int>(0);
+	m_pathOffsets = gcnew array<int>(0);
+	m_copyFromPathOffsets = gcnew array<int>(0);
+	m_textModifications = gcnew array<SByte>(0);
+	m_propertyModifications = gcnew array<SByte>(0);
+	Resize(Math::Max(capacity, 16));
+
+	m_heap = new std::vector<char>();
+	m_interned = new std::map<std::string, int>();
+}
+
+ChangeBatchBuilder::~ChangeBatchBuilder()
+{
+	this->!ChangeBatchBuilder();
+}
+
+ChangeBatchBuilder::!ChangeBatchBuilder()
+{
+	if(NULL != m_heap)
+	{
+		delete m_heap;
+		m_heap = NULL;
+	}
+
+	if(NULL != m_interned)
+	{
+		delete m_interned;
+		m_interned = NULL;
+	}
+}
+
+void
+ChangeBatchBuilder::Resize(int capacity)
+{
+	Array::Resize(m_actions, capacity);
+	Array::Resize(m_nodeKinds, capacity);
+	Array::Resize(m_copyFromRevisions, capacity);
+	Array::Resize(m_pathOffsets, capacity);
+	Array::Resize(m_copyFromPathOffsets, capacity);
+	Array::Resize(m_textModifications, capacity);
+	Array::Resize(m_propertyModifications, capacity);
+}
+
+int
+ChangeBatchBuilder::Intern(const std::string& path)
+{
+	std::map<std::string, int>::const_iterator existing = m_interned->find(path);
+	if(existing != m_interned->end())
+	{
+		return existing->second;
+	}
+
+	int offset = (int)m_heap->size();
+	m_heap->insert(m_heap->end(), path.begin(), path.end());
+	m_heap->push_back('\0');
+	m_interned->insert(std::make_pair(path, offset));
+
+	return offset;
+}
+
+void
+ChangeBatchBuilder::Add(const std::string& path, ObjectModel::ChangeAction changeAction, svn_node_kind_t nodeKind, const std::string& copyFromPath, long copyFromRevision, int textModification, int propertyModification)
+{
+	if(NULL == m_heap)
+	{
+		throw gcnew ObjectDisposedException("ChangeBatchBuilder");
+	}
+
+	if(m_count == m_actions->Length)
+	{
+		Resize(m_count * 2);
+	}
+
+	m_actions[m_count] = (Byte)changeAction;
+	m_nodeKinds[m_count] = (Byte)nodeKind;
+	m_copyFromRevisions[m_count] = copyFromRevision;
+	m_pathOffsets[m_count] = Intern(path);
+	m_copyFromPathOffsets[m_count] = (copyFromRevision > 0 && !copyFromPath.empty()) ? Intern(copyFromPath) : -1;
+	m_textModifications[m_count] = (SByte)textModification;
+	m_propertyModifications[m_count] = (SByte)propertyModification;
+	m_count++;
+}
+
+void
+ChangeBatchBuilder::Add(const ChangeBuffer::Record& record)
+{
+	ObjectModel::ChangeAction changeAction = Change::ParseChangeActionChar(record.action, record.copyFromRevision > 0);
+	Add(record.path, changeAction, (svn_node_kind_t)record.nodeKind, record.copyFromPath, record.copyFromRevision, record.textModified, record.propsModified);
+}
+
+void
+ChangeBatchBuilder::Add(String^ fullServerPath, ObjectModel::ChangeAction changeAction, svn_node_kind_t nodeKind, String^ copyFromFullServerPath, long copyFromRevision, Nullable<bool> textModification, Nullable<bool> propertyModification)
+{
+	if(String::IsNullOrEmpty(fullServerPath))
+	{
+		throw gcnew ArgumentNullException("fullServerPath");
+	}
+
+	//The heap stores the paths the same way subversion reports them: relative to the root, with a leading slash and UTF-8 encoded
+	String^ repositoryRoot = m_changeset->Client->RepositoryRoot->ToString();
+	std::string path = Utils::ConvertStringToUTF8(Utils::ExtractPath(repositoryRoot, fullServerPath));
+
+	std::string copyFromPath;
+	if(nullptr != copyFromFullServerPath)
+	{
+		copyFromPath = Utils::ConvertStringToUTF8(Utils::ExtractPath(repositoryRoot, copyFromFullServerPath));
+	}
+
+	int text = textModification.HasValue ? (textModification.Value ? 1 : 0) : -1;
+	int properties = propertyModification.HasValue ? (propertyModification.Value ? 1 : 0) : -1;
+	Add(path, changeAction, nodeKind, copyFromPath, copyFromRevision, text, properties);
+}
+
+ChangeBatch^
+ChangeBatchBuilder::ToBatch()
+{
+	if(NULL == m_heap)
+	{
+		throw gcnew ObjectDisposedException("ChangeBatchBuilder");
+	}
+
+	std::vector<int> offsets(m_count);
+	std::vector<int> order(m_count);
+	for(int i = 0; i < m_count; i++)
+	{
+		offsets[i] = m_pathOffsets[i];
+		order[i] = i;
+	}
+
+	HeapOrder comparer;
+	comparer.heap = m_heap;
+	comparer.offsets = &offsets;
+	std::stable_sort(order.begin(), order.end(), comparer);
+
+	array<Byte>^ actions = gcnew array<Byte>(m_count);
+	array<Byte>^ nodeKinds = gcnew array<Byte>(m_count);
+	array<int>^ copyFromRevisions = gcnew array<int>(m_count);
+	array<int>^ pathOffsets = gcnew array<int>(m_count);
+	array<int>^ copyFromPathOffsets = gcnew array<int>(m_count);
+	array<SByte>^ textModifications = gcnew array<SByte>(m_count);
+	array<SByte>^ propertyModifications = gcnew array<SByte>(m_count);
+
+	for(int i = 0; i < m_count; i++)
+	{
+		int source = order[i];
+		actions[i] = m_actions[source];
+		nodeKinds[i] = m_nodeKinds[source];
+		copyFromRevisions[i] = m_copyFromRevisions[source];
+		pathOffsets[i] = m_pathOffsets[source];
+		copyFromPathOffsets[i] = m_copyFromPathOffsets[source];
+		textModifications[i] = m_textModifications[source];
+		propertyModifications[i] = m_propertyModifications[source];
+	}
+
+	array<Byte>^ heap = gcnew array<Byte>((int)m_heap->size());
+	if(heap->Length > 0)
+	{
+		Marshal::Copy(IntPtr(&(*m_heap)[0]), heap, 0, heap->Length);
+	}
+
+	return gcnew ChangeBatch(m_changeset, m_count, actions, nodeKinds, copyFromRevisions, pathOffsets, copyFromPathOffsets, textModifications, propertyModifications, heap);
+}
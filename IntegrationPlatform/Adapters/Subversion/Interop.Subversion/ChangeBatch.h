@@ -0,0 +1,255 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <svn_client.h>
+#include "ChangeAction.h"
+#include "ChangeBuffer.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace ObjectModel
+						{
+							ref class Change;
+							ref class ChangeSet;
+
+							/// <summary>
+							/// A read only list of changes that stores their values in parallel arrays instead of one object per change. The paths are stored
+							/// UTF-8 encoded in one heap that holds every distinct path once. A <see cref="Change"/> object is only created if an element is
+							/// accessed by the indexer or the enumerator. The accessors by index read the arrays without creating any object
+							/// </summary>
+							public ref class ChangeBatch : public IList<Change^>
+							{
+							private:
+								ChangeSet^ m_changeset;
+								int m_start;
+								int m_count;
+
+								array<Byte>^ m_actions;
+								array<Byte>^ m_nodeKinds;
+								array<int>^ m_copyFromRevisions;
+								array<int>^ m_pathOffsets;
+								array<int>^ m_copyFromPathOffsets;
+								array<SByte>^ m_textModifications;
+								array<SByte>^ m_propertyModifications;
+								array<Byte>^ m_heap;
+
+								int ToPosition(int index);
+								String^ ReadPath(int offset);
+								std::string ReadBytes(int offset);
+								static Nullable<bool> ToModification(SByte value);
+
+							internal:
+								/// <summary>
+								/// Creates a batch from the arrays of a <see cref="ChangeBatchBuilder"/>
+								/// </summary>
+								ChangeBatch(ChangeSet^ changeset, int count, array<Byte>^ actions, array<Byte>^ nodeKinds, array<int>^ copyFromRevisions, array<int>^ pathOffsets,
+									array<int>^ copyFromPathOffsets, array<SByte>^ textModifications, array<SByte>^ propertyModifications, array<Byte>^ heap);
+
+								/// <summary>
+								/// Creates a batch that contains a range of another batch. Both batches share the same arrays
+								/// </summary>
+								/// <param name="batch">The batch that stores the changes</param>
+								/// <param name="start">The index of the first change of the range</param>
+								/// <param name="count">The number of changes of the range</param>
+								ChangeBatch(ChangeBatch^ batch, int start, int count);
+
+								/// <summary>
+								/// Gets the node kind of a change as it has been reported by subversion
+								/// </summary>
+								svn_node_kind_t GetNodeKind(int index);
+
+								/// <summary>
+								/// Replaces the node kind of a change whose node kind has not been reported by subversion
+								/// </summary>
+								void SetNodeKind(int index, svn_node_kind_t nodeKind);
+
+								/// <summary>
+								/// Gets the path of a change relative to the repository root. The path starts with a slash and is UTF-8 encoded
+								/// </summary>
+								std::string GetPath(int index);
+
+								/// <summary>
+								/// Gets the path of the copy source of a change relative to the repository root; an empty string if the change is not a copy
+								/// </summary>
+								std::string GetCopyFromPath(int index);
+
+								/// <summary>
+								/// Gets whether the text of the item has been modified; no value if this is not known
+								/// </summary>
+								Nullable<bool> GetTextModification(int index);
+
+								/// <summary>
+								/// Gets whether the properties of the item have been modified; no value if this is not known
+								/// </summary>
+								Nullable<bool> GetPropertyModification(int index);
+
+							public:
+								/// <summary>
+								/// Gets the number of changes of this batch
+								/// </summary>
+								property int Count { virtual int get(); }
+
+								/// <summary>
+								/// Gets true. The changes of a batch cannot be modified
+								/// </summary>
+								property bool IsReadOnly { virtual bool get(); }
+
+								/// <summary>
+								/// Gets a new <see cref="Change"/> object for the change at the index
+								/// </summary>
+								property Change^ default[int] { virtual Change^ get(int index); virtual void set(int index, Change^ value); }
+
+								/// <summary>
+								/// Gets the change operation of the change at the index
+								/// </summary>
+								ChangeAction GetChangeAction(int index);
+
+								/// <summary>
+								/// Gets whether the change at the index has a copy relation
+								/// </summary>
+								bool IsCopy(int index);
+
+								/// <summary>
+								/// Gets the revision of the copy source of the change at the index
+								/// </summary>
+								long GetCopyFromRevision(int index);
+
+								/// <summary>
+								/// Gets the absolute path of the item of the change at the index in the svn repository
+								/// </summary>
+								String^ GetFullServerPath(int index);
+
+								/// <summary>
+								/// Gets the absolute path of the copy source of the change at the index; null if the change is not a copy
+								/// </summary>
+								String^ GetCopyFromFullServerPath(int index);
+
+								/// <summary>
+								/// Searches a change with the same path and change action as <paramref name="item"/>
+								/// </summary>
+								virtual int IndexOf(Change^ item);
+
+								virtual bool Contains(Change^ item);
+
+								virtual void CopyTo(array<Change^>^ target, int arrayIndex);
+
+								virtual void Insert(int index, Change^ item);
+
+								virtual void RemoveAt(int index);
+
+								virtual void Add(Change^ item);
+
+								virtual void Clear();
+
+								virtual bool Remove(Change^ item);
+
+								virtual IEnumerator<Change^>^ GetEnumerator();
+
+								virtual System::Collections::IEnumerator^ GetEnumeratorNonGeneric() = System::Collections::IEnumerable::GetEnumerator;
+							};
+
+							/// <summary>
+							/// Enumerates the changes of a batch. Every step creates the <see cref="Change"/> object of the next change
+							/// </summary>
+							private ref class ChangeBatchEnumerator : public IEnumerator<Change^>
+							{
+							private:
+								ChangeBatch^ m_batch;
+								int m_index;
+								Change^ m_current;
+
+							public:
+								ChangeBatchEnumerator(ChangeBatch^ batch);
+
+								~ChangeBatchEnumerator();
+
+								virtual bool MoveNext();
+
+								virtual void Reset();
+
+								property Change^ Current { virtual Change^ get(); }
+
+								property Object^ CurrentNonGeneric { virtual Object^ get() = System::Collections::IEnumerator::Current::get; }
+							};
+
+							/// <summary>
+							/// Collects the changes of a batch. Identical paths are stored once in the heap of the batch
+							/// </summary>
+							private ref class ChangeBatchBuilder
+							{
+							private:
+								ChangeSet^ m_changeset;
+								int m_count;
+
+								array<Byte>^ m_actions;
+								array<Byte>^ m_nodeKinds;
+								array<int>^ m_copyFromRevisions;
+								array<int>^ m_pathOffsets;
+								array<int>^ m_copyFromPathOffsets;
+								array<SByte>^ m_textModifications;
+								array<SByte>^ m_propertyModifications;
+
+								std::vector<char>* m_heap;
+								std::map<std::string, int>* m_interned;
+
+								int Intern(const std::string& path);
+								void Resize(int capacity);
+								void Add(const std::string& path, ChangeAction changeAction, svn_node_kind_t nodeKind, const std::string& copyFromPath, long copyFromRevision, int textModification, int propertyModification);
+
+							public:
+								/// <summary>
+								/// Creates an empty builder
+								/// </summary>
+								/// <param name="changeset">The changeset to which the changes belong to</param>
+								/// <param name="capacity">The expected number of changes</param>
+								ChangeBatchBuilder(ChangeSet^ changeset, int capacity);
+
+								/// <summary>
+								/// Default destructor
+								/// </summary>
+								~ChangeBatchBuilder();
+
+								/// <summary>
+								/// Default Finalizer
+								/// </summary>
+								!ChangeBatchBuilder();
+
+								/// <summary>
+								/// Adds a change as it has been encoded by <see cref="Change::ToRecord"/>
+								/// </summary>
+								/// <exception cref="NotSupportedException">Will be thrown if subversion reported an unsupported change action</exception>
+								void Add(const Helpers::ChangeBuffer::Record& record);
+
+								/// <summary>
+								/// Adds a change from already decoded values
+								/// </summary>
+								void Add(String^ fullServerPath, ChangeAction changeAction, svn_node_kind_t nodeKind, String^ copyFromFullServerPath, long copyFromRevision, Nullable<bool> textModification, Nullable<bool> propertyModification);
+
+								/// <summary>
+								/// Creates the batch of all changes that have been added. The changes are ordered by their path, so that every folder
+								/// precedes the items below of it
+								/// </summary>
+								ChangeBatch^ ToBatch();
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,237 @@
+#include "Stdafx.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include "ChangeBuffer.h"
+
+using namespace System;
+
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+
+ChangeBuffer::ChangeBuffer(size_t spillThreshold, const std::wstring& spillFile)
+	: m_spillThreshold(spillThreshold), m_spillFile(spillFile), m_writer(NULL), m_spilledCount(0), m_sealed(false)
+{
+}
+
+ChangeBuffer::~ChangeBuffer()
+{
+	if(NULL != m_writer)
+	{
+		fclose(m_writer);
+		m_writer = NULL;
+	}
+
+	if(m_spilledCount > 0)
+	{
+		_wremove(m_spillFile.c_str());
+	}
+}
+
+void
+ChangeBuffer::Encode(const Record& record, std::vector<char>& target)
+{
+	unsigned int pathLength = (unsigned int)record.path.size();
+	unsigned int copyFromPathLength = (unsigned int)record.copyFromPath.size();
+	int copyFromRevision = (int)record.copyFromRevision;
+
+	char header[HeaderSize];
+	header[0] = record.action;
+	header[1] = (char)record.nodeKind;
+	header[2] = (char)record.textModified;
+	header[3] = (char)record.propsModified;
+	memcpy(header + 4, &copyFromRevision, 4);
+	memcpy(header + 8, &pathLength, 4);
+	memcpy(header + 12, &copyFromPathLength, 4);
+
+	target.insert(target.end(), header, header + HeaderSize);
+	target.insert(target.end(), record.path.begin(), record.path.end());
+	target.insert(target.end(), record.copyFromPath.begin(), record.copyFromPath.end());
+}
+
+void
+ChangeBuffer::Decode(const char* data, Record& record)
+{
+	int copyFromRevision;
+	unsigned int pathLength;
+	unsigned int copyFromPathLength;
+
+	record.action = data[0];
+	record.nodeKind = data[1];
+	record.textModified = data[2];
+	record.propsModified = data[3];
+	memcpy(&copyFromRevision, data + 4, 4);
+	memcpy(&pathLength, data + 8, 4);
+	memcpy(&copyFromPathLength, data + 12, 4);
+
+	record.copyFromRevision = copyFromRevision;
+	record.path.assign(data + HeaderSize, pathLength);
+	record.copyFromPath.assign(data + HeaderSize + pathLength, copyFromPathLength);
+}
+
+void
+ChangeBuffer::Add(const Record& record)
+{
+	if(m_sealed)
+	{
+		return;
+	}
+
+	if(0 == m_spillThreshold || m_offsets.size() < m_spillThreshold)
+	{
+		m_offsets.push_back(m_data.size());
+		Encode(record, m_data);
+		return;
+	}
+
+	if(NULL == m_writer)
+	{
+		m_writer = _wfopen(m_spillFile.c_str(), L"wb");
+		if(NULL == m_writer)
+		{
+			//Without a spill file the records stay in memory. This is the behavior of a buffer without a threshold
+			m_spillThreshold = 0;
+			Add(record);
+			return;
+		}
+	}
+
+	std::vector<char> encoded;
+	Encode(record, encoded);
+
+	//A record that is not written completely would cut off the changes of the revision
+	if(encoded.size() != fwrite(&encoded[0], 1, encoded.size(), m_writer))
+	{
+		ThrowIOError("write the change to");
+	}
+
+	m_spilledCount++;
+}
+
+void
+ChangeBuffer::ThrowIOError(const char* operation) const
+{
+	int error = errno;
+	throw gcnew MigrationException(String::Format("Subversion Client: Failed to {0} the spill file '{1}' (errno {2})", gcnew String(operation), gcnew String(m_spillFile.c_str()), error));
+}
+
+bool
+ChangeBuffer::PathOrder::operator()(size_t x, size_t y) const
+{
+	const char* left = &(*data)[x];
+	const char* right = &(*data)[y];
+
+	unsigned int leftLength;
+	unsigned int rightLength;
+	memcpy(&leftLength, left + 8, 4);
+	memcpy(&rightLength, right + 8, 4);
+
+	int result = memcmp(left + HeaderSize, right + HeaderSize, std::min(leftLength, rightLength));
+	return result < 0 || (0 == result && leftLength < rightLength);
+}
+
+void
+ChangeBuffer::Seal()
+{
+	if(m_sealed)
+	{
+		return;
+	}
+
+	m_sealed = true;
+
+	if(NULL != m_writer)
+	{
+		//The buffered records reach the disk with the flush. A full disk is reported here at the latest
+		bool flushed = 0 == fflush(m_writer);
+		bool closed = 0 == fclose(m_writer);
+		m_writer = NULL;
+
+		if(!flushed || !closed)
+		{
+			ThrowIOError("flush the changes to");
+		}
+	}
+
+	//A byte wise order of the UTF-8 paths places every folder before all items below of it
+	if(0 == m_spilledCount)
+	{
+		PathOrder order;
+		order.data = &m_data;
+		std::sort(m_offsets.begin(), m_offsets.end(), order);
+	}
+}
+
+size_t
+ChangeBuffer::Count() const
+{
+	return m_offsets.size() + m_spilledCount;
+}
+
+bool
+ChangeBuffer::Spilled() const
+{
+	return m_spilledCount > 0;
+}
+
+ChangeBuffer::Cursor::Cursor(const ChangeBuffer& buffer)
+	: m_buffer(buffer), m_position(0), m_file(NULL)
+{
+}
+
+ChangeBuffer::Cursor::~Cursor()
+{
+	if(NULL != m_file)
+	{
+		fclose(m_file);
+		m_file = NULL;
+	}
+}
+
+bool
+ChangeBuffer::Cursor::Next(Record& record)
+{
+	if(m_position < m_buffer.m_offsets.size())
+	{
+		Decode(&m_buffer.m_data[m_buffer.m_offsets[m_position]], record);
+		m_position++;
+		return true;
+	}
+
+	if(m_position >= m_buffer.Count())
+	{
+		return false;
+	}
+
+	if(NULL == m_file)
+	{
+		m_file = _wfopen(m_buffer.m_spillFile.c_str(), L"rb");
+		if(NULL == m_file)
+		{
+			m_buffer.ThrowIOError("open");
+		}
+	}
+
+	//The buffer reports the record. A short read means that the spill file is damaged or unreadable
+	char header[HeaderSize];
+	if(HeaderSize != fread(header, 1, HeaderSize, m_file))
+	{
+		m_buffer.ThrowIOError("read a change from");
+	}
+
+	unsigned int pathLength;
+	unsigned int copyFromPathLength;
+	memcpy(&pathLength, header + 8, 4);
+	memcpy(&copyFromPathLength, header + 12, 4);
+
+	std::vector<char> encoded(HeaderSize + pathLength + copyFromPathLength);
+	memcpy(&encoded[0], header, HeaderSize);
+	if(encoded.size() > HeaderSize && encoded.size() - HeaderSize != fread(&encoded[HeaderSize], 1, encoded.size() - HeaderSize, m_file))
+	{
+		m_buffer.ThrowIOError("read a change from");
+	}
+
+	Decode(&encoded[0], record);
+	m_position++;
+	return true;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							/// <summary>
+							/// Native store for the changed paths of a single revision. The changes are encoded as compact records in one buffer
+							/// instead of one managed object per path. Once the buffer holds more records than the spill threshold, all further
+							/// records are appended to a temporary file. Therefore the memory of a revision is bounded regardless of its size.
+							/// <para/>
+							/// The buffer is filled once and read sequentially by any number of cursors afterwards
+							/// </summary>
+							class ChangeBuffer
+							{
+							public:
+								/// <summary>
+								/// A decoded change. The modifications are -1 if unknown, 0 if not modified and 1 if modified
+								/// </summary>
+								struct Record
+								{
+									char action;
+									int nodeKind;
+									long copyFromRevision;
+									int textModified;
+									int propsModified;
+									std::string path;
+									std::string copyFromPath;
+								};
+
+								/// <summary>
+								/// Reads the records of a sealed buffer in order. Every cursor has its own handle of the spill file
+								/// </summary>
+								class Cursor
+								{
+								public:
+									Cursor(const ChangeBuffer& buffer);
+									~Cursor();
+
+									/// <summary>
+									/// Reads the next record
+									/// </summary>
+									/// <returns>false if all records have been read</returns>
+									/// <exception cref="MigrationException">Will be thrown if a spilled record cannot be read</exception>
+									bool Next(Record& record);
+
+								private:
+									const ChangeBuffer& m_buffer;
+									size_t m_position;
+									FILE* m_file;
+
+									Cursor(const Cursor&);
+									Cursor& operator=(const Cursor&);
+								};
+
+								/// <summary>
+								/// Creates an empty buffer
+								/// </summary>
+								/// <param name="spillThreshold">The number of records that are kept in memory; 0 to keep all records in memory</param>
+								/// <param name="spillFile">The file that receives the records above the threshold. It is created with the first spilled record and deleted with the buffer</param>
+								ChangeBuffer(size_t spillThreshold, const std::wstring& spillFile);
+								~ChangeBuffer();
+
+								/// <summary>
+								/// Appends a record. Must not be called after the buffer has been sealed
+								/// </summary>
+								/// <exception cref="MigrationException">Will be thrown if the record cannot be written to the spill file</exception>
+								void Add(const Record& record);
+
+								/// <summary>
+								/// Completes the buffer. Records that are held in memory entirely are ordered by their path, so that parents precede their children
+								/// </summary>
+								/// <exception cref="MigrationException">Will be thrown if the spill file cannot be flushed</exception>
+								void Seal();
+
+								/// <summary>
+								/// Gets the number of records
+								/// </summary>
+								size_t Count() const;
+
+								/// <summary>
+								/// Gets whether records have been written to the spill file. Spilled records are kept in the order they have been added
+								/// </summary>
+								bool Spilled() const;
+
+							private:
+								//Every record starts with a fixed header that is followed by the path and the copy from path
+								static const size_t HeaderSize = 16;
+
+								size_t m_spillThreshold;
+								std::wstring m_spillFile;
+								std::vector<char> m_data;
+								std::vector<size_t> m_offsets;
+								FILE* m_writer;
+								size_t m_spilledCount;
+								bool m_sealed;
+
+								static void Encode(const Record& record, std::vector<char>& target);
+								static void Decode(const char* data, Record& record);
+								void ThrowIOError(const char* operation) const;
+
+								struct PathOrder
+								{
+									const std::vector<char>* data;
+									bool operator()(size_t x, size_t y) const;
+								};
+
+								ChangeBuffer(const ChangeBuffer&);
+								ChangeBuffer& operator=(const ChangeBuffer&);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
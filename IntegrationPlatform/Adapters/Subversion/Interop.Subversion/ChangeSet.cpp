@@ -1,12 +1,18 @@
 #include "stdafx.h"
 
+#include <msclr\marshal_cppstd.h>
 #include "Change.h"
+#include "ChangeBatch.h"
 #include "ChangeSet.h"
 #include "DI_LibApr.h"
+#include "PathFilter.h"
 #include "SubversionClient.h"
 #include "Utils.h"
 
 using namespace System;
+using namespace System::IO;
+using namespace msclr::interop;
+
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
@@ -14,7 +20,7 @@ using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop
 using namespace Microsoft::TeamFoundation::Migration::Toolkit;
 using namespace Microsoft::TeamFoundation::Migration::Toolkit::Services;
 
-ChangeSet::ChangeSet(svn_log_entry_t *log_entry, SubversionClient^ client, apr_pool_t* pool)
+ChangeSet::ChangeSet(svn_log_entry_t *log_entry, SubversionClient^ client, apr_pool_t* pool, PathFilter^ pathFilter)
 {	
 	if (NULL == log_entry)
 	{
@@ -67,17 +73,104 @@ ChangeSet::ChangeSet(svn_log_entry_t *log_entry, SubversionClient^ client, apr_p
 		}
 	}
 	
-	if (NULL != log_entry->changed_paths2)
+	if (NULL != log_entry->changed_paths2 && libApr->AprHashCount(log_entry->changed_paths2) > BufferThreshold)
 	{
-		m_changes = gcnew List<Change^>();
+		//A revision that imports or tags a whole tree can change hundreds of thousands of paths. They are encoded in a native buffer
+		//and decoded batch by batch. Therefore the managed heap never has to hold all of them at once
+		String^ spillFile = Path::Combine(Path::GetTempPath(), Path::GetRandomFileName());
+		m_buffer = new ChangeBuffer(client->ChangeSpillThreshold, marshal_as<std::wstring>(spillFile));
+
+		ChangeBuffer::Record record;
 		for (index = libApr->AprHashFirst(pool, log_entry->changed_paths2); index; index = libApr->AprHashNext(index))
 		{
 			libApr->AprHashThis(index, &key, NULL, &value);
-			svn_log_changed_path2_t* changeDetail = (svn_log_changed_path2_t*)value;
-			String^ changePath = gcnew String((const char*)key, 0, strlen((const char*) key), System::Text::Encoding::UTF8);
-			m_changes->Add(gcnew Change(this, changePath, changeDetail));
+			if(nullptr != pathFilter && !pathFilter->Includes((const char*)key))
+			{
+				continue;
+			}
+
+			Change::ToRecord((const char*)key, (svn_log_changed_path2_t*)value, record);
+			m_buffer->Add(record);
+		}
+
+		m_buffer->Seal();
+		if(m_buffer->Spilled())
+		{
+			TraceManager::TraceInformation("Revision {0} changes {1} paths. The changes above {2} paths have been written to '{3}'", m_revision, (int)m_buffer->Count(), client->ChangeSpillThreshold, spillFile);
 		}
 	}
+	else if (NULL != log_entry->changed_paths2)
+	{
+		//The changes are stored in columns. A change object is only created if a consumer asks for it
+		ChangeBatchBuilder^ builder = gcnew ChangeBatchBuilder(this, (int)libApr->AprHashCount(log_entry->changed_paths2));
+		try
+		{
+			ChangeBuffer::Record record;
+			for (index = libApr->AprHashFirst(pool, log_entry->changed_paths2); index; index = libApr->AprHashNext(index))
+			{
+				libApr->AprHashThis(index, &key, NULL, &value);
+				if(nullptr != pathFilter && !pathFilter->Includes((const char*)key))
+				{
+					//The change is neither within the mapped scope nor a recursive operation on a parent of a mapping. Skip it before any managed memory is allocated
+					continue;
+				}
+
+				Change::ToRecord((const char*)key, (svn_log_changed_path2_t*)value, record);
+				builder->Add(record);
+			}
+
+			m_changes = builder->ToBatch();
+		}
+		finally
+		{
+			delete builder;
+		}
+	}
+}
+
+ChangeSet::ChangeSet(SubversionClient^ client, long revision, String^ author, String^ comment, DateTime commitTime)
+{
+	if(nullptr == client)
+	{
+		throw gcnew ArgumentNullException("client");
+	}
+
+	m_client = client;
+	m_revision = revision;
+	m_author = author;
+	m_comment = comment;
+	m_commitTime = commitTime;
+}
+
+void
+ChangeSet::SetChanges(ChangeBatch^ changes)
+{
+	if(nullptr == changes)
+	{
+		throw gcnew ArgumentNullException("changes");
+	}
+
+	m_changes = changes;
+}
+
+ChangeSet::~ChangeSet()
+{
+	this->!ChangeSet();
+}
+
+ChangeSet::!ChangeSet()
+{
+	FreeBuffer();
+}
+
+void
+ChangeSet::FreeBuffer()
+{
+	if(NULL != m_buffer)
+	{
+		delete m_buffer;
+		m_buffer = NULL;
+	}
 }
 
 long 
@@ -104,10 +197,167 @@ ChangeSet::Comment::get()
 	return m_comment;
 }
 
+void
+ChangeSet::ResolveModifications()
+{
+	if(m_modificationsResolved || (nullptr == m_changes && NULL == m_buffer))
+	{
+		return;
+	}
+
+	m_modificationsResolved = true;
+
+	//The folder that contains all modified files. A modified file existed in the previous revision already and so did its folder,
+	//unless the folder has been copied in the same revision. The comparison fails in that case and the modifications remain unknown
+	String^ repositoryRoot = m_client->RepositoryRoot->ToString()->TrimEnd(Utils::SeperatorCharArray);
+	String^ root = nullptr;
+
+	for each(ChangeBatch^ batch in GetChangeBatches())
+	{
+		for(int i = 0; i < batch->Count; i++)
+		{
+			if(ObjectModel::ChangeAction::Modify != batch->GetChangeAction(i) || svn_node_dir == batch->GetNodeKind(i) || batch->GetTextModification(i).HasValue)
+			{
+				continue;
+			}
+
+			String^ path = batch->GetFullServerPath(i);
+			if(nullptr == root)
+			{
+				root = path;
+			}
+
+			while(root->Length > repositoryRoot->Length && !path->StartsWith(String::Concat(root, Utils::Seperator), StringComparison::Ordinal))
+			{
+				root = root->Substring(0, root->LastIndexOf(Utils::Seperator));
+			}
+		}
+	}
+
+	if(nullptr == root)
+	{
+		return;
+	}
+
+	try
+	{
+		m_modifiedItems = m_client->GetModifiedItems(gcnew Uri(root), m_revision - 1, gcnew Uri(root), m_revision);
+		m_modifiedItems->Sort(StringComparer::Ordinal);
+	}
+	catch(MigrationException^ e)
+	{
+		//The modifications remain unknown. The files are treated as modified as they have been before
+		TraceManager::TraceWarning("The modifications of revision {0} could not be determined: {1}", m_revision, e->Message);
+	}
+}
+
+void
+ChangeSet::ApplyModifications(Change^ change)
+{
+	//The change objects are created on demand. They receive their modifications when they are asked for them
+	ResolveModifications();
+
+	if(nullptr == m_modifiedItems || ObjectModel::ChangeAction::Modify != change->ChangeAction || svn_node_dir == change->NodeKind || change->TextModification.HasValue)
+	{
+		return;
+	}
+
+	bool textModified = m_modifiedItems->BinarySearch(change->FullServerPath, StringComparer::Ordinal) >= 0;
+	change->TextModification = textModified;
+	if(!textModified)
+	{
+		//Subversion reported the file as modified although its text is unchanged. Therefore only the properties can have been modified
+		change->PropertyModification = true;
+	}
+}
+
+bool
+ChangeSet::IsOrdered::get()
+{
+	if(NULL != m_buffer)
+	{
+		return !m_buffer->Spilled();
+	}
+
+	return nullptr != m_changes;
+}
+
+int
+ChangeSet::ChangeCount::get()
+{
+	if(NULL != m_buffer)
+	{
+		return (int)m_buffer->Count();
+	}
+
+	return nullptr == m_changes ? -1 : m_changes->Count;
+}
+
+void
+ChangeSet::ResolveDetails()
+{
+	ResolveModifications();
+
+	if(nullptr == m_changes)
+	{
+		return;
+	}
+
+	for(int i = 0; i < m_changes->Count; i++)
+	{
+		if(svn_node_unknown != m_changes->GetNodeKind(i))
+		{
+			continue;
+		}
+
+		try
+		{
+			Change^ change = m_changes[i];
+			if(nullptr != change->ItemType)
+			{
+				m_changes->SetNodeKind(i, change->NodeKind);
+			}
+		}
+		catch(MigrationException^ e)
+		{
+			//The change may not need its node kind at all. If it does, the query is repeated and fails where the change is processed
+			TraceManager::TraceWarning("The node kind of a change of revision {0} could not be determined: {1}", m_revision, e->Message);
+		}
+	}
+}
+
+IEnumerable<ChangeBatch^>^
+ChangeSet::GetChangeBatches()
+{
+	return GetChangeBatches(DefaultBatchSize);
+}
+
+IEnumerable<ChangeBatch^>^
+ChangeSet::GetChangeBatches(int batchSize)
+{
+	if(batchSize <= 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("batchSize");
+	}
+
+	return gcnew ChangeBatches(this, m_changes, m_buffer, batchSize);
+}
+
 List<Change^>^
 ChangeSet::Changes::get()
 {
-	return m_changes;
+	if(nullptr == m_changes && NULL == m_buffer)
+	{
+		return nullptr;
+	}
+
+	List<Change^>^ changes = gcnew List<Change^>(ChangeCount);
+	for each(ChangeBatch^ batch in GetChangeBatches())
+	{
+		changes->AddRange(batch);
+	}
+
+	return changes;
 }
 
 String^
@@ -122,3 +372,122 @@ ChangeSet::Client::get()
 	return m_client;
 }
 
+ChangeBatches::ChangeBatches(ChangeSet^ changeset, ChangeBatch^ changes, ChangeBuffer* buffer, int batchSize)
+{
+	m_changeset = changeset;
+	m_changes = changes;
+	m_buffer = buffer;
+	m_batchSize = batchSize;
+}
+
+ChangeBatches::~ChangeBatches()
+{
+	this->!ChangeBatches();
+}
+
+ChangeBatches::!ChangeBatches()
+{
+	if(NULL != m_cursor)
+	{
+		delete m_cursor;
+		m_cursor = NULL;
+	}
+}
+
+IEnumerator<ChangeBatch^>^
+ChangeBatches::GetEnumerator()
+{
+	if(m_started)
+	{
+		throw gcnew InvalidOperationException("The batches of a changeset can only be enumerated once");
+	}
+
+	m_started = true;
+	if(NULL != m_buffer)
+	{
+		m_cursor = new ChangeBuffer::Cursor(*m_buffer);
+	}
+
+	return this;
+}
+
+System::Collections::IEnumerator^
+ChangeBatches::GetEnumeratorNonGeneric()
+{
+	return GetEnumerator();
+}
+
+bool
+ChangeBatches::MoveNext()
+{
+	m_current = nullptr;
+
+	if(nullptr != m_changes)
+	{
+		int count = Math::Min(m_batchSize, m_changes->Count - m_position);
+		if(count <= 0)
+		{
+			return false;
+		}
+
+		m_current = gcnew ChangeBatch(m_changes, m_position, count);
+		m_position += count;
+		return true;
+	}
+
+	if(NULL == m_cursor)
+	{
+		return false;
+	}
+
+	int total = (int)m_buffer->Count();
+	if(m_position >= total)
+	{
+		return false;
+	}
+
+	int end = m_position + Math::Min(m_batchSize, total - m_position);
+	ChangeBatchBuilder^ builder = gcnew ChangeBatchBuilder(m_changeset, end - m_position);
+	try
+	{
+		ChangeBuffer::Record record;
+		while(m_position < end)
+		{
+			if(!m_cursor->Next(record))
+			{
+				String^ message = String::Format("Subversion Client: Only {0} of the {1} buffered changes of revision {2} could be read", m_position, total, m_changeset->Revision);
+				TraceManager::TraceError(message);
+				throw gcnew MigrationException(message);
+			}
+
+			builder->Add(record);
+			m_position++;
+		}
+
+		m_current = builder->ToBatch();
+	}
+	finally
+	{
+		delete builder;
+	}
+
+	return true;
+}
+
+void
+ChangeBatches::Reset()
+{
+	throw gcnew NotSupportedException();
+}
+
+ChangeBatch^
+ChangeBatches::Current::get()
+{
+	return m_current;
+}
+
+Object^
+ChangeBatches::CurrentNonGeneric::get()
+{
+	return m_current;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <svn_client.h>
+#include "ChangeBuffer.h"
 
 using namespace System;
 using namespace System::Collections::Generic;
@@ -22,6 +23,59 @@ namespace Microsoft
 						namespace ObjectModel
 						{
 							ref class Change;
+							ref class ChangeBatch;
+							ref class PathFilter;
+
+							ref class ChangeSet;
+
+							/// <summary>
+							/// A single pass sequence of the changes of a changeset in batches of a fixed size. The changes of a buffered changeset
+							/// are decoded batch by batch. Therefore only one batch is held in memory if the consumer releases the previous ones
+							/// </summary>
+							private ref class ChangeBatches : public IEnumerable<ChangeBatch^>, public IEnumerator<ChangeBatch^>
+							{
+							private:
+								ChangeSet^ m_changeset;
+								ChangeBatch^ m_changes;
+								Helpers::ChangeBuffer* m_buffer;
+								Helpers::ChangeBuffer::Cursor* m_cursor;
+								int m_batchSize;
+								int m_position;
+								bool m_started;
+								ChangeBatch^ m_current;
+
+							public:
+								/// <summary>
+								/// Creates the batches of a changeset
+								/// </summary>
+								/// <param name="changeset">The changeset to which the changes belong to</param>
+								/// <param name="changes">The changes of a changeset that holds them in a single batch; null for a buffered changeset</param>
+								/// <param name="buffer">The buffer of a buffered changeset; NULL for a changeset that holds the changes in a single batch</param>
+								/// <param name="batchSize">The maximum number of changes per batch</param>
+								ChangeBatches(ChangeSet^ changeset, ChangeBatch^ changes, Helpers::ChangeBuffer* buffer, int batchSize);
+
+								/// <summary>
+								/// Default destructor
+								/// </summary>
+								~ChangeBatches();
+
+								/// <summary>
+								/// Default Finalizer
+								/// </summary>
+								!ChangeBatches();
+
+								virtual IEnumerator<ChangeBatch^>^ GetEnumerator();
+
+								virtual System::Collections::IEnumerator^ GetEnumeratorNonGeneric() = System::Collections::IEnumerable::GetEnumerator;
+
+								virtual bool MoveNext();
+
+								virtual void Reset();
+
+								property ChangeBatch^ Current { virtual ChangeBatch^ get(); }
+
+								property Object^ CurrentNonGeneric { virtual Object^ get() = System::Collections::IEnumerator::Current::get; }
+							};
 
 							public ref class ChangeSet
 							{
@@ -30,11 +84,21 @@ namespace Microsoft
 									String^ m_author;
 									String^ m_comment;
 									DateTime m_commitTime;
-									List<Change^>^ m_changes;
+									ChangeBatch^ m_changes;
+									Helpers::ChangeBuffer* m_buffer;
+									bool m_modificationsResolved;
+									List<String^>^ m_modifiedItems;
 														
 									SubversionClient^ m_client;
+
+									void FreeBuffer();
 								
 								internal:
+									/// <summary>
+									/// The number of changed paths above which the changes of a revision are stored in a native buffer instead of a list
+									/// </summary>
+									static const int BufferThreshold = 10000;
+
 									/// <summary>
 									/// Gets the subversion client connection that can be used to query more information
 									/// </summary>
@@ -43,9 +107,62 @@ namespace Microsoft
 									/// <summary>
 									/// Default Constructor
 									/// </summary>
-									ChangeSet(svn_log_entry_t *log_entry, SubversionClient^ client, apr_pool_t* pool);
+									/// <param name="log_entry">The log entry as it is reported by subversion</param>
+									/// <param name="client">The client that is used to query more information</param>
+									/// <param name="pool">The pool that is used to iterate the log entry</param>
+									/// <param name="pathFilter">The filter that decides which changed paths are materialized; null to materialize all changes</param>
+									ChangeSet(svn_log_entry_t *log_entry, SubversionClient^ client, apr_pool_t* pool, PathFilter^ pathFilter);
+
+									/// <summary>
+									/// Creates a changeset from already decoded values. The changes are unknown until they are set by <see cref="SetChanges"/>
+									/// </summary>
+									/// <param name="client">The client that is used to query more information</param>
+									/// <param name="revision">The revision number of the changeset</param>
+									/// <param name="author">The author of the changeset</param>
+									/// <param name="comment">The checkin comment of the changeset</param>
+									/// <param name="commitTime">The commit time (in UTC) of the changeset</param>
+									ChangeSet(SubversionClient^ client, long revision, String^ author, String^ comment, DateTime commitTime);
+
+									/// <summary>
+									/// Sets the changes of a changeset that has been created from already decoded values
+									/// </summary>
+									/// <param name="changes">The changes that have been collected by a <see cref="ChangeBatchBuilder"/> of this changeset</param>
+									void SetChanges(ChangeBatch^ changes);
+
+									/// <summary>
+									/// Determines the text and property modifications of all modified files whose modifications have not been reported by subversion.
+									/// The files are compared to the previous revision by a single diff of their common parent folder
+									/// </summary>
+									void ResolveModifications();
+
+									/// <summary>
+									/// Sets the text and property modifications of a modified file that have been determined by <see cref="ResolveModifications"/>
+									/// </summary>
+									/// <param name="change">A change of this changeset whose modifications are unknown</param>
+									void ApplyModifications(Change^ change);
+
+									/// <summary>
+									/// Gets whether the batches yield every folder before the items below of it. This is the case unless the changes
+									/// have been spilled to disk
+									/// </summary>
+									property bool IsOrdered { bool get(); }
 
 								public:
+									/// <summary>
+									/// The default number of changes per batch of <see cref="GetChangeBatches"/>
+									/// </summary>
+									static const int DefaultBatchSize = 1000;
+
+									/// <summary>
+									/// Default destructor. Releases the buffered changes
+									/// </summary>
+									~ChangeSet();
+
+									/// <summary>
+									/// Default Finalizer
+									/// </summary>
+									!ChangeSet();
+
 									/// <summary>
 									/// Gets the author of the changeset
 									/// </summary>
@@ -69,8 +186,41 @@ namespace Microsoft
 									/// <summary>
 									/// Gets all the changes if the changed items were queried; Null if the changes were not queried at all
 									/// </summary>
+									/// <remarks>
+									/// The changes are stored in columns and a new list with a new object per change is created by every call.
+									/// Use <see cref="GetChangeBatches"/> to process them with a bounded amount of memory
+									/// </remarks>
 									property List<Change^>^ Changes { List<Change^>^ get(); }
 
+									/// <summary>
+									/// Gets the number of changes; -1 if the changes were not queried at all
+									/// </summary>
+									property int ChangeCount { int get(); }
+
+									/// <summary>
+									/// Gets the changes in batches of <see cref="DefaultBatchSize"/> changes
+									/// </summary>
+									/// <returns>The batches of changes; an empty sequence if the changes were not queried at all</returns>
+									IEnumerable<ChangeBatch^>^ GetChangeBatches();
+
+									/// <summary>
+									/// Gets the changes in batches of a fixed size. Every batch can be released once it has been processed
+									/// </summary>
+									/// <param name="batchSize">The maximum number of changes per batch</param>
+									/// <returns>The batches of changes; an empty sequence if the changes were not queried at all</returns>
+									/// <exception cref="MigrationException">Will be thrown if the buffered changes cannot be read anymore</exception>
+									IEnumerable<ChangeBatch^>^ GetChangeBatches(int batchSize);
+
+									/// <summary>
+									/// Queries the details that subversion did not report along with the changes. These are the node kinds of the
+									/// changed items and whether modified files changed their text. Otherwise the details are queried on demand
+									/// while the changes are processed. Resolving them in advance allows to query them on an other thread
+									/// </summary>
+									/// <remarks>
+									/// The node kinds of changes that have been spilled to disk are not stored and remain to be queried on demand
+									/// </remarks>
+									void ResolveDetails();
+
 									/// <summary>
 									/// Gets the URI of the repository
 									/// </summary>
@@ -0,0 +1,490 @@
+#include "Stdafx.h"
+#include <svn_error_codes.h>
+#include <svn_props.h>
+#include "AprPool.h"
+#include "CommitItem.h"
+#include "DI_LibApr.h"
+#include "DI_Svn_Client-1.h"
+#include "DI_Svn_Delta-1.h"
+#include "DI_Svn_Ra-1.h"
+#include "DI_Svn_Subr-1.h"
+#include "LibraryLoader.h"
+#include "SubversionContext.h"
+#include "CommitCommand.h"
+#include "SvnError.h"
+#include "Utils.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::IO;
+using namespace System::Runtime::InteropServices;
+using namespace System::Security::Cryptography;
+using namespace System::Text;
+using namespace System::Threading;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Commands;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* SvnPathDriverCallbackDelegate(void **dir_baton, void *parent_baton, void *callback_baton, const char *path, apr_pool_t *pool);
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* SvnCommitCallback2Delegate(const svn_commit_info_t *commit_info, void *baton, apr_pool_t *pool);
+
+PreparedContent::PreparedContent(CommitItem^ item)
+{
+	Item = item;
+	Ready = gcnew ManualResetEventSlim(false);
+}
+
+CommitCommand::CommitCommand(SubversionContext^ context, Uri^ repositoryRoot, IEnumerable<CommitItem^>^ items, String^ message)
+{
+	if(nullptr == context)
+	{
+		throw gcnew ArgumentNullException("context");
+	}
+
+	if(nullptr == repositoryRoot)
+	{
+		throw gcnew ArgumentNullException("repositoryRoot");
+	}
+
+	if(nullptr == items)
+	{
+		throw gcnew ArgumentNullException("items");
+	}
+
+	m_context = context;
+	m_repositoryRoot = repositoryRoot;
+	m_message = nullptr != message ? message : String::Empty;
+
+	Sort(items);
+}
+
+void
+CommitCommand::Sort(IEnumerable<CommitItem^>^ items)
+{
+	m_deletions = gcnew Dictionary<String^, CommitItem^>(StringComparer::Ordinal);
+	m_changes = gcnew Dictionary<String^, CommitItem^>(StringComparer::Ordinal);
+
+	for each(CommitItem^ item in items)
+	{
+		Dictionary<String^, CommitItem^>^ target = CommitAction::Delete == item->Action ? m_deletions : m_changes;
+		if(target->ContainsKey(item->Path))
+		{
+			throw gcnew ArgumentException(String::Format("The path {0} is changed more than once", item->Path), "items");
+		}
+
+		if(CommitAction::Modify == item->Action && m_deletions->ContainsKey(item->Path))
+		{
+			throw gcnew ArgumentException(String::Format("The path {0} is modified after it has been deleted", item->Path), "items");
+		}
+
+		target->Add(item->Path, item);
+	}
+
+	m_paths = gcnew List<String^>();
+	List<CommitItem^>^ contentItems = gcnew List<CommitItem^>();
+
+	for each(String^ path in m_deletions->Keys)
+	{
+		//The children of a deleted directory are deleted together with it. Only a replaced directory may be changed below
+		if(!IsBelowDeletion(path) && !m_changes->ContainsKey(path))
+		{
+			m_paths->Add(path);
+		}
+	}
+
+	for each(KeyValuePair<String^, CommitItem^> change in m_changes)
+	{
+		if(IsBelowDeletion(change.Key))
+		{
+			throw gcnew ArgumentException(String::Format("The path {0} is changed below a deleted directory", change.Key), "items");
+		}
+
+		m_paths->Add(change.Key);
+		if(!change.Value->IsDirectory && nullptr != change.Value->ContentSource)
+		{
+			contentItems->Add(change.Value);
+		}
+	}
+
+	//The path driver visits the paths in this order. The workers prepare the content in the same order
+	m_paths->Sort(gcnew Comparison<String^>(&CommitCommand::ComparePaths));
+
+	contentItems->Sort(gcnew Comparison<CommitItem^>(&CommitCommand::CompareItems));
+	m_prepared = gcnew array<PreparedContent^>(contentItems->Count);
+	for(int i = 0; i < m_prepared->Length; i++)
+	{
+		m_prepared[i] = gcnew PreparedContent(contentItems[i]);
+	}
+}
+
+bool
+CommitCommand::IsBelowDeletion(String^ path)
+{
+	for(int index = path->IndexOf('/'); index >= 0; index = path->IndexOf('/', index + 1))
+	{
+		String^ parent = path->Substring(0, index);
+		if(m_deletions->ContainsKey(parent) && !m_changes->ContainsKey(parent))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void
+CommitCommand::Execute([Out] long% revision)
+{
+	revision = -1;
+
+	m_nextPrepared = 0;
+	m_nextConsumed = 0;
+	m_revision = -1;
+	m_error = nullptr;
+	m_editor = NULL;
+
+	if(0 == m_paths->Count)
+	{
+		throw gcnew InvalidOperationException("The commit does not contain any change");
+	}
+
+	SvnPathDriverCallbackDelegate^ fpDriver = gcnew SvnPathDriverCallbackDelegate(this, &CommitCommand::SvnPathDriverCallbackT);
+	GCHandle gchDriver = GCHandle::Alloc(fpDriver);
+	svn_delta_path_driver_cb_func_t driverCallback = static_cast<svn_delta_path_driver_cb_func_t>(Marshal::GetFunctionPointerForDelegate(fpDriver).ToPointer());
+
+	SvnCommitCallback2Delegate^ fpCommit = gcnew SvnCommitCallback2Delegate(this, &CommitCommand::SvnCommitCallback2T);
+	GCHandle gchCommit = GCHandle::Alloc(fpCommit);
+	svn_commit_callback2_t commitCallback = static_cast<svn_commit_callback2_t>(Marshal::GetFunctionPointerForDelegate(fpCommit).ToPointer());
+
+	m_window = gcnew SemaphoreSlim(ReadAhead);
+	m_cancellation = gcnew CancellationTokenSource();
+	array<Thread^>^ workers = gcnew array<Thread^>(Math::Min(Workers, m_prepared->Length));
+	for(int i = 0; i < workers->Length; i++)
+	{
+		workers[i] = gcnew Thread(gcnew ThreadStart(this, &CommitCommand::Prepare));
+		workers[i]->IsBackground = true;
+		workers[i]->Start();
+	}
+
+	AprPool^ pool = gcnew AprPool();
+	void* editBaton = NULL;
+	try
+	{
+		//The session is opened at the root because the paths of the editor are relative to the session
+		svn_ra_session_t* session = NULL;
+		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_OPEN_RA_SESSION(&session, pool->CopyString(m_repositoryRoot->AbsoluteUri), m_context->Handle, pool->Handle));
+
+		apr_hash_t* revprops = LibApr::Instance()->AprHashMake(pool->Handle);
+		LibApr::Instance()->AprHashSet(revprops, SVN_PROP_REVISION_LOG, APR_HASH_KEY_STRING, Svn_subr::Instance()->SVN_STRING_CREATE(pool->CopyString(m_message), pool->Handle));
+
+		const svn_delta_editor_t* editor = NULL;
+		SvnError::Err(Svn_Ra::Instance()->SVN_RA_GET_COMMIT_EDITOR3(session, &editor, &editBaton, revprops, commitCallback, NULL, NULL, FALSE, pool->Handle));
+		m_editor = editor;
+
+		apr_array_header_t* paths = LibApr::Instance()->AprArrayMake(pool->Handle, m_paths->Count, sizeof(const char*));
+		for each(String^ path in m_paths)
+		{
+			*(const char**)LibApr::Instance()->AprArrayPush(paths) = pool->CopyString(path);
+		}
+
+		try
+		{
+			SvnError::Err(Svn_Delta::Instance()->SVN_DELTA_PATH_DRIVER(m_editor, editBaton, SVN_INVALID_REVNUM, paths, driverCallback, NULL, pool->Handle));
+			SvnError::Err(m_editor->close_edit(editBaton, pool->Handle));
+		}
+		catch(Exception^)
+		{
+			//The transaction is removed from the server. The error of the abort is less relevant than the original one
+			Svn_subr::Instance()->SVN_ERROR_CLEAR(m_editor->abort_edit(editBaton, pool->Handle));
+			throw;
+		}
+	}
+	catch(OperationCanceledException^)
+	{
+		if(nullptr == m_error)
+		{
+			throw;
+		}
+
+		throw gcnew MigrationException(String::Format("The commit to {0} failed", m_repositoryRoot), m_error);
+	}
+	finally
+	{
+		m_cancellation->Cancel();
+		for each(Thread^ worker in workers)
+		{
+			worker->Join();
+		}
+
+		m_editor = NULL;
+		delete pool;
+		gchDriver.Free();
+		gchCommit.Free();
+	}
+
+	revision = m_revision;
+}
+
+void
+CommitCommand::Prepare()
+{
+	try
+	{
+		while(true)
+		{
+			m_window->Wait(m_cancellation->Token);
+
+			int index = Interlocked::Increment(m_nextPrepared) - 1;
+			if(index >= m_prepared->Length)
+			{
+				return;
+			}
+
+			PreparedContent^ content = m_prepared[index];
+			try
+			{
+				content->LocalPath = content->Item->ContentSource->Invoke();
+				content->Checksum = ComputeChecksum(content->LocalPath);
+				if(nullptr != content->Item->BaseFile)
+				{
+					content->BaseChecksum = ComputeChecksum(content->Item->BaseFile);
+				}
+			}
+			catch(Exception^ e)
+			{
+				content->Error = e;
+			}
+			finally
+			{
+				content->Ready->Set();
+			}
+		}
+	}
+	catch(OperationCanceledException^)
+	{
+		//The commit has been completed or has failed
+	}
+}
+
+PreparedContent^
+CommitCommand::TakeContent(CommitItem^ item)
+{
+	PreparedContent^ content = m_prepared[m_nextConsumed++];
+	if(content->Item != item)
+	{
+		throw gcnew InvalidOperationException(String::Format("The content of {0} has been prepared out of order", item->Path));
+	}
+
+	content->Ready->Wait();
+	m_window->Release();
+
+	if(nullptr != content->Error)
+	{
+		throw gcnew MigrationException(String::Format("The content of {0} is not available", item->Path), content->Error);
+	}
+
+	return content;
+}
+
+const char*
+CommitCommand::GetCopySource(CommitItem^ item, apr_pool_t* pool)
+{
+	if(nullptr == item->CopyFromPath)
+	{
+		return NULL;
+	}
+
+	//The editor expects the source as an URL. Every segment is escaped on its own to keep the separators
+	array<String^>^ segments = item->CopyFromPath->Split('/');
+	for(int i = 0; i < segments->Length; i++)
+	{
+		segments[i] = Uri::EscapeDataString(segments[i]);
+	}
+
+	String^ url = m_repositoryRoot->AbsoluteUri->TrimEnd('/') + "/" + String::Join("/", segments);
+
+	array<Byte>^ bytes = Encoding::UTF8->GetBytes(url);
+	pin_ptr<Byte> pinned = &bytes[0];
+	return LibApr::Instance()->AprPStrDup(pool, reinterpret_cast<const char*>(pinned));
+}
+
+void
+CommitCommand::SendContent(CommitItem^ item, void* fileBaton, apr_pool_t* pool)
+{
+	String^ checksum = nullptr;
+
+	if(nullptr != item->ContentSource)
+	{
+		PreparedContent^ content = TakeContent(item);
+		checksum = content->Checksum;
+
+		//The streams hold open files. They are closed with their own pool as soon as the file has been sent
+		AprPool^ streamPool = gcnew AprPool();
+		try
+		{
+			const char* baseChecksum = nullptr != content->BaseChecksum ? streamPool->CopyString(content->BaseChecksum) : NULL;
+
+			svn_txdelta_window_handler_t handler = NULL;
+			void* handlerBaton = NULL;
+			SvnError::Err(m_editor->apply_textdelta(fileBaton, baseChecksum, pool, &handler, &handlerBaton));
+
+			svn_stream_t* target = NULL;
+			SvnError::Err(Svn_subr::Instance()->SVN_STREAM_OPEN_READONLY(&target, streamPool->CopyString(content->LocalPath->Replace('\\', '/')), streamPool->Handle, streamPool->Handle));
+
+			if(nullptr != content->BaseChecksum)
+			{
+				//Only the differences to the base are transferred. The server verifies the base against the given checksum
+				svn_stream_t* source = NULL;
+				SvnError::Err(Svn_subr::Instance()->SVN_STREAM_OPEN_READONLY(&source, streamPool->CopyString(item->BaseFile->Replace('\\', '/')), streamPool->Handle, streamPool->Handle));
+
+				svn_txdelta_stream_t* txdelta = NULL;
+				Svn_Delta::Instance()->SVN_TXDELTA(&txdelta, source, target, streamPool->Handle);
+				SvnError::Err(Svn_Delta::Instance()->SVN_TXDELTA_SEND_TXSTREAM(txdelta, handler, handlerBaton, streamPool->Handle));
+			}
+			else
+			{
+				SvnError::Err(Svn_Delta::Instance()->SVN_TXDELTA_SEND_STREAM(target, handler, handlerBaton, NULL, streamPool->Handle));
+			}
+		}
+		finally
+		{
+			delete streamPool;
+		}
+	}
+
+	//The server compares the result with the checksum of the local content
+	SvnError::Err(m_editor->close_file(fileBaton, nullptr != checksum ? LibApr::Instance()->AprPStrDup(pool, (const char*)Utils::ConvertStringToUTF8(checksum).c_str()) : NULL, pool));
+}
+
+svn_error_t*
+CommitCommand::SvnPathDriverCallbackT(void **dir_baton, void *parent_baton, void *callback_baton, const char *path, apr_pool_t *pool)
+{
+	*dir_baton = NULL;
+
+	try
+	{
+		String^ key = Utils::ConvertUTF8ToString(path);
+
+		CommitItem^ deletion = nullptr;
+		if(m_deletions->TryGetValue(key, deletion))
+		{
+			SvnError::Err(m_editor->delete_entry(path, (svn_revnum_t)deletion->BaseRevision, parent_baton, pool));
+		}
+
+		CommitItem^ change = nullptr;
+		if(!m_changes->TryGetValue(key, change))
+		{
+			return SVN_NO_ERROR;
+		}
+
+		//A replaced item must not be compared with the deleted one. It is always added as a new node
+		const char* copyFromPath = GetCopySource(change, pool);
+		svn_revnum_t copyFromRevision = NULL != copyFromPath ? (svn_revnum_t)change->CopyFromRevision : SVN_INVALID_REVNUM;
+
+		void* fileBaton = NULL;
+		switch(change->Action)
+		{
+		case CommitAction::Add:
+			if(change->IsDirectory)
+			{
+				SvnError::Err(m_editor->add_directory(path, parent_baton, copyFromPath, copyFromRevision, pool, dir_baton));
+				return SVN_NO_ERROR;
+			}
+
+			SvnError::Err(m_editor->add_file(path, parent_baton, copyFromPath, copyFromRevision, pool, &fileBaton));
+			break;
+		case CommitAction::Modify:
+			SvnError::Err(m_editor->open_file(path, parent_baton, (svn_revnum_t)change->BaseRevision, pool, &fileBaton));
+			break;
+		default:
+			return SVN_NO_ERROR;
+		}
+
+		SendContent(change, fileBaton, pool);
+		return SVN_NO_ERROR;
+	}
+	catch(Exception^ e)
+	{
+		//The exception must not pass the native frames of subversion. It is raised again when the editor has been aborted
+		m_error = e;
+		return Svn_subr::Instance()->SVN_ERROR_CREATE(SVN_ERR_CANCELLED, NULL, "The commit has been cancelled");
+	}
+}
+
+svn_error_t*
+CommitCommand::SvnCommitCallback2T(const svn_commit_info_t *commit_info, void *baton, apr_pool_t *pool)
+{
+	m_revision = (long)commit_info->revision;
+	return SVN_NO_ERROR;
+}
+
+int
+CommitCommand::ComparePaths(String^ x, String^ y)
+{
+	//Matches svn_path_compare_paths: the bytes of the UTF-8 representation are compared and a separator sorts before every other character.
+	//The parent directories are visited before their children that way
+	array<Byte>^ left = Encoding::UTF8->GetBytes(x);
+	array<Byte>^ right = Encoding::UTF8->GetBytes(y);
+
+	int length = Math::Min(left->Length, right->Length);
+	int i = 0;
+	while(i < length && left[i] == right[i])
+	{
+		i++;
+	}
+
+	if(i == left->Length && i == right->Length)
+	{
+		return 0;
+	}
+
+	if(i == left->Length)
+	{
+		return -1;
+	}
+
+	if(i == right->Length)
+	{
+		return 1;
+	}
+
+	if('/' == left[i])
+	{
+		return -1;
+	}
+
+	if('/' == right[i])
+	{
+		return 1;
+	}
+
+	return left[i] < right[i] ? -1 : 1;
+}
+
+int
+CommitCommand::CompareItems(CommitItem^ x, CommitItem^ y)
+{
+	return ComparePaths(x->Path, y->Path);
+}
+
+String^
+CommitCommand::ComputeChecksum(String^ path)
+{
+	HashAlgorithm^ md5 = gcnew MD5CryptoServiceProvider();
+	FileStream^ file = gcnew FileStream(path, FileMode::Open, FileAccess::Read, FileShare::Read, 64 * 1024);
+	try
+	{
+		return BitConverter::ToString(md5->ComputeHash(file))->Replace("-", String::Empty)->ToLowerInvariant();
+	}
+	finally
+	{
+		delete file;
+	}
+}
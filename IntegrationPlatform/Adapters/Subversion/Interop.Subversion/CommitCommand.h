@@ -0,0 +1,121 @@
+#pragma once
+
+#include <svn_delta.h>
+#include <svn_types.h>
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Runtime::InteropServices;
+using namespace System::Threading;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							ref class SubversionContext;
+						}
+
+						namespace ObjectModel
+						{
+							ref class CommitItem;
+						}
+
+						namespace Commands
+						{
+							/// <summary>
+							/// The local content of a file that is prepared by a worker of the <see cref="CommitCommand"/>
+							/// </summary>
+							private ref class PreparedContent
+							{
+							public:
+								PreparedContent(ObjectModel::CommitItem^ item);
+
+								ObjectModel::CommitItem^ Item;
+								String^ LocalPath;
+								String^ Checksum;
+								String^ BaseChecksum;
+								Exception^ Error;
+								ManualResetEventSlim^ Ready;
+							};
+
+							/// <summary>
+							/// Commits a set of changes as a single revision. The items are sent through the commit editor of one RA session in the
+							/// order of the paths, so that every directory is opened once. Copies are performed by the server. A file with a known
+							/// base is sent as a difference to that base; all other files are sent as full text.
+							/// <para/>
+							/// Worker threads resolve the content of the files ahead of the editor. The transfer of a file therefore overlaps with
+							/// the download or the hashing of the following ones. The number of prepared files is bounded by the read ahead
+							/// </summary>
+							private ref class CommitCommand
+							{
+							private:
+								static const int Workers = 4;
+								static const int ReadAhead = 16;
+
+								Helpers::SubversionContext^ m_context;
+
+								Uri^ m_repositoryRoot;
+								String^ m_message;
+
+								Dictionary<String^, ObjectModel::CommitItem^>^ m_deletions;
+								Dictionary<String^, ObjectModel::CommitItem^>^ m_changes;
+								List<String^>^ m_paths;
+
+								array<PreparedContent^>^ m_prepared;
+								int m_nextPrepared;
+								int m_nextConsumed;
+								SemaphoreSlim^ m_window;
+								CancellationTokenSource^ m_cancellation;
+
+								const svn_delta_editor_t* m_editor;
+								long m_revision;
+								Exception^ m_error;
+
+								void Sort(IEnumerable<ObjectModel::CommitItem^>^ items);
+								bool IsBelowDeletion(String^ path);
+								void Prepare();
+								PreparedContent^ TakeContent(ObjectModel::CommitItem^ item);
+								const char* GetCopySource(ObjectModel::CommitItem^ item, apr_pool_t* pool);
+								void SendContent(ObjectModel::CommitItem^ item, void* fileBaton, apr_pool_t* pool);
+
+								svn_error_t* SvnPathDriverCallbackT(void **dir_baton, void *parent_baton, void *callback_baton, const char *path, apr_pool_t *pool);
+								svn_error_t* SvnCommitCallback2T(const svn_commit_info_t *commit_info, void *baton, apr_pool_t *pool);
+
+								static int ComparePaths(String^ x, String^ y);
+								static int CompareItems(ObjectModel::CommitItem^ x, ObjectModel::CommitItem^ y);
+								static String^ ComputeChecksum(String^ path);
+
+							public:
+								/// <summary>
+								/// Creates a new command that commits the items as a single revision
+								/// </summary>
+								/// <param name="context">The context that is used to access the repository</param>
+								/// <param name="repositoryRoot">The root of the repository. All paths of the items are relative to it</param>
+								/// <param name="items">The changes of the revision. A path may be deleted and added again, but not changed twice otherwise</param>
+								/// <param name="message">The log message of the revision</param>
+								CommitCommand(Helpers::SubversionContext^ context, Uri^ repositoryRoot, IEnumerable<ObjectModel::CommitItem^>^ items, String^ message);
+
+								/// <summary>
+								/// Executes the command and commits the items. Either all items are committed or none of them
+								/// </summary>
+								/// <param name="revision">The number of the new revision</param>
+								/// <exception cref="MigrationException">Will be thrown if the commit has been rejected or the content of an item is not available</exception>
+								void Execute([Out] long% revision);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
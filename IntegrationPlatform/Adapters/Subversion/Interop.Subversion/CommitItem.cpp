@@ -0,0 +1,111 @@
+#include "Stdafx.h"
+#include "CommitItem.h"
+
+using namespace System;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+CommitItem::CommitItem(String^ path, CommitAction action, bool isDirectory)
+{
+	if(String::IsNullOrEmpty(path))
+	{
+		//The root itself cannot be added, modified or deleted
+		throw gcnew ArgumentNullException("path");
+	}
+
+	if(path->StartsWith("/") || path->EndsWith("/"))
+	{
+		throw gcnew ArgumentException("The path has to be relative to the root of the repository", "path");
+	}
+
+	if(CommitAction::Modify == action && isDirectory)
+	{
+		throw gcnew ArgumentException("The properties of a directory cannot be modified", "action");
+	}
+
+	m_path = path;
+	m_action = action;
+	m_isDirectory = isDirectory;
+	m_copyFromPath = nullptr;
+	m_copyFromRevision = -1;
+	m_baseRevision = -1;
+	m_contentSource = nullptr;
+	m_baseFile = nullptr;
+}
+
+String^
+CommitItem::Path::get()
+{
+	return m_path;
+}
+
+CommitAction
+CommitItem::Action::get()
+{
+	return m_action;
+}
+
+bool
+CommitItem::IsDirectory::get()
+{
+	return m_isDirectory;
+}
+
+String^
+CommitItem::CopyFromPath::get()
+{
+	return m_copyFromPath;
+}
+
+void
+CommitItem::CopyFromPath::set(String^ value)
+{
+	m_copyFromPath = value;
+}
+
+long
+CommitItem::CopyFromRevision::get()
+{
+	return m_copyFromRevision;
+}
+
+void
+CommitItem::CopyFromRevision::set(long value)
+{
+	m_copyFromRevision = value;
+}
+
+long
+CommitItem::BaseRevision::get()
+{
+	return m_baseRevision;
+}
+
+void
+CommitItem::BaseRevision::set(long value)
+{
+	m_baseRevision = value;
+}
+
+Func<String^>^
+CommitItem::ContentSource::get()
+{
+	return m_contentSource;
+}
+
+void
+CommitItem::ContentSource::set(Func<String^>^ value)
+{
+	m_contentSource = value;
+}
+
+String^
+CommitItem::BaseFile::get()
+{
+	return m_baseFile;
+}
+
+void
+CommitItem::BaseFile::set(String^ value)
+{
+	m_baseFile = value;
+}
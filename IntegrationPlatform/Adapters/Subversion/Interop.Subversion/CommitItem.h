@@ -0,0 +1,116 @@
+#pragma once
+
+using namespace System;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace ObjectModel
+						{
+							/// <summary>
+							/// The modification that a <see cref="CommitItem"/> applies to its path
+							/// </summary>
+							public enum class CommitAction
+							{
+								/// <summary>
+								/// The item is added. It may be copied from an other location to preserve its history
+								/// </summary>
+								Add,
+
+								/// <summary>
+								/// The content of an existing file is replaced
+								/// </summary>
+								Modify,
+
+								/// <summary>
+								/// The item is deleted together with all of its children
+								/// </summary>
+								Delete
+							};
+
+							/// <summary>
+							/// Describes the modification of a single path within a commit. A delete and an add of the same path form a replacement.
+							/// <para/>
+							/// The content of a file is provided by a callback. The commit resolves the callbacks ahead of the items that are sent to the
+							/// server, so that a download or the creation of a temporary file overlaps with the transfer of the preceding items
+							/// </summary>
+							public ref class CommitItem
+							{
+								private:
+									String^ m_path;
+									CommitAction m_action;
+									bool m_isDirectory;
+									String^ m_copyFromPath;
+									long m_copyFromRevision;
+									long m_baseRevision;
+									Func<String^>^ m_contentSource;
+									String^ m_baseFile;
+
+								public:
+
+									/// <summary>
+									/// Creates a new commit item
+									/// </summary>
+									/// <param name="path">The path of the item relative to the root of the repository</param>
+									/// <param name="action">The modification that is applied to the path</param>
+									/// <param name="isDirectory">true if the item is a directory</param>
+									CommitItem(String^ path, CommitAction action, bool isDirectory);
+
+									/// <summary>
+									/// Gets the path of the item relative to the root of the repository. The path neither starts nor ends with a slash
+									/// </summary>
+									property String^ Path { String^ get(); }
+
+									/// <summary>
+									/// Gets the modification that is applied to the path
+									/// </summary>
+									property CommitAction Action { CommitAction get(); }
+
+									/// <summary>
+									/// Gets whether the item is a directory
+									/// </summary>
+									property bool IsDirectory { bool get(); }
+
+									/// <summary>
+									/// Gets or sets the path relative to the root of the repository from which an added item is copied; null if the item is new
+									/// </summary>
+									property String^ CopyFromPath { String^ get(); void set(String^ value); }
+
+									/// <summary>
+									/// Gets or sets the revision from which an added item is copied
+									/// </summary>
+									property long CopyFromRevision { long get(); void set(long value); }
+
+									/// <summary>
+									/// Gets or sets the revision that the modification is based on; -1 if the item shall not be checked for newer revisions
+									/// </summary>
+									property long BaseRevision { long get(); void set(long value); }
+
+									/// <summary>
+									/// Gets or sets the callback that returns the local file with the new content of a file; null if the content is not changed.
+									/// The callback is invoked on a worker thread of the commit and may block until the content is available
+									/// </summary>
+									property Func<String^>^ ContentSource { Func<String^>^ get(); void set(Func<String^>^ value); }
+
+									/// <summary>
+									/// Gets or sets the local file with the content of the file in the base revision or in the source of the copy; null if it is unknown.
+									/// The new content is sent as a difference to this file. It has to match the repository or the commit fails
+									/// </summary>
+									property String^ BaseFile { String^ get(); void set(String^ value); }
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
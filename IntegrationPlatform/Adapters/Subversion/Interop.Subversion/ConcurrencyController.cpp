@@ -0,0 +1,212 @@
+#include "Stdafx.h"
+#include "ConcurrencyController.h"
+
+using namespace System;
+using namespace System::Diagnostics;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+
+ConcurrencyController::ConcurrencyController(int hardCap, long long bandwidth)
+{
+	if(hardCap <= 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("hardCap");
+	}
+
+	if(bandwidth < 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("bandwidth");
+	}
+
+	m_hardCap = hardCap;
+	m_limit = 1;
+	m_inFlight = 0;
+	m_slowStart = true;
+	m_saturated = false;
+
+	m_windows = gcnew array<Window^>(Enum::GetValues(RequestKind::typeid)->Length);
+	for(int i = 0; i < m_windows->Length; i++)
+	{
+		m_windows[i] = gcnew Window();
+		m_windows[i]->Samples = gcnew array<long long>(Math::Max(MinimumWindow, 2 * hardCap));
+		m_windows[i]->SampleCount = 0;
+		m_windows[i]->FailureCount = 0;
+		m_windows[i]->BaselineMedian = 0;
+		m_windows[i]->BaselineTail = 0;
+	}
+
+	m_median = 0;
+	m_tail = 0;
+
+	m_bandwidth = bandwidth;
+	m_paidUntil = 0;
+}
+
+int
+ConcurrencyController::HardCap::get()
+{
+	return m_hardCap;
+}
+
+int
+ConcurrencyController::Limit::get()
+{
+	return m_limit;
+}
+
+int
+ConcurrencyController::InFlight::get()
+{
+	return m_inFlight;
+}
+
+long long
+ConcurrencyController::Bandwidth::get()
+{
+	return m_bandwidth;
+}
+
+TimeSpan
+ConcurrencyController::MedianLatency::get()
+{
+	return TimeSpan::FromTicks(m_median);
+}
+
+TimeSpan
+ConcurrencyController::TailLatency::get()
+{
+	return TimeSpan::FromTicks(m_tail);
+}
+
+bool
+ConcurrencyController::CanEnter()
+{
+	return m_inFlight < m_limit;
+}
+
+int
+ConcurrencyController::GetDelay()
+{
+	if(0 == m_bandwidth)
+	{
+		return 0;
+	}
+
+	//The transfers may run ahead of the ceiling by one second. This smooths the bursts of many small files
+	long long ahead = m_paidUntil - Stopwatch::GetTimestamp() - Stopwatch::Frequency;
+	if(ahead <= 0)
+	{
+		return 0;
+	}
+
+	return (int)Math::Min((long long)Int32::MaxValue, Math::Max(1LL, ahead * 1000 / Stopwatch::Frequency));
+}
+
+void
+ConcurrencyController::Enter()
+{
+	m_inFlight++;
+
+	//The limit is only raised if it actually constrained the requests
+	if(m_inFlight >= m_limit)
+	{
+		m_saturated = true;
+	}
+}
+
+void
+ConcurrencyController::Leave()
+{
+	if(m_inFlight > 0)
+	{
+		m_inFlight--;
+	}
+}
+
+void
+ConcurrencyController::Record(RequestKind kind, TimeSpan latency, bool succeeded, long long bytes)
+{
+	if(0 != m_bandwidth && bytes > 0)
+	{
+		long long now = Stopwatch::GetTimestamp();
+		if(m_paidUntil < now)
+		{
+			m_paidUntil = now;
+		}
+
+		m_paidUntil += (long long)((double)bytes * Stopwatch::Frequency / m_bandwidth);
+	}
+
+	Window^ window = m_windows[(int)kind];
+
+	//A slow request is judged by the latencies only. Large transfers and recursive listings legitimately take long
+	if(!succeeded)
+	{
+		window->FailureCount++;
+	}
+
+	long long cost = latency.Ticks;
+	if(bytes > 0)
+	{
+		cost /= 1 + (bytes - 1) / TransferUnit;
+	}
+
+	window->Samples[window->SampleCount++] = cost;
+
+	//The window grows with the limit. Otherwise a high limit would be judged by the requests of a single round
+	if(window->SampleCount >= Math::Min(window->Samples->Length, Math::Max(MinimumWindow, 2 * m_limit)))
+	{
+		Adjust(window);
+	}
+}
+
+void
+ConcurrencyController::Adjust(Window^ window)
+{
+	array<long long>^ samples = gcnew array<long long>(window->SampleCount);
+	Array::Copy(window->Samples, samples, window->SampleCount);
+	Array::Sort(samples);
+
+	m_median = samples[samples->Length / 2];
+	m_tail = samples[samples->Length * 9 / 10];
+
+	bool congested = window->FailureCount * 100 > window->SampleCount * MaximumErrorPercent;
+	if(0 != window->BaselineMedian)
+	{
+		congested = congested || m_median * 100 > window->BaselineMedian * MedianTolerancePercent || m_tail * 100 > window->BaselineTail * TailTolerancePercent;
+	}
+
+	if(congested)
+	{
+		m_limit = Math::Max(1, m_limit / 2);
+		m_slowStart = false;
+	}
+	else if(m_saturated)
+	{
+		m_limit = Math::Min(m_hardCap, m_slowStart ? 2 * m_limit : m_limit + 1);
+	}
+
+	//Failed requests often return early. Their latencies must not lower the baselines
+	if(0 == window->FailureCount)
+	{
+		window->BaselineMedian = 0 == window->BaselineMedian ? m_median : Drift(window->BaselineMedian, m_median);
+		window->BaselineTail = 0 == window->BaselineTail ? m_tail : Drift(window->BaselineTail, m_tail);
+	}
+
+	window->SampleCount = 0;
+	window->FailureCount = 0;
+	m_saturated = m_inFlight >= m_limit;
+}
+
+long long
+ConcurrencyController::Drift(long long baseline, long long current)
+{
+	//A lower latency is taken at once. A higher one is approached slowly, so that a permanently slower server is accepted
+	//after a few windows while a sudden spike is still recognized as congestion
+	if(current <= baseline)
+	{
+		return current;
+	}
+
+	return baseline + Math::Max(1LL, (current - baseline) / DriftDivisor);
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+using namespace System;
+using namespace System::Diagnostics;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							/// <summary>
+							/// The kinds of requests whose latencies are judged against baselines of their own
+							/// </summary>
+							private enum class RequestKind
+							{
+								Listing,
+								History,
+								Download,
+								Commit
+							};
+
+							/// <summary>
+							/// Decides how many requests may be in flight against one repository. The limit starts at one and is doubled after every
+							/// window of requests until the server shows the first sign of congestion. Afterwards it is increased by one per window
+							/// and halved whenever a window is congested (AIMD). A window is congested if too many of its requests failed
+							/// or if its median or its 90th percentile latency exceeds the respective baseline by far. The baselines follow the
+							/// lowest latencies that have been observed and drift slowly towards the current ones.
+							/// <para/>
+							/// Listings, log requests, downloads and commits differ in their latencies by orders of magnitude. Therefore every kind of
+							/// request is collected in a window of its own and compared with its own baselines. The latency of a transfer is divided by
+							/// the number of started units of 64 KiB, so that large files are comparable with small ones.
+							/// <para/>
+							/// The optional bandwidth ceiling delays new requests once the transferred bytes exceed the allowance of the ceiling
+							/// by more than one second. The ceiling is kept on average because the size of a transfer is known after its completion only.
+							/// <para/>
+							/// The controller is not thread safe. Its owner has to serialize all calls
+							/// </summary>
+							private ref class ConcurrencyController
+							{
+							private:
+								static const int MinimumWindow = 16;
+								static const int MaximumErrorPercent = 5;
+								static const int MedianTolerancePercent = 200;
+								static const int TailTolerancePercent = 300;
+								static const int DriftDivisor = 8;
+								static const int TransferUnit = 64 * 1024;
+
+								ref class Window
+								{
+								public:
+									array<long long>^ Samples;
+									int SampleCount;
+									int FailureCount;
+									long long BaselineMedian;
+									long long BaselineTail;
+								};
+
+								int m_hardCap;
+								int m_limit;
+								int m_inFlight;
+								bool m_slowStart;
+								bool m_saturated;
+
+								array<Window^>^ m_windows;
+								long long m_median;
+								long long m_tail;
+
+								long long m_bandwidth;
+								long long m_paidUntil;
+
+								void Adjust(Window^ window);
+								static long long Drift(long long baseline, long long current);
+
+							public:
+								/// <summary>
+								/// Creates a new controller
+								/// </summary>
+								/// <param name="hardCap">The number of requests that will never be exceeded</param>
+								/// <param name="bandwidth">The maximum number of bytes per second; 0 if the bandwidth is unlimited</param>
+								ConcurrencyController(int hardCap, long long bandwidth);
+
+								/// <summary>
+								/// Gets the number of requests that will never be exceeded
+								/// </summary>
+								property int HardCap { int get(); }
+
+								/// <summary>
+								/// Gets the number of requests that may currently be in flight
+								/// </summary>
+								property int Limit { int get(); }
+
+								/// <summary>
+								/// Gets the number of requests that are currently in flight
+								/// </summary>
+								property int InFlight { int get(); }
+
+								/// <summary>
+								/// Gets the maximum number of bytes per second; 0 if the bandwidth is unlimited
+								/// </summary>
+								property long long Bandwidth { long long get(); }
+
+								/// <summary>
+								/// Gets the median latency of the last completed window. The latencies of transfers are normalized to 64 KiB
+								/// </summary>
+								property TimeSpan MedianLatency { TimeSpan get(); }
+
+								/// <summary>
+								/// Gets the 90th percentile latency of the last completed window. The latencies of transfers are normalized to 64 KiB
+								/// </summary>
+								property TimeSpan TailLatency { TimeSpan get(); }
+
+								/// <summary>
+								/// Gets whether an other request may be started with respect to the limit
+								/// </summary>
+								bool CanEnter();
+
+								/// <summary>
+								/// Gets the number of milliseconds new requests have to wait to keep the bandwidth ceiling; 0 if they may start immediately
+								/// </summary>
+								int GetDelay();
+
+								/// <summary>
+								/// Counts a request that has been started
+								/// </summary>
+								void Enter();
+
+								/// <summary>
+								/// Counts a request that has been completed
+								/// </summary>
+								void Leave();
+
+								/// <summary>
+								/// Records the outcome of a completed request. Adjusts the limit whenever a window of requests is complete
+								/// </summary>
+								/// <param name="kind">The kind of the request</param>
+								/// <param name="latency">The time between the start and the completion of the request</param>
+								/// <param name="succeeded">false if the request failed</param>
+								/// <param name="bytes">The number of bytes that have been transferred; 0 if unknown</param>
+								void Record(RequestKind kind, TimeSpan latency, bool succeeded, long long bytes);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,79 @@
+#include "Stdafx.h"
+#include "ContentDigest.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Security::Cryptography;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+ContentDigest::ContentDigest(array<Byte>^ md5, array<Byte>^ sha1, long long length, bool verified)
+{
+	if(nullptr == md5)
+	{
+		throw gcnew ArgumentNullException("md5");
+	}
+
+	if(nullptr == sha1)
+	{
+		throw gcnew ArgumentNullException("sha1");
+	}
+
+	m_md5 = md5;
+	m_sha1 = sha1;
+	m_length = length;
+	m_verified = verified;
+}
+
+ContentDigest^
+ContentDigest::Compute(String^ path)
+{
+	HashAlgorithm^ md5 = gcnew MD5CryptoServiceProvider();
+	HashAlgorithm^ sha1 = gcnew SHA1CryptoServiceProvider();
+	array<Byte>^ buffer = gcnew array<Byte>(64 * 1024);
+	long long length = 0;
+
+	FileStream^ stream = File::OpenRead(path);
+	try
+	{
+		int count;
+		while((count = stream->Read(buffer, 0, buffer->Length)) > 0)
+		{
+			md5->TransformBlock(buffer, 0, count, nullptr, 0);
+			sha1->TransformBlock(buffer, 0, count, nullptr, 0);
+			length += count;
+		}
+
+		md5->TransformFinalBlock(buffer, 0, 0);
+		sha1->TransformFinalBlock(buffer, 0, 0);
+	}
+	finally
+	{
+		delete stream;
+	}
+
+	return gcnew ContentDigest(md5->Hash, sha1->Hash, length, false);
+}
+
+array<Byte>^
+ContentDigest::MD5::get()
+{
+	return m_md5;
+}
+
+array<Byte>^
+ContentDigest::SHA1::get()
+{
+	return m_sha1;
+}
+
+long long
+ContentDigest::Length::get()
+{
+	return m_length;
+}
+
+bool
+ContentDigest::Verified::get()
+{
+	return m_verified;
+}
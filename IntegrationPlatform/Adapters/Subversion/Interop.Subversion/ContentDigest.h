@@ -0,0 +1,76 @@
+#pragma once
+
+using namespace System;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace ObjectModel
+						{
+							/// <summary>
+							/// The checksums of a downloaded file. They are computed while the content is written to disk
+							/// </summary>
+							public ref class ContentDigest
+							{
+								private:
+									array<Byte>^ m_md5;
+									array<Byte>^ m_sha1;
+									long long m_length;
+									bool m_verified;
+
+								internal:
+
+									/// <summary>
+									/// Creates a new digest
+									/// </summary>
+									/// <param name="md5">The MD5 hash of the content</param>
+									/// <param name="sha1">The SHA-1 hash of the content</param>
+									/// <param name="length">The number of bytes of the content</param>
+									/// <param name="verified">Determines whether the content has been verified against the checksum of the repository</param>
+									ContentDigest(array<Byte>^ md5, array<Byte>^ sha1, long long length, bool verified);
+
+									/// <summary>
+									/// Computes the digest of a local file. The file is read once for both hashes
+									/// </summary>
+									/// <param name="path">The full local path of the file</param>
+									static ContentDigest^ Compute(String^ path);
+
+								public:
+
+									/// <summary>
+									/// Gets the MD5 hash of the content
+									/// </summary>
+									property array<Byte>^ MD5 { array<Byte>^ get(); }
+
+									/// <summary>
+									/// Gets the SHA-1 hash of the content
+									/// </summary>
+									property array<Byte>^ SHA1 { array<Byte>^ get(); }
+
+									/// <summary>
+									/// Gets the number of bytes of the content
+									/// </summary>
+									property long long Length { long long get(); }
+
+									/// <summary>
+									/// Gets whether the content has been verified against the checksum that the repository stores for the file.
+									/// Files with keyword expansion or end of line translation differ from the repository content and are not verified
+									/// </summary>
+									property bool Verified { bool get(); }
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
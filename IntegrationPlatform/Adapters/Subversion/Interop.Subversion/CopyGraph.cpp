@@ -0,0 +1,286 @@
+#include "Stdafx.h"
+#include "Change.h"
+#include "ChangeBatch.h"
+#include "ChangeSet.h"
+#include "CopyGraph.h"
+#include "CopyIndex.h"
+#include "CopyRecord.h"
+#include "Utils.h"
+
+#include <vector>
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Collections::Generic;
+using namespace System::Text;
+
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+CopyGraph::CopyGraph(Uri^ repositoryRoot, Guid repositoryId, String^ directory)
+{
+	if(nullptr == repositoryRoot)
+	{
+		throw gcnew ArgumentNullException("repositoryRoot");
+	}
+
+	m_repositoryRoot = repositoryRoot->ToString()->TrimEnd(Utils::SeperatorCharArray);
+	m_repositoryId = repositoryId;
+	m_revision = 0;
+	m_index = new CopyIndex();
+
+	if(!String::IsNullOrEmpty(directory))
+	{
+		m_file = Path::Combine(directory, String::Concat(repositoryId.ToString(), ".copygraph"));
+		Load();
+	}
+}
+
+CopyGraph::~CopyGraph()
+{
+	this->!CopyGraph();
+}
+
+CopyGraph::!CopyGraph()
+{
+	if(NULL != m_index)
+	{
+		delete m_index;
+		m_index = NULL;
+	}
+}
+
+Guid
+CopyGraph::RepositoryId::get()
+{
+	return m_repositoryId;
+}
+
+long
+CopyGraph::Revision::get()
+{
+	return m_revision;
+}
+
+int
+CopyGraph::Count::get()
+{
+	if(NULL == m_index)
+	{
+		throw gcnew ObjectDisposedException("CopyGraph");
+	}
+
+	return (int)m_index->Count();
+}
+
+std::string
+CopyGraph::ToRelativePath(String^ fullServerPath)
+{
+	if(nullptr == fullServerPath)
+	{
+		throw gcnew ArgumentNullException("fullServerPath");
+	}
+
+	//The paths are stored the same way subversion reports them: relative to the root, with a leading slash and UTF-8 encoded
+	return Utils::ConvertStringToUTF8(Utils::ExtractPath(m_repositoryRoot, fullServerPath));
+}
+
+String^
+CopyGraph::ToFullServerPath(const std::string& path)
+{
+	return Utils::Combine(m_repositoryRoot, Utils::ConvertUTF8ToString(path.c_str()));
+}
+
+void
+CopyGraph::Add(ChangeSet^ changeset)
+{
+	if(nullptr == changeset)
+	{
+		throw gcnew ArgumentNullException("changeset");
+	}
+
+	if(NULL == m_index)
+	{
+		throw gcnew ObjectDisposedException("CopyGraph");
+	}
+
+	if(changeset->Revision <= m_revision)
+	{
+		return;
+	}
+
+	//The batches store the paths relative to the repository root as well. They are read without creating any change objects
+	for each(ChangeBatch^ batch in changeset->GetChangeBatches())
+	{
+		for(int i = 0; i < batch->Count; i++)
+		{
+			ChangeAction changeAction = batch->GetChangeAction(i);
+			if(ChangeAction::Modify == changeAction || ChangeAction::Delete == changeAction)
+			{
+				continue;
+			}
+
+			//Additions are recorded as well because they cut the ancestry of a path that existed before
+			std::string copyFromPath = batch->GetCopyFromPath(i);
+			long copyFromRevision = copyFromPath.empty() ? -1 : batch->GetCopyFromRevision(i);
+
+			m_index->Add(batch->GetPath(i), changeset->Revision, copyFromPath, copyFromRevision);
+		}
+	}
+
+	m_revision = changeset->Revision;
+}
+
+CopyRecord^
+CopyGraph::GetOrigin(String^ fullServerPath, long revision)
+{
+	if(NULL == m_index)
+	{
+		throw gcnew ObjectDisposedException("CopyGraph");
+	}
+
+	std::string path = ToRelativePath(fullServerPath);
+	const CopyIndex::Birth* birth = m_index->FindBirth(path, revision);
+	if(NULL == birth || birth->copyFromPath.empty())
+	{
+		return nullptr;
+	}
+
+	//The copy may have been applied on a parent. The source of the item is the same relative location below the source of the parent
+	std::string copyFromPath = ("/" == birth->copyFromPath) ? std::string() : birth->copyFromPath;
+	copyFromPath += path.substr(("/" == birth->path) ? 0 : birth->path.length());
+	if(copyFromPath.empty())
+	{
+		copyFromPath = "/";
+	}
+	return gcnew CopyRecord(fullServerPath, birth->revision, ToFullServerPath(copyFromPath), birth->copyFromRevision);
+}
+
+List<CopyRecord^>^
+CopyGraph::GetAncestry(String^ fullServerPath, long revision)
+{
+	List<CopyRecord^>^ ancestry = gcnew List<CopyRecord^>();
+
+	//Every hop goes back to an older revision. Therefore the walk always terminates
+	CopyRecord^ record = GetOrigin(fullServerPath, revision);
+	while(nullptr != record)
+	{
+		ancestry->Add(record);
+		record = GetOrigin(record->CopyFromFullServerPath, record->CopyFromRevision);
+	}
+
+	return ancestry;
+}
+
+List<CopyRecord^>^
+CopyGraph::GetDescendants(String^ fullServerPath)
+{
+	if(NULL == m_index)
+	{
+		throw gcnew ObjectDisposedException("CopyGraph");
+	}
+
+	std::vector<const CopyIndex::Birth*> copies;
+	m_index->FindCopiesOf(ToRelativePath(fullServerPath), copies);
+
+	List<CopyRecord^>^ descendants = gcnew List<CopyRecord^>((int)copies.size());
+	for(std::vector<const CopyIndex::Birth*>::const_iterator position = copies.begin(); position != copies.end(); ++position)
+	{
+		descendants->Add(gcnew CopyRecord(ToFullServerPath((*position)->path), (*position)->revision, ToFullServerPath((*position)->copyFromPath), (*position)->copyFromRevision));
+	}
+
+	return descendants;
+}
+
+void
+CopyGraph::Load()
+{
+	if(!File::Exists(m_file))
+	{
+		return;
+	}
+
+	BinaryReader^ reader = gcnew BinaryReader(gcnew FileStream(m_file, FileMode::Open, FileAccess::Read, FileShare::Read), Encoding::UTF8);
+	try
+	{
+		if(!String::Equals(reader->ReadString(), Signature, StringComparison::Ordinal) || Version != reader->ReadInt32() || m_repositoryId != Guid(reader->ReadBytes(16)))
+		{
+			//The graph is only a cache. It is rebuilt from the changesets that are analyzed from now on
+			TraceManager::TraceWarning("The copy graph '{0}' is not valid for the repository {1}. The graph will be rebuilt", m_file, m_repositoryId);
+			return;
+		}
+
+		long revision = reader->ReadInt32();
+		int count = reader->ReadInt32();
+		for(int i = 0; i < count; i++)
+		{
+			std::string path = Utils::ConvertStringToUTF8(reader->ReadString());
+			long pathRevision = reader->ReadInt32();
+			std::string copyFromPath = Utils::ConvertStringToUTF8(reader->ReadString());
+			long copyFromRevision = reader->ReadInt32();
+
+			m_index->Add(path, pathRevision, copyFromPath, copyFromRevision);
+		}
+
+		m_revision = revision;
+		TraceManager::TraceInformation("Loaded {0} entries of the copy graph up to revision {1} from '{2}'", count, revision, m_file);
+	}
+	catch(EndOfStreamException^)
+	{
+		TraceManager::TraceWarning("The copy graph '{0}' is truncated. The graph will be rebuilt", m_file);
+
+		delete m_index;
+		m_index = new CopyIndex();
+		m_revision = 0;
+	}
+	finally
+	{
+		reader->Close();
+	}
+}
+
+void
+CopyGraph::Save()
+{
+	if(NULL == m_index)
+	{
+		throw gcnew ObjectDisposedException("CopyGraph");
+	}
+
+	if(nullptr == m_file)
+	{
+		return;
+	}
+
+	//The graph is written to a temporary file first. A crash while saving must not destroy the previous state
+	String^ temporaryFile = String::Concat(m_file, ".tmp");
+	BinaryWriter^ writer = gcnew BinaryWriter(gcnew FileStream(temporaryFile, FileMode::Create, FileAccess::Write), Encoding::UTF8);
+	try
+	{
+		writer->Write(Signature);
+		writer->Write((Int32)Version);
+		writer->Write(m_repositoryId.ToByteArray());
+		writer->Write((Int32)m_revision);
+		writer->Write((Int32)m_index->Count());
+
+		for(CopyIndex::const_iterator position = m_index->begin(); position != m_index->end(); ++position)
+		{
+			writer->Write(Utils::ConvertUTF8ToString(position->second.path.c_str()));
+			writer->Write((Int32)position->second.revision);
+			writer->Write(Utils::ConvertUTF8ToString(position->second.copyFromPath.c_str()));
+			writer->Write((Int32)position->second.copyFromRevision);
+		}
+	}
+	finally
+	{
+		writer->Close();
+	}
+
+	if(File::Exists(m_file))
+	{
+		File::Delete(m_file);
+	}
+
+	File::Move(temporaryFile, m_file);
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <string>
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							class CopyIndex;
+						}
+
+						namespace ObjectModel
+						{
+							ref class ChangeSet;
+							ref class CopyRecord;
+
+							/// <summary>
+							/// Repository wide index of all copy operations. The nodes of the graph are paths at specific revisions and the edges are the copies between them.
+							/// The graph is built incrementally from the changesets and can be persisted per repository. Therefore questions like 
+							/// "where does this item come from" can be answered locally without querying the history of the repository
+							/// </summary>
+							public ref class CopyGraph
+							{
+							private:
+								static String^ Signature = "SVNCOPYGRAPH";
+								static const int Version = 1;
+
+								Helpers::CopyIndex* m_index;
+								String^ m_repositoryRoot;
+								Guid m_repositoryId;
+								String^ m_file;
+								long m_revision;
+
+								std::string ToRelativePath(String^ fullServerPath);
+								String^ ToFullServerPath(const std::string& path);
+								void Load();
+
+							internal:
+								/// <summary>
+								/// Creates the copy graph of a repository. An already persisted graph is loaded from the directory
+								/// </summary>
+								/// <param name="repositoryRoot">The root of the repository. All paths are stored relative to it</param>
+								/// <param name="repositoryId">The unique id of the repository which identifies the persisted graph</param>
+								/// <param name="directory">The directory in which the graph is persisted; null to keep the graph in memory only</param>
+								CopyGraph(Uri^ repositoryRoot, Guid repositoryId, String^ directory);
+
+							public:
+								/// <summary>
+								/// Default destructor
+								/// </summary>
+								~CopyGraph();
+
+								/// <summary>
+								/// Default Finalizer
+								/// </summary>
+								!CopyGraph();
+
+								/// <summary>
+								/// Gets the unique id of the repository
+								/// </summary>
+								property Guid RepositoryId { Guid get(); }
+
+								/// <summary>
+								/// Gets the youngest revision that has been added to the graph
+								/// </summary>
+								property long Revision { long get(); }
+
+								/// <summary>
+								/// Gets the number of paths whose creation has been recorded
+								/// </summary>
+								property int Count { int get(); }
+
+								/// <summary>
+								/// Records all additions and copies of a changeset. Changesets that are not younger than <see cref="Revision"/> have already been recorded and are ignored
+								/// </summary>
+								void Add(ChangeSet^ changeset);
+
+								/// <summary>
+								/// Gets the copy from which the item at the path originates. The item itself or one of its parents may have been copied
+								/// </summary>
+								/// <param name="fullServerPath">The full path of the item</param>
+								/// <param name="revision">The revision in which the item is identified by the path</param>
+								/// <returns>The copy with the source path of the item itself; null if the item has not been copied</returns>
+								CopyRecord^ GetOrigin(String^ fullServerPath, long revision);
+
+								/// <summary>
+								/// Follows the copies of an item back to the oldest known origin
+								/// </summary>
+								/// <param name="fullServerPath">The full path of the item</param>
+								/// <param name="revision">The revision in which the item is identified by the path</param>
+								/// <returns>The copies ordered from the youngest to the oldest one; an empty list if the item has not been copied</returns>
+								List<CopyRecord^>^ GetAncestry(String^ fullServerPath, long revision);
+
+								/// <summary>
+								/// Gets all copies whose source is the path or one of its children
+								/// </summary>
+								/// <param name="fullServerPath">The full path of the copy source</param>
+								List<CopyRecord^>^ GetDescendants(String^ fullServerPath);
+
+								/// <summary>
+								/// Persists the graph. Graphs without a directory are not persisted
+								/// </summary>
+								void Save();
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,106 @@
+#include "Stdafx.h"
+#include "CopyIndex.h"
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+
+CopyIndex::CopyIndex()
+{
+}
+
+bool
+CopyIndex::Add(const std::string& path, long revision, const std::string& copyFromPath, long copyFromRevision)
+{
+	std::pair<std::string, long> key(path, revision);
+	if(m_births.find(key) != m_births.end())
+	{
+		return false;
+	}
+
+	Birth& birth = m_births[key];
+	birth.path = path;
+	birth.revision = revision;
+	birth.copyFromPath = copyFromPath;
+	birth.copyFromRevision = copyFromRevision;
+
+	if(!copyFromPath.empty())
+	{
+		m_sources.insert(std::make_pair(copyFromPath, &birth));
+	}
+
+	return true;
+}
+
+const CopyIndex::Birth*
+CopyIndex::FindBirth(const std::string& path, long revision) const
+{
+	const Birth* result = NULL;
+	std::string level = path;
+
+	//Walk up the path. Every level may have been replaced or copied. The youngest of these events wins because it replaced everything below of it.
+	//On the same revision the deeper level wins because it has been applied on top of the parent copy
+	while(true)
+	{
+		std::map<std::pair<std::string, long>, Birth>::const_iterator position = m_births.upper_bound(std::make_pair(level, revision));
+		if(position != m_births.begin())
+		{
+			--position;
+			if(position->first.first == level && (NULL == result || position->second.revision > result->revision))
+			{
+				result = &position->second;
+			}
+		}
+
+		std::string::size_type separator = level.find_last_of('/');
+		if(std::string::npos == separator || level.length() <= 1)
+		{
+			break;
+		}
+
+		level = (0 == separator) ? "/" : level.substr(0, separator);
+	}
+
+	return result;
+}
+
+void
+CopyIndex::CollectRange(std::multimap<std::string, const Birth*>::const_iterator first, std::multimap<std::string, const Birth*>::const_iterator last, std::vector<const Birth*>& copies) const
+{
+	for(; first != last; ++first)
+	{
+		copies.push_back(first->second);
+	}
+}
+
+void
+CopyIndex::FindCopiesOf(const std::string& path, std::vector<const Birth*>& copies) const
+{
+	if("/" == path)
+	{
+		CollectRange(m_sources.begin(), m_sources.end(), copies);
+		return;
+	}
+
+	//The children of the path are the keys between "path/" and "path0" because '0' is the character that follows '/'.
+	//The path itself is collected separately since keys like "path-1" are sorted between the path and its children
+	std::pair<std::multimap<std::string, const Birth*>::const_iterator, std::multimap<std::string, const Birth*>::const_iterator> range = m_sources.equal_range(path);
+	CollectRange(range.first, range.second, copies);
+	CollectRange(m_sources.lower_bound(path + "/"), m_sources.lower_bound(path + "0"), copies);
+}
+
+size_t
+CopyIndex::Count() const
+{
+	return m_births.size();
+}
+
+CopyIndex::const_iterator
+CopyIndex::begin() const
+{
+	return m_births.begin();
+}
+
+CopyIndex::const_iterator
+CopyIndex::end() const
+{
+	return m_births.end();
+}
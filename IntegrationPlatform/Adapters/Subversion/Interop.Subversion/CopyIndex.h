@@ -0,0 +1,81 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							/// <summary>
+							/// Native index of the revisions in which paths came into existence. A path is either added or copied from an other path.
+							/// The paths are the UTF-8 encoded paths relative to the repository root as they are reported by subversion.
+							/// All lookups are O(log n) per path level
+							/// </summary>
+							class CopyIndex
+							{
+							public:
+								struct Birth
+								{
+									std::string path;
+									long revision;
+
+									/// <summary>
+									/// The source of the copy; empty if the path has been added without history
+									/// </summary>
+									std::string copyFromPath;
+									long copyFromRevision;
+								};
+
+								typedef std::map<std::pair<std::string, long>, Birth>::const_iterator const_iterator;
+
+								CopyIndex();
+
+								/// <summary>
+								/// Records the birth of a path. Returns false if the birth has already been recorded
+								/// </summary>
+								bool Add(const std::string& path, long revision, const std::string& copyFromPath, long copyFromRevision);
+
+								/// <summary>
+								/// Finds the youngest birth at or before the revision of the path itself or one of its parents.
+								/// This is the event that determines where the item at the path comes from. Returns NULL if there is none
+								/// </summary>
+								const Birth* FindBirth(const std::string& path, long revision) const;
+
+								/// <summary>
+								/// Collects all copies whose source is the path or one of its children
+								/// </summary>
+								void FindCopiesOf(const std::string& path, std::vector<const Birth*>& copies) const;
+
+								size_t Count() const;
+
+								const_iterator begin() const;
+								const_iterator end() const;
+
+							private:
+								//Ordered by path and revision. The ancestry lookup is a upper bound search per path level
+								std::map<std::pair<std::string, long>, Birth> m_births;
+
+								//Ordered by the copy source. The nodes of the birth map are stable and can be referenced
+								std::multimap<std::string, const Birth*> m_sources;
+
+								void CollectRange(std::multimap<std::string, const Birth*>::const_iterator first, std::multimap<std::string, const Birth*>::const_iterator last, std::vector<const Birth*>& copies) const;
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
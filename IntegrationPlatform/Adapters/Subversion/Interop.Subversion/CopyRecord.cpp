@@ -0,0 +1,53 @@
+#include "Stdafx.h"
+#include "CopyRecord.h"
+
+using namespace System;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+CopyRecord::CopyRecord(String^ fullServerPath, long revision, String^ copyFromFullServerPath, long copyFromRevision)
+{
+	if(nullptr == fullServerPath)
+	{
+		throw gcnew ArgumentNullException("fullServerPath");
+	}
+
+	if(nullptr == copyFromFullServerPath)
+	{
+		throw gcnew ArgumentNullException("copyFromFullServerPath");
+	}
+
+	m_fullServerPath = fullServerPath;
+	m_revision = revision;
+	m_copyFromFullServerPath = copyFromFullServerPath;
+	m_copyFromRevision = copyFromRevision;
+}
+
+String^
+CopyRecord::FullServerPath::get()
+{
+	return m_fullServerPath;
+}
+
+long
+CopyRecord::Revision::get()
+{
+	return m_revision;
+}
+
+String^
+CopyRecord::CopyFromFullServerPath::get()
+{
+	return m_copyFromFullServerPath;
+}
+
+long
+CopyRecord::CopyFromRevision::get()
+{
+	return m_copyFromRevision;
+}
+
+String^
+CopyRecord::ToString()
+{
+	return String::Format("{0}@{1} -> {2}@{3}", m_copyFromFullServerPath, m_copyFromRevision, m_fullServerPath, m_revision);
+}
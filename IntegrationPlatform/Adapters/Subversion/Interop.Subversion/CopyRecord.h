@@ -0,0 +1,71 @@
+#pragma once
+
+using namespace System;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace ObjectModel
+						{
+							/// <summary>
+							/// An edge of the <see cref="CopyGraph"/>. The item at a path in a revision has been copied from an other path in an older revision
+							/// </summary>
+							public ref class CopyRecord
+							{
+								private:
+									String^ m_fullServerPath;
+									long m_revision;
+									String^ m_copyFromFullServerPath;
+									long m_copyFromRevision;
+
+								internal:
+
+									/// <summary>
+									/// Creates a new copy record
+									/// </summary>
+									/// <param name="fullServerPath">The full path of the copy</param>
+									/// <param name="revision">The revision in which the copy has been created</param>
+									/// <param name="copyFromFullServerPath">The full path of the copy source</param>
+									/// <param name="copyFromRevision">The revision of the copy source</param>
+									CopyRecord(String^ fullServerPath, long revision, String^ copyFromFullServerPath, long copyFromRevision);
+
+								public:
+
+									/// <summary>
+									/// Gets the full path of the copy
+									/// </summary>
+									property String^ FullServerPath { String^ get(); }
+
+									/// <summary>
+									/// Gets the revision in which the copy has been created
+									/// </summary>
+									property long Revision { long get(); }
+
+									/// <summary>
+									/// Gets the full path of the copy source
+									/// </summary>
+									property String^ CopyFromFullServerPath { String^ get(); }
+
+									/// <summary>
+									/// Gets the revision of the copy source
+									/// </summary>
+									property long CopyFromRevision { long get(); }
+
+									virtual String^ ToString() override;
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -107,6 +107,30 @@ LibApr::AprHashThis(apr_hash_index_t *hi, const void **key, apr_ssize_t *klen, v
 	return method(hi, key, klen, val);
 }
 
+void*
+LibApr::AprHashGet(apr_hash_t *ht, const void *key, apr_ssize_t klen)
+{
+	if(nullptr == m_fpAprHashGet)
+	{
+		m_fpAprHashGet = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpAprHashGet method = (tfpAprHashGet)m_fpAprHashGet->Handle;
+	return method(ht, key, klen);
+}
+
+unsigned int
+LibApr::AprHashCount(apr_hash_t *ht)
+{
+	if(nullptr == m_fpAprHashCount)
+	{
+		m_fpAprHashCount = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpAprHashCount method = (tfpAprHashCount)m_fpAprHashCount->Handle;
+	return method(ht);
+}
+
 char* 
 LibApr::AprPStrDup(apr_pool_t *pool, const char* s)
 {
@@ -117,4 +141,28 @@ LibApr::AprPStrDup(apr_pool_t *pool, const char* s)
 
 	tfpAprPStrDup method = (tfpAprPStrDup)m_fAprPStrDup->Handle;
 	return method(pool, s);
-}
\ No newline at end of file
+}
+
+apr_hash_t*
+LibApr::AprHashMake(apr_pool_t *pool)
+{
+	if(nullptr == m_fpAprHashMake)
+	{
+		m_fpAprHashMake = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpAprHashMake method = (tfpAprHashMake)m_fpAprHashMake->Handle;
+	return method(pool);
+}
+
+void
+LibApr::AprHashSet(apr_hash_t *ht, const void *key, apr_ssize_t klen, const void *val)
+{
+	if(nullptr == m_fpAprHashSet)
+	{
+		m_fpAprHashSet = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpAprHashSet method = (tfpAprHashSet)m_fpAprHashSet->Handle;
+	method(ht, key, klen, val);
+}
@@ -17,7 +17,11 @@ typedef void * (CALLBACK* tfpAprArrayPush) (apr_array_header_t *arr);
 typedef apr_hash_index_t* (CALLBACK* tfpAprHashFirst) (apr_pool_t *p, apr_hash_t *ht);
 typedef apr_hash_index_t* (CALLBACK* tfpAprHashNext) (apr_hash_index_t *hi);
 typedef apr_hash_index_t* (CALLBACK* tfpAprHashThis) (apr_hash_index_t *hi, const void **key, apr_ssize_t *klen, void **val);
+typedef void* (CALLBACK* tfpAprHashGet) (apr_hash_t *ht, const void *key, apr_ssize_t klen);
+typedef unsigned int (CALLBACK* tfpAprHashCount) (apr_hash_t *ht);
 typedef char* (CALLBACK* tfpAprPStrDup) (apr_pool_t *pool, const char* s);
+typedef apr_hash_t* (CALLBACK* tfpAprHashMake) (apr_pool_t *pool);
+typedef void (CALLBACK* tfpAprHashSet) (apr_hash_t *ht, const void *key, apr_ssize_t klen, const void *val);
 
 namespace Microsoft
 {
@@ -43,7 +47,11 @@ namespace Microsoft
 								ProcAddress^ m_fpAprHashFirst;
 								ProcAddress^ m_fpAprHashNext;
 								ProcAddress^ m_fAprHashThis;
+								ProcAddress^ m_fpAprHashGet;
+								ProcAddress^ m_fpAprHashCount;
 								ProcAddress^ m_fAprPStrDup;
+								ProcAddress^ m_fpAprHashMake;
+								ProcAddress^ m_fpAprHashSet;
 							
 								static LibApr^ m_instance;
 
@@ -77,8 +85,20 @@ namespace Microsoft
 								[DynamicInvocationAttribute("libapr-1.dll","_apr_hash_this@16")]
 								apr_hash_index_t* AprHashThis(apr_hash_index_t *hi, const void **key, apr_ssize_t *klen, void **val);
 
+								[DynamicInvocationAttribute("libapr-1.dll","_apr_hash_get@12")]
+								void* AprHashGet(apr_hash_t *ht, const void *key, apr_ssize_t klen);
+
+								[DynamicInvocationAttribute("libapr-1.dll","_apr_hash_count@4")]
+								unsigned int AprHashCount(apr_hash_t *ht);
+
 								[DynamicInvocationAttribute("libapr-1.dll","_apr_pstrdup@8")]
 								char* AprPStrDup(apr_pool_t *pool, const char* s);
+
+								[DynamicInvocationAttribute("libapr-1.dll","_apr_hash_make@4")]
+								apr_hash_t* AprHashMake(apr_pool_t *pool);
+
+								[DynamicInvocationAttribute("libapr-1.dll","_apr_hash_set@16")]
+								void AprHashSet(apr_hash_t *ht, const void *key, apr_ssize_t klen, const void *val);
 							};
 						}
 					}
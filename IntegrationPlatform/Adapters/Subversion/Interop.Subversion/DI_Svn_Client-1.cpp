@@ -187,4 +187,31 @@ Svn_Client::SVN_CLIENT_INFO2(
 
 	tfpSVN_CLIENT_INFO2 method = (tfpSVN_CLIENT_INFO2)m_fpSVN_CLIENT_INFO2->Handle;
 	return method(path_or_url, peg_revision, revision, receiver, receiver_baton, depth, changelists, ctx, pool);
+}
+svn_error_t* 
+Svn_Client::SVN_CLIENT_OPEN_RA_SESSION(
+	svn_ra_session_t **session, 
+	const char *url, 
+	svn_client_ctx_t *ctx, 
+	apr_pool_t *pool)
+{
+	if(nullptr == m_fpSVN_CLIENT_OPEN_RA_SESSION)
+	{
+		m_fpSVN_CLIENT_OPEN_RA_SESSION = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_CLIENT_OPEN_RA_SESSION method = (tfpSVN_CLIENT_OPEN_RA_SESSION)m_fpSVN_CLIENT_OPEN_RA_SESSION->Handle;
+	return method(session, url, ctx, pool);
+}
+
+const svn_version_t*
+Svn_Client::SVN_CLIENT_VERSION()
+{
+	if(nullptr == m_fpSVN_CLIENT_VERSION)
+	{
+		m_fpSVN_CLIENT_VERSION = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_CLIENT_VERSION method = (tfpSVN_CLIENT_VERSION)m_fpSVN_CLIENT_VERSION->Handle;
+	return method();
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "apr_pools.h"
 #include "apr_allocator.h"
 #include "svn_client.h"
+#include "svn_version.h"
 
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::DynamicInvocation;
 
@@ -95,6 +96,14 @@ typedef svn_error_t* (CALLBACK* tfpSVN_CLIENT_INFO2) (
 	svn_client_ctx_t *ctx, 
 	apr_pool_t *pool );
 
+typedef svn_error_t* (CALLBACK* tfpSVN_CLIENT_OPEN_RA_SESSION) (
+	svn_ra_session_t **session, 
+	const char *url, 
+	svn_client_ctx_t *ctx, 
+	apr_pool_t *pool );
+
+typedef const svn_version_t* (CALLBACK* tfpSVN_CLIENT_VERSION) ();
+
 namespace Microsoft
 {
 	namespace TeamFoundation
@@ -120,6 +129,8 @@ namespace Microsoft
 								ProcAddress^ m_fpSVN_CLIENT_LOG4;
 								ProcAddress^ m_fpSVN_CLIENT_DIFF_SUMMARIZE;
 								ProcAddress^ m_fpSVN_CLIENT_INFO2;
+								ProcAddress^ m_fpSVN_CLIENT_OPEN_RA_SESSION;
+								ProcAddress^ m_fpSVN_CLIENT_VERSION;
 							
 								static Svn_Client^ m_instance;
 								Svn_Client() { }
@@ -224,6 +235,16 @@ namespace Microsoft
 									const apr_array_header_t *changelists, 
 									svn_client_ctx_t *ctx, 
 									apr_pool_t *pool);
+
+								[DynamicInvocationAttribute("libsvn_client-1.dll", "svn_client_open_ra_session")]
+								svn_error_t* SVN_CLIENT_OPEN_RA_SESSION(
+									svn_ra_session_t **session, 
+									const char *url, 
+									svn_client_ctx_t *ctx, 
+									apr_pool_t *pool);
+
+								[DynamicInvocationAttribute("libsvn_client-1.dll", "svn_client_version")]
+								const svn_version_t* SVN_CLIENT_VERSION();
 							};
 						}
 					}
@@ -0,0 +1,119 @@
+#include "Stdafx.h"
+#include "LibraryLoader.h"
+#include "DI_Svn_Delta-1.h"
+
+using namespace System::Reflection;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
+
+
+Svn_Delta^
+Svn_Delta::Instance()
+{
+	if(nullptr == m_instance)
+	{
+		m_instance = gcnew Svn_Delta();
+	}
+
+	return m_instance;
+}
+
+
+svn_delta_editor_t* 
+Svn_Delta::SVN_DELTA_DEFAULT_EDITOR(
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_DELTA_DEFAULT_EDITOR)
+	{
+		m_fpSVN_DELTA_DEFAULT_EDITOR = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_DELTA_DEFAULT_EDITOR method = (tfpSVN_DELTA_DEFAULT_EDITOR)m_fpSVN_DELTA_DEFAULT_EDITOR->Handle;
+	return method(pool);
+}
+
+void 
+Svn_Delta::SVN_TXDELTA_APPLY(
+	svn_stream_t *source, 
+	svn_stream_t *target, 
+	unsigned char *result_digest, 
+	const char *error_info, 
+	apr_pool_t *pool, 
+	svn_txdelta_window_handler_t *handler, 
+	void **handler_baton )
+{
+	if(nullptr == m_fpSVN_TXDELTA_APPLY)
+	{
+		m_fpSVN_TXDELTA_APPLY = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_TXDELTA_APPLY method = (tfpSVN_TXDELTA_APPLY)m_fpSVN_TXDELTA_APPLY->Handle;
+	method(source, target, result_digest, error_info, pool, handler, handler_baton);
+}
+
+svn_error_t*
+Svn_Delta::SVN_DELTA_PATH_DRIVER(
+	const svn_delta_editor_t *editor, 
+	void *edit_baton, 
+	svn_revnum_t revision, 
+	const apr_array_header_t *paths, 
+	svn_delta_path_driver_cb_func_t callback_func, 
+	void *callback_baton, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_DELTA_PATH_DRIVER)
+	{
+		m_fpSVN_DELTA_PATH_DRIVER = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_DELTA_PATH_DRIVER method = (tfpSVN_DELTA_PATH_DRIVER)m_fpSVN_DELTA_PATH_DRIVER->Handle;
+	return method(editor, edit_baton, revision, paths, callback_func, callback_baton, pool);
+}
+
+void
+Svn_Delta::SVN_TXDELTA(
+	svn_txdelta_stream_t **stream, 
+	svn_stream_t *source, 
+	svn_stream_t *target, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_TXDELTA)
+	{
+		m_fpSVN_TXDELTA = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_TXDELTA method = (tfpSVN_TXDELTA)m_fpSVN_TXDELTA->Handle;
+	method(stream, source, target, pool);
+}
+
+svn_error_t*
+Svn_Delta::SVN_TXDELTA_SEND_STREAM(
+	svn_stream_t *stream, 
+	svn_txdelta_window_handler_t handler, 
+	void *handler_baton, 
+	unsigned char *digest, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_TXDELTA_SEND_STREAM)
+	{
+		m_fpSVN_TXDELTA_SEND_STREAM = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_TXDELTA_SEND_STREAM method = (tfpSVN_TXDELTA_SEND_STREAM)m_fpSVN_TXDELTA_SEND_STREAM->Handle;
+	return method(stream, handler, handler_baton, digest, pool);
+}
+
+svn_error_t*
+Svn_Delta::SVN_TXDELTA_SEND_TXSTREAM(
+	svn_txdelta_stream_t *txstream, 
+	svn_txdelta_window_handler_t handler, 
+	void *handler_baton, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_TXDELTA_SEND_TXSTREAM)
+	{
+		m_fpSVN_TXDELTA_SEND_TXSTREAM = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_TXDELTA_SEND_TXSTREAM method = (tfpSVN_TXDELTA_SEND_TXSTREAM)m_fpSVN_TXDELTA_SEND_TXSTREAM->Handle;
+	return method(txstream, handler, handler_baton, pool);
+}
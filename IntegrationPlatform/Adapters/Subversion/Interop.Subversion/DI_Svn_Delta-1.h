@@ -0,0 +1,136 @@
+#pragma once
+
+#include "DynamicInvocationAttribute.h"
+#include "Library.h"
+#include "apr_pools.h"
+#include "svn_delta.h"
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::DynamicInvocation;
+
+typedef svn_delta_editor_t* (CALLBACK* tfpSVN_DELTA_DEFAULT_EDITOR) (
+	apr_pool_t *pool );
+
+typedef void (CALLBACK* tfpSVN_TXDELTA_APPLY) (
+	svn_stream_t *source, 
+	svn_stream_t *target, 
+	unsigned char *result_digest, 
+	const char *error_info, 
+	apr_pool_t *pool, 
+	svn_txdelta_window_handler_t *handler, 
+	void **handler_baton );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_DELTA_PATH_DRIVER) (
+	const svn_delta_editor_t *editor, 
+	void *edit_baton, 
+	svn_revnum_t revision, 
+	const apr_array_header_t *paths, 
+	svn_delta_path_driver_cb_func_t callback_func, 
+	void *callback_baton, 
+	apr_pool_t *pool );
+
+typedef void (CALLBACK* tfpSVN_TXDELTA) (
+	svn_txdelta_stream_t **stream, 
+	svn_stream_t *source, 
+	svn_stream_t *target, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_TXDELTA_SEND_STREAM) (
+	svn_stream_t *stream, 
+	svn_txdelta_window_handler_t handler, 
+	void *handler_baton, 
+	unsigned char *digest, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_TXDELTA_SEND_TXSTREAM) (
+	svn_txdelta_stream_t *txstream, 
+	svn_txdelta_window_handler_t handler, 
+	void *handler_baton, 
+	apr_pool_t *pool );
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace LibraryAccess
+						{
+							private ref class Svn_Delta
+							{
+							private:
+								ProcAddress^ m_fpSVN_DELTA_DEFAULT_EDITOR;
+								ProcAddress^ m_fpSVN_TXDELTA_APPLY;
+								ProcAddress^ m_fpSVN_DELTA_PATH_DRIVER;
+								ProcAddress^ m_fpSVN_TXDELTA;
+								ProcAddress^ m_fpSVN_TXDELTA_SEND_STREAM;
+								ProcAddress^ m_fpSVN_TXDELTA_SEND_TXSTREAM;
+							
+								static Svn_Delta^ m_instance;
+								Svn_Delta() { }
+
+							public:
+								
+								/// <summary>
+								/// Gets the actual instance of the library
+								/// </summary>
+								static Svn_Delta^ Instance();
+
+								[DynamicInvocationAttribute("libsvn_delta-1.dll", "svn_delta_default_editor")]
+								svn_delta_editor_t* SVN_DELTA_DEFAULT_EDITOR(
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_delta-1.dll", "svn_txdelta_apply")]
+								void SVN_TXDELTA_APPLY(
+									svn_stream_t *source, 
+									svn_stream_t *target, 
+									unsigned char *result_digest, 
+									const char *error_info, 
+									apr_pool_t *pool, 
+									svn_txdelta_window_handler_t *handler, 
+									void **handler_baton );
+
+								[DynamicInvocationAttribute("libsvn_delta-1.dll", "svn_delta_path_driver")]
+								svn_error_t* SVN_DELTA_PATH_DRIVER(
+									const svn_delta_editor_t *editor, 
+									void *edit_baton, 
+									svn_revnum_t revision, 
+									const apr_array_header_t *paths, 
+									svn_delta_path_driver_cb_func_t callback_func, 
+									void *callback_baton, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_delta-1.dll", "svn_txdelta")]
+								void SVN_TXDELTA(
+									svn_txdelta_stream_t **stream, 
+									svn_stream_t *source, 
+									svn_stream_t *target, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_delta-1.dll", "svn_txdelta_send_stream")]
+								svn_error_t* SVN_TXDELTA_SEND_STREAM(
+									svn_stream_t *stream, 
+									svn_txdelta_window_handler_t handler, 
+									void *handler_baton, 
+									unsigned char *digest, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_delta-1.dll", "svn_txdelta_send_txstream")]
+								svn_error_t* SVN_TXDELTA_SEND_TXSTREAM(
+									svn_txdelta_stream_t *txstream, 
+									svn_txdelta_window_handler_t handler, 
+									void *handler_baton, 
+									apr_pool_t *pool );
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
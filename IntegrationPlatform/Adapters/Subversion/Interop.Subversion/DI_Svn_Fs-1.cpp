@@ -0,0 +1,163 @@
+#include "Stdafx.h"
+#include "LibraryLoader.h"
+#include "DI_Svn_Fs-1.h"
+
+using namespace System::Reflection;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
+
+
+Svn_Fs^
+Svn_Fs::Instance()
+{
+	if(nullptr == m_instance)
+	{
+		m_instance = gcnew Svn_Fs();
+	}
+
+	return m_instance;
+}
+
+svn_error_t* 
+Svn_Fs::SVN_FS_YOUNGEST_REV(
+	svn_revnum_t *youngest_p, 
+	svn_fs_t *fs, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_FS_YOUNGEST_REV)
+	{
+		m_fpSVN_FS_YOUNGEST_REV = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_FS_YOUNGEST_REV method = (tfpSVN_FS_YOUNGEST_REV)m_fpSVN_FS_YOUNGEST_REV->Handle;
+	return method(youngest_p, fs, pool);
+}
+
+svn_error_t* 
+Svn_Fs::SVN_FS_REVISION_ROOT(
+	svn_fs_root_t **root_p, 
+	svn_fs_t *fs, 
+	svn_revnum_t rev, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_FS_REVISION_ROOT)
+	{
+		m_fpSVN_FS_REVISION_ROOT = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_FS_REVISION_ROOT method = (tfpSVN_FS_REVISION_ROOT)m_fpSVN_FS_REVISION_ROOT->Handle;
+	return method(root_p, fs, rev, pool);
+}
+
+svn_error_t* 
+Svn_Fs::SVN_FS_REVISION_PROP(
+	svn_string_t **value_p, 
+	svn_fs_t *fs, 
+	svn_revnum_t rev, 
+	const char *propname, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_FS_REVISION_PROP)
+	{
+		m_fpSVN_FS_REVISION_PROP = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_FS_REVISION_PROP method = (tfpSVN_FS_REVISION_PROP)m_fpSVN_FS_REVISION_PROP->Handle;
+	return method(value_p, fs, rev, propname, pool);
+}
+
+svn_error_t* 
+Svn_Fs::SVN_FS_CHECK_PATH(
+	svn_node_kind_t *kind_p, 
+	svn_fs_root_t *root, 
+	const char *path, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_FS_CHECK_PATH)
+	{
+		m_fpSVN_FS_CHECK_PATH = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_FS_CHECK_PATH method = (tfpSVN_FS_CHECK_PATH)m_fpSVN_FS_CHECK_PATH->Handle;
+	return method(kind_p, root, path, pool);
+}
+
+svn_error_t* 
+Svn_Fs::SVN_FS_NODE_CREATED_REV(
+	svn_revnum_t *revision, 
+	svn_fs_root_t *root, 
+	const char *path, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_FS_NODE_CREATED_REV)
+	{
+		m_fpSVN_FS_NODE_CREATED_REV = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_FS_NODE_CREATED_REV method = (tfpSVN_FS_NODE_CREATED_REV)m_fpSVN_FS_NODE_CREATED_REV->Handle;
+	return method(revision, root, path, pool);
+}
+
+svn_error_t* 
+Svn_Fs::SVN_FS_NODE_PROP(
+	svn_string_t **value_p, 
+	svn_fs_root_t *root, 
+	const char *path, 
+	const char *propname, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_FS_NODE_PROP)
+	{
+		m_fpSVN_FS_NODE_PROP = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_FS_NODE_PROP method = (tfpSVN_FS_NODE_PROP)m_fpSVN_FS_NODE_PROP->Handle;
+	return method(value_p, root, path, propname, pool);
+}
+
+svn_error_t* 
+Svn_Fs::SVN_FS_DIR_ENTRIES(
+	apr_hash_t **entries_p, 
+	svn_fs_root_t *root, 
+	const char *path, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_FS_DIR_ENTRIES)
+	{
+		m_fpSVN_FS_DIR_ENTRIES = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_FS_DIR_ENTRIES method = (tfpSVN_FS_DIR_ENTRIES)m_fpSVN_FS_DIR_ENTRIES->Handle;
+	return method(entries_p, root, path, pool);
+}
+
+svn_error_t* 
+Svn_Fs::SVN_FS_FILE_LENGTH(
+	svn_filesize_t *length_p, 
+	svn_fs_root_t *root, 
+	const char *path, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_FS_FILE_LENGTH)
+	{
+		m_fpSVN_FS_FILE_LENGTH = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_FS_FILE_LENGTH method = (tfpSVN_FS_FILE_LENGTH)m_fpSVN_FS_FILE_LENGTH->Handle;
+	return method(length_p, root, path, pool);
+}
+
+svn_error_t* 
+Svn_Fs::SVN_FS_FILE_CONTENTS(
+	svn_stream_t **contents, 
+	svn_fs_root_t *root, 
+	const char *path, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_FS_FILE_CONTENTS)
+	{
+		m_fpSVN_FS_FILE_CONTENTS = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_FS_FILE_CONTENTS method = (tfpSVN_FS_FILE_CONTENTS)m_fpSVN_FS_FILE_CONTENTS->Handle;
+	return method(contents, root, path, pool);
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "DynamicInvocationAttribute.h"
+#include "Library.h"
+#include "apr_pools.h"
+#include "svn_fs.h"
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::DynamicInvocation;
+
+typedef svn_error_t* (CALLBACK* tfpSVN_FS_YOUNGEST_REV) (
+	svn_revnum_t *youngest_p, 
+	svn_fs_t *fs, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_FS_REVISION_ROOT) (
+	svn_fs_root_t **root_p, 
+	svn_fs_t *fs, 
+	svn_revnum_t rev, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_FS_REVISION_PROP) (
+	svn_string_t **value_p, 
+	svn_fs_t *fs, 
+	svn_revnum_t rev, 
+	const char *propname, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_FS_CHECK_PATH) (
+	svn_node_kind_t *kind_p, 
+	svn_fs_root_t *root, 
+	const char *path, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_FS_NODE_CREATED_REV) (
+	svn_revnum_t *revision, 
+	svn_fs_root_t *root, 
+	const char *path, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_FS_NODE_PROP) (
+	svn_string_t **value_p, 
+	svn_fs_root_t *root, 
+	const char *path, 
+	const char *propname, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_FS_DIR_ENTRIES) (
+	apr_hash_t **entries_p, 
+	svn_fs_root_t *root, 
+	const char *path, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_FS_FILE_LENGTH) (
+	svn_filesize_t *length_p, 
+	svn_fs_root_t *root, 
+	const char *path, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_FS_FILE_CONTENTS) (
+	svn_stream_t **contents, 
+	svn_fs_root_t *root, 
+	const char *path, 
+	apr_pool_t *pool );
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace LibraryAccess
+						{
+							private ref class Svn_Fs
+							{
+							private:
+								ProcAddress^ m_fpSVN_FS_YOUNGEST_REV;
+								ProcAddress^ m_fpSVN_FS_REVISION_ROOT;
+								ProcAddress^ m_fpSVN_FS_REVISION_PROP;
+								ProcAddress^ m_fpSVN_FS_CHECK_PATH;
+								ProcAddress^ m_fpSVN_FS_NODE_CREATED_REV;
+								ProcAddress^ m_fpSVN_FS_NODE_PROP;
+								ProcAddress^ m_fpSVN_FS_DIR_ENTRIES;
+								ProcAddress^ m_fpSVN_FS_FILE_LENGTH;
+								ProcAddress^ m_fpSVN_FS_FILE_CONTENTS;
+								
+								static Svn_Fs^ m_instance;
+								Svn_Fs() { }
+
+							public:
+								
+								/// <summary>
+								/// Gets the actual instance of the library
+								/// </summary>
+								static Svn_Fs^ Instance();
+
+								[DynamicInvocationAttribute("libsvn_fs-1.dll", "svn_fs_youngest_rev")]
+								svn_error_t* SVN_FS_YOUNGEST_REV(
+									svn_revnum_t *youngest_p, 
+									svn_fs_t *fs, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_fs-1.dll", "svn_fs_revision_root")]
+								svn_error_t* SVN_FS_REVISION_ROOT(
+									svn_fs_root_t **root_p, 
+									svn_fs_t *fs, 
+									svn_revnum_t rev, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_fs-1.dll", "svn_fs_revision_prop")]
+								svn_error_t* SVN_FS_REVISION_PROP(
+									svn_string_t **value_p, 
+									svn_fs_t *fs, 
+									svn_revnum_t rev, 
+									const char *propname, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_fs-1.dll", "svn_fs_check_path")]
+								svn_error_t* SVN_FS_CHECK_PATH(
+									svn_node_kind_t *kind_p, 
+									svn_fs_root_t *root, 
+									const char *path, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_fs-1.dll", "svn_fs_node_created_rev")]
+								svn_error_t* SVN_FS_NODE_CREATED_REV(
+									svn_revnum_t *revision, 
+									svn_fs_root_t *root, 
+									const char *path, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_fs-1.dll", "svn_fs_node_prop")]
+								svn_error_t* SVN_FS_NODE_PROP(
+									svn_string_t **value_p, 
+									svn_fs_root_t *root, 
+									const char *path, 
+									const char *propname, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_fs-1.dll", "svn_fs_dir_entries")]
+								svn_error_t* SVN_FS_DIR_ENTRIES(
+									apr_hash_t **entries_p, 
+									svn_fs_root_t *root, 
+									const char *path, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_fs-1.dll", "svn_fs_file_length")]
+								svn_error_t* SVN_FS_FILE_LENGTH(
+									svn_filesize_t *length_p, 
+									svn_fs_root_t *root, 
+									const char *path, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_fs-1.dll", "svn_fs_file_contents")]
+								svn_error_t* SVN_FS_FILE_CONTENTS(
+									svn_stream_t **contents, 
+									svn_fs_root_t *root, 
+									const char *path, 
+									apr_pool_t *pool );
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,116 @@
+#include "Stdafx.h"
+#include "LibraryLoader.h"
+#include "DI_Svn_Ra-1.h"
+
+using namespace System::Reflection;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
+
+
+Svn_Ra^
+Svn_Ra::Instance()
+{
+	if(nullptr == m_instance)
+	{
+		m_instance = gcnew Svn_Ra();
+	}
+
+	return m_instance;
+}
+
+
+svn_error_t* 
+Svn_Ra::SVN_RA_GET_LOCATION_SEGMENTS(
+	svn_ra_session_t *session, 
+	const char *path, 
+	svn_revnum_t peg_revision, 
+	svn_revnum_t start_rev, 
+	svn_revnum_t end_rev, 
+	svn_location_segment_receiver_t receiver, 
+	void *receiver_baton, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_RA_GET_LOCATION_SEGMENTS)
+	{
+		m_fpSVN_RA_GET_LOCATION_SEGMENTS = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_RA_GET_LOCATION_SEGMENTS method = (tfpSVN_RA_GET_LOCATION_SEGMENTS)m_fpSVN_RA_GET_LOCATION_SEGMENTS->Handle;
+	return method(session, path, peg_revision, start_rev, end_rev, receiver, receiver_baton, pool);
+}
+
+svn_error_t* 
+Svn_Ra::SVN_RA_GET_FILE(
+	svn_ra_session_t *session, 
+	const char *path, 
+	svn_revnum_t revision, 
+	svn_stream_t *stream, 
+	svn_revnum_t *fetched_rev, 
+	apr_hash_t **props, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_RA_GET_FILE)
+	{
+		m_fpSVN_RA_GET_FILE = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_RA_GET_FILE method = (tfpSVN_RA_GET_FILE)m_fpSVN_RA_GET_FILE->Handle;
+	return method(session, path, revision, stream, fetched_rev, props, pool);
+}
+
+svn_error_t* 
+Svn_Ra::SVN_RA_DO_UPDATE2(
+	svn_ra_session_t *session, 
+	const svn_ra_reporter3_t **reporter, 
+	void **report_baton, 
+	svn_revnum_t revision_to_update_to, 
+	const char *update_target, 
+	svn_depth_t depth, 
+	svn_boolean_t send_copyfrom_args, 
+	const svn_delta_editor_t *update_editor, 
+	void *update_baton, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_RA_DO_UPDATE2)
+	{
+		m_fpSVN_RA_DO_UPDATE2 = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_RA_DO_UPDATE2 method = (tfpSVN_RA_DO_UPDATE2)m_fpSVN_RA_DO_UPDATE2->Handle;
+	return method(session, reporter, report_baton, revision_to_update_to, update_target, depth, send_copyfrom_args, update_editor, update_baton, pool);
+}
+
+svn_error_t* 
+Svn_Ra::SVN_RA_GET_LATEST_REVNUM(
+	svn_ra_session_t *session, 
+	svn_revnum_t *latest_revnum, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_RA_GET_LATEST_REVNUM)
+	{
+		m_fpSVN_RA_GET_LATEST_REVNUM = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_RA_GET_LATEST_REVNUM method = (tfpSVN_RA_GET_LATEST_REVNUM)m_fpSVN_RA_GET_LATEST_REVNUM->Handle;
+	return method(session, latest_revnum, pool);
+}
+
+svn_error_t*
+Svn_Ra::SVN_RA_GET_COMMIT_EDITOR3(
+	svn_ra_session_t *session, 
+	const svn_delta_editor_t **editor, 
+	void **edit_baton, 
+	apr_hash_t *revprop_table, 
+	svn_commit_callback2_t callback, 
+	void *callback_baton, 
+	apr_hash_t *lock_tokens, 
+	svn_boolean_t keep_locks, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_RA_GET_COMMIT_EDITOR3)
+	{
+		m_fpSVN_RA_GET_COMMIT_EDITOR3 = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_RA_GET_COMMIT_EDITOR3 method = (tfpSVN_RA_GET_COMMIT_EDITOR3)m_fpSVN_RA_GET_COMMIT_EDITOR3->Handle;
+	return method(session, editor, edit_baton, revprop_table, callback, callback_baton, lock_tokens, keep_locks, pool);
+}
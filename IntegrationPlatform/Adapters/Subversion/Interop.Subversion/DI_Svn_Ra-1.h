@@ -0,0 +1,148 @@
+#pragma once
+
+#include "DynamicInvocationAttribute.h"
+#include "Library.h"
+#include "apr_pools.h"
+#include "svn_ra.h"
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::DynamicInvocation;
+
+typedef svn_error_t* (CALLBACK* tfpSVN_RA_GET_LOCATION_SEGMENTS) (
+	svn_ra_session_t *session, 
+	const char *path, 
+	svn_revnum_t peg_revision, 
+	svn_revnum_t start_rev, 
+	svn_revnum_t end_rev, 
+	svn_location_segment_receiver_t receiver, 
+	void *receiver_baton, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_RA_GET_FILE) (
+	svn_ra_session_t *session, 
+	const char *path, 
+	svn_revnum_t revision, 
+	svn_stream_t *stream, 
+	svn_revnum_t *fetched_rev, 
+	apr_hash_t **props, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_RA_DO_UPDATE2) (
+	svn_ra_session_t *session, 
+	const svn_ra_reporter3_t **reporter, 
+	void **report_baton, 
+	svn_revnum_t revision_to_update_to, 
+	const char *update_target, 
+	svn_depth_t depth, 
+	svn_boolean_t send_copyfrom_args, 
+	const svn_delta_editor_t *update_editor, 
+	void *update_baton, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_RA_GET_LATEST_REVNUM) (
+	svn_ra_session_t *session, 
+	svn_revnum_t *latest_revnum, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_RA_GET_COMMIT_EDITOR3) (
+	svn_ra_session_t *session, 
+	const svn_delta_editor_t **editor, 
+	void **edit_baton, 
+	apr_hash_t *revprop_table, 
+	svn_commit_callback2_t callback, 
+	void *callback_baton, 
+	apr_hash_t *lock_tokens, 
+	svn_boolean_t keep_locks, 
+	apr_pool_t *pool );
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace LibraryAccess
+						{
+							private ref class Svn_Ra
+							{
+							private:
+								ProcAddress^ m_fpSVN_RA_GET_LOCATION_SEGMENTS;
+								ProcAddress^ m_fpSVN_RA_GET_FILE;
+								ProcAddress^ m_fpSVN_RA_DO_UPDATE2;
+								ProcAddress^ m_fpSVN_RA_GET_LATEST_REVNUM;
+								ProcAddress^ m_fpSVN_RA_GET_COMMIT_EDITOR3;
+							
+								static Svn_Ra^ m_instance;
+								Svn_Ra() { }
+
+							public:
+								
+								/// <summary>
+								/// Gets the actual instance of the library
+								/// </summary>
+								static Svn_Ra^ Instance();
+
+								[DynamicInvocationAttribute("libsvn_ra-1.dll", "svn_ra_get_location_segments")]
+								svn_error_t* SVN_RA_GET_LOCATION_SEGMENTS(
+									svn_ra_session_t *session, 
+									const char *path, 
+									svn_revnum_t peg_revision, 
+									svn_revnum_t start_rev, 
+									svn_revnum_t end_rev, 
+									svn_location_segment_receiver_t receiver, 
+									void *receiver_baton, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_ra-1.dll", "svn_ra_get_file")]
+								svn_error_t* SVN_RA_GET_FILE(
+									svn_ra_session_t *session, 
+									const char *path, 
+									svn_revnum_t revision, 
+									svn_stream_t *stream, 
+									svn_revnum_t *fetched_rev, 
+									apr_hash_t **props, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_ra-1.dll", "svn_ra_do_update2")]
+								svn_error_t* SVN_RA_DO_UPDATE2(
+									svn_ra_session_t *session, 
+									const svn_ra_reporter3_t **reporter, 
+									void **report_baton, 
+									svn_revnum_t revision_to_update_to, 
+									const char *update_target, 
+									svn_depth_t depth, 
+									svn_boolean_t send_copyfrom_args, 
+									const svn_delta_editor_t *update_editor, 
+									void *update_baton, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_ra-1.dll", "svn_ra_get_latest_revnum")]
+								svn_error_t* SVN_RA_GET_LATEST_REVNUM(
+									svn_ra_session_t *session, 
+									svn_revnum_t *latest_revnum, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_ra-1.dll", "svn_ra_get_commit_editor3")]
+								svn_error_t* SVN_RA_GET_COMMIT_EDITOR3(
+									svn_ra_session_t *session, 
+									const svn_delta_editor_t **editor, 
+									void **edit_baton, 
+									apr_hash_t *revprop_table, 
+									svn_commit_callback2_t callback, 
+									void *callback_baton, 
+									apr_hash_t *lock_tokens, 
+									svn_boolean_t keep_locks, 
+									apr_pool_t *pool );
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
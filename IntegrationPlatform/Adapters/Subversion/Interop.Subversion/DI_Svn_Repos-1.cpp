@@ -0,0 +1,92 @@
+#include "Stdafx.h"
+#include "LibraryLoader.h"
+#include "DI_Svn_Repos-1.h"
+
+using namespace System::Reflection;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
+
+
+Svn_Repos^
+Svn_Repos::Instance()
+{
+	if(nullptr == m_instance)
+	{
+		m_instance = gcnew Svn_Repos();
+	}
+
+	return m_instance;
+}
+
+svn_error_t* 
+Svn_Repos::SVN_REPOS_OPEN(
+	svn_repos_t **repos_p, 
+	const char *path, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_REPOS_OPEN)
+	{
+		m_fpSVN_REPOS_OPEN = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_REPOS_OPEN method = (tfpSVN_REPOS_OPEN)m_fpSVN_REPOS_OPEN->Handle;
+	return method(repos_p, path, pool);
+}
+
+svn_fs_t* 
+Svn_Repos::SVN_REPOS_FS(
+	svn_repos_t *repos )
+{
+	if(nullptr == m_fpSVN_REPOS_FS)
+	{
+		m_fpSVN_REPOS_FS = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_REPOS_FS method = (tfpSVN_REPOS_FS)m_fpSVN_REPOS_FS->Handle;
+	return method(repos);
+}
+
+svn_error_t* 
+Svn_Repos::SVN_REPOS_GET_LOGS4(
+	svn_repos_t *repos, 
+	const apr_array_header_t *paths, 
+	svn_revnum_t start, 
+	svn_revnum_t end, 
+	int limit, 
+	svn_boolean_t discover_changed_paths, 
+	svn_boolean_t strict_node_history, 
+	svn_boolean_t include_merged_revisions, 
+	const apr_array_header_t *revprops, 
+	svn_repos_authz_func_t authz_read_func, 
+	void *authz_read_baton, 
+	svn_log_entry_receiver_t receiver, 
+	void *receiver_baton, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_REPOS_GET_LOGS4)
+	{
+		m_fpSVN_REPOS_GET_LOGS4 = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_REPOS_GET_LOGS4 method = (tfpSVN_REPOS_GET_LOGS4)m_fpSVN_REPOS_GET_LOGS4->Handle;
+	return method(repos, paths, start, end, limit, discover_changed_paths, strict_node_history, include_merged_revisions, revprops, authz_read_func, authz_read_baton, receiver, receiver_baton, pool);
+}
+
+svn_error_t* 
+Svn_Repos::SVN_REPOS_TRACE_NODE_LOCATIONS(
+	svn_fs_t *fs, 
+	apr_hash_t **locations, 
+	const char *fs_path, 
+	svn_revnum_t peg_revision, 
+	const apr_array_header_t *location_revisions, 
+	svn_repos_authz_func_t authz_read_func, 
+	void *authz_read_baton, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_REPOS_TRACE_NODE_LOCATIONS)
+	{
+		m_fpSVN_REPOS_TRACE_NODE_LOCATIONS = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_REPOS_TRACE_NODE_LOCATIONS method = (tfpSVN_REPOS_TRACE_NODE_LOCATIONS)m_fpSVN_REPOS_TRACE_NODE_LOCATIONS->Handle;
+	return method(fs, locations, fs_path, peg_revision, location_revisions, authz_read_func, authz_read_baton, pool);
+}
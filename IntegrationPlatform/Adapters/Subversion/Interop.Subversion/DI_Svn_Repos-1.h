@@ -0,0 +1,120 @@
+#pragma once
+
+#include "DynamicInvocationAttribute.h"
+#include "Library.h"
+#include "apr_pools.h"
+#include "svn_repos.h"
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::DynamicInvocation;
+
+typedef svn_error_t* (CALLBACK* tfpSVN_REPOS_OPEN) (
+	svn_repos_t **repos_p, 
+	const char *path, 
+	apr_pool_t *pool );
+
+typedef svn_fs_t* (CALLBACK* tfpSVN_REPOS_FS) (
+	svn_repos_t *repos );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_REPOS_GET_LOGS4) (
+	svn_repos_t *repos, 
+	const apr_array_header_t *paths, 
+	svn_revnum_t start, 
+	svn_revnum_t end, 
+	int limit, 
+	svn_boolean_t discover_changed_paths, 
+	svn_boolean_t strict_node_history, 
+	svn_boolean_t include_merged_revisions, 
+	const apr_array_header_t *revprops, 
+	svn_repos_authz_func_t authz_read_func, 
+	void *authz_read_baton, 
+	svn_log_entry_receiver_t receiver, 
+	void *receiver_baton, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_REPOS_TRACE_NODE_LOCATIONS) (
+	svn_fs_t *fs, 
+	apr_hash_t **locations, 
+	const char *fs_path, 
+	svn_revnum_t peg_revision, 
+	const apr_array_header_t *location_revisions, 
+	svn_repos_authz_func_t authz_read_func, 
+	void *authz_read_baton, 
+	apr_pool_t *pool );
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace LibraryAccess
+						{
+							private ref class Svn_Repos
+							{
+							private:
+								ProcAddress^ m_fpSVN_REPOS_OPEN;
+								ProcAddress^ m_fpSVN_REPOS_FS;
+								ProcAddress^ m_fpSVN_REPOS_GET_LOGS4;
+								ProcAddress^ m_fpSVN_REPOS_TRACE_NODE_LOCATIONS;
+								
+								static Svn_Repos^ m_instance;
+								Svn_Repos() { }
+
+							public:
+								
+								/// <summary>
+								/// Gets the actual instance of the library
+								/// </summary>
+								static Svn_Repos^ Instance();
+
+								[DynamicInvocationAttribute("libsvn_repos-1.dll", "svn_repos_open")]
+								svn_error_t* SVN_REPOS_OPEN(
+									svn_repos_t **repos_p, 
+									const char *path, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_repos-1.dll", "svn_repos_fs")]
+								svn_fs_t* SVN_REPOS_FS(
+									svn_repos_t *repos );
+
+								[DynamicInvocationAttribute("libsvn_repos-1.dll", "svn_repos_get_logs4")]
+								svn_error_t* SVN_REPOS_GET_LOGS4(
+									svn_repos_t *repos, 
+									const apr_array_header_t *paths, 
+									svn_revnum_t start, 
+									svn_revnum_t end, 
+									int limit, 
+									svn_boolean_t discover_changed_paths, 
+									svn_boolean_t strict_node_history, 
+									svn_boolean_t include_merged_revisions, 
+									const apr_array_header_t *revprops, 
+									svn_repos_authz_func_t authz_read_func, 
+									void *authz_read_baton, 
+									svn_log_entry_receiver_t receiver, 
+									void *receiver_baton, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_repos-1.dll", "svn_repos_trace_node_locations")]
+								svn_error_t* SVN_REPOS_TRACE_NODE_LOCATIONS(
+									svn_fs_t *fs, 
+									apr_hash_t **locations, 
+									const char *fs_path, 
+									svn_revnum_t peg_revision, 
+									const apr_array_header_t *location_revisions, 
+									svn_repos_authz_func_t authz_read_func, 
+									void *authz_read_baton, 
+									apr_pool_t *pool );
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
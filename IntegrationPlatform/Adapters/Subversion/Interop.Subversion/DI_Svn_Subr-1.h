@@ -3,6 +3,7 @@
 #include "DynamicInvocationAttribute.h"
 #include "Library.h"
 #include "svn_cmdline.h"
+#include "svn_io.h"
 #include "apr_pools.h"
 #include "apr_allocator.h"
 
@@ -42,6 +43,40 @@ typedef svn_error_t* (CALLBACK* tfpSVN_UTF_CSTRING_TO_UTF8)(
 	const char *src, 
 	apr_pool_t *pool);
 
+typedef svn_error_t* (CALLBACK* tfpSVN_ERROR_CREATE)(
+	apr_status_t apr_err, 
+	svn_error_t *child, 
+	const char *message);
+
+typedef svn_stream_t* (CALLBACK* tfpSVN_STREAM_CREATE)(
+	void *baton, 
+	apr_pool_t *pool);
+
+typedef void (CALLBACK* tfpSVN_STREAM_SET_WRITE)(
+	svn_stream_t *stream, 
+	svn_write_fn_t write_fn);
+
+typedef svn_stream_t* (CALLBACK* tfpSVN_STREAM_EMPTY)(
+	apr_pool_t *pool);
+
+typedef svn_string_t* (CALLBACK* tfpSVN_STRING_CREATE) (
+	const char *cstring, 
+	apr_pool_t *pool );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_STREAM_OPEN_READONLY) (
+	svn_stream_t **stream, 
+	const char *path, 
+	apr_pool_t *result_pool, 
+	apr_pool_t *scratch_pool );
+
+typedef void (CALLBACK* tfpSVN_ERROR_CLEAR) (
+	svn_error_t *error );
+
+typedef svn_error_t* (CALLBACK* tfpSVN_STREAM_READ) (
+	svn_stream_t *stream, 
+	char *buffer, 
+	apr_size_t *len );
+
 namespace Microsoft
 {
 	namespace TeamFoundation
@@ -65,6 +100,14 @@ namespace Microsoft
 								ProcAddress^ m_fpSVN_POOL_CREATE_EX;
 								ProcAddress^ m_fpSVN_POOL_DESTROY;
 								ProcAddress^ m_fpSVN_UTF_CSTRING_TO_UTF8;
+								ProcAddress^ m_fpSVN_ERROR_CREATE;
+								ProcAddress^ m_fpSVN_STREAM_CREATE;
+								ProcAddress^ m_fpSVN_STREAM_SET_WRITE;
+								ProcAddress^ m_fpSVN_STREAM_EMPTY;
+								ProcAddress^ m_fpSVN_STRING_CREATE;
+								ProcAddress^ m_fpSVN_STREAM_OPEN_READONLY;
+								ProcAddress^ m_fpSVN_ERROR_CLEAR;
+								ProcAddress^ m_fpSVN_STREAM_READ;
 							
 								static Svn_subr^ m_instance;
 
@@ -118,6 +161,48 @@ namespace Microsoft
 									const char **dest, 
 									const char *src, 
 									apr_pool_t *pool);
+
+								[DynamicInvocationAttribute("libsvn_subr-1.dll", "svn_error_create")]
+								svn_error_t* SVN_ERROR_CREATE(
+									apr_status_t apr_err, 
+									svn_error_t *child, 
+									const char *message);
+
+								[DynamicInvocationAttribute("libsvn_subr-1.dll", "svn_stream_create")]
+								svn_stream_t* SVN_STREAM_CREATE(
+									void *baton, 
+									apr_pool_t *pool);
+
+								[DynamicInvocationAttribute("libsvn_subr-1.dll", "svn_stream_set_write")]
+								void SVN_STREAM_SET_WRITE(
+									svn_stream_t *stream, 
+									svn_write_fn_t write_fn);
+
+								[DynamicInvocationAttribute("libsvn_subr-1.dll", "svn_stream_empty")]
+								svn_stream_t* SVN_STREAM_EMPTY(
+									apr_pool_t *pool);
+
+								[DynamicInvocationAttribute("libsvn_subr-1.dll", "svn_string_create")]
+								svn_string_t* SVN_STRING_CREATE(
+									const char *cstring, 
+									apr_pool_t *pool );
+
+								[DynamicInvocationAttribute("libsvn_subr-1.dll", "svn_stream_open_readonly")]
+								svn_error_t* SVN_STREAM_OPEN_READONLY(
+									svn_stream_t **stream, 
+									const char *path, 
+									apr_pool_t *result_pool, 
+									apr_pool_t *scratch_pool );
+
+								[DynamicInvocationAttribute("libsvn_subr-1.dll", "svn_error_clear")]
+								void SVN_ERROR_CLEAR(
+									svn_error_t *error );
+
+								[DynamicInvocationAttribute("libsvn_subr-1.dll", "svn_stream_read")]
+								svn_error_t* SVN_STREAM_READ(
+									svn_stream_t *stream, 
+									char *buffer, 
+									apr_size_t *len );
 							};
 						}
 					}
@@ -106,5 +106,109 @@ Svn_subr::SVN_UTF_CSTRING_TO_UTF8(const char **dest, const char *src, apr_pool_t
 	return method(dest, src, pool);
 }
 
-							
 
+svn_error_t* 
+Svn_subr::SVN_ERROR_CREATE(apr_status_t apr_err, svn_error_t *child, const char *message) 
+{
+	if(nullptr == m_fpSVN_ERROR_CREATE)
+	{
+		m_fpSVN_ERROR_CREATE = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_ERROR_CREATE method = (tfpSVN_ERROR_CREATE)m_fpSVN_ERROR_CREATE->Handle;
+	return method(apr_err, child, message);
+}
+
+svn_stream_t* 
+Svn_subr::SVN_STREAM_CREATE(void *baton, apr_pool_t *pool) 
+{
+	if(nullptr == m_fpSVN_STREAM_CREATE)
+	{
+		m_fpSVN_STREAM_CREATE = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_STREAM_CREATE method = (tfpSVN_STREAM_CREATE)m_fpSVN_STREAM_CREATE->Handle;
+	return method(baton, pool);
+}
+
+void 
+Svn_subr::SVN_STREAM_SET_WRITE(svn_stream_t *stream, svn_write_fn_t write_fn) 
+{
+	if(nullptr == m_fpSVN_STREAM_SET_WRITE)
+	{
+		m_fpSVN_STREAM_SET_WRITE = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_STREAM_SET_WRITE method = (tfpSVN_STREAM_SET_WRITE)m_fpSVN_STREAM_SET_WRITE->Handle;
+	method(stream, write_fn);
+}
+
+svn_stream_t* 
+Svn_subr::SVN_STREAM_EMPTY(apr_pool_t *pool) 
+{
+	if(nullptr == m_fpSVN_STREAM_EMPTY)
+	{
+		m_fpSVN_STREAM_EMPTY = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_STREAM_EMPTY method = (tfpSVN_STREAM_EMPTY)m_fpSVN_STREAM_EMPTY->Handle;
+	return method(pool);
+}
+
+svn_string_t*
+Svn_subr::SVN_STRING_CREATE(
+	const char *cstring, 
+	apr_pool_t *pool )
+{
+	if(nullptr == m_fpSVN_STRING_CREATE)
+	{
+		m_fpSVN_STRING_CREATE = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_STRING_CREATE method = (tfpSVN_STRING_CREATE)m_fpSVN_STRING_CREATE->Handle;
+	return method(cstring, pool);
+}
+
+svn_error_t*
+Svn_subr::SVN_STREAM_OPEN_READONLY(
+	svn_stream_t **stream, 
+	const char *path, 
+	apr_pool_t *result_pool, 
+	apr_pool_t *scratch_pool )
+{
+	if(nullptr == m_fpSVN_STREAM_OPEN_READONLY)
+	{
+		m_fpSVN_STREAM_OPEN_READONLY = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_STREAM_OPEN_READONLY method = (tfpSVN_STREAM_OPEN_READONLY)m_fpSVN_STREAM_OPEN_READONLY->Handle;
+	return method(stream, path, result_pool, scratch_pool);
+}
+
+void
+Svn_subr::SVN_ERROR_CLEAR(
+	svn_error_t *error )
+{
+	if(nullptr == m_fpSVN_ERROR_CLEAR)
+	{
+		m_fpSVN_ERROR_CLEAR = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_ERROR_CLEAR method = (tfpSVN_ERROR_CLEAR)m_fpSVN_ERROR_CLEAR->Handle;
+	method(error);
+}
+
+svn_error_t*
+Svn_subr::SVN_STREAM_READ(
+	svn_stream_t *stream, 
+	char *buffer, 
+	apr_size_t *len )
+{
+	if(nullptr == m_fpSVN_STREAM_READ)
+	{
+		m_fpSVN_STREAM_READ = LibraryLoader::Instance()->GetProcAddress(MethodInfo::GetCurrentMethod());
+	}
+
+	tfpSVN_STREAM_READ method = (tfpSVN_STREAM_READ)m_fpSVN_STREAM_READ->Handle;
+	return method(stream, buffer, len);
+}
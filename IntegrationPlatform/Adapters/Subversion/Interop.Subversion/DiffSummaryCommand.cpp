@@ -1,12 +1,17 @@
 #include "Stdafx.h"
+#include <svn_error_codes.h>
 #include "AprPool.h"
 #include "DI_LibApr.h"
 #include "DI_Svn_Client-1.h"
+#include "DI_Svn_Subr-1.h"
 #include "DiffSummaryCommand.h"
 #include "LibraryLoader.h"
 #include "SubversionContext.h"
 #include "SvnError.h"
+#include "Utils.h"
 
+using namespace System;
+using namespace System::Collections::Generic;
 using namespace System::Runtime::InteropServices;
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Commands;
@@ -38,6 +43,46 @@ DiffSummaryCommand::DiffSummaryCommand(SubversionContext^ context, Uri^ path1, l
 
 void 
 DiffSummaryCommand::AreEqual([Out] bool% result)
+{
+	m_modifiedItems = nullptr;
+	m_result = true; //Initialize as equal because the diff function will not be called on equality
+
+	try
+	{
+		Summarize();
+	}
+	catch(OperationCanceledException^)
+	{
+		//The receiver stops the diff as soon as the first difference is known. Any other cancellation is passed on
+		if(m_result)
+		{
+			throw;
+		}
+	}
+	finally
+	{
+		result = m_result;
+	}
+}
+
+void 
+DiffSummaryCommand::GetModifiedItems([Out] List<String^>^% items)
+{
+	m_modifiedItems = gcnew List<String^>();
+	m_result = true;
+
+	try
+	{
+		Summarize();
+	}
+	finally
+	{
+		items = m_modifiedItems;
+	}
+}
+
+void 
+DiffSummaryCommand::Summarize()
 {
 	svn_opt_revision_t revisionT1;
 	revisionT1.kind = svn_opt_revision_number;
@@ -52,14 +97,14 @@ DiffSummaryCommand::AreEqual([Out] bool% result)
 	GCHandle gch = GCHandle::Alloc(fp);
 	svn_client_diff_summarize_func_t receiver = static_cast<svn_client_diff_summarize_func_t>(Marshal::GetFunctionPointerForDelegate(fp).ToPointer());
 
+	//The batch summarizes a whole copy. Folders that have been created again instead of being copied are not related by ancestry
+	//but must not report every file below of them as added and deleted
 	try
 	{
-		m_result = true; //Initialize as equal because the diff function will not be called on equality
-		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_DIFF_SUMMARIZE(pool->CopyString(m_path1->AbsoluteUri), &revisionT1, pool->CopyString(m_path2->AbsoluteUri), &revisionT2, false, false, receiver, NULL, m_context->Handle, pool->Handle));
+		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_DIFF_SUMMARIZE(pool->CopyString(m_path1->AbsoluteUri), &revisionT1, pool->CopyString(m_path2->AbsoluteUri), &revisionT2, nullptr != m_modifiedItems, nullptr != m_modifiedItems, receiver, NULL, m_context->Handle, pool->Handle));
 	}
 	finally
 	{
-		result = m_result;
 		gch.Free();
 	}
 }
@@ -67,6 +112,19 @@ DiffSummaryCommand::AreEqual([Out] bool% result)
 svn_error_t*
 DiffSummaryCommand::SvnClientDiffSummarizeFuncT(const svn_client_diff_summarize_t *diff, void *baton, apr_pool_t *pool)
 {
-	m_result = svn_client_diff_summarize_kind_normal == diff->summarize_kind;
+	if(svn_client_diff_summarize_kind_normal == diff->summarize_kind)
+	{
+		return SVN_NO_ERROR;
+	}
+
+	m_result = false;
+	if(nullptr == m_modifiedItems)
+	{
+		//A single difference answers the comparison. There is no need to receive the summary of the remaining items
+		return Svn_subr::Instance()->SVN_ERROR_CREATE(SVN_ERR_CANCELLED, NULL, "The comparison has been cancelled");
+	}
+
+	//The path of the summary is relative to the second target and not escaped
+	m_modifiedItems->Add(Utils::Combine(m_path2->ToString(), Utils::ConvertUTF8ToString(diff->path)));
 	return SVN_NO_ERROR;
-}
\ No newline at end of file
+}
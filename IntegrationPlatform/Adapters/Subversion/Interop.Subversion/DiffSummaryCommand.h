@@ -36,6 +36,9 @@ namespace Microsoft
 								Helpers::SubversionContext^ m_context;
 
 								bool m_result;
+								List<System::String^>^ m_modifiedItems;
+
+								void Summarize();
 								svn_error_t* SvnClientDiffSummarizeFuncT(const svn_client_diff_summarize_t *diff, void *baton, apr_pool_t *pool);
 
 							public:
@@ -54,6 +57,12 @@ namespace Microsoft
 								/// </summary>
 								/// <param name="result">The result of the comparison</param>
 								void AreEqual([Out] bool% result);
+
+								/// <summary>
+								/// Compares two folders recursively in a single pass and collects every item that differs
+								/// </summary>
+								/// <param name="items">The full server paths below of <paramref name="path2"/> of all items that have been added, modified or deleted</param>
+								void GetModifiedItems([Out] List<System::String^>^% items);
 							};
 						}
 					}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <svn_types.h>
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace ObjectModel
+						{
+							/// <summary>
+							/// The fields of a directory entry that the server has to compute when items are listed.
+							/// The kind and the path of an item are always available
+							/// </summary>
+							[System::Flags]
+							public enum class DirentFields : System::UInt32
+							{
+								/// <summary>
+								/// The node kind of the item
+								/// </summary>
+								Kind = SVN_DIRENT_KIND,
+
+								/// <summary>
+								/// The length of a file
+								/// </summary>
+								Size = SVN_DIRENT_SIZE,
+
+								/// <summary>
+								/// Whether the item has properties
+								/// </summary>
+								HasProperties = SVN_DIRENT_HAS_PROPS,
+
+								/// <summary>
+								/// The last revision in which the item has been changed
+								/// </summary>
+								CreatedRevision = SVN_DIRENT_CREATED_REV,
+
+								/// <summary>
+								/// The time of the created revision
+								/// </summary>
+								Time = SVN_DIRENT_TIME,
+
+								/// <summary>
+								/// The author of the created revision
+								/// </summary>
+								LastAuthor = SVN_DIRENT_LAST_AUTHOR,
+
+								/// <summary>
+								/// All fields
+								/// </summary>
+								All = SVN_DIRENT_ALL
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -1,20 +1,32 @@
 #include "Stdafx.h"
+#include <svn_error_codes.h>
+#include <svn_props.h>
 #include "AprPool.h"
+#include "ContentDigest.h"
+#include "DI_LibApr.h"
 #include "DI_Svn_Client-1.h"
+#include "DI_Svn_Ra-1.h"
+#include "DI_Svn_Subr-1.h"
 #include "LibraryLoader.h"
 #include "SubversionContext.h"
 #include "DownloadCommand.h"
 #include "SvnError.h"
 
 using namespace System;
+using namespace System::IO;
 using namespace System::Runtime::InteropServices;
+using namespace System::Security::Cryptography;
 
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Commands;
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
 using namespace Microsoft::TeamFoundation::Migration::Toolkit;
 
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* SvnWriteFnTDelegate(void *baton, const char *data, apr_size_t *len);
+
 DownloadCommand::DownloadCommand(SubversionContext^ context, System::Uri^ fromPath, long revision, String^ toPath)
 {
 	if(nullptr == context)
@@ -51,6 +63,121 @@ DownloadCommand::Execute()
 	pegRevision.kind = svn_opt_revision_number;
 	pegRevision.value.number = (svn_revnum_t)m_revision;
 
+	//The export opens a session of its own in the pool. Releasing the pool closes the connection
+	AprPool^ pool = gcnew AprPool();
+	try
+	{
+		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_EXPORT4(&resultRevision, pool->CopyString(m_fromPath->AbsoluteUri), pool->CopyString(m_toPath), &pegRevision, &revision, TRUE, TRUE, svn_depth_empty, NULL, m_context->Handle, pool->Handle));
+	}
+	finally
+	{
+		delete pool;
+	}
+}
+
+void 
+DownloadCommand::Execute([Out] ContentDigest^% digest)
+{
+	digest = nullptr;
+
 	AprPool^ pool = gcnew AprPool();
-	SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_EXPORT4(&resultRevision, pool->CopyString(m_fromPath->AbsoluteUri), pool->CopyString(m_toPath), &pegRevision, &revision, TRUE, TRUE, svn_depth_empty, NULL, m_context->Handle, pool->Handle));
-}
\ No newline at end of file
+	SvnWriteFnTDelegate^ fp = gcnew SvnWriteFnTDelegate(this, &DownloadCommand::SvnWriteFnT);
+	GCHandle gch = GCHandle::Alloc(fp);
+	svn_write_fn_t writer = static_cast<svn_write_fn_t>(Marshal::GetFunctionPointerForDelegate(fp).ToPointer());
+
+	m_md5 = gcnew MD5CryptoServiceProvider();
+	m_sha1 = gcnew SHA1CryptoServiceProvider();
+	m_buffer = gcnew array<Byte>(64 * 1024);
+	m_length = 0;
+	m_error = nullptr;
+
+	bool translated = false;
+	try
+	{
+		m_file = gcnew FileStream(m_toPath, FileMode::Create, FileAccess::Write, FileShare::None, m_buffer->Length);
+		try
+		{
+			//The session is opened directly at the item and belongs to the pool
+			svn_ra_session_t* session = NULL;
+			SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_OPEN_RA_SESSION(&session, pool->CopyString(m_fromPath->AbsoluteUri), m_context->Handle, pool->Handle));
+
+			svn_stream_t* stream = Svn_subr::Instance()->SVN_STREAM_CREATE(NULL, pool->Handle);
+			Svn_subr::Instance()->SVN_STREAM_SET_WRITE(stream, writer);
+
+			//The RA layer compares the received text with the checksum that the repository stores for the file. A mismatch fails with SVN_ERR_CHECKSUM_MISMATCH
+			apr_hash_t* props = NULL;
+			SvnError::Err(Svn_Ra::Instance()->SVN_RA_GET_FILE(session, "", (svn_revnum_t)m_revision, stream, NULL, &props, pool->Handle));
+
+			//Export expands keywords and translates line endings. Such files differ from the repository content and have to be exported after all
+			LibApr^ libApr = LibApr::Instance();
+			translated = NULL != libApr->AprHashGet(props, SVN_PROP_EOL_STYLE, APR_HASH_KEY_STRING) || NULL != libApr->AprHashGet(props, SVN_PROP_KEYWORDS, APR_HASH_KEY_STRING);
+		}
+		finally
+		{
+			delete m_file;
+			m_file = nullptr;
+		}
+	}
+	catch(OperationCanceledException^)
+	{
+		File::Delete(m_toPath);
+		if(nullptr == m_error)
+		{
+			throw;
+		}
+
+		throw gcnew MigrationException(String::Format("The download of {0} failed", m_fromPath), m_error);
+	}
+	catch(Exception^)
+	{
+		//Do not leave a partial or corrupt file behind
+		File::Delete(m_toPath);
+		throw;
+	}
+	finally
+	{
+		gch.Free();
+
+		//The session belongs to the pool. Releasing the pool closes the connection before the next request acquires the context
+		delete pool;
+	}
+
+	if(translated)
+	{
+		Execute();
+		digest = ContentDigest::Compute(m_toPath);
+		return;
+	}
+
+	m_md5->TransformFinalBlock(m_buffer, 0, 0);
+	m_sha1->TransformFinalBlock(m_buffer, 0, 0);
+	digest = gcnew ContentDigest(m_md5->Hash, m_sha1->Hash, m_length, true);
+}
+
+svn_error_t* 
+DownloadCommand::SvnWriteFnT(void *baton, const char *data, apr_size_t *len)
+{
+	try
+	{
+		//The content passes through the buffer once. It is written and hashed in the same pass
+		for(apr_size_t offset = 0; offset < *len; )
+		{
+			int count = (int)Math::Min((apr_size_t)m_buffer->Length, *len - offset);
+			Marshal::Copy(IntPtr((void*)(data + offset)), m_buffer, 0, count);
+
+			m_file->Write(m_buffer, 0, count);
+			m_md5->TransformBlock(m_buffer, 0, count, nullptr, 0);
+			m_sha1->TransformBlock(m_buffer, 0, count, nullptr, 0);
+			offset += count;
+		}
+
+		m_length += *len;
+		return SVN_NO_ERROR;
+	}
+	catch(Exception^ e)
+	{
+		//No exception must pass the native frames of subversion. It is raised again when the transfer has been stopped
+		m_error = e;
+		return Svn_subr::Instance()->SVN_ERROR_CREATE(SVN_ERR_CANCELLED, NULL, "The download has been cancelled");
+	}
+}
@@ -3,7 +3,9 @@
 #include <svn_client.h>
 
 using namespace System::Collections::Generic;
+using namespace System::IO;
 using namespace System::Runtime::InteropServices;
+using namespace System::Security::Cryptography;
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
 
 namespace Microsoft
@@ -23,6 +25,11 @@ namespace Microsoft
 							ref class SubversionContext;
 						}
 
+						namespace ObjectModel
+						{
+							ref class ContentDigest;
+						}
+
 						namespace Commands
 						{
 							private ref class DownloadCommand
@@ -34,6 +41,15 @@ namespace Microsoft
 								long m_revision;
 								String^ m_toPath;
 
+								FileStream^ m_file;
+								HashAlgorithm^ m_md5;
+								HashAlgorithm^ m_sha1;
+								array<Byte>^ m_buffer;
+								long long m_length;
+								Exception^ m_error;
+
+								svn_error_t* SvnWriteFnT(void *baton, const char *data, apr_size_t *len);
+
 							public:
 								/// <summary>
 								/// Creates a new class that can be used to query the repository information
@@ -48,6 +64,14 @@ namespace Microsoft
 								/// Executes the command to retrieve the information from subversion
 								/// </summary>
 								void Execute();
+
+								/// <summary>
+								/// Downloads the item and computes its MD5 and SHA-1 hashes while the content is written to disk. 
+								/// The content is verified against the checksum of the repository during the transfer
+								/// </summary>
+								/// <param name="digest">The hashes of the downloaded file</param>
+								/// <exception cref="MigrationException">Will be thrown if the content does not match the checksum of the repository</exception>
+								void Execute([Out] ObjectModel::ContentDigest^% digest);
 							};
 						}
 					}
@@ -0,0 +1,1421 @@
+#include "Stdafx.h"
+#include "ChangeBatch.h"
+#include "ChangeSet.h"
+#include "ContentDigest.h"
+#include "DumpFileBackend.h"
+#include "DumpFileReader.h"
+#include "Item.h"
+#include "ItemInfo.h"
+#include "LocationSegment.h"
+#include "PathFilter.h"
+#include "RevisionFilter.h"
+#include "SubversionClient.h"
+#include "SvnDiffDecoder.h"
+#include "Utils.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Diagnostics;
+using namespace System::Globalization;
+using namespace System::IO;
+using namespace System::Text;
+
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Backends;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+//Converts the hexadecimal checksum of a dump header. Returns null if the header is missing or malformed
+static array<Byte>^ ParseChecksum(String^ value)
+{
+	if(nullptr == value || 0 != value->Length % 2)
+	{
+		return nullptr;
+	}
+
+	array<Byte>^ checksum = gcnew array<Byte>(value->Length / 2);
+	for(int i = 0; i < checksum->Length; i++)
+	{
+		if(!Byte::TryParse(value->Substring(2 * i, 2), NumberStyles::AllowHexSpecifier, CultureInfo::InvariantCulture, checksum[i]))
+		{
+			return nullptr;
+		}
+	}
+
+	return checksum;
+}
+
+static bool IsEqual(array<Byte>^ value1, array<Byte>^ value2)
+{
+	if(value1->Length != value2->Length)
+	{
+		return false;
+	}
+
+	for(int i = 0; i < value1->Length; i++)
+	{
+		if(value1[i] != value2[i])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//Gets the line ending that export writes for a value of svn:eol-style. Returns null if the line endings are kept
+static array<Byte>^ GetEndOfLine(String^ eolStyle, String^ path)
+{
+	if(nullptr == eolStyle)
+	{
+		return nullptr;
+	}
+
+	if(String::Equals(eolStyle, "native", StringComparison::Ordinal))
+	{
+		return Encoding::ASCII->GetBytes(Environment::NewLine);
+	}
+
+	if(String::Equals(eolStyle, "CRLF", StringComparison::Ordinal))
+	{
+		return gcnew array<Byte> { '\r', '\n' };
+	}
+
+	if(String::Equals(eolStyle, "LF", StringComparison::Ordinal))
+	{
+		return gcnew array<Byte> { '\n' };
+	}
+
+	if(String::Equals(eolStyle, "CR", StringComparison::Ordinal))
+	{
+		return gcnew array<Byte> { '\r' };
+	}
+
+	throw gcnew MigrationException(String::Format("The value '{0}' of svn:eol-style of {1} is not supported", eolStyle, path));
+}
+
+//Replaces every CRLF, LF and CR by the line ending. Returns whether the buffer ends with a CR whose LF may start the next buffer
+static bool TranslateEndOfLines(array<Byte>^ buffer, int count, bool carriageReturn, array<Byte>^ endOfLine, Stream^ target)
+{
+	int start = 0;
+	for(int i = 0; i < count; i++)
+	{
+		if('\r' == buffer[i])
+		{
+			target->Write(buffer, start, i - start);
+			target->Write(endOfLine, 0, endOfLine->Length);
+			start = i + 1;
+			carriageReturn = true;
+		}
+		else if('\n' == buffer[i])
+		{
+			target->Write(buffer, start, i - start);
+			if(!carriageReturn)
+			{
+				target->Write(endOfLine, 0, endOfLine->Length);
+			}
+
+			start = i + 1;
+			carriageReturn = false;
+		}
+		else
+		{
+			carriageReturn = false;
+		}
+	}
+
+	target->Write(buffer, start, count - start);
+	return carriageReturn;
+}
+
+//Collects the names of the keyword anchors that a value of svn:keywords expands. Unknown names are custom keywords
+static HashSet<String^>^ GetKeywordNames(String^ keywords)
+{
+	array<array<String^>^>^ aliases = gcnew array<array<String^>^>
+	{
+		gcnew array<String^> { "LastChangedDate", "Date" },
+		gcnew array<String^> { "LastChangedRevision", "Revision", "Rev" },
+		gcnew array<String^> { "LastChangedBy", "Author" },
+		gcnew array<String^> { "HeadURL", "URL" },
+		gcnew array<String^> { "Id" },
+		gcnew array<String^> { "Header" }
+	};
+
+	HashSet<String^>^ names = gcnew HashSet<String^>(StringComparer::Ordinal);
+	for each(String^ keyword in keywords->Split((array<wchar_t>^)nullptr, StringSplitOptions::RemoveEmptyEntries))
+	{
+		String^ name = keyword->Split('=')[0];
+		names->Add(name);
+
+		//The names of the property are matched without regard to case. The anchors in the text are not
+		for each(array<String^>^ group in aliases)
+		{
+			for each(String^ alias in group)
+			{
+				if(String::Equals(alias, name, StringComparison::OrdinalIgnoreCase))
+				{
+					names->UnionWith(group);
+					break;
+				}
+			}
+		}
+	}
+
+	return names;
+}
+
+static void ReadExactly(Stream^ source, array<Byte>^ buffer, int count)
+{
+	int offset = 0;
+	while(offset < count)
+	{
+		int read = source->Read(buffer, offset, count - offset);
+		if(read <= 0)
+		{
+			throw gcnew MigrationException("The text ends unexpectedly. The dump file has been changed since it has been indexed");
+		}
+
+		offset += read;
+	}
+}
+
+//Adds a path and all items below of it
+static void CollectAll(const TreeIndex::Node* node, String^ path, List<String^>^ paths)
+{
+	paths->Add(path);
+
+	for(std::map<std::string, std::shared_ptr<TreeIndex::Node> >::const_iterator child = node->children.begin(); child != node->children.end(); ++child)
+	{
+		CollectAll(child->second.get(), Utils::Combine(path, Utils::ConvertUTF8ToString(child->first.c_str())), paths);
+	}
+}
+
+DumpFileBackend::DumpFileBackend(String^ dumpFile, Uri^ repositoryRoot)
+{
+	if(String::IsNullOrEmpty(dumpFile))
+	{
+		throw gcnew ArgumentNullException("dumpFile");
+	}
+
+	m_dumpFile = dumpFile;
+	m_configuredRoot = repositoryRoot;
+	m_storeFile = nullptr;
+	m_repositoryId = Guid::Empty;
+
+	m_index = new TreeIndex();
+	m_firstRevision = 0;
+	m_revisions = gcnew List<DumpRevision^>();
+	m_contents = gcnew List<DumpContent>();
+	m_properties = gcnew List<DumpProperties>();
+	m_origins = gcnew Dictionary<String^, List<DumpOrigin>^>(StringComparer::Ordinal);
+	m_reconstructedTexts = 0;
+
+	Load();
+}
+
+DumpFileBackend::~DumpFileBackend()
+{
+	this->!DumpFileBackend();
+}
+
+DumpFileBackend::!DumpFileBackend()
+{
+	if(NULL != m_index)
+	{
+		delete m_index;
+		m_index = NULL;
+	}
+
+	if(nullptr != m_storeFile)
+	{
+		try
+		{
+			File::Delete(m_storeFile);
+		}
+		catch(IOException^)
+		{
+			//The file is located in the temporary directory. It is left behind if it is still in use
+		}
+
+		m_storeFile = nullptr;
+	}
+}
+
+long
+DumpFileBackend::FirstRevision::get()
+{
+	return m_firstRevision;
+}
+
+long
+DumpFileBackend::LatestRevision::get()
+{
+	return m_firstRevision + m_revisions->Count - 1;
+}
+
+void
+DumpFileBackend::Load()
+{
+	Stopwatch^ watch = Stopwatch::StartNew();
+
+	FileStream^ dump = OpenDump();
+	FileStream^ bases = nullptr;
+	FileStream^ store = nullptr;
+	FileStream^ storedBases = nullptr;
+	try
+	{
+		DumpFileReader^ reader = gcnew DumpFileReader(dump);
+
+		long revision = -1;
+		std::string author;
+		while(reader->Read())
+		{
+			if(reader->IsNode)
+			{
+				if(revision < 0)
+				{
+					throw gcnew MigrationException(String::Format("The dump file '{0}' contains a node before the first revision", m_dumpFile));
+				}
+
+				ApplyNode(reader, revision, author, bases, store, storedBases);
+				continue;
+			}
+
+			if(revision >= 0)
+			{
+				m_index->Commit();
+			}
+
+			revision = ParseRevision(reader->GetHeader("Revision-number"));
+			if(0 == m_revisions->Count)
+			{
+				m_firstRevision = revision;
+			}
+			else if(revision != LatestRevision + 1)
+			{
+				throw gcnew MigrationException(String::Format("The dump file '{0}' continues with revision {1} after revision {2}", m_dumpFile, revision, LatestRevision));
+			}
+
+			Dictionary<String^, String^>^ properties = reader->ReadProperties();
+			String^ value;
+			DumpRevision^ info = gcnew DumpRevision();
+			info->Offset = reader->Offset;
+			info->Author = properties->TryGetValue("svn:author", value) ? value : nullptr;
+			info->Comment = properties->TryGetValue("svn:log", value) ? value : nullptr;
+			info->Date = properties->TryGetValue("svn:date", value) ? value : nullptr;
+
+			DateTime commitTime;
+			if(nullptr != info->Date && !DateTime::TryParse(info->Date, commitTime))
+			{
+				TraceManager::TraceError("Fail to parse commitTime '{0}' for revision '{1}'", info->Date, revision);
+			}
+
+			info->CommitTime = commitTime;
+
+			m_revisions->Add(info);
+			author = nullptr == info->Author ? std::string() : Utils::ConvertStringToUTF8(info->Author);
+
+			m_index->Begin(revision);
+		}
+
+		if(revision >= 0)
+		{
+			m_index->Commit();
+		}
+
+		if(nullptr != reader->Uuid)
+		{
+			m_repositoryId = Guid(reader->Uuid);
+		}
+	}
+	catch(Exception^)
+	{
+		m_index->Abort();
+		throw;
+	}
+	finally
+	{
+		delete dump;
+
+		if(nullptr != bases)
+		{
+			delete bases;
+		}
+
+		if(nullptr != storedBases)
+		{
+			delete storedBases;
+		}
+
+		if(nullptr != store)
+		{
+			delete store;
+		}
+	}
+
+	if(0 == m_revisions->Count)
+	{
+		throw gcnew MigrationException(String::Format("The dump file '{0}' does not contain any revision", m_dumpFile));
+	}
+
+	TraceManager::TraceInformation("Indexed the revisions {0} to {1} of the dump file '{2}' in {3}. {4} of {5} texts have been reconstructed from deltas",
+		m_firstRevision, LatestRevision, m_dumpFile, watch->Elapsed, m_reconstructedTexts, m_contents->Count);
+}
+
+void
+DumpFileBackend::ApplyNode(DumpFileReader^ reader, long revision, const std::string& author, FileStream^% bases, FileStream^% store, FileStream^% storedBases)
+{
+	String^ nodePath = reader->GetHeader("Node-path");
+	String^ action = reader->GetHeader("Node-action");
+	std::string path = ToRelativePath(nodePath);
+
+	//The text of a changed file is the base of its delta. The change itself resets the size
+	long long content = -1;
+	long long size = 0;
+
+	if(String::Equals(action, "change"))
+	{
+		const TreeIndex::Node* node = m_index->FindCurrent(path);
+		if(NULL == node)
+		{
+			throw gcnew MigrationException(String::Format("The dump file does not contain '{0}' which has been changed in revision {1}. Incremental dumps are not supported", nodePath, revision));
+		}
+
+		content = node->content;
+		size = node->size;
+		m_index->Modify(path, author);
+	}
+	else if(String::Equals(action, "delete") || String::Equals(action, "replace"))
+	{
+		if(!m_index->Delete(path))
+		{
+			throw gcnew MigrationException(String::Format("The dump file does not contain '{0}' which has been deleted in revision {1}. Incremental dumps are not supported", nodePath, revision));
+		}
+	}
+	else if(!String::Equals(action, "add"))
+	{
+		throw gcnew MigrationException(String::Format("The dump file contains the unknown action '{0}' for '{1}' in revision {2}", action, nodePath, revision));
+	}
+
+	if(String::Equals(action, "delete"))
+	{
+		return;
+	}
+
+	if(String::Equals(action, "add") || String::Equals(action, "replace"))
+	{
+		DumpOrigin origin;
+		origin.Revision = revision;
+		origin.CopyFromPath = nullptr;
+		origin.CopyFromRevision = -1;
+
+		String^ copyFromPath = reader->GetHeader("Node-copyfrom-path");
+		if(nullptr != copyFromPath)
+		{
+			origin.CopyFromPath = Utils::ConvertUTF8ToString(ToRelativePath(copyFromPath).c_str());
+			origin.CopyFromRevision = ParseRevision(reader->GetHeader("Node-copyfrom-rev"));
+
+			if(!m_index->Copy(path, ToRelativePath(copyFromPath), origin.CopyFromRevision, author))
+			{
+				throw gcnew MigrationException(String::Format("The dump file does not contain '{0}' in revision {1} which has been copied to '{2}' in revision {3}. Incremental dumps are not supported",
+					copyFromPath, origin.CopyFromRevision, nodePath, revision));
+			}
+
+			//A copied file keeps the text of its source until the node replaces it
+			const TreeIndex::Node* node = m_index->FindCurrent(path);
+			content = node->content;
+			size = node->size;
+		}
+		else
+		{
+			m_index->Add(path, String::Equals(reader->GetHeader("Node-kind"), "dir"), author);
+		}
+
+		String^ key = Utils::ConvertUTF8ToString(path.c_str());
+		List<DumpOrigin>^ origins;
+		if(!m_origins->TryGetValue(key, origins))
+		{
+			origins = gcnew List<DumpOrigin>(1);
+			m_origins->Add(key, origins);
+		}
+
+		origins->Add(origin);
+	}
+
+	const TreeIndex::Node* node = m_index->FindCurrent(path);
+	if(node->directory)
+	{
+		return;
+	}
+
+	//A node without a property block keeps its properties. A delta changes the properties of the node or of its copy source
+	if(nullptr != reader->GetHeader("Prop-content-length"))
+	{
+		String^ eolStyleName = gcnew String(SVN_PROP_EOL_STYLE);
+		String^ keywordsName = gcnew String(SVN_PROP_KEYWORDS);
+
+		Dictionary<String^, String^>^ nodeProperties = gcnew Dictionary<String^, String^>(StringComparer::Ordinal);
+		if(String::Equals(reader->GetHeader("Prop-delta"), "true") && node->properties >= 0)
+		{
+			DumpProperties current = m_properties[(int)node->properties];
+			if(nullptr != current.EolStyle)
+			{
+				nodeProperties[eolStyleName] = current.EolStyle;
+			}
+
+			if(nullptr != current.Keywords)
+			{
+				nodeProperties[keywordsName] = current.Keywords;
+			}
+		}
+
+		reader->ReadProperties(nodeProperties);
+
+		String^ eolStyle;
+		String^ keywords;
+		nodeProperties->TryGetValue(eolStyleName, eolStyle);
+		nodeProperties->TryGetValue(keywordsName, keywords);
+
+		long long properties = -1;
+		if(nullptr != eolStyle || nullptr != keywords)
+		{
+			DumpProperties tracked;
+			tracked.EolStyle = eolStyle;
+			tracked.Keywords = keywords;
+			m_properties->Add(tracked);
+			properties = m_properties->Count - 1;
+		}
+
+		m_index->SetProperties(path, properties);
+	}
+
+	if(reader->HasText)
+	{
+		DumpContent text;
+		text.MD5 = ParseChecksum(reader->GetHeader("Text-content-md5"));
+
+		if(String::Equals(reader->GetHeader("Text-delta"), "true"))
+		{
+			if(nullptr == store)
+			{
+				m_storeFile = Path::Combine(Path::GetTempPath(), Path::GetRandomFileName());
+				store = gcnew FileStream(m_storeFile, FileMode::CreateNew, FileAccess::Write, FileShare::Read, BufferSize);
+				storedBases = gcnew FileStream(m_storeFile, FileMode::Open, FileAccess::Read, FileShare::ReadWrite, BufferSize);
+			}
+
+			//The delta is computed against the previous text of the node or the text of its copy source
+			Stream^ source = nullptr;
+			long long sourceOffset = 0;
+			long long sourceLength = 0;
+			if(content >= 0)
+			{
+				DumpContent base = m_contents[(int)content];
+				if(base.Stored)
+				{
+					store->Flush();
+					source = storedBases;
+				}
+				else
+				{
+					if(nullptr == bases)
+					{
+						bases = OpenDump();
+					}
+
+					source = bases;
+				}
+
+				sourceOffset = base.Offset;
+				sourceLength = base.Length;
+			}
+
+			reader->BaseStream->Seek(reader->TextOffset, SeekOrigin::Begin);
+			SvnDiffDecoder^ decoder = gcnew SvnDiffDecoder(reader->BaseStream, reader->TextLength);
+
+			text.Stored = true;
+			text.Offset = store->Position;
+			text.Length = decoder->Apply(source, sourceOffset, sourceLength, store);
+			m_reconstructedTexts++;
+		}
+		else
+		{
+			text.Stored = false;
+			text.Offset = reader->TextOffset;
+			text.Length = reader->TextLength;
+		}
+
+		m_contents->Add(text);
+		content = m_contents->Count - 1;
+		size = text.Length;
+	}
+
+	m_index->SetContent(path, content, size);
+}
+
+void
+DumpFileBackend::ReadChanges(DumpFileReader^ reader, long revision, std::vector<ChangeBuffer::Record>& changes)
+{
+	//The first record is the revision itself. The nodes follow up to the next revision
+	reader->Seek(m_revisions[revision - m_firstRevision]->Offset);
+	reader->Read();
+
+	std::map<std::string, size_t> positions;
+	while(reader->Read() && reader->IsNode)
+	{
+		String^ action = reader->GetHeader("Node-action");
+		String^ kind = reader->GetHeader("Node-kind");
+
+		ChangeBuffer::Record record;
+		record.path = ToRelativePath(reader->GetHeader("Node-path"));
+		record.action = String::Equals(action, "add") ? 'A' : String::Equals(action, "delete") ? 'D' : String::Equals(action, "replace") ? 'R' : 'M';
+		record.textModified = reader->HasText ? 1 : 0;
+		record.propsModified = reader->HasProperties ? 1 : 0;
+		record.copyFromRevision = -1;
+
+		String^ copyFromPath = reader->GetHeader("Node-copyfrom-path");
+		if(nullptr != copyFromPath)
+		{
+			record.copyFromPath = ToRelativePath(copyFromPath);
+			record.copyFromRevision = ParseRevision(reader->GetHeader("Node-copyfrom-rev"));
+		}
+
+		if(String::Equals(kind, "dir"))
+		{
+			record.nodeKind = svn_node_dir;
+		}
+		else if(String::Equals(kind, "file"))
+		{
+			record.nodeKind = svn_node_file;
+		}
+		else
+		{
+			//Deletions do not state the kind. It is taken from the previous revision
+			const TreeIndex::Node* node = m_index->Find(record.path, revision - 1);
+			record.nodeKind = NULL == node ? svn_node_unknown : node->directory ? svn_node_dir : svn_node_file;
+		}
+
+		//Older dumps write a replacement as a deletion followed by an addition. The log reports a single change per path
+		std::map<std::string, size_t>::iterator position = positions.find(record.path);
+		if(position == positions.end())
+		{
+			positions[record.path] = changes.size();
+			changes.push_back(record);
+		}
+		else if('D' == changes[position->second].action && 'D' != record.action)
+		{
+			record.action = 'R';
+			changes[position->second] = record;
+		}
+		else
+		{
+			ChangeBuffer::Record& existing = changes[position->second];
+			existing.textModified = Math::Max(existing.textModified, record.textModified);
+			existing.propsModified = Math::Max(existing.propsModified, record.propsModified);
+		}
+	}
+}
+
+bool
+DumpFileBackend::Affects(const std::vector<ChangeBuffer::Record>& changes, const std::string& scope)
+{
+	//The log of the root lists every revision
+	if("/" == scope)
+	{
+		return true;
+	}
+
+	for(std::vector<ChangeBuffer::Record>::const_iterator change = changes.begin(); change != changes.end(); ++change)
+	{
+		const std::string& path = change->path;
+		if(path == scope || (path.length() < scope.length() && 0 == scope.compare(0, path.length(), path) && '/' == scope[path.length()] && 'M' != change->action))
+		{
+			//The item itself or one of its parents has been added, deleted or replaced
+			return true;
+		}
+
+		if(path.length() > scope.length() && 0 == path.compare(0, scope.length(), scope) && '/' == path[scope.length()])
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool
+DumpFileBackend::FindOrigin(String^ path, long revision, DumpOrigin% origin, [Out] String^% originPath)
+{
+	//The youngest addition of the path or of one of its parents created the node that lives at the path.
+	//If a parent and the path itself have been added in the same revision, the path wins
+	bool found = false;
+	originPath = nullptr;
+
+	String^ candidate = path;
+	while(true)
+	{
+		List<DumpOrigin>^ origins;
+		if(m_origins->TryGetValue(candidate, origins))
+		{
+			for(int i = origins->Count - 1; i >= 0; i--)
+			{
+				if(origins[i].Revision <= revision)
+				{
+					if(!found || origins[i].Revision > origin.Revision)
+					{
+						origin = origins[i];
+						originPath = candidate;
+						found = true;
+					}
+
+					break;
+				}
+			}
+		}
+
+		int separator = candidate->LastIndexOf('/');
+		if(separator <= 0)
+		{
+			return found;
+		}
+
+		candidate = candidate->Substring(0, separator);
+	}
+}
+
+void
+DumpFileBackend::EnsureOpen()
+{
+	if(nullptr == m_client)
+	{
+		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
+	}
+}
+
+long
+DumpFileBackend::ResolveRevision(long revision)
+{
+	if(revision < 0)
+	{
+		return LatestRevision;
+	}
+
+	if(revision > LatestRevision)
+	{
+		throw gcnew MigrationException(String::Format("The revision {0} is not part of the dump file '{1}'. The latest revision is {2}", revision, m_dumpFile, LatestRevision));
+	}
+
+	return revision;
+}
+
+FileStream^
+DumpFileBackend::OpenDump()
+{
+	return gcnew FileStream(m_dumpFile, FileMode::Open, FileAccess::Read, FileShare::Read, BufferSize);
+}
+
+FileStream^
+DumpFileBackend::OpenText(DumpContent text)
+{
+	FileStream^ stream = gcnew FileStream(text.Stored ? m_storeFile : m_dumpFile, FileMode::Open, FileAccess::Read, FileShare::Read, BufferSize);
+	stream->Seek(text.Offset, SeekOrigin::Begin);
+	return stream;
+}
+
+std::string
+DumpFileBackend::ToRelativePath(String^ path)
+{
+	//The dump stores the paths without a leading slash. They are stored the same way subversion reports them in the log
+	return Utils::ConvertStringToUTF8(String::Concat(Utils::Seperator, path->Trim(Utils::SeperatorCharArray)));
+}
+
+long
+DumpFileBackend::ParseRevision(String^ value)
+{
+	int revision;
+	if(nullptr == value || !Int32::TryParse(value, NumberStyles::None, CultureInfo::InvariantCulture, revision))
+	{
+		throw gcnew MigrationException(String::Format("The dump file contains the invalid revision number '{0}'", value));
+	}
+
+	return revision;
+}
+
+String^
+DumpFileBackend::ToFullServerPath(const std::string& path)
+{
+	return Utils::Combine(m_repositoryRoot, Utils::ConvertUTF8ToString(path.c_str()));
+}
+
+Item^
+DumpFileBackend::ToItem(const std::string& path, const TreeIndex::Node* node)
+{
+	return gcnew Item(
+		ToFullServerPath(path),
+		node->directory ? WellKnownContentType::VersionControlledFolder : WellKnownContentType::VersionControlledFile,
+		node->size,
+		node->createdRevision,
+		node->lastAuthor.empty() ? nullptr : Utils::ConvertUTF8ToString(node->lastAuthor.c_str()),
+		m_itemRoot);
+}
+
+const TreeIndex::Node*
+DumpFileBackend::Find(Uri^ path, long revision)
+{
+	const TreeIndex::Node* node = m_index->Find(ToRelativePath(Utils::ExtractPath(m_repositoryRoot, path->ToString())), ResolveRevision(revision));
+	if(NULL == node)
+	{
+		throw gcnew MigrationException(String::Format("The path '{0}' does not exist in revision {1} of the dump file", path, revision));
+	}
+
+	return node;
+}
+
+void
+DumpFileBackend::WriteContent(const TreeIndex::Node* node, String^ path, String^ toPath)
+{
+	//Export translates the line endings and expands the keywords. Keywords are not expanded here, so such texts cannot be written
+	array<Byte>^ endOfLine = nullptr;
+	if(node->properties >= 0 && node->content >= 0)
+	{
+		DumpProperties properties = m_properties[(int)node->properties];
+		endOfLine = GetEndOfLine(properties.EolStyle, path);
+
+		if(nullptr != properties.Keywords && ContainsKeywords(m_contents[(int)node->content], properties.Keywords))
+		{
+			throw gcnew MigrationException(String::Format("The expansion of svn:keywords is not supported by dump files. The text of {0} contains one of the keywords '{1}'", path, properties.Keywords));
+		}
+	}
+
+	FileStream^ target = gcnew FileStream(toPath, FileMode::Create, FileAccess::Write, FileShare::None, BufferSize);
+	try
+	{
+		//Files without a text are empty
+		if(node->content < 0)
+		{
+			return;
+		}
+
+		DumpContent text = m_contents[(int)node->content];
+		FileStream^ source = OpenText(text);
+		try
+		{
+			array<Byte>^ buffer = gcnew array<Byte>(BufferSize);
+			long long remaining = text.Length;
+			bool carriageReturn = false;
+			while(remaining > 0)
+			{
+				int count = (int)Math::Min((long long)buffer->Length, remaining);
+				ReadExactly(source, buffer, count);
+
+				if(nullptr == endOfLine)
+				{
+					target->Write(buffer, 0, count);
+				}
+				else
+				{
+					carriageReturn = TranslateEndOfLines(buffer, count, carriageReturn, endOfLine, target);
+				}
+
+				remaining -= count;
+			}
+		}
+		finally
+		{
+			delete source;
+		}
+	}
+	finally
+	{
+		delete target;
+	}
+}
+
+bool
+DumpFileBackend::ContainsKeywords(DumpContent text, String^ keywords)
+{
+	HashSet<String^>^ names = GetKeywordNames(keywords);
+
+	//An anchor is a keyword between '$' and either '$' or ':'. The keyword must not span lines
+	FileStream^ source = OpenText(text);
+	try
+	{
+		array<Byte>^ buffer = gcnew array<Byte>(BufferSize);
+		StringBuilder^ name = nullptr;
+		long long remaining = text.Length;
+		while(remaining > 0)
+		{
+			int count = (int)Math::Min((long long)buffer->Length, remaining);
+			ReadExactly(source, buffer, count);
+
+			for(int i = 0; i < count; i++)
+			{
+				Byte value = buffer[i];
+				if('$' == value || ':' == value)
+				{
+					if(nullptr != name && names->Contains(name->ToString()))
+					{
+						return true;
+					}
+
+					name = ('$' == value) ? gcnew StringBuilder() : nullptr;
+				}
+				else if(nullptr != name)
+				{
+					if('\r' == value || '\n' == value || SVN_KEYWORD_MAX_LEN <= name->Length)
+					{
+						name = nullptr;
+					}
+					else
+					{
+						name->Append((wchar_t)value);
+					}
+				}
+			}
+
+			remaining -= count;
+		}
+	}
+	finally
+	{
+		delete source;
+	}
+
+	return false;
+}
+
+bool
+DumpFileBackend::HasSameContent(const TreeIndex::Node* node1, const TreeIndex::Node* node2)
+{
+	if(node1->content == node2->content)
+	{
+		return true;
+	}
+
+	long long length1 = node1->content < 0 ? 0 : m_contents[(int)node1->content].Length;
+	long long length2 = node2->content < 0 ? 0 : m_contents[(int)node2->content].Length;
+	if(length1 != length2)
+	{
+		return false;
+	}
+
+	if(0 == length1)
+	{
+		return true;
+	}
+
+	DumpContent text1 = m_contents[(int)node1->content];
+	DumpContent text2 = m_contents[(int)node2->content];
+	if(nullptr != text1.MD5 && nullptr != text2.MD5)
+	{
+		return IsEqual(text1.MD5, text2.MD5);
+	}
+
+	//A text without a checksum is compared byte by byte
+	FileStream^ source1 = OpenText(text1);
+	FileStream^ source2 = OpenText(text2);
+	try
+	{
+		array<Byte>^ buffer1 = gcnew array<Byte>(BufferSize);
+		array<Byte>^ buffer2 = gcnew array<Byte>(BufferSize);
+		long long remaining = length1;
+		while(remaining > 0)
+		{
+			int count = (int)Math::Min((long long)BufferSize, remaining);
+			ReadExactly(source1, buffer1, count);
+			ReadExactly(source2, buffer2, count);
+
+			for(int i = 0; i < count; i++)
+			{
+				if(buffer1[i] != buffer2[i])
+				{
+					return false;
+				}
+			}
+
+			remaining -= count;
+		}
+	}
+	finally
+	{
+		delete source1;
+		delete source2;
+	}
+
+	return true;
+}
+
+bool
+DumpFileBackend::Compare(const TreeIndex::Node* node1, const TreeIndex::Node* node2, String^ path, List<String^>^ differences)
+{
+	//Unchanged subtrees are shared between the snapshots
+	if(node1 == node2)
+	{
+		return true;
+	}
+
+	if(node1->directory != node2->directory || (!node2->directory && !HasSameContent(node1, node2)))
+	{
+		if(nullptr != differences)
+		{
+			differences->Add(path);
+		}
+
+		return false;
+	}
+
+	bool equal = true;
+
+	std::map<std::string, std::shared_ptr<TreeIndex::Node> >::const_iterator child1 = node1->children.begin();
+	std::map<std::string, std::shared_ptr<TreeIndex::Node> >::const_iterator child2 = node2->children.begin();
+	while(child1 != node1->children.end() || child2 != node2->children.end())
+	{
+		int order = child1 == node1->children.end() ? 1 : child2 == node2->children.end() ? -1 : child1->first.compare(child2->first);
+		if(0 == order)
+		{
+			equal = Compare(child1->second.get(), child2->second.get(), Utils::Combine(path, Utils::ConvertUTF8ToString(child1->first.c_str())), differences) && equal;
+			++child1;
+			++child2;
+		}
+		else
+		{
+			equal = false;
+			if(nullptr == differences)
+			{
+				return false;
+			}
+
+			if(order < 0)
+			{
+				differences->Add(Utils::Combine(path, Utils::ConvertUTF8ToString(child1->first.c_str())));
+				++child1;
+			}
+			else
+			{
+				//An added folder is reported with all items below of it
+				CollectAll(child2->second.get(), Utils::Combine(path, Utils::ConvertUTF8ToString(child2->first.c_str())), differences);
+				++child2;
+			}
+		}
+
+		if(!equal && nullptr == differences)
+		{
+			return false;
+		}
+	}
+
+	return equal;
+}
+
+void
+DumpFileBackend::AddSegment(List<LocationSegment^>^ segments, long first, long last, String^ fullServerPath, long startRevision, long endRevision)
+{
+	first = Math::Max(first, endRevision);
+	last = Math::Min(last, startRevision);
+
+	if(first <= last)
+	{
+		segments->Add(gcnew LocationSegment(first, last, fullServerPath));
+	}
+}
+
+void
+DumpFileBackend::Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId)
+{
+	if(nullptr == client)
+	{
+		throw gcnew ArgumentNullException("client");
+	}
+
+	if(nullptr == repository)
+	{
+		throw gcnew ArgumentNullException("repository");
+	}
+
+	String^ root = (nullptr == m_configuredRoot ? repository : m_configuredRoot)->ToString()->TrimEnd(Utils::SeperatorCharArray);
+	String^ path = repository->ToString()->TrimEnd(Utils::SeperatorCharArray);
+	if(!String::Equals(path, root, StringComparison::OrdinalIgnoreCase) && !path->StartsWith(String::Concat(root, Utils::Seperator), StringComparison::OrdinalIgnoreCase))
+	{
+		throw gcnew MigrationException(String::Format("The repository '{0}' is not located below the root '{1}' of the dump file", repository, root));
+	}
+
+	m_client = client;
+	m_repositoryRoot = root;
+	m_itemRoot = client->VirtualRepositoryRoot->ToString();
+
+	repositoryRoot = gcnew Uri(root);
+	repositoryId = m_repositoryId;
+
+	TraceManager::TraceInformation("Serving '{0}' from the revisions {1} to {2} of the dump file '{3}'", repository, m_firstRevision, LatestRevision, m_dumpFile);
+}
+
+void
+DumpFileBackend::Close()
+{
+	m_client = nullptr;
+}
+
+long
+DumpFileBackend::GetLatestRevisionNumber(Uri^ path)
+{
+	//This is the youngest revision that changed the path like the single entry log of the live backend
+	for each(long revision in QueryHistory(path, -1, -1, -1, 1, false, nullptr, nullptr)->Keys)
+	{
+		return revision;
+	}
+
+	return m_firstRevision;
+}
+
+Dictionary<long, ChangeSet^>^
+DumpFileBackend::QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, PathFilter^ pathFilter, RevisionFilter^ revisionFilter)
+{
+	EnsureOpen();
+
+	if(nullptr == path)
+	{
+		throw gcnew ArgumentNullException("path");
+	}
+
+	//The defaults of svn_client_log: the range starts at the peg revision and ends at revision 0. A single start revision is a range of its own
+	long pegRevision = ResolveRevision(pegRevisionNumber);
+	long startRevision;
+	long endRevision;
+	if(startRevisionNumber >= 0)
+	{
+		startRevision = ResolveRevision(startRevisionNumber);
+		endRevision = endRevisionNumber >= 0 ? ResolveRevision(endRevisionNumber) : startRevision;
+	}
+	else
+	{
+		startRevision = pegRevision;
+		endRevision = endRevisionNumber >= 0 ? ResolveRevision(endRevisionNumber) : 0;
+	}
+
+	//The history follows the item across copies like the log of the live backend does
+	long youngestRevision = Math::Min(pegRevision, Math::Max(startRevision, endRevision));
+	List<LocationSegment^>^ segments = GetLocationSegments(path, pegRevision, youngestRevision, Math::Min(startRevision, endRevision));
+
+	Dictionary<long, ChangeSet^>^ changesets = gcnew Dictionary<long, ChangeSet^>();
+
+	FileStream^ stream = OpenDump();
+	try
+	{
+		DumpFileReader^ reader = gcnew DumpFileReader(stream);
+		int step = startRevision >= endRevision ? -1 : 1;
+		int count = 0;
+
+		for(long revision = startRevision; ; revision += step)
+		{
+			String^ scope = nullptr;
+			for each(LocationSegment^ segment in segments)
+			{
+				if(segment->RangeStart <= revision && revision <= segment->RangeEnd)
+				{
+					scope = segment->FullServerPath;
+					break;
+				}
+			}
+
+			if(nullptr != scope && revision >= m_firstRevision)
+			{
+				//The nodes are only read if they are needed. The log of the root lists every revision anyway
+				std::string relativeScope = ToRelativePath(Utils::ExtractPath(m_repositoryRoot, scope));
+				std::vector<ChangeBuffer::Record> changes;
+				if(includeChanges || "/" != relativeScope)
+				{
+					ReadChanges(reader, revision, changes);
+				}
+
+				if(Affects(changes, relativeScope))
+				{
+					DumpRevision^ info = m_revisions[revision - m_firstRevision];
+
+					bool matches = true;
+					if(nullptr != revisionFilter)
+					{
+						std::string comment = nullptr == info->Comment ? std::string() : Utils::ConvertStringToUTF8(info->Comment);
+						std::string author = nullptr == info->Author ? std::string() : Utils::ConvertStringToUTF8(info->Author);
+						std::string date = nullptr == info->Date ? std::string() : Utils::ConvertStringToUTF8(info->Date);
+						matches = revisionFilter->Matches(
+							nullptr == info->Comment ? NULL : comment.c_str(),
+							nullptr == info->Author ? NULL : author.c_str(),
+							nullptr == info->Date ? NULL : date.c_str());
+					}
+
+					if(matches)
+					{
+						ChangeSet^ changeset = gcnew ChangeSet(m_client, revision, info->Author, info->Comment, info->CommitTime);
+						if(includeChanges)
+						{
+							ChangeBatchBuilder^ builder = gcnew ChangeBatchBuilder(changeset, (int)changes.size());
+							try
+							{
+								for(std::vector<ChangeBuffer::Record>::const_iterator change = changes.begin(); change != changes.end(); ++change)
+								{
+									if(nullptr == pathFilter || pathFilter->Includes(change->path.c_str()))
+									{
+										builder->Add(*change);
+									}
+								}
+
+								changeset->SetChanges(builder->ToBatch());
+							}
+							finally
+							{
+								delete builder;
+							}
+						}
+
+						changesets->Add(revision, changeset);
+					}
+
+					//The limit counts the revisions that have been rejected by the filter as the log receiver does
+					count++;
+					if(limit > 0 && count >= limit)
+					{
+						break;
+					}
+				}
+			}
+
+			if(revision == endRevision)
+			{
+				break;
+			}
+		}
+	}
+	finally
+	{
+		delete stream;
+	}
+
+	return changesets;
+}
+
+List<ItemInfo^>^
+DumpFileBackend::QueryItemInfo(Uri^ path, long revision, Depth depth)
+{
+	EnsureOpen();
+
+	revision = ResolveRevision(revision);
+
+	std::vector<TreeIndex::Entry> entries;
+	if(!m_index->List(ToRelativePath(Utils::ExtractPath(m_repositoryRoot, path->ToString())), revision, (int)depth, entries))
+	{
+		throw gcnew MigrationException(String::Format("The path '{0}' does not exist in revision {1} of the dump file", path, revision));
+	}
+
+	Uri^ repositoryRoot = gcnew Uri(m_repositoryRoot);
+	List<ItemInfo^>^ items = gcnew List<ItemInfo^>((int)entries.size());
+	for(std::vector<TreeIndex::Entry>::const_iterator entry = entries.begin(); entry != entries.end(); ++entry)
+	{
+		items->Add(gcnew ItemInfo(
+			gcnew Uri(ToFullServerPath(entry->path)),
+			repositoryRoot,
+			revision,
+			entry->node->directory ? WellKnownContentType::VersionControlledFolder : WellKnownContentType::VersionControlledFile));
+	}
+
+	return items;
+}
+
+void
+DumpFileBackend::DownloadItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	EnsureOpen();
+
+	const TreeIndex::Node* node = Find(fromPath, revision);
+	if(node->directory)
+	{
+		throw gcnew MigrationException(String::Format("The path '{0}' is a folder in revision {1} of the dump file", fromPath, revision));
+	}
+
+	WriteContent(node, fromPath->ToString(), toPath);
+}
+
+ContentDigest^
+DumpFileBackend::DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	EnsureOpen();
+
+	const TreeIndex::Node* node = Find(fromPath, revision);
+	if(node->directory)
+	{
+		throw gcnew MigrationException(String::Format("The path '{0}' is a folder in revision {1} of the dump file", fromPath, revision));
+	}
+
+	WriteContent(node, fromPath->ToString(), toPath);
+	ContentDigest^ digest = ContentDigest::Compute(toPath);
+
+	//The dump stores the MD5 checksum of every text. Reconstructed texts are verified against it as well.
+	//Translated texts differ from the checksum like they do when they are exported
+	array<Byte>^ checksum = (node->content < 0 || node->properties >= 0) ? nullptr : m_contents[(int)node->content].MD5;
+	if(nullptr == checksum)
+	{
+		return digest;
+	}
+
+	if(!IsEqual(checksum, digest->MD5))
+	{
+		throw gcnew MigrationException(String::Format("The text of {0} in revision {1} does not match the checksum of the dump file", fromPath, revision));
+	}
+
+	return gcnew ContentDigest(digest->MD5, digest->SHA1, digest->Length, true);
+}
+
+bool
+DumpFileBackend::AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	EnsureOpen();
+
+	return Compare(Find(path1, revision1), Find(path2, revision2), path2->ToString()->TrimEnd(Utils::SeperatorCharArray), nullptr);
+}
+
+List<String^>^
+DumpFileBackend::GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	EnsureOpen();
+
+	List<String^>^ items = gcnew List<String^>();
+	Compare(Find(path1, revision1), Find(path2, revision2), path2->ToString()->TrimEnd(Utils::SeperatorCharArray), items);
+	return items;
+}
+
+List<Item^>^
+DumpFileBackend::ExportTree(Uri^ root, long revision, String^ localRoot, PathFilter^ filter)
+{
+	EnsureOpen();
+
+	revision = ResolveRevision(revision);
+	std::string rootPath = ToRelativePath(Utils::ExtractPath(m_repositoryRoot, root->ToString()));
+
+	std::vector<TreeIndex::Entry> entries;
+	if(!m_index->List(rootPath, revision, svn_depth_infinity, entries))
+	{
+		throw gcnew MigrationException(String::Format("The path '{0}' does not exist in revision {1} of the dump file", root, revision));
+	}
+
+	List<Item^>^ items = gcnew List<Item^>();
+	std::string excluded;
+	for(std::vector<TreeIndex::Entry>::const_iterator entry = entries.begin(); entry != entries.end(); ++entry)
+	{
+		//The entries are listed depth first. Everything below of an excluded folder follows the folder
+		if(!excluded.empty() && 0 == entry->path.compare(0, excluded.length(), excluded))
+		{
+			continue;
+		}
+
+		excluded.clear();
+
+		if(nullptr != filter)
+		{
+			//Folders above of a mapping have to be created to reach the mapped items. Files have to be mapped themselves
+			bool included = entry->node->directory ? filter->Includes(entry->path.c_str()) : PathScope::Mapped == filter->Classify(entry->path.c_str());
+			if(!included)
+			{
+				if(entry->node->directory)
+				{
+					excluded = entry->path + "/";
+				}
+
+				continue;
+			}
+		}
+
+		String^ relative = Utils::ConvertUTF8ToString(entry->path.substr(rootPath.length()).c_str())->Trim(Utils::SeperatorCharArray);
+		String^ localPath = Path::Combine(localRoot, relative->Replace('/', Path::DirectorySeparatorChar));
+		if(entry->node->directory)
+		{
+			Directory::CreateDirectory(localPath);
+		}
+		else
+		{
+			WriteContent(entry->node, ToFullServerPath(entry->path), localPath);
+		}
+
+		items->Add(ToItem(entry->path, entry->node));
+	}
+
+	return items;
+}
+
+List<Item^>^
+DumpFileBackend::GetItems(Uri^ path, long revision, Depth depth)
+{
+	EnsureOpen();
+
+	revision = ResolveRevision(revision);
+
+	std::vector<TreeIndex::Entry> entries;
+	if(!m_index->List(ToRelativePath(Utils::ExtractPath(m_repositoryRoot, path->ToString())), revision, (int)depth, entries))
+	{
+		throw gcnew MigrationException(String::Format("The path '{0}' does not exist in revision {1} of the dump file", path, revision));
+	}
+
+	List<Item^>^ items = gcnew List<Item^>((int)entries.size());
+	for(std::vector<TreeIndex::Entry>::const_iterator entry = entries.begin(); entry != entries.end(); ++entry)
+	{
+		items->Add(ToItem(entry->path, entry->node));
+	}
+
+	return items;
+}
+
+IEnumerable<Item^>^
+DumpFileBackend::EnumerateItems(Uri^ path, long revision, Depth depth, DirentFields fields)
+{
+	//The index holds all fields. A listing is answered from memory at once
+	return GetItems(path, revision, depth);
+}
+
+List<LocationSegment^>^
+DumpFileBackend::GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision)
+{
+	EnsureOpen();
+
+	if(nullptr == path)
+	{
+		throw gcnew ArgumentNullException("path");
+	}
+
+	pegRevision = ResolveRevision(pegRevision);
+	startRevision = startRevision < 0 ? pegRevision : startRevision;
+	endRevision = endRevision < 0 ? 0 : endRevision;
+
+	String^ current = Utils::ConvertUTF8ToString(ToRelativePath(Utils::ExtractPath(m_repositoryRoot, path->ToString())).c_str());
+	if(NULL == m_index->Find(Utils::ConvertStringToUTF8(current), pegRevision))
+	{
+		throw gcnew MigrationException(String::Format("The path '{0}' does not exist in revision {1} of the dump file", path, pegRevision));
+	}
+
+	List<LocationSegment^>^ segments = gcnew List<LocationSegment^>();
+	long revision = pegRevision;
+	while(revision >= endRevision)
+	{
+		DumpOrigin origin;
+		String^ originPath;
+		bool found = FindOrigin(current, revision, origin, originPath);
+		long created = found ? origin.Revision : m_firstRevision;
+
+		AddSegment(segments, created, revision, Utils::Combine(m_repositoryRoot, current), startRevision, endRevision);
+		if(!found || nullptr == origin.CopyFromPath)
+		{
+			break;
+		}
+
+		//The item did not exist between the revision of its source and the copy
+		AddSegment(segments, origin.CopyFromRevision + 1, created - 1, nullptr, startRevision, endRevision);
+
+		current = String::Concat(origin.CopyFromPath, current->Substring(originPath->Length));
+		revision = origin.CopyFromRevision;
+	}
+
+	return segments;
+}
+
+long
+DumpFileBackend::Commit(Uri^ repositoryRoot, IEnumerable<CommitItem^>^ items, String^ message)
+{
+	throw gcnew NotSupportedException("A dump file cannot be committed to");
+}
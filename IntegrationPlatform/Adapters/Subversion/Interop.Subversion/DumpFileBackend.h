@@ -0,0 +1,200 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ChangeBuffer.h"
+#include "IRepositoryBackend.h"
+#include "TreeIndex.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Collections::Generic;
+using namespace System::Net;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							ref class DumpFileReader;
+						}
+
+						namespace Backends
+						{
+							/// <summary>
+							/// The revision properties and the position of a revision in the dump file
+							/// </summary>
+							private ref class DumpRevision
+							{
+							public:
+								long long Offset;
+								String^ Author;
+								String^ Comment;
+								String^ Date;
+								DateTime CommitTime;
+							};
+
+							/// <summary>
+							/// The location of a text. Full texts are read from the dump file. Texts that have been stored as deltas are
+							/// reconstructed while the dump file is indexed and read from a local file
+							/// </summary>
+							private value struct DumpContent
+							{
+								bool Stored;
+								long long Offset;
+								long long Length;
+								array<Byte>^ MD5;
+							};
+
+							/// <summary>
+							/// The properties that make subversion translate the text of a file when it is exported. Other properties are not tracked
+							/// </summary>
+							private value struct DumpProperties
+							{
+								String^ EolStyle;
+								String^ Keywords;
+							};
+
+							/// <summary>
+							/// The revision in which a node has been added to a path and the source of the node if it has been copied
+							/// </summary>
+							private value struct DumpOrigin
+							{
+								long Revision;
+								String^ CopyFromPath;
+								long CopyFromRevision;
+							};
+
+							/// <summary>
+							/// A backend that serves all requests from a dump file that has been created by svnadmin dump. No subversion server
+							/// is contacted, so the initial migration of a large repository runs at the speed of the local disk.
+							/// <para/>
+							/// The dump file is indexed once when the backend is created. The tree of every revision is kept in a persistent
+							/// <see cref="Helpers::TreeIndex"/>, the revision properties and the position of every revision are kept in memory.
+							/// The changes of a revision are read from the dump file again whenever the history is queried. Full texts are read
+							/// directly from the dump file; deltas are applied during the indexing and the reconstructed texts are stored in a
+							/// temporary file. Of the node properties only svn:eol-style and svn:keywords are tracked. The line endings are translated
+							/// like an export does; texts that contain a keyword which would be expanded are rejected.
+							/// <para/>
+							/// Dumps do not contain the url of the repository. The repository root is either configured or the url that the
+							/// client opens is taken as root
+							/// </summary>
+							public ref class DumpFileBackend : public IRepositoryBackend
+							{
+							private:
+								static const int BufferSize = 64 * 1024;
+
+								String^ m_dumpFile;
+								Uri^ m_configuredRoot;
+								String^ m_storeFile;
+								Guid m_repositoryId;
+
+								SubversionClient^ m_client;
+								String^ m_repositoryRoot;
+								String^ m_itemRoot;
+
+								Helpers::TreeIndex* m_index;
+								long m_firstRevision;
+								List<DumpRevision^>^ m_revisions;
+								List<DumpContent>^ m_contents;
+								List<DumpProperties>^ m_properties;
+								Dictionary<String^, List<DumpOrigin>^>^ m_origins;
+								int m_reconstructedTexts;
+
+								void Load();
+								void ApplyNode(Helpers::DumpFileReader^ reader, long revision, const std::string& author, FileStream^% bases, FileStream^% store, FileStream^% storedBases);
+								void ReadChanges(Helpers::DumpFileReader^ reader, long revision, std::vector<Helpers::ChangeBuffer::Record>& changes);
+								bool FindOrigin(String^ path, long revision, DumpOrigin% origin, [Out] String^% originPath);
+
+								void EnsureOpen();
+								long ResolveRevision(long revision);
+								FileStream^ OpenDump();
+								FileStream^ OpenText(DumpContent text);
+								String^ ToFullServerPath(const std::string& path);
+								ObjectModel::Item^ ToItem(const std::string& path, const Helpers::TreeIndex::Node* node);
+								const Helpers::TreeIndex::Node* Find(Uri^ path, long revision);
+								void WriteContent(const Helpers::TreeIndex::Node* node, String^ path, String^ toPath);
+								bool ContainsKeywords(DumpContent text, String^ keywords);
+								bool HasSameContent(const Helpers::TreeIndex::Node* node1, const Helpers::TreeIndex::Node* node2);
+								bool Compare(const Helpers::TreeIndex::Node* node1, const Helpers::TreeIndex::Node* node2, String^ path, List<String^>^ differences);
+
+								static std::string ToRelativePath(String^ path);
+								static long ParseRevision(String^ value);
+								static bool Affects(const std::vector<Helpers::ChangeBuffer::Record>& changes, const std::string& scope);
+								static void AddSegment(List<ObjectModel::LocationSegment^>^ segments, long first, long last, String^ fullServerPath, long startRevision, long endRevision);
+
+							public:
+								/// <summary>
+								/// Creates a dump file backend and indexes the dump file
+								/// </summary>
+								/// <param name="dumpFile">The path of the dump file in the format version 2 or 3. The file must not be incremental</param>
+								/// <param name="repositoryRoot">The url of the dumped repository; null if the url that the client opens is the root</param>
+								/// <exception cref="MigrationException">Will be thrown if the file is not a valid dump file</exception>
+								DumpFileBackend(String^ dumpFile, Uri^ repositoryRoot);
+
+								/// <summary>
+								/// Default destructor. Deletes the reconstructed texts
+								/// </summary>
+								~DumpFileBackend();
+
+								/// <summary>
+								/// Default Finalizer
+								/// </summary>
+								!DumpFileBackend();
+
+								/// <summary>
+								/// Gets the first revision of the dump file
+								/// </summary>
+								property long FirstRevision { long get(); }
+
+								/// <summary>
+								/// Gets the latest revision of the dump file
+								/// </summary>
+								property long LatestRevision { long get(); }
+
+								virtual void Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId);
+
+								virtual void Close();
+
+								virtual long GetLatestRevisionNumber(Uri^ path);
+
+								virtual Dictionary<long, ObjectModel::ChangeSet^>^ QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, ObjectModel::PathFilter^ pathFilter, ObjectModel::RevisionFilter^ revisionFilter);
+
+								virtual List<ObjectModel::ItemInfo^>^ QueryItemInfo(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								virtual void DownloadItem(Uri^ fromPath, long revision, String^ toPath);
+
+								virtual ObjectModel::ContentDigest^ DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath);
+
+								virtual bool AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								virtual List<String^>^ GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								virtual List<ObjectModel::Item^>^ ExportTree(Uri^ root, long revision, String^ localRoot, ObjectModel::PathFilter^ filter);
+
+								virtual List<ObjectModel::Item^>^ GetItems(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								virtual IEnumerable<ObjectModel::Item^>^ EnumerateItems(Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields);
+
+								virtual List<ObjectModel::LocationSegment^>^ GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision);
+
+								virtual long Commit(Uri^ repositoryRoot, IEnumerable<ObjectModel::CommitItem^>^ items, String^ message);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
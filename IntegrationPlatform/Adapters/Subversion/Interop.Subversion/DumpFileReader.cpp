@@ -0,0 +1,293 @@
+#include "Stdafx.h"
+#include "DumpFileReader.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Globalization;
+using namespace System::IO;
+using namespace System::Text;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+
+DumpFileReader::DumpFileReader(Stream^ stream)
+{
+	if(nullptr == stream)
+	{
+		throw gcnew ArgumentNullException("stream");
+	}
+
+	if(!stream->CanSeek)
+	{
+		throw gcnew ArgumentException("The stream has to be seekable", "stream");
+	}
+
+	m_stream = stream;
+	m_line = gcnew MemoryStream();
+	m_uuid = nullptr;
+	m_end = stream->Position;
+
+	String^ version = ReadHeaders() ? GetHeader("SVN-fs-dump-format-version") : nullptr;
+	if(nullptr == version)
+	{
+		throw gcnew MigrationException("The file is not a subversion dump file");
+	}
+
+	if(!Int32::TryParse(version, NumberStyles::None, CultureInfo::InvariantCulture, m_version) || m_version < 2 || m_version > 3)
+	{
+		throw gcnew MigrationException(String::Format("The dump file format version {0} is not supported. Valid versions are 2 and 3", version));
+	}
+}
+
+int
+DumpFileReader::Version::get()
+{
+	return m_version;
+}
+
+String^
+DumpFileReader::Uuid::get()
+{
+	return m_uuid;
+}
+
+Stream^
+DumpFileReader::BaseStream::get()
+{
+	return m_stream;
+}
+
+long long
+DumpFileReader::Offset::get()
+{
+	return m_offset;
+}
+
+bool
+DumpFileReader::IsRevision::get()
+{
+	return m_headers->ContainsKey("Revision-number");
+}
+
+bool
+DumpFileReader::IsNode::get()
+{
+	return m_headers->ContainsKey("Node-path");
+}
+
+bool
+DumpFileReader::HasProperties::get()
+{
+	return m_propertiesLength > EmptyPropertiesLength;
+}
+
+bool
+DumpFileReader::HasText::get()
+{
+	return m_textLength >= 0;
+}
+
+long long
+DumpFileReader::TextOffset::get()
+{
+	return m_contentOffset + Math::Max(0LL, m_propertiesLength);
+}
+
+long long
+DumpFileReader::TextLength::get()
+{
+	return m_textLength;
+}
+
+String^
+DumpFileReader::ReadLine()
+{
+	m_line->SetLength(0);
+
+	int value;
+	while((value = m_stream->ReadByte()) >= 0 && '\n' != value)
+	{
+		m_line->WriteByte((Byte)value);
+	}
+
+	if(value < 0 && 0 == m_line->Length)
+	{
+		return nullptr;
+	}
+
+	//The paths in the headers are UTF-8 encoded. All other headers are plain ASCII
+	return Encoding::UTF8->GetString(m_line->GetBuffer(), 0, (int)m_line->Length);
+}
+
+bool
+DumpFileReader::ReadHeaders()
+{
+	m_headers = gcnew Dictionary<String^, String^>(StringComparer::Ordinal);
+	m_propertiesLength = -1;
+	m_textLength = -1;
+
+	//The records are separated by a varying number of empty lines
+	String^ line;
+	do
+	{
+		m_offset = m_stream->Position;
+		line = ReadLine();
+		if(nullptr == line)
+		{
+			return false;
+		}
+	}
+	while(0 == line->Length);
+
+	while(nullptr != line && line->Length > 0)
+	{
+		int separator = line->IndexOf(": ", StringComparison::Ordinal);
+		if(separator <= 0)
+		{
+			throw gcnew MigrationException(String::Format("The dump file contains the invalid header '{0}' at position {1}", line, m_offset));
+		}
+
+		m_headers[line->Substring(0, separator)] = line->Substring(separator + 2);
+		line = ReadLine();
+	}
+
+	m_contentOffset = m_stream->Position;
+	m_propertiesLength = GetLength("Prop-content-length");
+	m_textLength = GetLength("Text-content-length");
+
+	//Old dumps may omit the total length. It is the sum of both parts then
+	long long contentLength = GetLength("Content-length");
+	if(contentLength < 0)
+	{
+		contentLength = Math::Max(0LL, m_propertiesLength) + Math::Max(0LL, m_textLength);
+	}
+
+	m_end = m_contentOffset + contentLength;
+	return true;
+}
+
+long long
+DumpFileReader::GetLength(String^ name)
+{
+	String^ value = GetHeader(name);
+	if(nullptr == value)
+	{
+		return -1;
+	}
+
+	long long length;
+	if(!Int64::TryParse(value, NumberStyles::None, CultureInfo::InvariantCulture, length))
+	{
+		throw gcnew MigrationException(String::Format("The dump file contains the invalid length '{0}: {1}' at position {2}", name, value, m_offset));
+	}
+
+	return length;
+}
+
+bool
+DumpFileReader::Read()
+{
+	while(true)
+	{
+		//The content of the previous record is skipped. The caller may have moved the stream while reading it
+		m_stream->Seek(m_end, SeekOrigin::Begin);
+		if(!ReadHeaders())
+		{
+			return false;
+		}
+
+		if(IsRevision || IsNode)
+		{
+			return true;
+		}
+
+		String^ uuid;
+		if(m_headers->TryGetValue("UUID", uuid))
+		{
+			m_uuid = uuid;
+		}
+	}
+}
+
+void
+DumpFileReader::Seek(long long offset)
+{
+	if(offset < 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("offset");
+	}
+
+	m_end = offset;
+}
+
+String^
+DumpFileReader::GetHeader(String^ name)
+{
+	String^ value;
+	return m_headers->TryGetValue(name, value) ? value : nullptr;
+}
+
+array<Byte>^
+DumpFileReader::ReadBlock(String^ line, String^ prefix)
+{
+	int length;
+	if(nullptr == line || !line->StartsWith(prefix, StringComparison::Ordinal) || !Int32::TryParse(line->Substring(prefix->Length), NumberStyles::None, CultureInfo::InvariantCulture, length))
+	{
+		throw gcnew MigrationException(String::Format("The dump file contains an invalid property block at position {0}", m_offset));
+	}
+
+	array<Byte>^ block = gcnew array<Byte>(length);
+	int offset = 0;
+	while(offset < length)
+	{
+		int read = m_stream->Read(block, offset, length - offset);
+		if(read <= 0)
+		{
+			throw gcnew MigrationException(String::Format("The dump file ends within the property block at position {0}", m_offset));
+		}
+
+		offset += read;
+	}
+
+	//The block is terminated by a line feed
+	m_stream->ReadByte();
+	return block;
+}
+
+Dictionary<String^, String^>^
+DumpFileReader::ReadProperties()
+{
+	Dictionary<String^, String^>^ properties = gcnew Dictionary<String^, String^>(StringComparer::Ordinal);
+	ReadProperties(properties);
+	return properties;
+}
+
+void
+DumpFileReader::ReadProperties(Dictionary<String^, String^>^ properties)
+{
+	if(m_propertiesLength <= 0)
+	{
+		return;
+	}
+
+	m_stream->Seek(m_contentOffset, SeekOrigin::Begin);
+	long long end = m_contentOffset + m_propertiesLength;
+
+	while(m_stream->Position < end)
+	{
+		String^ line = ReadLine();
+		if(nullptr == line || String::Equals(line, "PROPS-END", StringComparison::Ordinal))
+		{
+			break;
+		}
+
+		if(line->StartsWith("D ", StringComparison::Ordinal))
+		{
+			properties->Remove(Encoding::UTF8->GetString(ReadBlock(line, "D ")));
+			continue;
+		}
+
+		String^ name = Encoding::UTF8->GetString(ReadBlock(line, "K "));
+		properties[name] = Encoding::UTF8->GetString(ReadBlock(ReadLine(), "V "));
+	}
+}
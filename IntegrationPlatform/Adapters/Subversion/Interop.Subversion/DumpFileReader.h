@@ -0,0 +1,144 @@
+#pragma once
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::IO;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							/// <summary>
+							/// Reads the records of a dump file that has been written by svnadmin dump in the format version 2 or 3. A record consists
+							/// of a block of headers and an optional content which holds the properties followed by the text of a node.
+							/// The reader only parses the headers. The properties are parsed on demand and the text is skipped,
+							/// so that the caller can read it directly from the stream
+							/// </summary>
+							private ref class DumpFileReader
+							{
+							private:
+								//The content of a property block without any property
+								static const int EmptyPropertiesLength = 10;
+
+								Stream^ m_stream;
+								MemoryStream^ m_line;
+								int m_version;
+								String^ m_uuid;
+
+								Dictionary<String^, String^>^ m_headers;
+								long long m_offset;
+								long long m_contentOffset;
+								long long m_propertiesLength;
+								long long m_textLength;
+								long long m_end;
+
+								String^ ReadLine();
+								bool ReadHeaders();
+								long long GetLength(String^ name);
+								array<Byte>^ ReadBlock(String^ line, String^ prefix);
+
+							public:
+								/// <summary>
+								/// Creates a reader and reads the format version of the dump
+								/// </summary>
+								/// <param name="stream">A seekable stream that is positioned at the beginning of the dump</param>
+								/// <exception cref="MigrationException">Will be thrown if the stream is not a dump in a supported format version</exception>
+								DumpFileReader(Stream^ stream);
+
+								/// <summary>
+								/// Gets the format version of the dump
+								/// </summary>
+								property int Version { int get(); }
+
+								/// <summary>
+								/// Gets the UUID of the dumped repository; null if it has not been read yet
+								/// </summary>
+								property String^ Uuid { String^ get(); }
+
+								/// <summary>
+								/// Gets the stream of the dump. The text of the current node starts at <see cref="TextOffset"/>
+								/// </summary>
+								property Stream^ BaseStream { Stream^ get(); }
+
+								/// <summary>
+								/// Gets the position of the current record
+								/// </summary>
+								property long long Offset { long long get(); }
+
+								/// <summary>
+								/// Gets whether the current record starts a revision
+								/// </summary>
+								property bool IsRevision { bool get(); }
+
+								/// <summary>
+								/// Gets whether the current record describes the change of a node
+								/// </summary>
+								property bool IsNode { bool get(); }
+
+								/// <summary>
+								/// Gets whether the current record has properties other than an empty block
+								/// </summary>
+								property bool HasProperties { bool get(); }
+
+								/// <summary>
+								/// Gets whether the current record has a text
+								/// </summary>
+								property bool HasText { bool get(); }
+
+								/// <summary>
+								/// Gets the position of the text of the current record
+								/// </summary>
+								property long long TextOffset { long long get(); }
+
+								/// <summary>
+								/// Gets the number of bytes of the text of the current record; -1 if the record has no text
+								/// </summary>
+								property long long TextLength { long long get(); }
+
+								/// <summary>
+								/// Moves to the next revision or node record. The records of the format version and of the UUID are consumed
+								/// </summary>
+								/// <returns>false if the end of the dump has been reached</returns>
+								bool Read();
+
+								/// <summary>
+								/// Moves to a record that has been read before. The record is read by the next call of <see cref="Read"/>
+								/// </summary>
+								/// <param name="offset">The <see cref="Offset"/> of the record</param>
+								void Seek(long long offset);
+
+								/// <summary>
+								/// Gets a header of the current record
+								/// </summary>
+								/// <returns>The value of the header; null if the record does not have the header</returns>
+								String^ GetHeader(String^ name);
+
+								/// <summary>
+								/// Reads the properties of the current record. Properties that are deleted by a delta are not returned
+								/// </summary>
+								/// <returns>The properties by their name; the values are decoded as UTF-8</returns>
+								Dictionary<String^, String^>^ ReadProperties();
+
+								/// <summary>
+								/// Applies the properties of the current record to a set of properties. Properties that are deleted by a delta are removed
+								/// </summary>
+								/// <param name="properties">The properties by their name; the values are decoded as UTF-8</param>
+								void ReadProperties(Dictionary<String^, String^>^ properties);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
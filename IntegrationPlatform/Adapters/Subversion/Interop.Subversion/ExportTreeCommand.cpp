@@ -0,0 +1,542 @@
+#include "Stdafx.h"
+#include <svn_error_codes.h>
+#include <svn_props.h>
+#include "AprPool.h"
+#include "DI_Svn_Client-1.h"
+#include "DI_Svn_Delta-1.h"
+#include "DI_Svn_Ra-1.h"
+#include "DI_Svn_Subr-1.h"
+#include "DownloadCommand.h"
+#include "ExportTreeCommand.h"
+#include "Item.h"
+#include "LibraryLoader.h"
+#include "PathFilter.h"
+#include "SubversionClient.h"
+#include "SubversionContext.h"
+#include "SvnError.h"
+#include "Utils.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Text;
+using namespace System::Runtime::InteropServices;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Commands;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+using namespace Microsoft::TeamFoundation::Migration::Toolkit::Services;
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* OpenRootDelegate(void *edit_baton, svn_revnum_t base_revision, apr_pool_t *dir_pool, void **root_baton);
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* AddDirectoryDelegate(const char *path, void *parent_baton, const char *copyfrom_path, svn_revnum_t copyfrom_revision, apr_pool_t *dir_pool, void **child_baton);
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* ChangePropDelegate(void *baton, const char *name, const svn_string_t *value, apr_pool_t *pool);
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* CloseDirectoryDelegate(void *dir_baton, apr_pool_t *pool);
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* AddFileDelegate(const char *path, void *parent_baton, const char *copyfrom_path, svn_revnum_t copyfrom_revision, apr_pool_t *file_pool, void **file_baton);
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* ApplyTextDeltaDelegate(void *file_baton, const char *base_checksum, apr_pool_t *pool, svn_txdelta_window_handler_t *handler, void **handler_baton);
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* CloseFileDelegate(void *file_baton, const char *text_checksum, apr_pool_t *pool);
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* WindowHandlerDelegate(svn_txdelta_window_t *window, void *baton);
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* ExportWriteFnTDelegate(void *baton, const char *data, apr_size_t *len);
+
+ExportTreeCommand::ExportTreeCommand(SubversionContext^ context, SubversionClient^ client, System::Uri^ root, long revision, String^ localRoot, PathFilter^ filter)
+{
+	if(nullptr == context)
+	{
+		throw gcnew ArgumentNullException("context");
+	}
+
+	if(nullptr == client)
+	{
+		throw gcnew ArgumentNullException("client");
+	}
+
+	if(nullptr == root)
+	{
+		throw gcnew ArgumentNullException("root");
+	}
+
+	if(String::IsNullOrEmpty(localRoot))
+	{
+		throw gcnew ArgumentNullException("localRoot");
+	}
+
+	m_context = context;
+	m_client = client;
+	m_root = root;
+	m_revision = revision;
+	m_localRoot = localRoot;
+	m_filter = filter;
+
+	//The filter expects repository relative paths while the editor reports the paths relative to the exported root
+	String^ prefix = Utils::ExtractPath(m_client->RepositoryRoot->ToString(), m_root->ToString());
+	m_prefix = new std::string(Utils::ConvertStringToUTF8(String::Equals(prefix, Utils::Seperator) ? String::Empty : prefix));
+}
+
+ExportTreeCommand::~ExportTreeCommand()
+{
+	this->!ExportTreeCommand();
+}
+
+ExportTreeCommand::!ExportTreeCommand()
+{
+	if(NULL != m_prefix)
+	{
+		delete m_prefix;
+		m_prefix = NULL;
+	}
+}
+
+void
+ExportTreeCommand::Execute([Out] List<Item^>^% items)
+{
+	items = nullptr;
+
+	m_nodes = gcnew List<ExportNode^>();
+	m_items = gcnew List<Item^>();
+	m_translatedItems = gcnew List<Item^>();
+	m_buffer = gcnew array<Byte>(64 * 1024);
+	m_error = nullptr;
+
+	AprPool^ pool = gcnew AprPool();
+	List<GCHandle>^ handles = gcnew List<GCHandle>();
+
+	try
+	{
+		OpenRootDelegate^ openRoot = gcnew OpenRootDelegate(this, &ExportTreeCommand::OpenRoot);
+		AddDirectoryDelegate^ addDirectory = gcnew AddDirectoryDelegate(this, &ExportTreeCommand::AddDirectory);
+		ChangePropDelegate^ changeDirProp = gcnew ChangePropDelegate(this, &ExportTreeCommand::ChangeDirProp);
+		CloseDirectoryDelegate^ closeDirectory = gcnew CloseDirectoryDelegate(this, &ExportTreeCommand::CloseDirectory);
+		AddFileDelegate^ addFile = gcnew AddFileDelegate(this, &ExportTreeCommand::AddFile);
+		ApplyTextDeltaDelegate^ applyTextDelta = gcnew ApplyTextDeltaDelegate(this, &ExportTreeCommand::ApplyTextDelta);
+		ChangePropDelegate^ changeFileProp = gcnew ChangePropDelegate(this, &ExportTreeCommand::ChangeFileProp);
+		CloseFileDelegate^ closeFile = gcnew CloseFileDelegate(this, &ExportTreeCommand::CloseFile);
+		WindowHandlerDelegate^ ignoreWindow = gcnew WindowHandlerDelegate(this, &ExportTreeCommand::IgnoreWindow);
+		ExportWriteFnTDelegate^ writer = gcnew ExportWriteFnTDelegate(this, &ExportTreeCommand::SvnWriteFnT);
+
+		array<Delegate^>^ callbacks = { openRoot, addDirectory, changeDirProp, closeDirectory, addFile, applyTextDelta, changeFileProp, closeFile, ignoreWindow, writer };
+		for each(Delegate^ callback in callbacks)
+		{
+			handles->Add(GCHandle::Alloc(callback));
+		}
+
+		//The stream writer and the window handler are shared by all files. The baton identifies the file
+		m_writer = static_cast<svn_write_fn_t>(Marshal::GetFunctionPointerForDelegate(writer).ToPointer());
+		m_ignoreWindow = static_cast<svn_txdelta_window_handler_t>(Marshal::GetFunctionPointerForDelegate(ignoreWindow).ToPointer());
+
+		//All callbacks that are not overridden are no-ops. This also drops the deletion of a reported cloaked folder that does not exist in the revision
+		svn_delta_editor_t* editor = Svn_Delta::Instance()->SVN_DELTA_DEFAULT_EDITOR(pool->Handle);
+		editor->open_root = static_cast<svn_error_t* (*)(void*, svn_revnum_t, apr_pool_t*, void**)>(Marshal::GetFunctionPointerForDelegate(openRoot).ToPointer());
+		editor->add_directory = static_cast<svn_error_t* (*)(const char*, void*, const char*, svn_revnum_t, apr_pool_t*, void**)>(Marshal::GetFunctionPointerForDelegate(addDirectory).ToPointer());
+		editor->change_dir_prop = static_cast<svn_error_t* (*)(void*, const char*, const svn_string_t*, apr_pool_t*)>(Marshal::GetFunctionPointerForDelegate(changeDirProp).ToPointer());
+		editor->close_directory = static_cast<svn_error_t* (*)(void*, apr_pool_t*)>(Marshal::GetFunctionPointerForDelegate(closeDirectory).ToPointer());
+		editor->add_file = static_cast<svn_error_t* (*)(const char*, void*, const char*, svn_revnum_t, apr_pool_t*, void**)>(Marshal::GetFunctionPointerForDelegate(addFile).ToPointer());
+		editor->apply_textdelta = static_cast<svn_error_t* (*)(void*, const char*, apr_pool_t*, svn_txdelta_window_handler_t*, void**)>(Marshal::GetFunctionPointerForDelegate(applyTextDelta).ToPointer());
+		editor->change_file_prop = static_cast<svn_error_t* (*)(void*, const char*, const svn_string_t*, apr_pool_t*)>(Marshal::GetFunctionPointerForDelegate(changeFileProp).ToPointer());
+		editor->close_file = static_cast<svn_error_t* (*)(void*, const char*, apr_pool_t*)>(Marshal::GetFunctionPointerForDelegate(closeFile).ToPointer());
+
+		svn_ra_session_t* session = NULL;
+		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_OPEN_RA_SESSION(&session, pool->CopyString(m_root->AbsoluteUri), m_context->Handle, pool->Handle));
+
+		const svn_ra_reporter3_t* reporter = NULL;
+		void* reportBaton = NULL;
+		SvnError::Err(Svn_Ra::Instance()->SVN_RA_DO_UPDATE2(session, &reporter, &reportBaton, (svn_revnum_t)m_revision, "", svn_depth_infinity, FALSE, editor, NULL, pool->Handle));
+
+		svn_error_t* error = reporter->set_path(reportBaton, "", (svn_revnum_t)m_revision, svn_depth_infinity, TRUE, NULL, pool->Handle);
+
+		//Cloaked folders are reported as already present. The server does not send their content at all instead of sending content that would be dropped
+		if(NULL == error && nullptr != m_filter)
+		{
+			String^ prefix = Utils::ConvertUTF8ToString(m_prefix->c_str());
+			for each(String^ cloakedPath in m_filter->CloakedPaths)
+			{
+				if(NULL == error && cloakedPath->Length > prefix->Length + 1 && cloakedPath->StartsWith(prefix + Utils::Seperator, StringComparison::Ordinal))
+				{
+					error = reporter->set_path(reportBaton, pool->CopyString(cloakedPath->Substring(prefix->Length + 1)), (svn_revnum_t)m_revision, svn_depth_infinity, FALSE, NULL, pool->Handle);
+				}
+			}
+		}
+
+		if(NULL != error)
+		{
+			reporter->abort_report(reportBaton, pool->Handle);
+			SvnError::Err(error);
+		}
+
+		//The server drives the editor while the report is finished
+		SvnError::Err(reporter->finish_report(reportBaton, pool->Handle));
+	}
+	catch(OperationCanceledException^)
+	{
+		if(nullptr == m_error)
+		{
+			throw;
+		}
+
+		throw gcnew MigrationException(String::Format("The export of {0} at revision {1} failed", m_root, m_revision), m_error);
+	}
+	finally
+	{
+		//Release the files of a drive that has been aborted
+		for(int i = 0; i < m_nodes->Count; i++)
+		{
+			if(nullptr != m_nodes[i])
+			{
+				Close(IntPtr(i + 1).ToPointer());
+			}
+		}
+
+		for each(GCHandle handle in handles)
+		{
+			handle.Free();
+		}
+	}
+
+	//Export expands keywords and translates line endings. The update drive transfers the repository content, so such files are exported once more
+	for each(Item^ item in m_translatedItems)
+	{
+		String^ localPath = Path::Combine(m_localRoot, Utils::ExtractPath(m_root->ToString(), item->FullServerPath)->TrimStart(Utils::SeperatorCharArray)->Replace('/', Path::DirectorySeparatorChar));
+		DownloadCommand^ command = gcnew DownloadCommand(m_context, gcnew Uri(item->FullServerPath), m_revision, localPath);
+		command->Execute();
+	}
+
+	items = m_items;
+}
+
+void*
+ExportTreeCommand::Open(ExportNode^ node)
+{
+	//The baton is the position of the node. Null is reserved for the items that are excluded by the filter
+	m_nodes->Add(node);
+	return IntPtr(m_nodes->Count).ToPointer();
+}
+
+ExportNode^
+ExportTreeCommand::Get(void* baton)
+{
+	if(NULL == baton)
+	{
+		return nullptr;
+	}
+
+	return m_nodes[IntPtr(baton).ToInt32() - 1];
+}
+
+void
+ExportTreeCommand::Close(void* baton)
+{
+	ExportNode^ node = Get(baton);
+	if(nullptr == node)
+	{
+		return;
+	}
+
+	if(nullptr != node->File)
+	{
+		delete node->File;
+		node->File = nullptr;
+	}
+
+	if(NULL != node->Digest)
+	{
+		delete[] node->Digest;
+		node->Digest = NULL;
+	}
+
+	m_nodes[IntPtr(baton).ToInt32() - 1] = nullptr;
+}
+
+bool
+ExportTreeCommand::IsIncluded(const char* path, bool isDirectory)
+{
+	if(nullptr == m_filter)
+	{
+		return true;
+	}
+
+	std::string relative(*m_prefix);
+	if(NULL != path && '\0' != *path)
+	{
+		relative.append("/").append(path);
+	}
+
+	//Folders above of a mapping have to be created to reach the mapped items. Files have to be mapped themselves
+	if(isDirectory)
+	{
+		return m_filter->Includes(relative.c_str());
+	}
+
+	return PathScope::Mapped == m_filter->Classify(relative.c_str());
+}
+
+void
+ExportTreeCommand::SetProperty(void* baton, const char* name, const svn_string_t* value)
+{
+	ExportNode^ node = Get(baton);
+	if(nullptr == node)
+	{
+		return;
+	}
+
+	if(0 == strcmp(name, SVN_PROP_ENTRY_COMMITTED_REV))
+	{
+		node->CreatedRev = (NULL == value) ? -1 : Int32::Parse(gcnew String(value->data, 0, (int)value->len, Encoding::UTF8), Globalization::CultureInfo::InvariantCulture);
+	}
+	else if(0 == strcmp(name, SVN_PROP_ENTRY_LAST_AUTHOR))
+	{
+		node->LastAuthor = (NULL == value) ? nullptr : gcnew String(value->data, 0, (int)value->len, Encoding::UTF8);
+	}
+	else if(0 == strcmp(name, SVN_PROP_EOL_STYLE) || 0 == strcmp(name, SVN_PROP_KEYWORDS))
+	{
+		node->Translated |= (NULL != value);
+	}
+}
+
+void
+ExportTreeCommand::AddItem(ExportNode^ node)
+{
+	String^ fullServerPath = Utils::Combine(m_root->ToString(), node->Path);
+	ContentType^ itemType = node->IsDirectory ? WellKnownContentType::VersionControlledFolder : WellKnownContentType::VersionControlledFile;
+
+	Item^ item = gcnew Item(fullServerPath, itemType, node->Length, node->CreatedRev, node->LastAuthor, m_client->VirtualRepositoryRoot->ToString());
+	m_items->Add(item);
+
+	if(node->Translated)
+	{
+		m_translatedItems->Add(item);
+	}
+}
+
+svn_error_t*
+ExportTreeCommand::Cancel(Exception^ e)
+{
+	//The exception must not pass the native frames of subversion. It is raised again when the drive has been stopped
+	m_error = e;
+	return Svn_subr::Instance()->SVN_ERROR_CREATE(SVN_ERR_CANCELLED, NULL, "The export has been cancelled");
+}
+
+svn_error_t*
+ExportTreeCommand::OpenRoot(void *edit_baton, svn_revnum_t base_revision, apr_pool_t *dir_pool, void **root_baton)
+{
+	*root_baton = NULL;
+	if(!IsIncluded(NULL, true))
+	{
+		return SVN_NO_ERROR;
+	}
+
+	try
+	{
+		Directory::CreateDirectory(m_localRoot);
+	}
+	catch(Exception^ e)
+	{
+		return Cancel(e);
+	}
+
+	ExportNode^ node = gcnew ExportNode();
+	node->Path = String::Empty;
+	node->LocalPath = m_localRoot;
+	node->IsDirectory = true;
+	node->CreatedRev = -1;
+
+	*root_baton = Open(node);
+	return SVN_NO_ERROR;
+}
+
+svn_error_t*
+ExportTreeCommand::AddDirectory(const char *path, void *parent_baton, const char *copyfrom_path, svn_revnum_t copyfrom_revision, apr_pool_t *dir_pool, void **child_baton)
+{
+	*child_baton = NULL;
+
+	//Everything below of an excluded folder is excluded as well
+	ExportNode^ parent = Get(parent_baton);
+	if(nullptr == parent || !IsIncluded(path, true))
+	{
+		return SVN_NO_ERROR;
+	}
+
+	ExportNode^ node = gcnew ExportNode();
+	node->Path = Utils::ConvertUTF8ToString(path);
+	node->LocalPath = Path::Combine(m_localRoot, node->Path->Replace('/', Path::DirectorySeparatorChar));
+	node->IsDirectory = true;
+	node->CreatedRev = -1;
+
+	try
+	{
+		Directory::CreateDirectory(node->LocalPath);
+	}
+	catch(Exception^ e)
+	{
+		return Cancel(e);
+	}
+
+	*child_baton = Open(node);
+	return SVN_NO_ERROR;
+}
+
+svn_error_t*
+ExportTreeCommand::ChangeDirProp(void *dir_baton, const char *name, const svn_string_t *value, apr_pool_t *pool)
+{
+	SetProperty(dir_baton, name, value);
+	return SVN_NO_ERROR;
+}
+
+svn_error_t*
+ExportTreeCommand::CloseDirectory(void *dir_baton, apr_pool_t *pool)
+{
+	ExportNode^ node = Get(dir_baton);
+	if(nullptr != node)
+	{
+		AddItem(node);
+		Close(dir_baton);
+	}
+
+	return SVN_NO_ERROR;
+}
+
+svn_error_t*
+ExportTreeCommand::AddFile(const char *path, void *parent_baton, const char *copyfrom_path, svn_revnum_t copyfrom_revision, apr_pool_t *file_pool, void **file_baton)
+{
+	*file_baton = NULL;
+
+	ExportNode^ parent = Get(parent_baton);
+	if(nullptr == parent || !IsIncluded(path, false))
+	{
+		return SVN_NO_ERROR;
+	}
+
+	ExportNode^ node = gcnew ExportNode();
+	node->Path = Utils::ConvertUTF8ToString(path);
+	node->LocalPath = Path::Combine(m_localRoot, node->Path->Replace('/', Path::DirectorySeparatorChar));
+	node->IsDirectory = false;
+	node->CreatedRev = -1;
+
+	try
+	{
+		node->File = gcnew FileStream(node->LocalPath, FileMode::Create, FileAccess::Write, FileShare::None, m_buffer->Length);
+	}
+	catch(Exception^ e)
+	{
+		return Cancel(e);
+	}
+
+	*file_baton = Open(node);
+	return SVN_NO_ERROR;
+}
+
+svn_error_t*
+ExportTreeCommand::ApplyTextDelta(void *file_baton, const char *base_checksum, apr_pool_t *pool, svn_txdelta_window_handler_t *handler, void **handler_baton)
+{
+	ExportNode^ node = Get(file_baton);
+	if(nullptr == node)
+	{
+		//The text of an excluded file is received anyway. It is simply dropped
+		*handler = m_ignoreWindow;
+		*handler_baton = NULL;
+		return SVN_NO_ERROR;
+	}
+
+	svn_stream_t* target = Svn_subr::Instance()->SVN_STREAM_CREATE(file_baton, pool);
+	Svn_subr::Instance()->SVN_STREAM_SET_WRITE(target, m_writer);
+
+	//The windows are applied against an empty source because the report started from an empty tree. The MD5 digest of the result is computed on the way
+	node->Digest = new unsigned char[APR_MD5_DIGESTSIZE];
+	Svn_Delta::Instance()->SVN_TXDELTA_APPLY(Svn_subr::Instance()->SVN_STREAM_EMPTY(pool), target, node->Digest, NULL, pool, handler, handler_baton);
+	return SVN_NO_ERROR;
+}
+
+svn_error_t*
+ExportTreeCommand::ChangeFileProp(void *file_baton, const char *name, const svn_string_t *value, apr_pool_t *pool)
+{
+	SetProperty(file_baton, name, value);
+	return SVN_NO_ERROR;
+}
+
+svn_error_t*
+ExportTreeCommand::CloseFile(void *file_baton, const char *text_checksum, apr_pool_t *pool)
+{
+	ExportNode^ node = Get(file_baton);
+	if(nullptr == node)
+	{
+		return SVN_NO_ERROR;
+	}
+
+	try
+	{
+		node->File->Close();
+
+		if(NULL != text_checksum && NULL != node->Digest)
+		{
+			StringBuilder^ digest = gcnew StringBuilder(2 * APR_MD5_DIGESTSIZE);
+			for(int i = 0; i < APR_MD5_DIGESTSIZE; i++)
+			{
+				digest->Append(node->Digest[i].ToString("x2"));
+			}
+
+			if(!String::Equals(digest->ToString(), Utils::ConvertUTF8ToString(text_checksum), StringComparison::OrdinalIgnoreCase))
+			{
+				throw gcnew MigrationException(String::Format("The content of {0} does not match the checksum of the repository", Utils::Combine(m_root->ToString(), node->Path)));
+			}
+		}
+
+		AddItem(node);
+	}
+	catch(Exception^ e)
+	{
+		return Cancel(e);
+	}
+	finally
+	{
+		Close(file_baton);
+	}
+
+	return SVN_NO_ERROR;
+}
+
+svn_error_t*
+ExportTreeCommand::IgnoreWindow(svn_txdelta_window_t *window, void *baton)
+{
+	return SVN_NO_ERROR;
+}
+
+svn_error_t*
+ExportTreeCommand::SvnWriteFnT(void *baton, const char *data, apr_size_t *len)
+{
+	ExportNode^ node = Get(baton);
+
+	try
+	{
+		for(apr_size_t offset = 0; offset < *len; )
+		{
+			int count = (int)Math::Min((apr_size_t)m_buffer->Length, *len - offset);
+			Marshal::Copy(IntPtr((void*)(data + offset)), m_buffer, 0, count);
+
+			node->File->Write(m_buffer, 0, count);
+			offset += count;
+		}
+
+		node->Length += *len;
+		return SVN_NO_ERROR;
+	}
+	catch(Exception^ e)
+	{
+		return Cancel(e);
+	}
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <string>
+#include <svn_client.h>
+#include <svn_delta.h>
+
+using namespace System::Collections::Generic;
+using namespace System::IO;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						ref class SubversionClient;
+
+						namespace Helpers
+						{
+							ref class SubversionContext;
+						}
+
+						namespace ObjectModel
+						{
+							ref class Item;
+							ref class PathFilter;
+						}
+
+						namespace Commands
+						{
+							/// <summary>
+							/// The state of a directory or file that is currently open in the update drive
+							/// </summary>
+							private ref class ExportNode
+							{
+							public:
+								System::String^ Path;
+								System::String^ LocalPath;
+								bool IsDirectory;
+								long CreatedRev;
+								System::String^ LastAuthor;
+								bool Translated;
+
+								FileStream^ File;
+								long long Length;
+								unsigned char* Digest;
+							};
+
+							/// <summary>
+							/// Exports a whole tree at a revision by a single update report. The server streams all directories and file texts
+							/// in one response and the editor writes them to disk as they arrive
+							/// </summary>
+							private ref class ExportTreeCommand
+							{
+							private:
+								Helpers::SubversionContext^ m_context;
+								SubversionClient^ m_client;
+								ObjectModel::PathFilter^ m_filter;
+
+								System::Uri^ m_root;
+								long m_revision;
+								System::String^ m_localRoot;
+
+								std::string* m_prefix;
+								List<ExportNode^>^ m_nodes;
+								List<ObjectModel::Item^>^ m_items;
+								List<ObjectModel::Item^>^ m_translatedItems;
+								array<System::Byte>^ m_buffer;
+								System::Exception^ m_error;
+								svn_write_fn_t m_writer;
+								svn_txdelta_window_handler_t m_ignoreWindow;
+
+								void* Open(ExportNode^ node);
+								ExportNode^ Get(void* baton);
+								void Close(void* baton);
+								bool IsIncluded(const char* path, bool isDirectory);
+								void SetProperty(void* baton, const char* name, const svn_string_t* value);
+								void AddItem(ExportNode^ node);
+								svn_error_t* Cancel(System::Exception^ e);
+
+								svn_error_t* OpenRoot(void *edit_baton, svn_revnum_t base_revision, apr_pool_t *dir_pool, void **root_baton);
+								svn_error_t* AddDirectory(const char *path, void *parent_baton, const char *copyfrom_path, svn_revnum_t copyfrom_revision, apr_pool_t *dir_pool, void **child_baton);
+								svn_error_t* ChangeDirProp(void *dir_baton, const char *name, const svn_string_t *value, apr_pool_t *pool);
+								svn_error_t* CloseDirectory(void *dir_baton, apr_pool_t *pool);
+								svn_error_t* AddFile(const char *path, void *parent_baton, const char *copyfrom_path, svn_revnum_t copyfrom_revision, apr_pool_t *file_pool, void **file_baton);
+								svn_error_t* ApplyTextDelta(void *file_baton, const char *base_checksum, apr_pool_t *pool, svn_txdelta_window_handler_t *handler, void **handler_baton);
+								svn_error_t* ChangeFileProp(void *file_baton, const char *name, const svn_string_t *value, apr_pool_t *pool);
+								svn_error_t* CloseFile(void *file_baton, const char *text_checksum, apr_pool_t *pool);
+								svn_error_t* IgnoreWindow(svn_txdelta_window_t *window, void *baton);
+								svn_error_t* SvnWriteFnT(void *baton, const char *data, apr_size_t *len);
+
+							public:
+								/// <summary>
+								/// Creates a new command that exports a tree
+								/// </summary>
+								/// <param name="context">The context that can be used to access the repository</param>
+								/// <param name="client">The client that is used to calculate the paths of the items</param>
+								/// <param name="root">The full path of the folder in the subversion repository that has to be exported</param>
+								/// <param name="revision">The revision of the tree</param>
+								/// <param name="localRoot">The local directory that receives the content of <paramref name="root"/></param>
+								/// <param name="filter">The filter that decides which items are written; null to export all items</param>
+								ExportTreeCommand(Helpers::SubversionContext^ context, SubversionClient^ client, System::Uri^ root, long revision, System::String^ localRoot, ObjectModel::PathFilter^ filter);
+
+								/// <summary>
+								/// Default destructor
+								/// </summary>
+								~ExportTreeCommand();
+
+								/// <summary>
+								/// Default Finalizer
+								/// </summary>
+								!ExportTreeCommand();
+
+								/// <summary>
+								/// Exports the tree
+								/// </summary>
+								/// <param name="items">The directories and files that have been written</param>
+								/// <exception cref="MigrationException">Will be thrown if a file could not be written or does not match the checksum of the repository</exception>
+								void Execute([Out] List<ObjectModel::Item^>^% items);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "Depth.h"
+#include "DirentFields.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Net;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						ref class SubversionClient;
+
+						namespace ObjectModel
+						{
+							ref class CommitItem;
+							ref class ContentDigest;
+							ref class Item;
+							ref class ItemInfo;
+							ref class ChangeSet;
+							ref class LocationSegment;
+							ref class PathFilter;
+							ref class RevisionFilter;
+						}
+
+						namespace Backends
+						{
+							/// <summary>
+							/// A backend executes the actual repository requests on behalf of a <see cref="SubversionClient"/>.
+							/// The default backend talks to a live subversion server. Other backends can record or replay the traffic
+							/// which allows to benchmark and test the adapter without a subversion server
+							/// </summary>
+							public interface class IRepositoryBackend
+							{
+								/// <summary>
+								/// Establishes a connection to the repository
+								/// </summary>
+								/// <param name="client">The client that owns this backend. The client is needed to construct the object model</param>
+								/// <param name="repository">The uri of the repository</param>
+								/// <param name="credential">The credentials that will be used to connect to the repository</param>
+								/// <param name="repositoryRoot">The real root uri of the subversion repository</param>
+								/// <param name="repositoryId">The unique ID that can be used to identitfy the repository</param>
+								void Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId);
+
+								/// <summary>
+								/// Closes the connection and release all ressources
+								/// </summary>
+								void Close();
+
+								/// <summary>
+								/// Gets the latest revision number of a specific path
+								/// </summary>
+								/// <param name="path">The path for which we want to receive the latest revision</param>
+								long GetLatestRevisionNumber(Uri^ path);
+
+								/// <summary>
+								/// Queries the history log for a specific item in the subversion repository
+								/// </summary>
+								/// <param name="path">The path for which we want to receive the history log</param>
+								/// <param name="pegRevisionNumber">The peg revision of the path; -1 if unspecified</param>
+								/// <param name="startRevisionNumber">The start revision number of the range; -1 if unspecified</param>
+								/// <param name="endRevisionNumber">The end revision number of the range; -1 if unspecified</param>
+								/// <param name="limit">The maximum number of items which we want to retrieve as result; 0 is infitnity</param>
+								/// <param name="includeChanges">Determines whether we also want to retrieve the changed paths</param>
+								/// <param name="pathFilter">The filter that decides which changed paths are materialized; null to materialize all changes</param>
+								/// <param name="revisionFilter">The filter that decides which revisions are materialized; null to materialize all revisions</param>
+								Dictionary<long, ObjectModel::ChangeSet^>^ QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, ObjectModel::PathFilter^ pathFilter, ObjectModel::RevisionFilter^ revisionFilter);
+
+								/// <summary>
+								/// Queries the item info for a specific item at a specific revision
+								/// </summary>
+								/// <param name="path">The full path of the item that has to be queried</param>
+								/// <param name="revision">The revision of the item that has to be queried</param>
+								/// <param name="depth">Defines the recursin level</param>
+								List<ObjectModel::ItemInfo^>^ QueryItemInfo(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								/// <summary>
+								/// Download an item at a specific revision to a local destination path.
+								/// </summary>
+								/// <param name="fromPath">The full item path in the subversion repository</param>
+								/// <param name="revision">The revision of the item that has to be downloaded</param>
+								/// <param name="toPath">The full local path where the downloaded item shall be stored</param>
+								void DownloadItem(Uri^ fromPath, long revision, String^ toPath);
+
+								/// <summary>
+								/// Downloads an item like <see cref="DownloadItem"/> and computes the hashes of the content in the same pass
+								/// </summary>
+								/// <param name="fromPath">The full item path in the subversion repository</param>
+								/// <param name="revision">The revision of the item that has to be downloaded</param>
+								/// <param name="toPath">The full local path where the downloaded item shall be stored</param>
+								/// <returns>The hashes of the downloaded file</returns>
+								ObjectModel::ContentDigest^ DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath);
+
+								/// <summary>
+								/// Compares two subversion item at specific revisions for content change
+								/// </summary>
+								/// <returns>True if the items do not have any content change; false otherwise</returns>
+								bool AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								/// <summary>
+								/// Compares two folders recursively and returns every item that differs
+								/// </summary>
+								/// <returns>The full server paths below of <paramref name="path2"/> of all items that have been added, modified or deleted</returns>
+								List<String^>^ GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								/// <summary>
+								/// Writes the content of a folder at a specific revision to a local directory
+								/// </summary>
+								/// <param name="root">The full path of the folder in the subversion repository</param>
+								/// <param name="revision">The revision of the folder</param>
+								/// <param name="localRoot">The local directory that receives the content of <paramref name="root"/></param>
+								/// <param name="filter">The filter that decides which items are written; null to write all items</param>
+								/// <returns>The directories and files that have been written</returns>
+								List<ObjectModel::Item^>^ ExportTree(Uri^ root, long revision, String^ localRoot, ObjectModel::PathFilter^ filter);
+
+								/// <summary>
+								/// Lists the items below of specific path
+								/// </summary>
+								/// <param name="path">The path for which the items shall be listed</param>
+								/// <param name="revision">The revision for which the items shall be listed</param>
+								/// <param name="depth">The recursion type used to retrieve the items</param>
+								List<ObjectModel::Item^>^ GetItems(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								/// <summary>
+								/// Lists the items below of specific path. The items can be consumed while the listing is still in progress
+								/// </summary>
+								/// <param name="path">The path for which the items shall be listed</param>
+								/// <param name="revision">The revision for which the items shall be listed</param>
+								/// <param name="depth">The recursion type used to retrieve the items</param>
+								/// <param name="fields">The fields that have to be retrieved for every item. The kind and the path are always retrieved</param>
+								IEnumerable<ObjectModel::Item^>^ EnumerateItems(Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields);
+
+								/// <summary>
+								/// Queries the locations at which an item lived within a revision range
+								/// </summary>
+								/// <param name="path">The path of the item</param>
+								/// <param name="pegRevision">The revision in which the item is identified by the path; -1 for the head revision</param>
+								/// <param name="startRevision">The youngest revision of interest; -1 for the peg revision</param>
+								/// <param name="endRevision">The oldest revision of interest; -1 for the first revision of the item</param>
+								/// <returns>The segments ordered from the youngest to the oldest one</returns>
+								List<ObjectModel::LocationSegment^>^ GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision);
+
+								/// <summary>
+								/// Commits the items as a single revision
+								/// </summary>
+								/// <param name="repositoryRoot">The root of the repository. All paths of the items are relative to it</param>
+								/// <param name="items">The changes of the revision</param>
+								/// <param name="message">The log message of the revision</param>
+								/// <returns>The number of the new revision</returns>
+								long Commit(Uri^ repositoryRoot, IEnumerable<ObjectModel::CommitItem^>^ items, String^ message);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -30,7 +30,7 @@ Item::Item(String^ fullpath, const svn_dirent_t* dirent, String^ repositoryRoot)
 	m_fullServerPath = fullpath;
 	m_repositoryRoot = repositoryRoot;
 
-	m_size = (long)dirent->size;
+	m_size = dirent->size;
 	m_createdRev = (long)dirent->created_rev;	
 	m_lastAuthor = Utils::ConvertUTF8ToString(dirent->last_author);
 	
@@ -49,6 +49,32 @@ Item::Item(String^ fullpath, const svn_dirent_t* dirent, String^ repositoryRoot)
 	}
 }
 
+Item::Item(String^ fullpath, ContentType^ itemType, long long size, long createdRev, String^ lastAuthor, String^ repositoryRoot)
+{
+	if(nullptr == fullpath)
+	{
+		throw gcnew ArgumentNullException("fullpath");
+	}
+
+	if(nullptr == itemType)
+	{
+		throw gcnew ArgumentNullException("itemType");
+	}
+
+	if(nullptr == repositoryRoot)
+	{
+		throw gcnew ArgumentNullException("repositoryRoot");
+	}
+
+	m_fullServerPath = fullpath;
+	m_repositoryRoot = repositoryRoot;
+
+	m_itemType = itemType;
+	m_size = size;
+	m_createdRev = createdRev;
+	m_lastAuthor = lastAuthor;
+}
+
 long 
 Item::CreatedRev::get()
 { 
@@ -61,7 +87,7 @@ Item::ItemType::get()
    return m_itemType;
 }
 
-long 
+long long
 Item::Size::get()
 {
 	return m_size;
@@ -35,7 +35,7 @@ namespace Microsoft
 								long m_createdRev;
 
 								ContentType^ m_itemType;
-								long m_size;								
+								long long m_size;								
 
 							internal:
 								/// <summary>
@@ -46,6 +46,17 @@ namespace Microsoft
 								/// <param name"repositoryRoot">The root of the repository that will be used to calculate relative paths</param>
 								Item(String^ fullpath, const svn_dirent_t* dirent, String^ repositoryRoot);	
 
+								/// <summary>
+								/// Creates an item from already decoded values
+								/// </summary>
+								/// <param name"fullpath">The full path to the item</param>
+								/// <param name"itemType">The content type of the item</param>
+								/// <param name"size">The length of the file text, or 0 for directories</param>
+								/// <param name"createdRev">The revision when the item has been changed last</param>
+								/// <param name"lastAuthor">The author who changed the item last</param>
+								/// <param name"repositoryRoot">The root of the repository that will be used to calculate relative paths</param>
+								Item(String^ fullpath, ContentType^ itemType, long long size, long createdRev, String^ lastAuthor, String^ repositoryRoot);
+
 							public:
 								
 								/// <summary>
@@ -56,7 +67,7 @@ namespace Microsoft
 								/// <summary>
 								/// length of file text, or 0 for directories
 								/// </summary>
-								property long Size { long get(); }
+								property long long Size { long long get(); }
 
 								/// <summary>
 								/// The author who changed the item last
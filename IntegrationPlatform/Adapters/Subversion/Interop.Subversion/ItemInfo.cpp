@@ -37,6 +37,24 @@ ItemInfo::ItemInfo(const svn_info_t* info)
 	}
 }
 
+ItemInfo::ItemInfo(System::Uri^ uri, System::Uri^ repositoryRootUrl, long revision, ContentType^ itemType)
+{
+	if(nullptr == uri)
+	{
+		throw gcnew ArgumentNullException("uri");
+	}
+
+	if(nullptr == itemType)
+	{
+		throw gcnew ArgumentNullException("itemType");
+	}
+
+	m_uri = uri;
+	m_repositoryUri = repositoryRootUrl;
+	m_revision = revision;
+	m_itemType = itemType;
+}
+
 System::Uri^ 
 ItemInfo::Uri::get() 
 { 
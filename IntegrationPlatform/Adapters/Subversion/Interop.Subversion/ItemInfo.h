@@ -40,6 +40,15 @@ namespace Microsoft
 									/// <param name="changeDetail">Additional attributes of this change like the change action</param>
 									ItemInfo(const svn_info_t* info);
 
+									/// <summary>
+									/// Create a new SVN Info Object from already decoded values
+									/// </summary>
+									/// <param name="uri">The URI of the item</param>
+									/// <param name="repositoryRootUrl">The root url of the repository</param>
+									/// <param name="revision">The revision of the object</param>
+									/// <param name="itemType">The content type of the item</param>
+									ItemInfo(System::Uri^ uri, System::Uri^ repositoryRootUrl, long revision, ContentType^ itemType);
+
 								public:
 									
 									/// <summary>
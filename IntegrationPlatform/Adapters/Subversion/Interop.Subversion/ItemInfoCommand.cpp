@@ -23,11 +23,11 @@ using namespace Microsoft::TeamFoundation::Migration::Toolkit;
 [UnmanagedFunctionPointer(CallingConvention::Cdecl)]
 delegate svn_error_t* SvnItemInfoReceiverTDelegate(void *baton, const char *path, const svn_info_t *info, apr_pool_t *pool);
 
-ItemInfoCommand::ItemInfoCommand(SubversionClient^ client, System::Uri^ path, long revision, Depth depth)
+ItemInfoCommand::ItemInfoCommand(SubversionContext^ context, System::Uri^ path, long revision, Depth depth)
 {
-	if(nullptr == client)
+	if(nullptr == context)
 	{
-		throw gcnew ArgumentNullException("client");
+		throw gcnew ArgumentNullException("context");
 	}
 
 	if(nullptr == path)
@@ -35,7 +35,7 @@ ItemInfoCommand::ItemInfoCommand(SubversionClient^ client, System::Uri^ path, lo
 		throw gcnew ArgumentNullException("path");
 	}
 
-	m_client = client;
+	m_context = context;
 	m_path = path;
 	m_pegRevision = revision;
 	m_depth = depth;
@@ -67,7 +67,7 @@ ItemInfoCommand::Execute([Out] List<ItemInfo^>^% infoItems)
 
 	try
 	{
-		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_INFO2(pool->CopyString(m_path->AbsoluteUri) , &pegRevision, &revision, receiver, NULL, (svn_depth_t)m_depth, NULL,  m_client->Context->Handle, pool->Handle));
+		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_INFO2(pool->CopyString(m_path->AbsoluteUri) , &pegRevision, &revision, receiver, NULL, (svn_depth_t)m_depth, NULL,  m_context->Handle, pool->Handle));
 	}
 	finally
 	{
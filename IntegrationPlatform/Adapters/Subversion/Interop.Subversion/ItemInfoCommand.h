@@ -18,7 +18,10 @@ namespace Microsoft
 				{
 					namespace Subversion
 					{
-						ref class SubversionClient;
+						namespace Helpers
+						{
+							ref class SubversionContext;
+						}
 
 						namespace ObjectModel
 						{
@@ -30,7 +33,7 @@ namespace Microsoft
 							private ref class ItemInfoCommand
 							{
 							private:
-								SubversionClient^ m_client;
+								Helpers::SubversionContext^ m_context;
 								System::Uri^ m_path;
 								long m_pegRevision;
 								ObjectModel::Depth m_depth;
@@ -47,7 +50,7 @@ namespace Microsoft
 								/// <param name="path">The full path of the item that has to be queried</param>
 								/// <param name="revision">The revision of the item that has to be queried</param>
 								/// <param name="depth">Defines the recursin level</param>
-								ItemInfoCommand(SubversionClient^ context, System::Uri^ path, long revision, ObjectModel::Depth depth);
+								ItemInfoCommand(Helpers::SubversionContext^ context, System::Uri^ path, long revision, ObjectModel::Depth depth);
 
 								/// <summary>
 								/// Gets the requested item info objects
@@ -0,0 +1,153 @@
+#include "Stdafx.h"
+#include "Item.h"
+#include "ItemStream.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Collections::Concurrent;
+using namespace System::Threading;
+
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+ItemStream::ItemStream(int capacity, Action<ItemStream^>^ producer)
+{
+	if(capacity <= 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("capacity");
+	}
+
+	if(nullptr == producer)
+	{
+		throw gcnew ArgumentNullException("producer");
+	}
+
+	m_producer = producer;
+	m_queue = gcnew BlockingCollection<Item^>(gcnew ConcurrentQueue<Item^>(), capacity);
+	m_cancellation = gcnew CancellationTokenSource();
+}
+
+ItemStream::~ItemStream()
+{
+	Stop();
+}
+
+bool
+ItemStream::IsCancelled::get()
+{
+	return m_cancellation->IsCancellationRequested;
+}
+
+bool
+ItemStream::Post(Item^ item)
+{
+	try
+	{
+		m_queue->Add(item, m_cancellation->Token);
+		return true;
+	}
+	catch(OperationCanceledException^)
+	{
+		return false;
+	}
+}
+
+void
+ItemStream::Produce()
+{
+	try
+	{
+		m_producer(this);
+	}
+	catch(Exception^ e)
+	{
+		//The producer is expected to fail with a cancellation if the consumer stopped early
+		if(!IsCancelled)
+		{
+			m_error = e;
+		}
+	}
+	finally
+	{
+		m_queue->CompleteAdding();
+	}
+}
+
+void
+ItemStream::Stop()
+{
+	if(nullptr != m_thread)
+	{
+		m_cancellation->Cancel();
+		m_thread->Join();
+		m_thread = nullptr;
+	}
+}
+
+IEnumerator<Item^>^
+ItemStream::GetEnumerator()
+{
+	if(nullptr != m_thread || m_queue->IsAddingCompleted)
+	{
+		throw gcnew InvalidOperationException("The items of a stream can only be enumerated once");
+	}
+
+	m_thread = gcnew Thread(gcnew ThreadStart(this, &ItemStream::Produce));
+	m_thread->IsBackground = true;
+	m_thread->Start();
+
+	return this;
+}
+
+System::Collections::IEnumerator^
+ItemStream::GetEnumeratorNonGeneric()
+{
+	return GetEnumerator();
+}
+
+bool
+ItemStream::MoveNext()
+{
+	if(nullptr == m_thread)
+	{
+		return false;
+	}
+
+	Item^ item;
+	if(m_queue->TryTake(item, Timeout::Infinite))
+	{
+		m_current = item;
+		return true;
+	}
+
+	//The queue is empty and the producer has finished
+	m_current = nullptr;
+	m_thread->Join();
+	m_thread = nullptr;
+
+	if(nullptr != m_error)
+	{
+		throw gcnew MigrationException("Subversion Client: The listing of the items failed", m_error);
+	}
+
+	return false;
+}
+
+void
+ItemStream::Reset()
+{
+	throw gcnew NotSupportedException();
+}
+
+Item^
+ItemStream::Current::get()
+{
+	return m_current;
+}
+
+Object^
+ItemStream::CurrentNonGeneric::get()
+{
+	return m_current;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Collections::Concurrent;
+using namespace System::Threading;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace ObjectModel
+						{
+							ref class Item;
+						}
+
+						namespace Helpers
+						{
+							/// <summary>
+							/// A single pass sequence of items that are produced by a background listing. The producer is blocked as soon as
+							/// the bounded queue is full. Therefore only a small window of the listing is held in memory and the consumer
+							/// can process the first items while the listing is still running. Disposing the enumerator cancels the listing
+							/// </summary>
+							private ref class ItemStream : public IEnumerable<ObjectModel::Item^>, public IEnumerator<ObjectModel::Item^>
+							{
+							private:
+								Action<ItemStream^>^ m_producer;
+								BlockingCollection<ObjectModel::Item^>^ m_queue;
+								CancellationTokenSource^ m_cancellation;
+								Thread^ m_thread;
+								Exception^ m_error;
+								ObjectModel::Item^ m_current;
+
+								void Produce();
+								void Stop();
+
+							public:
+								/// <summary>
+								/// Creates a new stream. The producer is started with the enumeration
+								/// </summary>
+								/// <param name="capacity">The maximum number of items that are queued</param>
+								/// <param name="producer">The method that lists the items and posts them to the stream</param>
+								ItemStream(int capacity, Action<ItemStream^>^ producer);
+
+								/// <summary>
+								/// Default destructor. Cancels the producer if it is still running
+								/// </summary>
+								~ItemStream();
+
+								/// <summary>
+								/// Gets whether the consumer has stopped the enumeration
+								/// </summary>
+								property bool IsCancelled { bool get(); }
+
+								/// <summary>
+								/// Queues an item. Blocks until there is room in the queue
+								/// </summary>
+								/// <returns>true if the item has been queued; false if the enumeration has been cancelled and the producer has to stop</returns>
+								bool Post(ObjectModel::Item^ item);
+
+								virtual IEnumerator<ObjectModel::Item^>^ GetEnumerator();
+
+								virtual System::Collections::IEnumerator^ GetEnumeratorNonGeneric() = System::Collections::IEnumerable::GetEnumerator;
+
+								virtual bool MoveNext();
+
+								virtual void Reset();
+
+								property ObjectModel::Item^ Current { virtual ObjectModel::Item^ get(); }
+
+								property Object^ CurrentNonGeneric { virtual Object^ get() = System::Collections::IEnumerator::Current::get; }
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
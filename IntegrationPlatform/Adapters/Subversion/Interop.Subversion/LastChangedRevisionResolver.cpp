@@ -0,0 +1,139 @@
+#include "Stdafx.h"
+#include "ChangeSet.h"
+#include "IRepositoryBackend.h"
+#include "LastChangedRevisionResolver.h"
+#include "LocationSegment.h"
+#include "Utils.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Backends;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+LastChangedRevisionResolver::LastChangedRevisionResolver(IRepositoryBackend^ backend)
+{
+	if(nullptr == backend)
+	{
+		throw gcnew ArgumentNullException("backend");
+	}
+
+	m_backend = backend;
+	m_segments = gcnew Dictionary<String^, List<LocationSegment^>^>(StringComparer::Ordinal);
+	m_indices = gcnew Dictionary<String^, RevisionIndex^>(StringComparer::Ordinal);
+}
+
+void
+LastChangedRevisionResolver::Clear()
+{
+	m_segments->Clear();
+	m_indices->Clear();
+}
+
+LocationSegment^
+LastChangedRevisionResolver::FindSegment(String^ path, long revision)
+{
+	List<LocationSegment^>^ segments;
+	if(m_segments->TryGetValue(path, segments))
+	{
+		for each(LocationSegment^ segment in segments)
+		{
+			if(segment->Contains(revision))
+			{
+				return segment;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+LocationSegment^
+LastChangedRevisionResolver::QuerySegment(Uri^ path, long revision)
+{
+	String^ key = path->ToString()->TrimEnd(Utils::SeperatorCharArray);
+
+	List<LocationSegment^>^ segments;
+	if(!m_segments->TryGetValue(key, segments))
+	{
+		segments = gcnew List<LocationSegment^>();
+		m_segments->Add(key, segments);
+	}
+
+	//We are only interested in the segments in which the item lived at the requested path. A single request
+	//delivers all of them down to the first revision which serves all the following requests for older revisions as well
+	for each(LocationSegment^ segment in m_backend->GetLocationSegments(path, revision, revision, 0))
+	{
+		if(!String::Equals(key, segment->FullServerPath, StringComparison::Ordinal))
+		{
+			continue;
+		}
+
+		//A segment that starts at the same revision is the same segment that has been reported by an older peg revision. The new one is at least as long
+		for(int i = segments->Count - 1; i >= 0; i--)
+		{
+			if(segments[i]->RangeStart == segment->RangeStart)
+			{
+				segments->RemoveAt(i);
+			}
+		}
+
+		segments->Add(segment);
+	}
+
+	return FindSegment(key, revision);
+}
+
+long
+LastChangedRevisionResolver::Resolve(Uri^ path, long revision)
+{
+	if(nullptr == path)
+	{
+		throw gcnew ArgumentNullException("path");
+	}
+
+	LocationSegment^ segment = FindSegment(path->ToString()->TrimEnd(Utils::SeperatorCharArray), revision);
+	if(nullptr == segment)
+	{
+		segment = QuerySegment(path, revision);
+		if(nullptr == segment)
+		{
+			//The item did not exist at this path in the requested revision
+			return -1;
+		}
+	}
+
+	//The item has been created at the start of the segment. Therefore the last change is always part of the segment
+	String^ indexKey = String::Concat(segment->FullServerPath, "@", segment->RangeStart.ToString());
+
+	RevisionIndex^ index;
+	if(!m_indices->TryGetValue(indexKey, index))
+	{
+		index = gcnew RevisionIndex();
+		index->Revisions = gcnew List<long>();
+		index->UpperBound = segment->RangeStart - 1;
+		m_indices->Add(indexKey, index);
+	}
+
+	if(revision > index->UpperBound)
+	{
+		//Only the revisions that are not known yet are requested. The log is returned in ascending order which keeps the index sorted
+		Dictionary<long, ChangeSet^>^ changesets = m_backend->QueryHistory(path, revision, index->UpperBound + 1, revision, 0, false, nullptr, nullptr);
+
+		List<long>^ revisions = gcnew List<long>(changesets->Keys);
+		revisions->Sort();
+		index->Revisions->AddRange(revisions);
+		index->UpperBound = revision;
+	}
+
+	int position = index->Revisions->BinarySearch(revision);
+	if(position >= 0)
+	{
+		return index->Revisions[position];
+	}
+
+	//The complement of the result is the position of the next younger revision. We need the one before
+	position = ~position;
+	return position > 0 ? index->Revisions[position - 1] : -1;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Backends
+						{
+							interface class IRepositoryBackend;
+						}
+
+						namespace ObjectModel
+						{
+							ref class LocationSegment;
+						}
+
+						namespace Helpers
+						{
+							/// <summary>
+							/// Resolves the last revision up to a given revision in which an item has been changed.
+							/// <para/>
+							/// The history of an item is split into its location segments. Every segment owns a sorted index of the revisions in which the item has been changed.
+							/// The index is filled incrementally from the history log and only the revisions beyond the already known range are requested from the repository.
+							/// Therefore most of the requests are answered by a binary search without a round trip to the server
+							/// </summary>
+							private ref class LastChangedRevisionResolver
+							{
+							private:
+								/// <summary>
+								/// The sorted revisions in which the item of a location segment has been changed
+								/// </summary>
+								ref class RevisionIndex
+								{
+								public:
+									List<long>^ Revisions;
+
+									/// <summary>
+									/// The youngest revision up to which the index is complete
+									/// </summary>
+									long UpperBound;
+								};
+
+								Backends::IRepositoryBackend^ m_backend;
+
+								//The known location segments per path and the revision index per segment
+								Dictionary<String^, List<ObjectModel::LocationSegment^>^>^ m_segments;
+								Dictionary<String^, RevisionIndex^>^ m_indices;
+
+								ObjectModel::LocationSegment^ FindSegment(String^ path, long revision);
+								ObjectModel::LocationSegment^ QuerySegment(Uri^ path, long revision);
+
+							public:
+								/// <summary>
+								/// Creates a new resolver
+								/// </summary>
+								/// <param name="backend">The backend that is used to query the location segments and the history</param>
+								LastChangedRevisionResolver(Backends::IRepositoryBackend^ backend);
+
+								/// <summary>
+								/// Gets the last revision in which the item has been changed
+								/// </summary>
+								/// <param name="path">The path of the item</param>
+								/// <param name="revision">The revision in which the item is identified by the path</param>
+								/// <returns>The youngest revision that is older or equal to the revision in which the item has been changed; -1 if the item does not exist</returns>
+								long Resolve(Uri^ path, long revision);
+
+								/// <summary>
+								/// Drops all cached segments and revisions
+								/// </summary>
+								void Clear();
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -1,12 +1,16 @@
 #include "Stdafx.h"
+#include <svn_error_codes.h>
 #include "AprPool.h"
 #include "DI_LibApr.h"
 #include "DI_Svn_Client-1.h"
+#include "DI_Svn_Subr-1.h"
 #include "Item.h"
+#include "ItemStream.h"
 #include "LibraryLoader.h"
 #include "ListCommand.h"
 #include "SubversionClient.h"
 #include "SubversionContext.h"
+#include "SubversionContextPool.h"
 #include "SvnError.h"
 #include "Utils.h"
 
@@ -20,22 +24,126 @@ using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop
 [UnmanagedFunctionPointer(CallingConvention::Cdecl)]
 delegate svn_error_t* SvnClientListFuncTDelegate(void *baton, const char *path, const svn_dirent_t *dirent, const svn_lock_t *lock, const char *abs_path, apr_pool_t *pool);
 
-ListCommand::ListCommand(SubversionClient^ client, System::Uri^ path, long revision, ObjectModel::Depth depth)
+ListCommand::ListCommand(SubversionContext^ context, SubversionClient^ client, System::Uri^ path, long revision, ObjectModel::Depth depth)
 {
+	if(nullptr == context)
+		throw gcnew ArgumentNullException("context");
+
+	if(nullptr == client)
+		throw gcnew ArgumentNullException("client");
+
+	if(nullptr == path)
+		throw gcnew ArgumentNullException("path");
+
+	m_context = context;
+	m_client = client;
+	m_path = path;
+	m_revision = revision;
+	m_depth = depth;
+	m_fields = DirentFields::All;
+}
+
+ListCommand::ListCommand(SubversionContext^ context, SubversionClient^ client, System::Uri^ path, long revision, ObjectModel::Depth depth, DirentFields fields)
+{
+	if(nullptr == context)
+		throw gcnew ArgumentNullException("context");
+
+	if(nullptr == client)
+		throw gcnew ArgumentNullException("client");
+
+	if(nullptr == path)
+		throw gcnew ArgumentNullException("path");
+
+	m_context = context;
+	m_client = client;
+	m_path = path;
+	m_revision = revision;
+	m_depth = depth;
+	m_fields = fields | DirentFields::Kind;
+}
+
+ListCommand::ListCommand(SubversionContextPool^ contexts, SubversionClient^ client, System::Uri^ path, long revision, ObjectModel::Depth depth, DirentFields fields)
+{
+	if(nullptr == contexts)
+		throw gcnew ArgumentNullException("contexts");
+
 	if(nullptr == client)
 		throw gcnew ArgumentNullException("client");
 
 	if(nullptr == path)
 		throw gcnew ArgumentNullException("path");
 
+	m_contexts = contexts;
 	m_client = client;
 	m_path = path;
 	m_revision = revision;
 	m_depth = depth;
+	m_fields = fields | DirentFields::Kind;
 }
 
 void 
 ListCommand::Execute([Out] List<Item^>^% items)
+{
+	m_items = gcnew List<Item^>();
+	m_stream = nullptr;
+
+	try
+	{
+		if(nullptr != m_context)
+		{
+			Run(m_context);
+		}
+		else
+		{
+			SubversionContext^ context = m_contexts->Acquire();
+			bool succeeded = false;
+			try
+			{
+				Run(context);
+				succeeded = true;
+			}
+			finally
+			{
+				m_contexts->Release(context, RequestKind::Listing, succeeded, 0);
+			}
+		}
+	}
+	finally
+	{
+		items = m_items;
+	}
+}
+
+void 
+ListCommand::Execute(ItemStream^ stream)
+{
+	if(nullptr == stream)
+		throw gcnew ArgumentNullException("stream");
+
+	m_items = nullptr;
+	m_stream = stream;
+
+	if(nullptr != m_context)
+	{
+		Run(m_context);
+		return;
+	}
+
+	//The stream is consumed on an other thread. Therefore the listing must not share the context of the backend. Its duration
+	//depends on the consumer. It is neither counted against the limit nor reported to the concurrency controller
+	SubversionContext^ context = m_contexts->AcquireUnmetered();
+	try
+	{
+		Run(context);
+	}
+	finally
+	{
+		m_contexts->Release(context);
+	}
+}
+
+void 
+ListCommand::Run(SubversionContext^ context)
 {
 	svn_opt_revision_t revision;
 	revision.kind = svn_opt_revision_number;
@@ -50,15 +158,12 @@ ListCommand::Execute([Out] List<Item^>^% items)
 	GCHandle gch = GCHandle::Alloc(fp);
 	svn_client_list_func_t  receiver = static_cast<svn_client_list_func_t >(Marshal::GetFunctionPointerForDelegate(fp).ToPointer());
 
-	m_items = gcnew List<Item^>();
-
 	try
 	{
-		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_LIST2(pool->CopyString(m_path->AbsoluteUri), &pegRevision, &revision, (svn_depth_t)m_depth, SVN_DIRENT_ALL, false, receiver, NULL, m_client->Context->Handle, pool->Handle));
+		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_LIST2(pool->CopyString(m_path->AbsoluteUri), &pegRevision, &revision, (svn_depth_t)m_depth, (apr_uint32_t)m_fields, false, receiver, NULL, context->Handle, pool->Handle));
 	}
 	finally
 	{
-		items = m_items;
 		gch.Free();
 	}
 }
@@ -74,7 +179,15 @@ ListCommand::SvnClientListFuncT(void *baton, const char *path, const svn_dirent_
 	}
 
 	Item^ item = gcnew Item(fullpath, dirent, m_client->VirtualRepositoryRoot->ToString());
-	m_items->Add(item);
+	if(nullptr == m_stream)
+	{
+		m_items->Add(item);
+	}
+	else if(!m_stream->Post(item))
+	{
+		//The consumer has stopped the enumeration. Abort the listing instead of transferring the remaining entries
+		return Svn_subr::Instance()->SVN_ERROR_CREATE(SVN_ERR_CANCELLED, NULL, "The listing has been cancelled");
+	}
 
 	return SVN_NO_ERROR;
 }
@@ -2,6 +2,7 @@
 
 #include <svn_client.h>
 #include "Depth.h"
+#include "DirentFields.h"
 
 using namespace System::Collections::Generic;
 using namespace System::Runtime::InteropServices;
@@ -20,6 +21,13 @@ namespace Microsoft
 					{
 						ref class SubversionClient;
 
+						namespace Helpers
+						{
+							ref class SubversionContext;
+							ref class SubversionContextPool;
+							ref class ItemStream;
+						}
+
 						namespace ObjectModel
 						{
 							ref class Item;
@@ -33,27 +41,62 @@ namespace Microsoft
 								System::Uri^ m_path;
 								long m_revision;
 								ObjectModel::Depth m_depth;
+								ObjectModel::DirentFields m_fields;
+								Helpers::SubversionContext^ m_context;
+								Helpers::SubversionContextPool^ m_contexts;
+								Helpers::ItemStream^ m_stream;
 								SubversionClient^ m_client;
 
 								List<ObjectModel::Item^>^ m_items;
 
+								void Run(Helpers::SubversionContext^ context);
+
 								svn_error_t* SvnClientListFuncT(void *baton, const char *path, const svn_dirent_t *dirent, const svn_lock_t *lock, const char *abs_path, apr_pool_t *pool);
 
 							public:
 								/// <summary>
 								/// Creates a helper object that can be used to list the items of a file or folder
 								/// </summary>
-								/// <param name="client">The context that can be used to access the repository</param>
+								/// <param name="context">The context that can be used to access the repository</param>
+								/// <param name="client">The client that is used to calculate the paths of the items</param>
 								/// <param name="path">The path for which we want to retrieve the items</param>
 								/// <param name="revision">The revision for which we want to list the items</param>
 								/// <param name="path2">The depth of the items that we want to retrieve</param>
-								ListCommand(SubversionClient^ client, System::Uri^ path, long revision, ObjectModel::Depth depth);
+								ListCommand(Helpers::SubversionContext^ context, SubversionClient^ client, System::Uri^ path, long revision, ObjectModel::Depth depth);
+
+								/// <summary>
+								/// Creates a helper object that only requests the specified fields of the items
+								/// </summary>
+								/// <param name="context">The context that can be used to access the repository</param>
+								/// <param name="client">The client that is used to calculate the paths of the items</param>
+								/// <param name="path">The path for which we want to retrieve the items</param>
+								/// <param name="revision">The revision for which we want to list the items</param>
+								/// <param name="depth">The depth of the items that we want to retrieve</param>
+								/// <param name="fields">The fields that the server has to compute for every item</param>
+								ListCommand(Helpers::SubversionContext^ context, SubversionClient^ client, System::Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields);
 
 								/// <summary>
-								/// Executes the comparison of the objects
+								/// Creates a helper object that acquires a context from a pool while the items are listed
 								/// </summary>
-								/// <param name="result">The result of the comparison</param>
+								/// <param name="contexts">The pool that provides the context that is used to access the repository</param>
+								/// <param name="client">The client that is used to calculate the paths of the items</param>
+								/// <param name="path">The path for which we want to retrieve the items</param>
+								/// <param name="revision">The revision for which we want to list the items</param>
+								/// <param name="depth">The depth of the items that we want to retrieve</param>
+								/// <param name="fields">The fields that the server has to compute for every item</param>
+								ListCommand(Helpers::SubversionContextPool^ contexts, SubversionClient^ client, System::Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields);
+
+								/// <summary>
+								/// Lists the items
+								/// </summary>
+								/// <param name="items">The listed items</param>
 								void Execute([Out] List<ObjectModel::Item^>^% items);
+
+								/// <summary>
+								/// Lists the items and posts every item to a stream as soon as it is received. The listing is cancelled if the stream is closed
+								/// </summary>
+								/// <param name="stream">The stream that receives the items</param>
+								void Execute(Helpers::ItemStream^ stream);
 							};
 						}
 					}
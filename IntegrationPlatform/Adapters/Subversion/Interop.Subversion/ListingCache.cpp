@@ -0,0 +1,444 @@
+#include "Stdafx.h"
+#include "Item.h"
+#include "ListingCache.h"
+#include "Utils.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Threading;
+
+using namespace Microsoft::TeamFoundation::Migration::Toolkit::Services;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+ListingCache::ListingCache(Uri^ repositoryRoot, long long capacity)
+{
+	if(nullptr == repositoryRoot)
+	{
+		throw gcnew ArgumentNullException("repositoryRoot");
+	}
+
+	if(capacity < 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("capacity");
+	}
+
+	m_entries = gcnew Dictionary<String^, LinkedListNode<Entry^>^>(StringComparer::Ordinal);
+	m_recentlyUsed = gcnew LinkedList<Entry^>();
+	m_repositoryRoot = Normalize(repositoryRoot);
+	m_capacity = capacity;
+	m_size = 0;
+	m_hits = 0;
+	m_misses = 0;
+}
+
+long long
+ListingCache::Capacity::get()
+{
+	return m_capacity;
+}
+
+void
+ListingCache::Capacity::set(long long value)
+{
+	if(value < 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("value");
+	}
+
+	Monitor::Enter(this);
+	try
+	{
+		m_capacity = value;
+		Trim();
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+long long
+ListingCache::Hits::get()
+{
+	return m_hits;
+}
+
+long long
+ListingCache::Misses::get()
+{
+	return m_misses;
+}
+
+String^
+ListingCache::Normalize(Uri^ path)
+{
+	//The items are reported with unescaped paths. Therefore the requests have to be compared the same way
+	return path->ToString()->TrimEnd(Utils::SeperatorCharArray);
+}
+
+String^
+ListingCache::CreateKey(String^ path, long revision, Depth depth)
+{
+	return String::Concat(path, "@", revision.ToString(), ":", ((int)depth).ToString());
+}
+
+bool
+ListingCache::Covers(Entry^ entry, DirentFields fields)
+{
+	return fields == (entry->Fields & fields);
+}
+
+long long
+ListingCache::EstimateSize(Item^ item)
+{
+	//Object headers, the fields of the item and the references of both arrays plus the strings that are owned by the item.
+	//The repository string is shared between all items and is not taken into account
+	long long size = 96;
+	size += 2 * item->FullServerPath->Length;
+	if(nullptr != item->LastAuthor)
+	{
+		size += 2 * item->LastAuthor->Length;
+	}
+
+	return size;
+}
+
+ListingCache::Entry^
+ListingCache::Lookup(String^ key)
+{
+	LinkedListNode<Entry^>^ node;
+	if(!m_entries->TryGetValue(key, node))
+	{
+		return nullptr;
+	}
+
+	//Move the entry to the front. The entries at the end are the first candidates to be dropped
+	m_recentlyUsed->Remove(node);
+	m_recentlyUsed->AddFirst(node);
+
+	return node->Value;
+}
+
+List<Item^>^
+ListingCache::Slice(Entry^ entry, String^ path, Depth depth)
+{
+	//The paths are unique. A path that is not part of the listing did not exist in this revision
+	int self = Array::BinarySearch(entry->Paths, path, StringComparer::Ordinal);
+	if(self < 0)
+	{
+		return nullptr;
+	}
+
+	List<Item^>^ items = gcnew List<Item^>();
+	items->Add(entry->Items[self]);
+
+	if(Depth::Empty == depth)
+	{
+		return items;
+	}
+
+	//The children of the path are sorted between "path/" and "path0" because '0' is the character that follows '/'
+	int first = Array::BinarySearch(entry->Paths, String::Concat(path, "/"), StringComparer::Ordinal);
+	int last = Array::BinarySearch(entry->Paths, String::Concat(path, "0"), StringComparer::Ordinal);
+	first = first < 0 ? ~first : first;
+	last = last < 0 ? ~last : last;
+
+	for(int i = first; i < last; i++)
+	{
+		if(Depth::Infinity != depth)
+		{
+			//Only the immediate children are requested
+			if(entry->Paths[i]->IndexOf('/', path->Length + 1) >= 0)
+			{
+				continue;
+			}
+
+			if(Depth::Files == depth && WellKnownContentType::VersionControlledFile != entry->Items[i]->ItemType)
+			{
+				continue;
+			}
+		}
+
+		items->Add(entry->Items[i]);
+	}
+
+	return items;
+}
+
+bool
+ListingCache::TryGetItems(Uri^ path, long revision, Depth depth, DirentFields fields, [Out] List<Item^>^% items)
+{
+	items = nullptr;
+
+	if(nullptr == path)
+	{
+		throw gcnew ArgumentNullException("path");
+	}
+
+	if(revision < 0 || 0 == m_capacity)
+	{
+		return false;
+	}
+
+	String^ normalizedPath = Normalize(path);
+
+	Monitor::Enter(this);
+	try
+	{
+		//The listing itself is the best match
+		Entry^ entry = Lookup(CreateKey(normalizedPath, revision, depth));
+		if(nullptr != entry && Covers(entry, fields))
+		{
+			items = gcnew List<Item^>(entry->Items);
+			m_hits++;
+			return true;
+		}
+
+		//Every recursive listing of the path itself or a parent contains the requested items
+		String^ level = normalizedPath;
+		while(level->Length >= m_repositoryRoot->Length)
+		{
+			entry = Lookup(CreateKey(level, revision, Depth::Infinity));
+			if(nullptr != entry && Covers(entry, fields))
+			{
+				items = Slice(entry, normalizedPath, depth);
+				if(nullptr != items)
+				{
+					m_hits++;
+					return true;
+				}
+			}
+
+			int separator = level->LastIndexOf('/');
+			if(separator < 0)
+			{
+				break;
+			}
+
+			level = level->Substring(0, separator);
+		}
+
+		m_misses++;
+		return false;
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+void
+ListingCache::Add(Uri^ path, long revision, Depth depth, DirentFields fields, List<Item^>^ items)
+{
+	if(nullptr == path)
+	{
+		throw gcnew ArgumentNullException("path");
+	}
+
+	if(nullptr == items)
+	{
+		throw gcnew ArgumentNullException("items");
+	}
+
+	if(revision < 0 || 0 == m_capacity)
+	{
+		return;
+	}
+
+	Entry^ entry = gcnew Entry();
+	entry->Path = Normalize(path);
+	entry->Revision = revision;
+	entry->Depth = depth;
+	entry->Fields = fields;
+	entry->Key = CreateKey(entry->Path, revision, depth);
+	entry->Items = items->ToArray();
+	entry->Paths = gcnew array<String^>(entry->Items->Length);
+	entry->Size = 64;
+
+	for(int i = 0; i < entry->Items->Length; i++)
+	{
+		entry->Paths[i] = entry->Items[i]->FullServerPath->TrimEnd(Utils::SeperatorCharArray);
+		entry->Size += EstimateSize(entry->Items[i]);
+	}
+
+	Array::Sort(entry->Paths, entry->Items, StringComparer::Ordinal);
+
+	Monitor::Enter(this);
+	try
+	{
+		if(entry->Size > m_capacity)
+		{
+			return;
+		}
+
+		LinkedListNode<Entry^>^ node;
+		if(m_entries->TryGetValue(entry->Key, node))
+		{
+			if(Covers(node->Value, fields))
+			{
+				return;
+			}
+
+			//The new listing provides more fields than the cached one
+			m_recentlyUsed->Remove(node);
+			m_entries->Remove(entry->Key);
+			m_size -= node->Value->Size;
+		}
+
+		m_entries->Add(entry->Key, m_recentlyUsed->AddFirst(entry));
+		m_size += entry->Size;
+		Trim();
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+void
+ListingCache::Trim()
+{
+	while(m_size > m_capacity && nullptr != m_recentlyUsed->Last)
+	{
+		Entry^ entry = m_recentlyUsed->Last->Value;
+		m_recentlyUsed->RemoveLast();
+		m_entries->Remove(entry->Key);
+		m_size -= entry->Size;
+	}
+}
+
+void
+ListingCache::Clear()
+{
+	Monitor::Enter(this);
+	try
+	{
+		m_entries->Clear();
+		m_recentlyUsed->Clear();
+		m_size = 0;
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+IEnumerable<Item^>^
+ListingCache::Record(Uri^ path, long revision, Depth depth, DirentFields fields, IEnumerable<Item^>^ items)
+{
+	if(nullptr == path)
+	{
+		throw gcnew ArgumentNullException("path");
+	}
+
+	if(nullptr == items)
+	{
+		throw gcnew ArgumentNullException("items");
+	}
+
+	if(revision < 0 || 0 == m_capacity)
+	{
+		return items;
+	}
+
+	return gcnew Recorder(this, path, revision, depth, fields, items);
+}
+
+ListingCache::Recorder::Recorder(ListingCache^ cache, Uri^ path, long revision, Depth depth, DirentFields fields, IEnumerable<Item^>^ source)
+{
+	m_cache = cache;
+	m_path = path;
+	m_revision = revision;
+	m_depth = depth;
+	m_fields = fields;
+	m_source = source;
+}
+
+ListingCache::Recorder::~Recorder()
+{
+	//An enumeration that has been stopped early is incomplete and must not be cached
+	m_items = nullptr;
+
+	if(nullptr != m_enumerator)
+	{
+		delete m_enumerator;
+	}
+}
+
+IEnumerator<Item^>^
+ListingCache::Recorder::GetEnumerator()
+{
+	if(nullptr != m_enumerator)
+	{
+		throw gcnew InvalidOperationException("The items of a recorded listing can only be enumerated once");
+	}
+
+	m_enumerator = m_source->GetEnumerator();
+	m_items = gcnew List<Item^>();
+	m_size = 64;
+
+	return this;
+}
+
+System::Collections::IEnumerator^
+ListingCache::Recorder::GetEnumeratorNonGeneric()
+{
+	return GetEnumerator();
+}
+
+bool
+ListingCache::Recorder::MoveNext()
+{
+	if(nullptr == m_enumerator)
+	{
+		return false;
+	}
+
+	if(m_enumerator->MoveNext())
+	{
+		m_current = m_enumerator->Current;
+
+		if(nullptr != m_items)
+		{
+			m_items->Add(m_current);
+			m_size += EstimateSize(m_current);
+
+			//The listing would be rejected by the cache anyway. Therefore the memory is released while the enumeration continues
+			if(m_size > m_cache->m_capacity)
+			{
+				m_items = nullptr;
+			}
+		}
+
+		return true;
+	}
+
+	m_current = nullptr;
+
+	if(nullptr != m_items)
+	{
+		m_cache->Add(m_path, m_revision, m_depth, m_fields, m_items);
+		m_items = nullptr;
+	}
+
+	return false;
+}
+
+void
+ListingCache::Recorder::Reset()
+{
+	throw gcnew NotSupportedException();
+}
+
+Item^
+ListingCache::Recorder::Current::get()
+{
+	return m_current;
+}
+
+Object^
+ListingCache::Recorder::CurrentNonGeneric::get()
+{
+	return m_current;
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Depth.h"
+#include "DirentFields.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace ObjectModel
+						{
+							ref class Item;
+						}
+
+						namespace Helpers
+						{
+							/// <summary>
+							/// Memory budgeted LRU cache of directory listings keyed by path, revision and depth.
+							/// <para/>
+							/// A listing of a specific revision never changes. Therefore the entries do not have to be invalidated. 
+							/// The items of a listing are kept sorted by their path which allows to serve the listing of any subtree by slicing
+							/// the recursive listing of one of its parents. Every entry remembers the fields that have been requested for its
+							/// items. A listing is only served from an entry that provides at least the requested fields
+							/// </summary>
+							private ref class ListingCache
+							{
+							private:
+								ref class Entry
+								{
+								public:
+									String^ Key;
+									String^ Path;
+									long Revision;
+									ObjectModel::Depth Depth;
+									ObjectModel::DirentFields Fields;
+
+									//Both arrays are sorted by the ordinal order of the paths
+									array<String^>^ Paths;
+									array<ObjectModel::Item^>^ Items;
+
+									long long Size;
+								};
+
+								/// <summary>
+								/// Passes the items of a streamed listing through and adds the listing to the cache once it has been enumerated completely.
+								/// The items are no longer collected as soon as they exceed the capacity of the cache
+								/// </summary>
+								ref class Recorder : public IEnumerable<ObjectModel::Item^>, public IEnumerator<ObjectModel::Item^>
+								{
+								private:
+									ListingCache^ m_cache;
+									Uri^ m_path;
+									long m_revision;
+									ObjectModel::Depth m_depth;
+									ObjectModel::DirentFields m_fields;
+									IEnumerable<ObjectModel::Item^>^ m_source;
+									IEnumerator<ObjectModel::Item^>^ m_enumerator;
+									List<ObjectModel::Item^>^ m_items;
+									long long m_size;
+									ObjectModel::Item^ m_current;
+
+								public:
+									Recorder(ListingCache^ cache, Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields, IEnumerable<ObjectModel::Item^>^ source);
+
+									/// <summary>
+									/// Default destructor. Stops the enumeration of the source
+									/// </summary>
+									~Recorder();
+
+									virtual IEnumerator<ObjectModel::Item^>^ GetEnumerator();
+
+									virtual System::Collections::IEnumerator^ GetEnumeratorNonGeneric() = System::Collections::IEnumerable::GetEnumerator;
+
+									virtual bool MoveNext();
+
+									virtual void Reset();
+
+									property ObjectModel::Item^ Current { virtual ObjectModel::Item^ get(); }
+
+									property Object^ CurrentNonGeneric { virtual Object^ get() = System::Collections::IEnumerator::Current::get; }
+								};
+
+								Dictionary<String^, LinkedListNode<Entry^>^>^ m_entries;
+								LinkedList<Entry^>^ m_recentlyUsed;
+								String^ m_repositoryRoot;
+								long long m_capacity;
+								long long m_size;
+								long long m_hits;
+								long long m_misses;
+
+								static String^ CreateKey(String^ path, long revision, ObjectModel::Depth depth);
+								static bool Covers(Entry^ entry, ObjectModel::DirentFields fields);
+								static String^ Normalize(Uri^ path);
+								static long long EstimateSize(ObjectModel::Item^ item);
+
+								Entry^ Lookup(String^ key);
+								List<ObjectModel::Item^>^ Slice(Entry^ entry, String^ path, ObjectModel::Depth depth);
+								void Trim();
+
+							public:
+								/// <summary>
+								/// Creates a new cache
+								/// </summary>
+								/// <param name="repositoryRoot">The root of the repository. Parent listings are not searched beyond of it</param>
+								/// <param name="capacity">The estimated number of bytes that the cached items may occupy</param>
+								ListingCache(Uri^ repositoryRoot, long long capacity);
+
+								/// <summary>
+								/// Gets or sets the estimated number of bytes that the cached items may occupy. 0 disables the cache
+								/// </summary>
+								property long long Capacity { long long get(); void set(long long value); }
+
+								/// <summary>
+								/// Gets the number of requests that have been served from the cache
+								/// </summary>
+								property long long Hits { long long get(); }
+
+								/// <summary>
+								/// Gets the number of requests that could not be served from the cache
+								/// </summary>
+								property long long Misses { long long get(); }
+
+								/// <summary>
+								/// Tries to serve a listing from the cache. Either the listing itself or a recursive listing of a parent has to be cached
+								/// with at least the requested fields
+								/// </summary>
+								/// <returns>true if the listing has been found; false otherwise</returns>
+								bool TryGetItems(Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields, [Out] List<ObjectModel::Item^>^% items);
+
+								/// <summary>
+								/// Adds a listing to the cache. The least recently used listings are dropped if the capacity is exceeded.
+								/// A cached listing of the same path is replaced if it provides less fields
+								/// </summary>
+								void Add(Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields, List<ObjectModel::Item^>^ items);
+
+								/// <summary>
+								/// Wraps a streamed listing. The listing is added to the cache once the returned sequence has been enumerated completely.
+								/// A listing that is stopped early or fails is not cached
+								/// </summary>
+								/// <returns>A single pass sequence of the items of the source</returns>
+								IEnumerable<ObjectModel::Item^>^ Record(Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields, IEnumerable<ObjectModel::Item^>^ items);
+
+								/// <summary>
+								/// Drops all listings
+								/// </summary>
+								void Clear();
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,467 @@
+#include "Stdafx.h"
+#include "ChangeSet.h"
+#include "CommitCommand.h"
+#include "CommitItem.h"
+#include "ContentDigest.h"
+#include "DiffSummaryCommand.h"
+#include "DownloadCommand.h"
+#include "ExportTreeCommand.h"
+#include "Item.h"
+#include "ItemInfo.h"
+#include "ItemInfoCommand.h"
+#include "ItemStream.h"
+#include "LatestRevisionCommand.h"
+#include "ListCommand.h"
+#include "LiveBackend.h"
+#include "LocationSegment.h"
+#include "LocationSegmentsCommand.h"
+#include "LogCommand.h"
+#include "ParallelListCommand.h"
+#include "PathFilter.h"
+#include "RevisionFilter.h"
+#include "SubversionClient.h"
+#include "SubversionContext.h"
+#include "SubversionContextPool.h"
+#include "SubversionInfoCommand.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Threading;
+
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Backends;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Commands;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+LiveBackend::LiveBackend()
+{
+	m_client = nullptr;
+	m_context = nullptr;
+	m_contexts = nullptr;
+	m_maximumConnections = 4;
+	m_bandwidth = 0;
+}
+
+LiveBackend::~LiveBackend()
+{
+	Close();
+}
+
+void
+LiveBackend::Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId)
+{
+	if(nullptr == client)
+	{
+		throw gcnew ArgumentNullException("client");
+	}
+
+	if(nullptr == repository)
+	{
+		throw gcnew ArgumentNullException("repository");
+	}
+
+	m_client = client;
+	m_credential = credential;
+	m_context = gcnew SubversionContext(credential);
+
+	SubversionInfoCommand^ command = gcnew SubversionInfoCommand(m_context, repository);
+	command->Execute(repositoryRoot, repositoryId);
+}
+
+void
+LiveBackend::Close()
+{
+	m_client = nullptr;
+	m_credential = nullptr;
+
+	ResetContexts();
+
+	if(nullptr != m_context)
+	{
+		delete m_context;
+		m_context = nullptr;
+	}
+}
+
+int
+LiveBackend::MaximumConnections::get()
+{
+	return m_maximumConnections;
+}
+
+void
+LiveBackend::MaximumConnections::set(int value)
+{
+	if(value <= 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("value");
+	}
+
+	m_maximumConnections = value;
+
+	//The pool is recreated with the new capacity by the next recursive listing
+	ResetContexts();
+}
+
+long long
+LiveBackend::Bandwidth::get()
+{
+	return m_bandwidth;
+}
+
+void
+LiveBackend::Bandwidth::set(long long value)
+{
+	if(value < 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("value");
+	}
+
+	m_bandwidth = value;
+
+	//The pool is recreated with the new ceiling by the next pooled request
+	ResetContexts();
+}
+
+SubversionContextPool^
+LiveBackend::EnsureContexts()
+{
+	//The history and the listings acquire their contexts from different threads
+	Monitor::Enter(this);
+	try
+	{
+		if(nullptr == m_contexts)
+		{
+			m_contexts = gcnew SubversionContextPool(m_credential, m_maximumConnections, m_bandwidth);
+		}
+
+		return m_contexts;
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+void
+LiveBackend::ResetContexts()
+{
+	SubversionContextPool^ contexts;
+
+	Monitor::Enter(this);
+	try
+	{
+		contexts = m_contexts;
+		m_contexts = nullptr;
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+
+	//Other threads may still use the old pool. Disposing it releases the idle contexts only. The contexts in use are
+	//released by the pool as soon as they are returned
+	if(nullptr != contexts)
+	{
+		delete contexts;
+	}
+}
+
+SubversionContext^
+LiveBackend::Context::get()
+{
+	return m_context;
+}
+
+void
+LiveBackend::EnsureOpen()
+{
+	if(nullptr == m_context)
+	{
+		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
+	}
+}
+
+long
+LiveBackend::GetLatestRevisionNumber(Uri^ path)
+{
+	EnsureOpen();
+
+	long result;
+
+	Monitor::Enter(m_context);
+	try
+	{
+		LatestRevisionCommand^ command = gcnew LatestRevisionCommand(m_context, path);
+		command->Execute(result);
+	}
+	finally
+	{
+		Monitor::Exit(m_context);
+	}
+
+	return result;
+}
+
+Dictionary<long, ChangeSet^>^
+LiveBackend::QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, PathFilter^ pathFilter, RevisionFilter^ revisionFilter)
+{
+	EnsureOpen();
+
+	Dictionary<long, ChangeSet^>^ changesets;
+
+	//The history is fetched with a context of its own. Therefore the log of the next revisions can be received while the
+	//changes of the previous ones are queried on the shared context
+	SubversionContextPool^ contexts = EnsureContexts();
+	SubversionContext^ context = contexts->Acquire();
+	bool succeeded = false;
+	try
+	{
+		LogCommand^ command = gcnew LogCommand(context, m_client, path, pegRevisionNumber, startRevisionNumber, endRevisionNumber, limit, includeChanges, pathFilter, revisionFilter);
+		command->Execute(changesets);
+		succeeded = true;
+	}
+	finally
+	{
+		contexts->Release(context, RequestKind::History, succeeded, 0);
+	}
+
+	return changesets;
+}
+
+List<ItemInfo^>^
+LiveBackend::QueryItemInfo(Uri^ path, long revision, Depth depth)
+{
+	EnsureOpen();
+
+	List<ItemInfo^>^ items;
+
+	Monitor::Enter(m_context);
+	try
+	{
+		ItemInfoCommand^ command = gcnew ItemInfoCommand(m_context, path, revision, depth);
+		command->Execute(items);
+	}
+	finally
+	{
+		Monitor::Exit(m_context);
+	}
+
+	return items;
+}
+
+void
+LiveBackend::DownloadItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	EnsureOpen();
+
+	//Downloads are issued by several threads at once. Each of them transfers its file on a context of its own
+	SubversionContextPool^ contexts = EnsureContexts();
+	SubversionContext^ context = contexts->Acquire();
+	bool succeeded = false;
+	long long bytes = 0;
+	try
+	{
+		DownloadCommand^ command = gcnew DownloadCommand(context, fromPath, revision, toPath);
+		command->Execute();
+		succeeded = true;
+
+		//The transferred size is charged against the bandwidth ceiling
+		bytes = (gcnew IO::FileInfo(toPath))->Length;
+	}
+	finally
+	{
+		contexts->Release(context, RequestKind::Download, succeeded, bytes);
+	}
+}
+
+ContentDigest^
+LiveBackend::DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	EnsureOpen();
+
+	ContentDigest^ digest;
+
+	SubversionContextPool^ contexts = EnsureContexts();
+	SubversionContext^ context = contexts->Acquire();
+	bool succeeded = false;
+	try
+	{
+		DownloadCommand^ command = gcnew DownloadCommand(context, fromPath, revision, toPath);
+		command->Execute(digest);
+		succeeded = true;
+	}
+	finally
+	{
+		contexts->Release(context, RequestKind::Download, succeeded, succeeded ? digest->Length : 0);
+	}
+
+	return digest;
+}
+
+bool
+LiveBackend::AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	EnsureOpen();
+
+	bool result;
+
+	Monitor::Enter(m_context);
+	try
+	{
+		DiffSummaryCommand^ command = gcnew DiffSummaryCommand(m_context, path1, revision1, path2, revision2);
+		command->AreEqual(result);
+	}
+	finally
+	{
+		Monitor::Exit(m_context);
+	}
+
+	return result;
+}
+
+List<String^>^
+LiveBackend::GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	EnsureOpen();
+
+	List<String^>^ items;
+
+	Monitor::Enter(m_context);
+	try
+	{
+		DiffSummaryCommand^ command = gcnew DiffSummaryCommand(m_context, path1, revision1, path2, revision2);
+		command->GetModifiedItems(items);
+	}
+	finally
+	{
+		Monitor::Exit(m_context);
+	}
+
+	return items;
+}
+
+List<Item^>^
+LiveBackend::ExportTree(Uri^ root, long revision, String^ localRoot, PathFilter^ filter)
+{
+	EnsureOpen();
+
+	List<Item^>^ items;
+
+	Monitor::Enter(m_context);
+	try
+	{
+		ExportTreeCommand^ command = gcnew ExportTreeCommand(m_context, m_client, root, revision, localRoot, filter);
+		try
+		{
+			command->Execute(items);
+		}
+		finally
+		{
+			delete command;
+		}
+	}
+	finally
+	{
+		Monitor::Exit(m_context);
+	}
+
+	return items;
+}
+
+List<Item^>^
+LiveBackend::GetItems(Uri^ path, long revision, Depth depth)
+{
+	EnsureOpen();
+
+	List<Item^>^ items;
+
+	if(Depth::Infinity == depth && m_maximumConnections > 1)
+	{
+		ParallelListCommand^ parallelCommand = gcnew ParallelListCommand(EnsureContexts(), m_client, path, revision);
+		parallelCommand->Execute(items);
+
+		return items;
+	}
+
+	Monitor::Enter(m_context);
+	try
+	{
+		ListCommand^ command = gcnew ListCommand(m_context, m_client, path, revision, depth);
+		command->Execute(items);
+	}
+	finally
+	{
+		Monitor::Exit(m_context);
+	}
+
+	return items;
+}
+
+IEnumerable<Item^>^
+LiveBackend::EnumerateItems(Uri^ path, long revision, Depth depth, DirentFields fields)
+{
+	EnsureOpen();
+
+	//A recursive listing is distributed across the pool like in GetItems. The merged listing provides all fields
+	if(Depth::Infinity == depth && m_maximumConnections > 1)
+	{
+		List<Item^>^ items;
+		ParallelListCommand^ parallelCommand = gcnew ParallelListCommand(EnsureContexts(), m_client, path, revision);
+		parallelCommand->Execute(items);
+
+		return items;
+	}
+
+	//The items are listed on a background thread. Therefore the command acquires a context of its own
+	ListCommand^ command = gcnew ListCommand(EnsureContexts(), m_client, path, revision, depth, fields);
+	return gcnew ItemStream(StreamCapacity, gcnew Action<ItemStream^>(command, &ListCommand::Execute));
+}
+
+List<LocationSegment^>^
+LiveBackend::GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision)
+{
+	EnsureOpen();
+
+	List<LocationSegment^>^ segments;
+
+	Monitor::Enter(m_context);
+	try
+	{
+		LocationSegmentsCommand^ command = gcnew LocationSegmentsCommand(m_context, m_client, path, pegRevision, startRevision, endRevision);
+		command->Execute(segments);
+	}
+	finally
+	{
+		Monitor::Exit(m_context);
+	}
+
+	return segments;
+}
+
+long
+LiveBackend::Commit(Uri^ repositoryRoot, IEnumerable<CommitItem^>^ items, String^ message)
+{
+	EnsureOpen();
+
+	long revision;
+
+	//The commit editor holds a session of its own. It runs on a pooled context and counts against the limit of the server
+	SubversionContextPool^ contexts = EnsureContexts();
+	SubversionContext^ context = contexts->Acquire();
+	bool succeeded = false;
+	try
+	{
+		CommitCommand^ command = gcnew CommitCommand(context, repositoryRoot, items, message);
+		command->Execute(revision);
+		succeeded = true;
+	}
+	finally
+	{
+		contexts->Release(context, RequestKind::Commit, succeeded, 0);
+	}
+
+	return revision;
+}
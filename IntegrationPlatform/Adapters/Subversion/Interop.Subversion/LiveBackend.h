@@ -0,0 +1,112 @@
+#pragma once
+
+#include "IRepositoryBackend.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Net;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							ref class SubversionContext;
+							ref class SubversionContextPool;
+						}
+
+						namespace Backends
+						{
+							/// <summary>
+							/// The default backend. All requests are executed against the subversion server using the svn_client library
+							/// </summary>
+							public ref class LiveBackend : public IRepositoryBackend
+							{
+							private:
+								SubversionClient^ m_client;
+								Helpers::SubversionContext^ m_context;
+								Helpers::SubversionContextPool^ m_contexts;
+								NetworkCredential^ m_credential;
+								int m_maximumConnections;
+								long long m_bandwidth;
+
+								static const int StreamCapacity = 1024;
+
+								void EnsureOpen();
+								Helpers::SubversionContextPool^ EnsureContexts();
+								void ResetContexts();
+
+							internal:
+								/// <summary>
+								/// Gets the context associated with this backend
+								/// </summary>
+								property Helpers::SubversionContext^ Context { Helpers::SubversionContext^ get(); }
+
+							public:
+								/// <summary>
+								/// Default Constructor
+								/// </summary>
+								LiveBackend();
+
+								/// <summary>
+								/// Default destructor
+								/// </summary>
+								~LiveBackend();
+
+								/// <summary>
+								/// Gets or sets the number of connections that may be used to list a tree recursively. 1 disables the parallel listing.
+								/// The history, the listings and the downloads share these connections. Their number is adjusted to the load of the server
+								/// but never exceeds this value
+								/// </summary>
+								property int MaximumConnections { int get(); void set(int value); }
+
+								/// <summary>
+								/// Gets or sets the maximum number of bytes per second that the downloads may transfer on average; 0 if the bandwidth is unlimited
+								/// </summary>
+								property long long Bandwidth { long long get(); void set(long long value); }
+
+								virtual void Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId);
+
+								virtual void Close();
+
+								virtual long GetLatestRevisionNumber(Uri^ path);
+
+								virtual Dictionary<long, ObjectModel::ChangeSet^>^ QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, ObjectModel::PathFilter^ pathFilter, ObjectModel::RevisionFilter^ revisionFilter);
+
+								virtual List<ObjectModel::ItemInfo^>^ QueryItemInfo(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								virtual void DownloadItem(Uri^ fromPath, long revision, String^ toPath);
+
+								virtual ObjectModel::ContentDigest^ DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath);
+
+								virtual bool AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								virtual List<String^>^ GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								virtual List<ObjectModel::Item^>^ ExportTree(Uri^ root, long revision, String^ localRoot, ObjectModel::PathFilter^ filter);
+
+								virtual List<ObjectModel::Item^>^ GetItems(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								virtual IEnumerable<ObjectModel::Item^>^ EnumerateItems(Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields);
+
+								virtual List<ObjectModel::LocationSegment^>^ GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision);
+
+								virtual long Commit(Uri^ repositoryRoot, IEnumerable<ObjectModel::CommitItem^>^ items, String^ message);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,823 @@
+#include "Stdafx.h"
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include <svn_props.h>
+#include "AprPool.h"
+#include "ChangeSet.h"
+#include "CommitItem.h"
+#include "ContentDigest.h"
+#include "DI_LibApr.h"
+#include "DI_Svn_Fs-1.h"
+#include "DI_Svn_Repos-1.h"
+#include "DI_Svn_Subr-1.h"
+#include "Item.h"
+#include "ItemInfo.h"
+#include "ItemStream.h"
+#include "LocalRepositoryBackend.h"
+#include "LocationSegment.h"
+#include "PathFilter.h"
+#include "RevisionFilter.h"
+#include "SubversionClient.h"
+#include "SvnError.h"
+#include "Utils.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::IO;
+using namespace System::Runtime::InteropServices;
+using namespace System::Security::Cryptography;
+using namespace System::Threading;
+
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Backends;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* SvnReposLogEntryReceiverTDelegate(void *baton, svn_log_entry_t *log_entry, apr_pool_t *pool);
+
+LocalListing::LocalListing(LocalRepositoryBackend^ backend, String^ path, long revision, Depth depth, DirentFields fields)
+{
+	m_backend = backend;
+	m_path = path;
+	m_revision = revision;
+	m_depth = depth;
+	m_fields = fields;
+}
+
+void
+LocalListing::Execute(ItemStream^ stream)
+{
+	m_backend->List(m_path, m_revision, m_depth, m_fields, nullptr, stream);
+}
+
+LocalHistory::LocalHistory(SubversionClient^ client, Dictionary<long, ChangeSet^>^ changesets, PathFilter^ pathFilter, RevisionFilter^ revisionFilter)
+{
+	m_client = client;
+	m_changesets = changesets;
+	m_pathFilter = pathFilter;
+	m_revisionFilter = revisionFilter;
+}
+
+svn_error_t*
+LocalHistory::SvnLogEntryReceiverT(void *baton, svn_log_entry_t *log_entry, apr_pool_t *pool)
+{
+	if(nullptr != m_revisionFilter && !m_revisionFilter->Matches(log_entry))
+	{
+		//The revision is rejected by its revision properties. It is only counted by the filter; no managed changeset is created for it
+		return SVN_NO_ERROR;
+	}
+
+	ChangeSet^ changeSet = gcnew ChangeSet(log_entry, m_client, pool, m_pathFilter);
+	m_changesets->Add(changeSet->Revision, changeSet);
+
+	return SVN_NO_ERROR;
+}
+
+LocalRepositoryBackend::LocalRepositoryBackend(IRepositoryBackend^ backend)
+{
+	if(nullptr == backend)
+	{
+		throw gcnew ArgumentNullException("backend");
+	}
+
+	m_backend = backend;
+	m_client = nullptr;
+
+	m_localPath = nullptr;
+	m_sessions = gcnew Stack<LocalSession^>();
+	m_generation = 0;
+}
+
+LocalRepositoryBackend::~LocalRepositoryBackend()
+{
+	Close();
+}
+
+void
+LocalRepositoryBackend::Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId)
+{
+	if(nullptr == client)
+	{
+		throw gcnew ArgumentNullException("client");
+	}
+
+	//The other backend resolves the root and the id of the repository through ra_local
+	m_backend->Open(client, repository, credential, repositoryRoot, repositoryId);
+
+	if(!repositoryRoot->IsFile)
+	{
+		throw gcnew MigrationException(String::Format("The repository '{0}' is not located on the local machine. Only file:// urls can be read from the repository layer", repositoryRoot));
+	}
+
+	//svn_repos_open expects a local path in the internal style of subversion
+	String^ localPath = repositoryRoot->LocalPath->Replace('\\', '/')->TrimEnd(Utils::SeperatorCharArray);
+
+	//The first session verifies that the repository can be opened. The sessions of a previous open are not reused
+	LocalSession^ session = OpenSession(localPath, 0);
+
+	array<LocalSession^>^ previous;
+	Monitor::Enter(m_sessions);
+	try
+	{
+		m_generation++;
+		session->Generation = m_generation;
+
+		previous = m_sessions->ToArray();
+		m_sessions->Clear();
+		m_sessions->Push(session);
+		m_localPath = localPath;
+	}
+	finally
+	{
+		Monitor::Exit(m_sessions);
+	}
+
+	for each(LocalSession^ idle in previous)
+	{
+		CloseSession(idle);
+	}
+
+	m_client = client;
+	m_repositoryRoot = repositoryRoot->ToString();
+	m_itemRoot = client->VirtualRepositoryRoot->ToString();
+}
+
+void
+LocalRepositoryBackend::Close()
+{
+	m_backend->Close();
+
+	//Sessions that are in use are closed when they are released
+	array<LocalSession^>^ idle;
+	Monitor::Enter(m_sessions);
+	try
+	{
+		m_localPath = nullptr;
+		m_generation++;
+
+		idle = m_sessions->ToArray();
+		m_sessions->Clear();
+	}
+	finally
+	{
+		Monitor::Exit(m_sessions);
+	}
+
+	for each(LocalSession^ session in idle)
+	{
+		CloseSession(session);
+	}
+
+	m_client = nullptr;
+}
+
+void
+LocalRepositoryBackend::EnsureOpen()
+{
+	if(nullptr == m_client)
+	{
+		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
+	}
+}
+
+LocalSession^
+LocalRepositoryBackend::OpenSession(String^ localPath, int generation)
+{
+	LocalSession^ session = gcnew LocalSession();
+	session->Pool = gcnew AprPool();
+	session->Repos = NULL;
+	session->Fs = NULL;
+	session->RootPool = nullptr;
+	session->Root = NULL;
+	session->RootRevision = -1;
+	session->Generation = generation;
+
+	try
+	{
+		svn_repos_t* repos = NULL;
+		SvnError::Err(Svn_Repos::Instance()->SVN_REPOS_OPEN(&repos, session->Pool->CopyString(localPath), session->Pool->Handle));
+
+		session->Repos = repos;
+		session->Fs = Svn_Repos::Instance()->SVN_REPOS_FS(repos);
+	}
+	catch(Exception^)
+	{
+		delete session->Pool;
+		throw;
+	}
+
+	return session;
+}
+
+LocalSession^
+LocalRepositoryBackend::AcquireSession()
+{
+	String^ localPath;
+	int generation;
+
+	Monitor::Enter(m_sessions);
+	try
+	{
+		if(nullptr == m_localPath)
+		{
+			throw gcnew MigrationException("Subversion Client: There is currently no active connection");
+		}
+
+		if(m_sessions->Count > 0)
+		{
+			return m_sessions->Pop();
+		}
+
+		localPath = m_localPath;
+		generation = m_generation;
+	}
+	finally
+	{
+		Monitor::Exit(m_sessions);
+	}
+
+	//A concurrent request opens the repository once more instead of waiting for the busy sessions
+	return OpenSession(localPath, generation);
+}
+
+void
+LocalRepositoryBackend::ReleaseSession(LocalSession^ session)
+{
+	Monitor::Enter(m_sessions);
+	try
+	{
+		if(nullptr != m_localPath && m_generation == session->Generation)
+		{
+			m_sessions->Push(session);
+			return;
+		}
+	}
+	finally
+	{
+		Monitor::Exit(m_sessions);
+	}
+
+	//The backend has been closed or opened again while the session was in use
+	CloseSession(session);
+}
+
+void
+LocalRepositoryBackend::CloseSession(LocalSession^ session)
+{
+	//The root pool is a child of the repository pool. It has to be destroyed first
+	session->Root = NULL;
+	session->RootRevision = -1;
+	if(nullptr != session->RootPool)
+	{
+		delete session->RootPool;
+		session->RootPool = nullptr;
+	}
+
+	session->Repos = NULL;
+	session->Fs = NULL;
+	if(nullptr != session->Pool)
+	{
+		delete session->Pool;
+		session->Pool = nullptr;
+	}
+}
+
+long
+LocalRepositoryBackend::ResolveRevision(LocalSession^ session, long revision)
+{
+	if(revision >= 0)
+	{
+		return revision;
+	}
+
+	AprPool^ pool = gcnew AprPool();
+	try
+	{
+		svn_revnum_t youngest = SVN_INVALID_REVNUM;
+		SvnError::Err(Svn_Fs::Instance()->SVN_FS_YOUNGEST_REV(&youngest, session->Fs, pool->Handle));
+		return (long)youngest;
+	}
+	finally
+	{
+		delete pool;
+	}
+}
+
+svn_fs_root_t*
+LocalRepositoryBackend::GetRoot(LocalSession^ session, long revision)
+{
+	revision = ResolveRevision(session, revision);
+	if(NULL != session->Root && revision == session->RootRevision)
+	{
+		return session->Root;
+	}
+
+	//A revision root caches the nodes that have been visited. The previous root is released with its pool
+	AprPool^ pool = gcnew AprPool(session->Pool);
+	svn_fs_root_t* root = NULL;
+	try
+	{
+		SvnError::Err(Svn_Fs::Instance()->SVN_FS_REVISION_ROOT(&root, session->Fs, (svn_revnum_t)revision, pool->Handle));
+	}
+	catch(Exception^)
+	{
+		delete pool;
+		throw;
+	}
+
+	if(nullptr != session->RootPool)
+	{
+		delete session->RootPool;
+	}
+
+	session->RootPool = pool;
+	session->Root = root;
+	session->RootRevision = revision;
+
+	return session->Root;
+}
+
+String^
+LocalRepositoryBackend::ToRepositoryPath(Uri^ path)
+{
+	if(nullptr == path)
+	{
+		throw gcnew ArgumentNullException("path");
+	}
+
+	return Utils::ExtractPath(m_repositoryRoot, path->ToString());
+}
+
+Item^
+LocalRepositoryBackend::ReadItem(LocalSession^ session, svn_fs_root_t* root, const char* path, svn_node_kind_t kind, DirentFields fields, Dictionary<long, String^>^ authors, AprPool^ pool)
+{
+	Svn_Fs^ fs = Svn_Fs::Instance();
+
+	svn_filesize_t size = 0;
+	if(svn_node_file == kind && DirentFields::Size == (fields & DirentFields::Size))
+	{
+		SvnError::Err(fs->SVN_FS_FILE_LENGTH(&size, root, path, pool->Handle));
+	}
+
+	svn_revnum_t createdRevision = SVN_INVALID_REVNUM;
+	String^ author = nullptr;
+	if(DirentFields::CreatedRevision == (fields & DirentFields::CreatedRevision) || DirentFields::LastAuthor == (fields & DirentFields::LastAuthor))
+	{
+		SvnError::Err(fs->SVN_FS_NODE_CREATED_REV(&createdRevision, root, path, pool->Handle));
+
+		//Most items of a tree share a few revisions. The author of each of them is read once per listing
+		if(DirentFields::LastAuthor == (fields & DirentFields::LastAuthor) && !authors->TryGetValue((long)createdRevision, author))
+		{
+			svn_string_t* value = NULL;
+			SvnError::Err(fs->SVN_FS_REVISION_PROP(&value, session->Fs, createdRevision, SVN_PROP_REVISION_AUTHOR, pool->Handle));
+
+			author = NULL == value ? nullptr : Utils::ConvertUTF8ToString(value->data);
+			authors->Add((long)createdRevision, author);
+		}
+	}
+
+	return gcnew Item(
+		Utils::Combine(m_repositoryRoot, Utils::ConvertUTF8ToString(path)),
+		svn_node_dir == kind ? WellKnownContentType::VersionControlledFolder : WellKnownContentType::VersionControlledFile,
+		size,
+		(long)createdRevision,
+		author,
+		m_itemRoot);
+}
+
+void
+LocalRepositoryBackend::List(String^ path, long revision, Depth depth, DirentFields fields, List<Item^>^ items, ItemStream^ stream)
+{
+	Dictionary<long, String^>^ authors = gcnew Dictionary<long, String^>();
+	svn_node_kind_t kind = svn_node_none;
+	Item^ item;
+
+	LocalSession^ session = AcquireSession();
+	try
+	{
+		//The whole listing reads the same revision even if a commit arrives while it is running
+		revision = ResolveRevision(session, revision);
+
+		AprPool^ pool = gcnew AprPool();
+		try
+		{
+			svn_fs_root_t* root = GetRoot(session, revision);
+			const char* target = pool->CopyString(path);
+
+			SvnError::Err(Svn_Fs::Instance()->SVN_FS_CHECK_PATH(&kind, root, target, pool->Handle));
+			if(svn_node_none == kind)
+			{
+				throw gcnew MigrationException(String::Format("The path '{0}' does not exist in revision {1} of the repository", Utils::Combine(m_repositoryRoot, path), revision));
+			}
+
+			item = ReadItem(session, root, target, kind, fields, authors, pool);
+		}
+		finally
+		{
+			delete pool;
+		}
+	}
+	finally
+	{
+		ReleaseSession(session);
+	}
+
+	if(nullptr == stream)
+	{
+		items->Add(item);
+	}
+	else if(!stream->Post(item))
+	{
+		return;
+	}
+
+	if(svn_node_dir == kind && Depth::Empty != depth)
+	{
+		ListDirectory(path, revision, depth, fields, authors, items, stream);
+	}
+}
+
+bool
+LocalRepositoryBackend::ListDirectory(String^ path, long revision, Depth depth, DirentFields fields, Dictionary<long, String^>^ authors, List<Item^>^ items, ItemStream^ stream)
+{
+	//The session is only held while a directory is read. A consumer that is blocked by the stream does not keep it from other requests
+	List<Item^>^ entries = gcnew List<Item^>();
+	List<String^>^ directories = gcnew List<String^>();
+
+	LocalSession^ session = AcquireSession();
+	try
+	{
+		AprPool^ pool = gcnew AprPool();
+		try
+		{
+			svn_fs_root_t* root = GetRoot(session, revision);
+
+			apr_hash_t* dirents = NULL;
+			SvnError::Err(Svn_Fs::Instance()->SVN_FS_DIR_ENTRIES(&dirents, root, pool->CopyString(path), pool->Handle));
+
+			std::vector<std::pair<std::string, svn_node_kind_t> > children;
+
+			LibApr^ libApr = LibApr::Instance();
+			const void* key;
+			void* value;
+			for(apr_hash_index_t* index = libApr->AprHashFirst(pool->Handle, dirents); index; index = libApr->AprHashNext(index))
+			{
+				libApr->AprHashThis(index, &key, NULL, &value);
+
+				const svn_fs_dirent_t* dirent = (const svn_fs_dirent_t*)value;
+				if(Depth::Files != depth || svn_node_file == dirent->kind)
+				{
+					children.push_back(std::make_pair(std::string(dirent->name), dirent->kind));
+				}
+			}
+
+			//svn_client_list reports the entries of a directory in the order of their names
+			std::sort(children.begin(), children.end());
+
+			std::string parent = Utils::ConvertStringToUTF8(path->TrimEnd(Utils::SeperatorCharArray));
+			for(std::vector<std::pair<std::string, svn_node_kind_t> >::const_iterator child = children.begin(); child != children.end(); ++child)
+			{
+				std::string childPath = parent + "/" + child->first;
+				entries->Add(ReadItem(session, root, childPath.c_str(), child->second, fields, authors, pool));
+				directories->Add(svn_node_dir == child->second && Depth::Infinity == depth ? Utils::ConvertUTF8ToString(childPath.c_str()) : nullptr);
+			}
+		}
+		finally
+		{
+			delete pool;
+		}
+	}
+	finally
+	{
+		ReleaseSession(session);
+	}
+
+	for(int i = 0; i < entries->Count; i++)
+	{
+		if(nullptr == stream)
+		{
+			items->Add(entries[i]);
+		}
+		else if(!stream->Post(entries[i]))
+		{
+			//The consumer has stopped the enumeration. The remaining directories are not read anymore
+			return false;
+		}
+
+		if(nullptr != directories[i] && !ListDirectory(directories[i], revision, depth, fields, authors, items, stream))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool
+LocalRepositoryBackend::TryWriteContent(Uri^ fromPath, long revision, String^ toPath, bool computeDigest, [Out] ContentDigest^% digest)
+{
+	digest = nullptr;
+
+	if(String::IsNullOrEmpty(toPath))
+	{
+		throw gcnew ArgumentNullException("toPath");
+	}
+
+	LocalSession^ session = AcquireSession();
+	try
+	{
+		AprPool^ pool = gcnew AprPool();
+		try
+		{
+			Svn_Fs^ fs = Svn_Fs::Instance();
+			svn_fs_root_t* root = GetRoot(session, revision);
+			const char* path = pool->CopyString(ToRepositoryPath(fromPath));
+
+			svn_node_kind_t kind = svn_node_none;
+			SvnError::Err(fs->SVN_FS_CHECK_PATH(&kind, root, path, pool->Handle));
+			if(svn_node_file != kind)
+			{
+				throw gcnew MigrationException(String::Format("The path '{0}' is not a file in revision {1} of the repository", fromPath, revision));
+			}
+
+			//Export expands keywords and translates line endings. Such files differ from the repository content and are exported by the other backend
+			svn_string_t* eolStyle = NULL;
+			svn_string_t* keywords = NULL;
+			SvnError::Err(fs->SVN_FS_NODE_PROP(&eolStyle, root, path, SVN_PROP_EOL_STYLE, pool->Handle));
+			SvnError::Err(fs->SVN_FS_NODE_PROP(&keywords, root, path, SVN_PROP_KEYWORDS, pool->Handle));
+			if(NULL != eolStyle || NULL != keywords)
+			{
+				return false;
+			}
+
+			svn_stream_t* contents = NULL;
+			SvnError::Err(fs->SVN_FS_FILE_CONTENTS(&contents, root, path, pool->Handle));
+
+			HashAlgorithm^ md5 = computeDigest ? gcnew MD5CryptoServiceProvider() : nullptr;
+			HashAlgorithm^ sha1 = computeDigest ? gcnew SHA1CryptoServiceProvider() : nullptr;
+			array<Byte>^ buffer = gcnew array<Byte>(BufferSize);
+			long long length = 0;
+
+			try
+			{
+				FileStream^ file = gcnew FileStream(toPath, FileMode::Create, FileAccess::Write, FileShare::None, BufferSize);
+				try
+				{
+					//The file system compares the MD5 checksum of the text as soon as the stream has been read to its end
+					while(true)
+					{
+						apr_size_t count = (apr_size_t)buffer->Length;
+						{
+							pin_ptr<Byte> data = &buffer[0];
+							SvnError::Err(Svn_subr::Instance()->SVN_STREAM_READ(contents, (char*)data, &count));
+						}
+
+						if(count > 0)
+						{
+							file->Write(buffer, 0, (int)count);
+							if(computeDigest)
+							{
+								md5->TransformBlock(buffer, 0, (int)count, nullptr, 0);
+								sha1->TransformBlock(buffer, 0, (int)count, nullptr, 0);
+							}
+
+							length += count;
+						}
+
+						//A short read marks the end of the stream
+						if(count < (apr_size_t)buffer->Length)
+						{
+							break;
+						}
+					}
+				}
+				finally
+				{
+					delete file;
+				}
+			}
+			catch(Exception^)
+			{
+				//Do not leave a partial or corrupt file behind
+				File::Delete(toPath);
+				throw;
+			}
+
+			if(computeDigest)
+			{
+				md5->TransformFinalBlock(buffer, 0, 0);
+				sha1->TransformFinalBlock(buffer, 0, 0);
+				digest = gcnew ContentDigest(md5->Hash, sha1->Hash, length, true);
+			}
+
+			return true;
+		}
+		finally
+		{
+			delete pool;
+		}
+	}
+	finally
+	{
+		ReleaseSession(session);
+	}
+}
+
+long
+LocalRepositoryBackend::GetLatestRevisionNumber(Uri^ path)
+{
+	//This is the youngest revision that changed the path like the single entry log of the live backend
+	for each(long revision in QueryHistory(path, -1, -1, -1, 1, false, nullptr, nullptr)->Keys)
+	{
+		return revision;
+	}
+
+	return 0;
+}
+
+Dictionary<long, ChangeSet^>^
+LocalRepositoryBackend::QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, PathFilter^ pathFilter, RevisionFilter^ revisionFilter)
+{
+	EnsureOpen();
+
+	String^ repositoryPath = ToRepositoryPath(path);
+	Dictionary<long, ChangeSet^>^ changesets = gcnew Dictionary<long, ChangeSet^>();
+
+	LocalSession^ session = AcquireSession();
+	try
+	{
+		//The defaults of svn_client_log: the range starts at the peg revision and ends at revision 0. A single start revision is a range of its own
+		long pegRevision = ResolveRevision(session, pegRevisionNumber);
+		long startRevision;
+		long endRevision;
+		if(startRevisionNumber >= 0)
+		{
+			startRevision = startRevisionNumber;
+			endRevision = endRevisionNumber >= 0 ? endRevisionNumber : startRevision;
+		}
+		else
+		{
+			startRevision = pegRevision;
+			endRevision = endRevisionNumber >= 0 ? endRevisionNumber : 0;
+		}
+
+		//The state of the query belongs to the query. Other queries may run at the same time with sessions of their own
+		LocalHistory^ history = gcnew LocalHistory(m_client, changesets, pathFilter, revisionFilter);
+
+		AprPool^ pool = gcnew AprPool();
+		SvnReposLogEntryReceiverTDelegate^ fp = gcnew SvnReposLogEntryReceiverTDelegate(history, &LocalHistory::SvnLogEntryReceiverT);
+		GCHandle gch = GCHandle::Alloc(fp);
+		svn_log_entry_receiver_t receiver = static_cast<svn_log_entry_receiver_t>(Marshal::GetFunctionPointerForDelegate(fp).ToPointer());
+
+		try
+		{
+			LibApr^ libApr = LibApr::Instance();
+			const char* fsPath = pool->CopyString(repositoryPath);
+
+			//The repository layer reads the paths in the youngest revision of the range. The path is traced to that revision
+			//if the peg revision differs, like svn_client_log does
+			svn_revnum_t youngestRevision = (svn_revnum_t)Math::Min(pegRevision, Math::Max(startRevision, endRevision));
+			if(youngestRevision != pegRevision)
+			{
+				apr_array_header_t* revisions = libApr->AprArrayMake(pool->Handle, 1, sizeof(svn_revnum_t));
+				*(svn_revnum_t*)libApr->AprArrayPush(revisions) = youngestRevision;
+
+				apr_hash_t* locations = NULL;
+				SvnError::Err(Svn_Repos::Instance()->SVN_REPOS_TRACE_NODE_LOCATIONS(session->Fs, &locations, fsPath, (svn_revnum_t)pegRevision, revisions, NULL, NULL, pool->Handle));
+
+				fsPath = (const char*)libApr->AprHashGet(locations, &youngestRevision, sizeof(svn_revnum_t));
+				if(NULL == fsPath)
+				{
+					throw gcnew MigrationException(String::Format("The path '{0}' of revision {1} does not exist in revision {2} of the repository", path, pegRevision, youngestRevision));
+				}
+			}
+
+			apr_array_header_t* paths = libApr->AprArrayMake(pool->Handle, 1, sizeof(const char*));
+			*(const char**)libApr->AprArrayPush(paths) = fsPath;
+
+			SvnError::Err(Svn_Repos::Instance()->SVN_REPOS_GET_LOGS4(session->Repos, paths, (svn_revnum_t)startRevision, (svn_revnum_t)endRevision, limit, includeChanges, FALSE, FALSE, NULL, NULL, NULL, receiver, NULL, pool->Handle));
+		}
+		finally
+		{
+			gch.Free();
+			delete pool;
+		}
+	}
+	finally
+	{
+		ReleaseSession(session);
+	}
+
+	return changesets;
+}
+
+List<ItemInfo^>^
+LocalRepositoryBackend::QueryItemInfo(Uri^ path, long revision, Depth depth)
+{
+	EnsureOpen();
+
+	LocalSession^ session = AcquireSession();
+	try
+	{
+		revision = ResolveRevision(session, revision);
+	}
+	finally
+	{
+		ReleaseSession(session);
+	}
+
+	List<Item^>^ items = gcnew List<Item^>();
+	List(ToRepositoryPath(path), revision, depth, DirentFields::Kind, items, nullptr);
+
+	Uri^ repositoryRoot = gcnew Uri(m_repositoryRoot);
+	List<ItemInfo^>^ infos = gcnew List<ItemInfo^>(items->Count);
+	for each(Item^ item in items)
+	{
+		infos->Add(gcnew ItemInfo(gcnew Uri(item->FullServerPath), repositoryRoot, revision, item->ItemType));
+	}
+
+	return infos;
+}
+
+void
+LocalRepositoryBackend::DownloadItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	EnsureOpen();
+
+	ContentDigest^ digest;
+	if(!TryWriteContent(fromPath, revision, toPath, false, digest))
+	{
+		m_backend->DownloadItem(fromPath, revision, toPath);
+	}
+}
+
+ContentDigest^
+LocalRepositoryBackend::DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	EnsureOpen();
+
+	ContentDigest^ digest;
+	if(!TryWriteContent(fromPath, revision, toPath, true, digest))
+	{
+		return m_backend->DownloadVerifiedItem(fromPath, revision, toPath);
+	}
+
+	return digest;
+}
+
+bool
+LocalRepositoryBackend::AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	return m_backend->AreEqual(path1, revision1, path2, revision2);
+}
+
+List<String^>^
+LocalRepositoryBackend::GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	return m_backend->GetModifiedItems(path1, revision1, path2, revision2);
+}
+
+List<Item^>^
+LocalRepositoryBackend::ExportTree(Uri^ root, long revision, String^ localRoot, PathFilter^ filter)
+{
+	//The export translates the content of the files like svn export does
+	return m_backend->ExportTree(root, revision, localRoot, filter);
+}
+
+List<Item^>^
+LocalRepositoryBackend::GetItems(Uri^ path, long revision, Depth depth)
+{
+	EnsureOpen();
+
+	List<Item^>^ items = gcnew List<Item^>();
+	List(ToRepositoryPath(path), revision, depth, DirentFields::All, items, nullptr);
+
+	return items;
+}
+
+IEnumerable<Item^>^
+LocalRepositoryBackend::EnumerateItems(Uri^ path, long revision, Depth depth, DirentFields fields)
+{
+	EnsureOpen();
+
+	LocalListing^ listing = gcnew LocalListing(this, ToRepositoryPath(path), revision, depth, fields | DirentFields::Kind);
+	return gcnew ItemStream(StreamCapacity, gcnew Action<ItemStream^>(listing, &LocalListing::Execute));
+}
+
+List<LocationSegment^>^
+LocalRepositoryBackend::GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision)
+{
+	return m_backend->GetLocationSegments(path, pegRevision, startRevision, endRevision);
+}
+
+long
+LocalRepositoryBackend::Commit(Uri^ repositoryRoot, IEnumerable<CommitItem^>^ items, String^ message)
+{
+	//The next request of the latest revision reads the youngest revision of the file system again and sees the new revision
+	return m_backend->Commit(repositoryRoot, items, message);
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <svn_fs.h>
+#include <svn_repos.h>
+
+#include "IRepositoryBackend.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Net;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							ref class AprPool;
+							ref class ItemStream;
+						}
+
+						namespace Backends
+						{
+							ref class LocalRepositoryBackend;
+
+							/// <summary>
+							/// A listing of a <see cref="LocalRepositoryBackend"/> that runs on the producer thread of an item stream
+							/// </summary>
+							private ref class LocalListing
+							{
+							private:
+								LocalRepositoryBackend^ m_backend;
+								String^ m_path;
+								long m_revision;
+								ObjectModel::Depth m_depth;
+								ObjectModel::DirentFields m_fields;
+
+							public:
+								LocalListing(LocalRepositoryBackend^ backend, String^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields);
+
+								/// <summary>
+								/// Lists the items and posts them to the stream
+								/// </summary>
+								void Execute(Helpers::ItemStream^ stream);
+							};
+
+							/// <summary>
+							/// A repository that has been opened for a <see cref="LocalRepositoryBackend"/>. The file system of a session is used by
+							/// one thread at a time
+							/// </summary>
+							private ref class LocalSession
+							{
+							public:
+								Helpers::AprPool^ Pool;
+								svn_repos_t* Repos;
+								svn_fs_t* Fs;
+
+								//The revision root of the last request. It is allocated in a pool of its own which is replaced with the root
+								Helpers::AprPool^ RootPool;
+								svn_fs_root_t* Root;
+								long RootRevision;
+
+								//The session is only reused while the backend has not been opened again or closed since the session has been opened
+								int Generation;
+							};
+
+							/// <summary>
+							/// Collects the changesets of a single history query of a <see cref="LocalRepositoryBackend"/>
+							/// </summary>
+							private ref class LocalHistory
+							{
+							private:
+								SubversionClient^ m_client;
+								Dictionary<long, ObjectModel::ChangeSet^>^ m_changesets;
+								ObjectModel::PathFilter^ m_pathFilter;
+								ObjectModel::RevisionFilter^ m_revisionFilter;
+
+							public:
+								LocalHistory(SubversionClient^ client, Dictionary<long, ObjectModel::ChangeSet^>^ changesets, ObjectModel::PathFilter^ pathFilter, ObjectModel::RevisionFilter^ revisionFilter);
+
+								svn_error_t* SvnLogEntryReceiverT(void *baton, svn_log_entry_t *log_entry, apr_pool_t *pool);
+							};
+
+							/// <summary>
+							/// A backend for repositories that are located on the local machine. The history, the listings and the content of
+							/// files are read directly from the repository layer (libsvn_repos and libsvn_fs) instead of passing every request
+							/// through svn_client and the ra_local session.
+							/// <para/>
+							/// The file system must not be used by several threads at once. Therefore every request takes a session that has opened
+							/// the repository on its own, so concurrent requests do not wait for each other. Idle sessions are reused together with
+							/// the revision root of their last request, so the caches of their file systems stay warm. Exports, comparisons, location segments, commits and downloads of files whose content is translated
+							/// by svn:eol-style or svn:keywords are forwarded to an other backend that accesses the same repository
+							/// </summary>
+							public ref class LocalRepositoryBackend : public IRepositoryBackend
+							{
+							private:
+								static const int BufferSize = 64 * 1024;
+								static const int StreamCapacity = 1024;
+
+								IRepositoryBackend^ m_backend;
+								SubversionClient^ m_client;
+								String^ m_repositoryRoot;
+								String^ m_itemRoot;
+
+								//The repository in the internal style of subversion; null while the backend is closed. The idle sessions are guarded by their own lock
+								String^ m_localPath;
+								Stack<LocalSession^>^ m_sessions;
+								int m_generation;
+
+								void EnsureOpen();
+								LocalSession^ OpenSession(String^ localPath, int generation);
+								LocalSession^ AcquireSession();
+								void ReleaseSession(LocalSession^ session);
+								long ResolveRevision(LocalSession^ session, long revision);
+								svn_fs_root_t* GetRoot(LocalSession^ session, long revision);
+								String^ ToRepositoryPath(Uri^ path);
+								ObjectModel::Item^ ReadItem(LocalSession^ session, svn_fs_root_t* root, const char* path, svn_node_kind_t kind, ObjectModel::DirentFields fields, Dictionary<long, String^>^ authors, Helpers::AprPool^ pool);
+								bool ListDirectory(String^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields, Dictionary<long, String^>^ authors, List<ObjectModel::Item^>^ items, Helpers::ItemStream^ stream);
+								bool TryWriteContent(Uri^ fromPath, long revision, String^ toPath, bool computeDigest, [Out] ObjectModel::ContentDigest^% digest);
+
+								static void CloseSession(LocalSession^ session);
+
+							internal:
+								/// <summary>
+								/// Lists the items below of a path of the repository. The entries of a directory are read with a session of the
+								/// backend and published after the session has been released
+								/// </summary>
+								/// <param name="path">The path relative to the repository root</param>
+								/// <param name="revision">The revision of the items; -1 for the latest revision</param>
+								/// <param name="depth">The recursion type used to retrieve the items</param>
+								/// <param name="fields">The fields that have to be read for every item</param>
+								/// <param name="items">The list that receives the items; null if they are posted to a stream</param>
+								/// <param name="stream">The stream that receives the items; null if they are added to a list</param>
+								void List(String^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields, List<ObjectModel::Item^>^ items, Helpers::ItemStream^ stream);
+
+							public:
+								/// <summary>
+								/// Creates a local backend
+								/// </summary>
+								/// <param name="backend">The backend that executes the requests which are not served by the repository layer</param>
+								LocalRepositoryBackend(IRepositoryBackend^ backend);
+
+								/// <summary>
+								/// Default destructor
+								/// </summary>
+								~LocalRepositoryBackend();
+
+								virtual void Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId);
+
+								virtual void Close();
+
+								virtual long GetLatestRevisionNumber(Uri^ path);
+
+								virtual Dictionary<long, ObjectModel::ChangeSet^>^ QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, ObjectModel::PathFilter^ pathFilter, ObjectModel::RevisionFilter^ revisionFilter);
+
+								virtual List<ObjectModel::ItemInfo^>^ QueryItemInfo(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								virtual void DownloadItem(Uri^ fromPath, long revision, String^ toPath);
+
+								virtual ObjectModel::ContentDigest^ DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath);
+
+								virtual bool AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								virtual List<String^>^ GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								virtual List<ObjectModel::Item^>^ ExportTree(Uri^ root, long revision, String^ localRoot, ObjectModel::PathFilter^ filter);
+
+								virtual List<ObjectModel::Item^>^ GetItems(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								virtual IEnumerable<ObjectModel::Item^>^ EnumerateItems(Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields);
+
+								virtual List<ObjectModel::LocationSegment^>^ GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision);
+
+								virtual long Commit(Uri^ repositoryRoot, IEnumerable<ObjectModel::CommitItem^>^ items, String^ message);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
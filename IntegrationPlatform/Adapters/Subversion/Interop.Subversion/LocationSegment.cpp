@@ -0,0 +1,41 @@
+#include "Stdafx.h"
+#include "LocationSegment.h"
+
+using namespace System;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+LocationSegment::LocationSegment(long rangeStart, long rangeEnd, String^ fullServerPath)
+{
+	if(rangeStart > rangeEnd)
+	{
+		throw gcnew ArgumentOutOfRangeException("rangeStart");
+	}
+
+	m_rangeStart = rangeStart;
+	m_rangeEnd = rangeEnd;
+	m_fullServerPath = fullServerPath;
+}
+
+long
+LocationSegment::RangeStart::get()
+{
+	return m_rangeStart;
+}
+
+long
+LocationSegment::RangeEnd::get()
+{
+	return m_rangeEnd;
+}
+
+String^
+LocationSegment::FullServerPath::get()
+{
+	return m_fullServerPath;
+}
+
+bool
+LocationSegment::Contains(long revision)
+{
+	return revision >= m_rangeStart && revision <= m_rangeEnd;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <svn_types.h>
+
+using namespace System;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace ObjectModel
+						{
+							/// <summary>
+							/// Describes a revision range in which an item lived at the same location in the repository.
+							/// The history of an item is a sequence of these segments. A new segment starts whenever the item has been copied
+							/// </summary>
+							public ref class LocationSegment
+							{
+								private:
+									long m_rangeStart;
+									long m_rangeEnd;
+									String^ m_fullServerPath;
+
+								internal:
+
+									/// <summary>
+									/// Creates a new location segment
+									/// </summary>
+									/// <param name="rangeStart">The first revision of the segment</param>
+									/// <param name="rangeEnd">The last revision of the segment</param>
+									/// <param name="fullServerPath">The full path of the item within the range; null if the item did not exist within the range</param>
+									LocationSegment(long rangeStart, long rangeEnd, String^ fullServerPath);
+
+								public:
+
+									/// <summary>
+									/// Gets the first revision of the segment
+									/// </summary>
+									property long RangeStart { long get(); }
+
+									/// <summary>
+									/// Gets the last revision of the segment
+									/// </summary>
+									property long RangeEnd { long get(); }
+
+									/// <summary>
+									/// Gets the full path of the item within the range. The value is null if the segment describes a gap in the history of the item
+									/// </summary>
+									property String^ FullServerPath { String^ get(); }
+
+									/// <summary>
+									/// Determines whether the revision is part of the segment
+									/// </summary>
+									bool Contains(long revision);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
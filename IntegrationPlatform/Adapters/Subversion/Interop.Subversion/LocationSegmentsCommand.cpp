@@ -0,0 +1,84 @@
+#include "Stdafx.h"
+#include "AprPool.h"
+#include "DI_Svn_Client-1.h"
+#include "DI_Svn_Ra-1.h"
+#include "LibraryLoader.h"
+#include "LocationSegment.h"
+#include "LocationSegmentsCommand.h"
+#include "SubversionClient.h"
+#include "SubversionContext.h"
+#include "SvnError.h"
+#include "Utils.h"
+
+using namespace System::Runtime::InteropServices;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Commands;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+[UnmanagedFunctionPointer(CallingConvention::Cdecl)]
+delegate svn_error_t* SvnLocationSegmentReceiverTDelegate(svn_location_segment_t *segment, void *baton, apr_pool_t *pool);
+
+LocationSegmentsCommand::LocationSegmentsCommand(SubversionContext^ context, SubversionClient^ client, System::Uri^ path, long pegRevision, long startRevision, long endRevision)
+{
+	if(nullptr == context)
+		throw gcnew ArgumentNullException("context");
+
+	if(nullptr == client)
+		throw gcnew ArgumentNullException("client");
+
+	if(nullptr == path)
+		throw gcnew ArgumentNullException("path");
+
+	m_context = context;
+	m_client = client;
+	m_path = path;
+	m_pegRevision = pegRevision;
+	m_startRevision = startRevision;
+	m_endRevision = endRevision;
+}
+
+void 
+LocationSegmentsCommand::Execute([Out] List<LocationSegment^>^% segments)
+{
+	AprPool^ pool = gcnew AprPool();
+	SvnLocationSegmentReceiverTDelegate^ fp = gcnew SvnLocationSegmentReceiverTDelegate(this, &LocationSegmentsCommand::SvnLocationSegmentReceiverT);
+	GCHandle gch = GCHandle::Alloc(fp);
+	svn_location_segment_receiver_t receiver = static_cast<svn_location_segment_receiver_t>(Marshal::GetFunctionPointerForDelegate(fp).ToPointer());
+
+	m_segments = gcnew List<LocationSegment^>();
+
+	try
+	{
+		//The session is opened directly at the item. Therefore the path of the request is relative to the item itself.
+		//The session belongs to the pool and will be closed as soon as the pool is released
+		svn_ra_session_t* session = NULL;
+		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_OPEN_RA_SESSION(&session, pool->CopyString(m_path->AbsoluteUri), m_context->Handle, pool->Handle));
+
+		svn_revnum_t pegRevision = m_pegRevision >= 0 ? (svn_revnum_t)m_pegRevision : SVN_INVALID_REVNUM;
+		svn_revnum_t startRevision = m_startRevision >= 0 ? (svn_revnum_t)m_startRevision : SVN_INVALID_REVNUM;
+		svn_revnum_t endRevision = m_endRevision >= 0 ? (svn_revnum_t)m_endRevision : SVN_INVALID_REVNUM;
+
+		SvnError::Err(Svn_Ra::Instance()->SVN_RA_GET_LOCATION_SEGMENTS(session, "", pegRevision, startRevision, endRevision, receiver, NULL, pool->Handle));
+	}
+	finally
+	{
+		segments = m_segments;
+		gch.Free();
+	}
+}
+
+svn_error_t* 
+LocationSegmentsCommand::SvnLocationSegmentReceiverT(svn_location_segment_t *segment, void *baton, apr_pool_t *pool)
+{
+	//The path is relative to the repository root. It is not set for the gaps in the history of the item
+	String^ fullServerPath = nullptr;
+	if(NULL != segment->path)
+	{
+		fullServerPath = Utils::Combine(m_client->RepositoryRoot->ToString(), Utils::ConvertUTF8ToString(segment->path));
+	}
+
+	m_segments->Add(gcnew LocationSegment((long)segment->range_start, (long)segment->range_end, fullServerPath));
+	return SVN_NO_ERROR;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <svn_ra.h>
+
+using namespace System::Collections::Generic;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						ref class SubversionClient;
+
+						namespace Helpers
+						{
+							ref class SubversionContext;
+						}
+
+						namespace ObjectModel
+						{
+							ref class LocationSegment;
+						};
+
+						namespace Commands
+						{
+							private ref class LocationSegmentsCommand
+							{
+							private:
+								System::Uri^ m_path;
+								long m_pegRevision;
+								long m_startRevision;
+								long m_endRevision;
+								Helpers::SubversionContext^ m_context;
+								SubversionClient^ m_client;
+
+								List<ObjectModel::LocationSegment^>^ m_segments;
+
+								svn_error_t* SvnLocationSegmentReceiverT(svn_location_segment_t *segment, void *baton, apr_pool_t *pool);
+
+							public:
+								/// <summary>
+								/// Creates a helper object that can be used to retrieve the locations at which an item lived in the past
+								/// </summary>
+								/// <param name="context">The context that can be used to access the repository</param>
+								/// <param name="client">The client that is used to calculate the paths of the segments</param>
+								/// <param name="path">The path of the item</param>
+								/// <param name="pegRevision">The revision in which the item is identified by the path; -1 for the head revision</param>
+								/// <param name="startRevision">The youngest revision of interest; -1 for the peg revision</param>
+								/// <param name="endRevision">The oldest revision of interest; -1 for the first revision of the item</param>
+								LocationSegmentsCommand(Helpers::SubversionContext^ context, SubversionClient^ client, System::Uri^ path, long pegRevision, long startRevision, long endRevision);
+
+								/// <summary>
+								/// Queries the location segments of the item
+								/// </summary>
+								/// <param name="segments">The segments ordered from the youngest to the oldest one</param>
+								void Execute([Out] List<ObjectModel::LocationSegment^>^% segments);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
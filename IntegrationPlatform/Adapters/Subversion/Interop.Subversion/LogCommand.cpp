@@ -7,6 +7,8 @@
 #include "SubversionClient.h"
 #include "SubversionContext.h"
 #include "LogCommand.h"
+#include "PathFilter.h"
+#include "RevisionFilter.h"
 #include "SvnError.h"
 
 using namespace System;
@@ -22,31 +24,13 @@ using namespace Microsoft::TeamFoundation::Migration::Toolkit;
 [UnmanagedFunctionPointer(CallingConvention::Cdecl)]
 delegate svn_error_t* SvnLogEntryReceiverTDelegate(void *baton, svn_log_entry_t *log_entry, apr_pool_t *pool);
 
-LogCommand::LogCommand(SubversionClient^ client, System::Uri^ path, long startRevisionNumber, long endRevisionNumber, bool includeChanges)
+LogCommand::LogCommand(SubversionContext^ context, SubversionClient^ client, System::Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, PathFilter^ pathFilter, RevisionFilter^ revisionFilter)
 {
-	if(nullptr == client)
+	if(nullptr == context)
 	{
-		throw gcnew ArgumentNullException("client");
+		throw gcnew ArgumentNullException("context");
 	}
 
-	if(nullptr == path)
-	{
-		throw gcnew ArgumentNullException("path");
-	}
-
-	m_client = client;
-	m_path = path;
-
-	m_startRevisionNumber = startRevisionNumber;
-	m_endRevisionNumber = endRevisionNumber;
-	m_pegRevisionNumber = -1;
-
-	m_limit = 0;
-	m_includeChanges = includeChanges;
-}
-
-LogCommand::LogCommand(SubversionClient^ client, System::Uri^ path, long startRevisionNumber, int limit, bool includeChanges)
-{
 	if(nullptr == client)
 	{
 		throw gcnew ArgumentNullException("client");
@@ -57,38 +41,18 @@ LogCommand::LogCommand(SubversionClient^ client, System::Uri^ path, long startRe
 		throw gcnew ArgumentNullException("path");
 	}
 
+	m_context = context;
 	m_client = client;
 	m_path = path;
 
-	m_startRevisionNumber = -1;
-	m_endRevisionNumber = -1;
-	m_pegRevisionNumber = startRevisionNumber;
-
-	m_limit = limit;
-	m_includeChanges = includeChanges;
-}
-
-LogCommand::LogCommand(SubversionClient^ client, System::Uri^ path, int limit, bool includeChanges)
-{
-	if(nullptr == client)
-	{
-		throw gcnew ArgumentNullException("client");
-	}
-
-	if(nullptr == path)
-	{
-		throw gcnew ArgumentNullException("path");
-	}
-
-	m_client = client;
-	m_path = path;
-
-	m_startRevisionNumber = -1;
-	m_endRevisionNumber = -1;
-	m_pegRevisionNumber = -1;
+	m_startRevisionNumber = startRevisionNumber;
+	m_endRevisionNumber = endRevisionNumber;
+	m_pegRevisionNumber = pegRevisionNumber;
 
 	m_limit = limit;
 	m_includeChanges = includeChanges;
+	m_pathFilter = pathFilter;
+	m_revisionFilter = revisionFilter;
 }
 
 void 
@@ -140,7 +104,7 @@ LogCommand::Execute([Out] Dictionary<long, ChangeSet^>^% changesets)
 
 	try
 	{
-		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_LOG4(targets, &pegRevision, &startRevision, &endRevision, m_limit, m_includeChanges, false, false, NULL, receiver, NULL, m_client->Context->Handle, pool->Handle));
+		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_LOG4(targets, &pegRevision, &startRevision, &endRevision, m_limit, m_includeChanges, false, false, NULL, receiver, NULL, m_context->Handle, pool->Handle));
 	}
 	finally
 	{
@@ -156,7 +120,13 @@ LogCommand::SvnLogEntryReceiverT(void *baton, svn_log_entry_t *log_entry, apr_po
 	//rather than unwinding all the unmangaded stack which  might not be aware about the exception thrown. Additionally we should also catch all exceptions here
 	//and marshall those back
 
-	ChangeSet^ changeSet = gcnew ChangeSet(log_entry, m_client, pool);
+	if(nullptr != m_revisionFilter && !m_revisionFilter->Matches(log_entry))
+	{
+		//The revision is rejected by its revision properties. It is only counted by the filter; no managed changeset is created for it
+		return SVN_NO_ERROR;
+	}
+
+	ChangeSet^ changeSet = gcnew ChangeSet(log_entry, m_client, pool, m_pathFilter);
 	m_changesets->Add(changeSet->Revision, changeSet);
 
 	return SVN_NO_ERROR;
@@ -18,9 +18,16 @@ namespace Microsoft
 				{
 					namespace Subversion
 					{
+						namespace Helpers
+						{
+							ref class SubversionContext;
+						}
+
 						namespace ObjectModel
 						{
 							ref class ChangeSet;
+							ref class PathFilter;
+							ref class RevisionFilter;
 						};
 
 						namespace Commands
@@ -28,6 +35,7 @@ namespace Microsoft
 							private ref class LogCommand
 							{
 							private:
+								Helpers::SubversionContext^ m_context;
 								SubversionClient^ m_client;
 								System::Uri^ m_path;
 
@@ -37,6 +45,8 @@ namespace Microsoft
 
 								int m_limit;
 								bool m_includeChanges;
+								ObjectModel::PathFilter^ m_pathFilter;
+								ObjectModel::RevisionFilter^ m_revisionFilter;
 
 								Dictionary<long, ObjectModel::ChangeSet^>^ m_changesets;
 								svn_error_t* SvnLogEntryReceiverT(void *baton, svn_log_entry_t *log_entry, apr_pool_t *pool);
@@ -45,37 +55,23 @@ namespace Microsoft
 								/// <summary>
 								/// Creates a new class that can be used to query the repository information
 								/// </summary>
-								/// <param name="client">The client object that contains the context to access the repository</param>
-								/// <param name="path">The path for which we want to receive the history log</param>
-								/// <param name="startRevisionNumber">The start revision number for which we want to query the history log</param>
-								/// <param name="endRevisionNumber">The end revision number for which we want to query the history log</param>
-								/// <param name="limit">Determines whether we also want to retrieve the changed paths</param>
-								LogCommand(SubversionClient^ client, System::Uri^ path, long startRevisionNumber, long endRevisionNumber, bool includeChanges);
-
-								/// <summary>
-								/// Creates a new class that can be used to query the repository information
-								/// </summary>
-								/// <param name="client">The client object that contains the context to access the repository</param>
+								/// <param name="context">The context that can be used to access the repository</param>
+								/// <param name="client">The client object that is used to construct the changesets</param>
 								/// <param name="path">The path for which we want to receive the history log</param>
-								/// <param name="endRevisionNumber">The end revision number for which we want to query the history log</param>
+								/// <param name="pegRevisionNumber">The peg revision of the path; -1 if unspecified</param>
+								/// <param name="startRevisionNumber">The start revision number for which we want to query the history log; -1 if unspecified</param>
+								/// <param name="endRevisionNumber">The end revision number for which we want to query the history log; -1 if unspecified</param>
 								/// <param name="limit">The maximum number of items which we want to retrieve as result; 0 is infitnity</param>
 								/// <param name="includeChanges">Determines whether we also want to retrieve the changed paths</param>
+								/// <param name="pathFilter">The filter that decides which changed paths are materialized; null to materialize all changes</param>
+								/// <param name="revisionFilter">The filter that decides which revisions are materialized; null to materialize all revisions</param>
 								/// <remark>
-								/// Note that the start revision number is the revision number that describes the starting point of the search.
+								/// Note that the peg revision number is the revision number that describes the starting point of the search.
 								/// The internal subversion algorithm will then traverse in the past and return these records. Therefore,
-								/// if you query having StartRevisionNumber = 5 and Lmit = 0 subversion will return all records between 1 and 5.
+								/// if you query having PegRevisionNumber = 5 and Lmit = 0 subversion will return all records between 1 and 5.
 								/// It will not return any later changes like 6, 7, 8 ....
 								/// </remark>
-								LogCommand(SubversionClient^ client, System::Uri^ path, long startRevisionNumber, int limit, bool includeChanges);
-
-								/// <summary>
-								/// Creates a new class that can be used to query the repository information
-								/// </summary>
-								/// <param name="client">The client object that contains the context to access the repository</param>
-								/// <param name="path">The path for which we want to receive the history log</param>
-								/// <param name="limit">The maximum number of items which we want to retrieve as result; 0 is infitnity</param>
-								/// <param name="includeChanges">Determines whether we also want to retrieve the changed paths</param>
-								LogCommand(SubversionClient^ client, System::Uri^ path, int limit, bool includeChanges);
+								LogCommand(Helpers::SubversionContext^ context, SubversionClient^ client, System::Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, ObjectModel::PathFilter^ pathFilter, ObjectModel::RevisionFilter^ revisionFilter);
 
 								/// <summary>
 								/// Executes the command to retrieve the information from subversion
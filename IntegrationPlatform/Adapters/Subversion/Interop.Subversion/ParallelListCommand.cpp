@@ -0,0 +1,238 @@
+#include "Stdafx.h"
+#include "Item.h"
+#include "ListCommand.h"
+#include "ParallelListCommand.h"
+#include "SubversionClient.h"
+#include "SubversionContext.h"
+#include "SubversionContextPool.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Threading;
+
+using namespace Microsoft::TeamFoundation::Migration::Toolkit::Services;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Commands;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+ParallelListCommand::ParallelListCommand(SubversionContextPool^ contexts, SubversionClient^ client, Uri^ path, long revision)
+{
+	if(nullptr == contexts)
+		throw gcnew ArgumentNullException("contexts");
+
+	if(nullptr == client)
+		throw gcnew ArgumentNullException("client");
+
+	if(nullptr == path)
+		throw gcnew ArgumentNullException("path");
+
+	m_contexts = contexts;
+	m_client = client;
+	m_path = path;
+	m_revision = revision;
+	m_workers = contexts->Capacity;
+}
+
+void
+ParallelListCommand::Execute([Out] List<Item^>^% items)
+{
+	m_queues = gcnew array<LinkedList<Task^>^>(m_workers);
+	for(int i = 0; i < m_workers; i++)
+	{
+		m_queues[i] = gcnew LinkedList<Task^>();
+	}
+
+	m_listings = gcnew Dictionary<String^, Listing^>(StringComparer::Ordinal);
+	m_error = nullptr;
+
+	//The key of the root is empty because its path is not known before it has been listed
+	Task^ root = gcnew Task();
+	root->Path = m_path;
+	root->Key = String::Empty;
+	m_queues[0]->AddLast(root);
+	m_queuedTasks = 1;
+	m_pendingTasks = 1;
+
+	//The calling thread is the first worker
+	array<Thread^>^ threads = gcnew array<Thread^>(m_workers - 1);
+	for(int i = 0; i < threads->Length; i++)
+	{
+		threads[i] = gcnew Thread(gcnew ParameterizedThreadStart(this, &ParallelListCommand::Work));
+		threads[i]->IsBackground = true;
+		threads[i]->Start(i + 1);
+	}
+
+	Work(0);
+
+	for each(Thread^ thread in threads)
+	{
+		thread->Join();
+	}
+
+	if(nullptr != m_error)
+	{
+		throw m_error;
+	}
+
+	items = gcnew List<Item^>();
+	Merge(items, String::Empty);
+}
+
+bool
+ParallelListCommand::TryTakeTask(int worker, [Out] Task^% task, [Out] bool% split)
+{
+	task = nullptr;
+	split = false;
+
+	Monitor::Enter(this);
+	try
+	{
+		while(nullptr == m_error && m_pendingTasks > 0)
+		{
+			if(m_queuedTasks > 0)
+			{
+				//Prefer the youngest task of the own queue. It is the deepest directory that this worker discovered
+				LinkedList<Task^>^ queue = m_queues[worker];
+				if(queue->Count > 0)
+				{
+					task = queue->Last->Value;
+					queue->RemoveLast();
+				}
+				else
+				{
+					//Steal the oldest task of an other worker. It is the most likely one to be a large subtree
+					for(int i = 1; i < m_workers && nullptr == task; i++)
+					{
+						queue = m_queues[(worker + i) % m_workers];
+						if(queue->Count > 0)
+						{
+							task = queue->First->Value;
+							queue->RemoveFirst();
+						}
+					}
+				}
+
+				m_queuedTasks--;
+
+				//Keep on splitting as long as there is not enough queued work to keep all other workers busy
+				split = String::IsNullOrEmpty(task->Key) || m_queuedTasks < m_workers;
+				return true;
+			}
+
+			Monitor::Wait(this);
+		}
+
+		return false;
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+void
+ParallelListCommand::Work(Object^ state)
+{
+	int worker = (int)state;
+
+	Task^ task;
+	bool split;
+	while(TryTakeTask(worker, task, split))
+	{
+		List<Item^>^ items;
+		try
+		{
+			SubversionContext^ context = m_contexts->Acquire();
+			bool succeeded = false;
+			try
+			{
+				ListCommand^ command = gcnew ListCommand(context, m_client, task->Path, m_revision, split ? Depth::Immediates : Depth::Infinity);
+				command->Execute(items);
+				succeeded = true;
+			}
+			finally
+			{
+				m_contexts->Release(context, RequestKind::Listing, succeeded, 0);
+			}
+		}
+		catch(Exception^ e)
+		{
+			Monitor::Enter(this);
+			try
+			{
+				if(nullptr == m_error)
+				{
+					m_error = e;
+				}
+
+				Monitor::PulseAll(this);
+			}
+			finally
+			{
+				Monitor::Exit(this);
+			}
+
+			return;
+		}
+
+		Monitor::Enter(this);
+		try
+		{
+			Listing^ listing = gcnew Listing();
+			listing->Split = split;
+			listing->Items = items;
+			m_listings[task->Key] = listing;
+
+			if(split)
+			{
+				//The first item is the directory itself. The subdirectories are listed by the next tasks
+				for(int i = 1; i < items->Count; i++)
+				{
+					if(WellKnownContentType::VersionControlledFolder == items[i]->ItemType)
+					{
+						Task^ child = gcnew Task();
+						child->Key = items[i]->FullServerPath;
+						child->Path = gcnew Uri(child->Key);
+						m_queues[worker]->AddLast(child);
+						m_queuedTasks++;
+						m_pendingTasks++;
+					}
+				}
+			}
+
+			m_pendingTasks--;
+			Monitor::PulseAll(this);
+		}
+		finally
+		{
+			Monitor::Exit(this);
+		}
+	}
+}
+
+void
+ParallelListCommand::Merge(List<Item^>^ items, String^ key)
+{
+	Listing^ listing = m_listings[key];
+	if(!listing->Split)
+	{
+		//A recursive listing is already in the right order
+		items->AddRange(listing->Items);
+		return;
+	}
+
+	for(int i = 0; i < listing->Items->Count; i++)
+	{
+		Item^ item = listing->Items[i];
+		if(i > 0 && WellKnownContentType::VersionControlledFolder == item->ItemType)
+		{
+			//The listing of the subdirectory starts with the subdirectory itself
+			Merge(items, item->FullServerPath);
+		}
+		else
+		{
+			items->Add(item);
+		}
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						ref class SubversionClient;
+
+						namespace Helpers
+						{
+							ref class SubversionContextPool;
+						}
+
+						namespace ObjectModel
+						{
+							ref class Item;
+						};
+
+						namespace Commands
+						{
+							/// <summary>
+							/// Lists a tree recursively by distributing the directories across several connections.
+							/// <para/>
+							/// The directories are listed with depth immediates as long as there is not enough queued work to keep all workers busy.
+							/// Afterwards the remaining subtrees are listed with depth infinity in a single request each. Every worker takes the
+							/// youngest task of its own queue and steals the oldest task of an other queue if its own queue is empty.
+							/// The result is merged in the same order in which a single recursive list request reports the items
+							/// </summary>
+							private ref class ParallelListCommand
+							{
+							private:
+								ref class Task
+								{
+								public:
+									Uri^ Path;
+									String^ Key;
+								};
+
+								ref class Listing
+								{
+								public:
+									bool Split;
+									List<ObjectModel::Item^>^ Items;
+								};
+
+								Helpers::SubversionContextPool^ m_contexts;
+								SubversionClient^ m_client;
+								Uri^ m_path;
+								long m_revision;
+								int m_workers;
+
+								array<LinkedList<Task^>^>^ m_queues;
+								int m_queuedTasks;
+								int m_pendingTasks;
+								Dictionary<String^, Listing^>^ m_listings;
+								Exception^ m_error;
+
+								void Work(Object^ state);
+								bool TryTakeTask(int worker, [Out] Task^% task, [Out] bool% split);
+								void Merge(List<ObjectModel::Item^>^ items, String^ key);
+
+							public:
+								/// <summary>
+								/// Creates a helper object that can be used to list a tree in parallel
+								/// </summary>
+								/// <param name="contexts">The pool that provides a context for every concurrent request</param>
+								/// <param name="client">The client that is used to calculate the paths of the items</param>
+								/// <param name="path">The path for which we want to retrieve the items</param>
+								/// <param name="revision">The revision for which we want to list the items</param>
+								ParallelListCommand(Helpers::SubversionContextPool^ contexts, SubversionClient^ client, Uri^ path, long revision);
+
+								/// <summary>
+								/// Lists the tree recursively
+								/// </summary>
+								/// <param name="items">The items of the tree</param>
+								void Execute([Out] List<ObjectModel::Item^>^% items);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
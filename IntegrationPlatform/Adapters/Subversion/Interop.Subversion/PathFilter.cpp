@@ -0,0 +1,152 @@
+#include "Stdafx.h"
+#include "PathFilter.h"
+#include "PathMatcher.h"
+#include "Utils.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Text;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+PathFilter::PathFilter(Uri^ repositoryRoot, IEnumerable<Uri^>^ mappedPaths, IEnumerable<Uri^>^ cloakedPaths)
+{
+	if(nullptr == repositoryRoot)
+	{
+		throw gcnew ArgumentNullException("repositoryRoot");
+	}
+
+	if(nullptr == mappedPaths)
+	{
+		throw gcnew ArgumentNullException("mappedPaths");
+	}
+
+	m_repositoryRoot = repositoryRoot->AbsoluteUri->TrimEnd(Utils::SeperatorCharArray);
+	m_matcher = new PathMatcher();
+	m_cloakedPaths = gcnew List<String^>();
+
+	List<String^>^ keys = gcnew List<String^>();
+	Add(mappedPaths, false, keys);
+
+	if(nullptr != cloakedPaths)
+	{
+		Add(cloakedPaths, true, keys);
+	}
+
+	keys->Sort(StringComparer::OrdinalIgnoreCase);
+	m_key = String::Join(";", keys->ToArray());
+}
+
+PathFilter::~PathFilter()
+{
+	this->!PathFilter();
+}
+
+PathFilter::!PathFilter()
+{
+	if(NULL != m_matcher)
+	{
+		delete m_matcher;
+		m_matcher = NULL;
+	}
+}
+
+void
+PathFilter::Add(IEnumerable<Uri^>^ paths, bool cloaked, List<String^>^ keys)
+{
+	for each(Uri^ path in paths)
+	{
+		String^ absolute = path->AbsoluteUri->TrimEnd(Utils::SeperatorCharArray);
+		if(!absolute->StartsWith(m_repositoryRoot, StringComparison::OrdinalIgnoreCase))
+		{
+			throw gcnew ArgumentException(String::Format("The path '{0}' is not located within the repository '{1}'", path, m_repositoryRoot));
+		}
+
+		//Subversion reports the changed paths unescaped and UTF-8 encoded. Therefore the prefixes have to be stored the same way
+		String^ relative = Uri::UnescapeDataString(absolute->Substring(m_repositoryRoot->Length));
+		array<Byte>^ bytes = Encoding::UTF8->GetBytes(relative);
+
+		if(0 == bytes->Length)
+		{
+			m_matcher->Add("", 0, cloaked);
+		}
+		else
+		{
+			pin_ptr<Byte> pinned = &bytes[0];
+			m_matcher->Add((const char*)pinned, bytes->Length, cloaked);
+		}
+
+		keys->Add(String::Concat(cloaked ? "-" : "+", relative));
+		if(cloaked)
+		{
+			m_cloakedPaths->Add(relative);
+		}
+	}
+}
+
+PathScope
+PathFilter::Classify(const char* path)
+{
+	if(NULL == m_matcher)
+	{
+		throw gcnew ObjectDisposedException("PathFilter");
+	}
+
+	return (PathScope)m_matcher->Classify(path, strlen(path));
+}
+
+bool
+PathFilter::Includes(const char* path)
+{
+	PathScope scope = Classify(path);
+	return PathScope::Mapped == scope || PathScope::AncestorOfMapping == scope;
+}
+
+IEnumerable<String^>^
+PathFilter::CloakedPaths::get()
+{
+	return m_cloakedPaths;
+}
+
+PathScope
+PathFilter::Classify(Uri^ path)
+{
+	if(nullptr == path)
+	{
+		throw gcnew ArgumentNullException("path");
+	}
+
+	if(NULL == m_matcher)
+	{
+		throw gcnew ObjectDisposedException("PathFilter");
+	}
+
+	String^ absolute = path->AbsoluteUri;
+	if(!absolute->StartsWith(m_repositoryRoot, StringComparison::OrdinalIgnoreCase) || 
+		(absolute->Length > m_repositoryRoot->Length && '/' != absolute[m_repositoryRoot->Length]))
+	{
+		return PathScope::Unmapped;
+	}
+
+	array<Byte>^ bytes = Encoding::UTF8->GetBytes(Uri::UnescapeDataString(absolute->Substring(m_repositoryRoot->Length)));
+	if(0 == bytes->Length)
+	{
+		return (PathScope)m_matcher->Classify("", 0);
+	}
+
+	pin_ptr<Byte> pinned = &bytes[0];
+	return (PathScope)m_matcher->Classify((const char*)pinned, bytes->Length);
+}
+
+bool
+PathFilter::IsMapped(Uri^ path)
+{
+	return PathScope::Mapped == Classify(path);
+}
+
+String^
+PathFilter::ToString()
+{
+	return m_key;
+}
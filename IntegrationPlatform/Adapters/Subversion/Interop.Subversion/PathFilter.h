@@ -0,0 +1,100 @@
+#pragma once
+
+#include "PathScope.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							class PathMatcher;
+						}
+
+						namespace ObjectModel
+						{
+							/// <summary>
+							/// Compiled set of mapped and cloaked paths. The filter can be passed to the history queries so that changes outside 
+							/// of the mapped scope are dropped in the native log receiver before any managed object is created for them
+							/// </summary>
+							public ref class PathFilter
+							{
+							private:
+								Helpers::PathMatcher* m_matcher;
+								String^ m_repositoryRoot;
+								String^ m_key;
+								List<String^>^ m_cloakedPaths;
+
+								void Add(IEnumerable<Uri^>^ paths, bool cloaked, List<String^>^ keys);
+
+							internal:
+								/// <summary>
+								/// Creates a new filter
+								/// </summary>
+								/// <param name="repositoryRoot">The real root of the repository. Changed paths reported by subversion are relative to this uri</param>
+								/// <param name="mappedPaths">The fully qualified paths that are mapped</param>
+								/// <param name="cloakedPaths">The fully qualified paths that are cloaked</param>
+								PathFilter(Uri^ repositoryRoot, IEnumerable<Uri^>^ mappedPaths, IEnumerable<Uri^>^ cloakedPaths);
+
+								/// <summary>
+								/// Determines the scope of a repository relative UTF-8 encoded path as it is reported by subversion
+								/// </summary>
+								PathScope Classify(const char* path);
+
+								/// <summary>
+								/// Determines whether a change on the repository relative path has to be materialized. These are all changes within
+								/// the mapped scope and all changes on ancestors of a mapping because recursive folder operations affect the mapping
+								/// </summary>
+								bool Includes(const char* path);
+
+								/// <summary>
+								/// Gets the unescaped repository relative paths of all cloaked items
+								/// </summary>
+								property IEnumerable<String^>^ CloakedPaths { IEnumerable<String^>^ get(); }
+
+							public:
+								/// <summary>
+								/// Default destructor
+								/// </summary>
+								~PathFilter();
+
+								/// <summary>
+								/// Default Finalizer
+								/// </summary>
+								!PathFilter();
+
+								/// <summary>
+								/// Determines the scope of a fully qualified path
+								/// </summary>
+								/// <param name="path">The fully qualified path of the item</param>
+								PathScope Classify(Uri^ path);
+
+								/// <summary>
+								/// Determines whether the fully qualified path is mapped and not cloaked
+								/// </summary>
+								/// <param name="path">The fully qualified path of the item</param>
+								bool IsMapped(Uri^ path);
+
+								/// <summary>
+								/// Returns a string that identifies the mapped and cloaked paths of this filter
+								/// </summary>
+								virtual String^ ToString() override;
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
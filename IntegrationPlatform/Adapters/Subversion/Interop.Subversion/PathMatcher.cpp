@@ -0,0 +1,222 @@
+#include "Stdafx.h"
+#include "PathMatcher.h"
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+
+PathMatcher::PathMatcher()
+{
+	m_root = new Node();
+}
+
+PathMatcher::~PathMatcher()
+{
+	Release(m_root);
+	m_root = NULL;
+}
+
+void
+PathMatcher::Release(Node* node)
+{
+	for(size_t i = 0; i < node->children.size(); i++)
+	{
+		Release(node->children[i]);
+	}
+
+	delete node;
+}
+
+char
+PathMatcher::Fold(char c)
+{
+	return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+void
+PathMatcher::Trim(const char*& path, size_t& length)
+{
+	while(length > 0 && '/' == path[0])
+	{
+		path++;
+		length--;
+	}
+
+	while(length > 0 && '/' == path[length - 1])
+	{
+		length--;
+	}
+}
+
+size_t
+PathMatcher::FindChild(const Node* node, char c)
+{
+	//The children are sorted by the first character of their label. Returns the index of the matching child or the insert position
+	size_t low = 0;
+	size_t high = node->children.size();
+
+	while(low < high)
+	{
+		size_t middle = low + (high - low) / 2;
+		if(node->children[middle]->label[0] < c)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	return low;
+}
+
+void
+PathMatcher::Add(const char* path, size_t length, bool cloaked)
+{
+	Trim(path, length);
+
+	std::string key(path, length);
+	for(size_t i = 0; i < key.size(); i++)
+	{
+		key[i] = Fold(key[i]);
+	}
+
+	std::vector<Node*> trail;
+	trail.push_back(m_root);
+
+	Node* node = m_root;
+	size_t position = 0;
+
+	while(position < key.size())
+	{
+		size_t index = FindChild(node, key[position]);
+		if(index == node->children.size() || node->children[index]->label[0] != key[position])
+		{
+			Node* leaf = new Node();
+			leaf->label = key.substr(position);
+			node->children.insert(node->children.begin() + index, leaf);
+
+			node = leaf;
+			trail.push_back(node);
+			break;
+		}
+
+		Node* child = node->children[index];
+
+		size_t common = 0;
+		while(common < child->label.size() && position + common < key.size() && child->label[common] == key[position + common])
+		{
+			common++;
+		}
+
+		if(common < child->label.size())
+		{
+			//The new key ends within the label or diverges from it. Split the edge so that the common part becomes a node of its own
+			Node* split = new Node();
+			split->label = child->label.substr(0, common);
+			split->mappedBelow = child->mappedBelow;
+			split->children.push_back(child);
+
+			child->label.erase(0, common);
+			node->children[index] = split;
+			child = split;
+		}
+
+		node = child;
+		position += common;
+		trail.push_back(node);
+	}
+
+	if(cloaked)
+	{
+		node->cloaked = true;
+	}
+	else
+	{
+		node->mapped = true;
+		for(size_t i = 0; i < trail.size(); i++)
+		{
+			trail[i]->mappedBelow = true;
+		}
+	}
+}
+
+PathMatcher::Scope
+PathMatcher::Classify(const char* path, size_t length) const
+{
+	Trim(path, length);
+
+	bool mapped = m_root->mapped;
+	bool cloaked = m_root->cloaked;
+	bool ancestor = (0 == length) && m_root->mappedBelow;
+
+	const Node* node = m_root;
+	size_t position = 0;
+
+	while(position < length)
+	{
+		size_t index = FindChild(node, Fold(path[position]));
+		if(index == node->children.size() || node->children[index]->label[0] != Fold(path[position]))
+		{
+			break;
+		}
+
+		const Node* child = node->children[index];
+		const std::string& label = child->label;
+
+		size_t i = 0;
+		while(i < label.size() && position + i < length && label[i] == Fold(path[position + i]))
+		{
+			i++;
+		}
+
+		if(position + i == length)
+		{
+			//The path has been consumed completely. It is an ancestor of a mapping if the trie continues with a new path segment
+			if(i == label.size())
+			{
+				mapped |= child->mapped;
+				cloaked |= child->cloaked;
+				ancestor = child->mapped;
+
+				size_t slash = FindChild(child, '/');
+				if(slash < child->children.size() && '/' == child->children[slash]->label[0])
+				{
+					ancestor |= child->children[slash]->mappedBelow;
+				}
+			}
+			else
+			{
+				ancestor = ('/' == label[i]) && child->mappedBelow;
+			}
+
+			break;
+		}
+
+		if(i < label.size())
+		{
+			break;
+		}
+
+		node = child;
+		position += i;
+
+		//A prefix only applies if it ends at a segment boundary. Otherwise /Release would match /Release-2.0
+		if('/' == path[position])
+		{
+			mapped |= node->mapped;
+			cloaked |= node->cloaked;
+		}
+	}
+
+	if(mapped && !cloaked)
+	{
+		return Mapped;
+	}
+
+	if(ancestor)
+	{
+		return AncestorOfMapping;
+	}
+
+	return cloaked ? Cloaked : Unmapped;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							/// <summary>
+							/// Native prefix matcher for repository relative paths. The prefixes are stored in a radix trie whose children are sorted by 
+							/// their first character. Paths are compared case insensitive for ASCII characters and byte wise for all other UTF-8 sequences.
+							/// <para/>
+							/// The matcher only works on the UTF-8 encoded paths as they are delivered by subversion and therefore does not allocate any memory 
+							/// while classifying paths
+							/// </summary>
+							class PathMatcher
+							{
+							public:
+								enum Scope
+								{
+									Unmapped = 0,
+									Mapped = 1,
+									Cloaked = 2,
+									AncestorOfMapping = 3
+								};
+
+								PathMatcher();
+								~PathMatcher();
+
+								/// <summary>
+								/// Adds a mapped or cloaked prefix. Leading and trailing slashes are ignored; an empty path denotes the repository root
+								/// </summary>
+								void Add(const char* path, size_t length, bool cloaked);
+
+								/// <summary>
+								/// Determines the scope of a repository relative path
+								/// </summary>
+								Scope Classify(const char* path, size_t length) const;
+
+							private:
+								struct Node
+								{
+									std::string label;
+									bool mapped;
+									bool cloaked;
+									bool mappedBelow;
+									std::vector<Node*> children;
+
+									Node() : mapped(false), cloaked(false), mappedBelow(false) { }
+								};
+
+								Node* m_root;
+
+								static char Fold(char c);
+								static void Trim(const char*& path, size_t& length);
+								static size_t FindChild(const Node* node, char c);
+								static void Release(Node* node);
+
+								//The matcher owns native memory and must not be copied
+								PathMatcher(const PathMatcher&);
+								PathMatcher& operator=(const PathMatcher&);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace ObjectModel
+						{
+							public enum class PathScope
+							{
+								/// <summary>
+								/// The path is neither mapped nor cloaked.
+								/// </summary>
+								Unmapped = 0,
+
+								/// <summary>
+								/// The path is below a mapped path and not cloaked.
+								/// </summary>
+								Mapped = 1,
+
+								/// <summary>
+								/// The path is below a cloaked path.
+								/// </summary>
+								Cloaked = 2,
+
+								/// <summary>
+								/// The path itself is not mapped but one of its descendants is. Recursive folder operations on this path affect a mapping.
+								/// </summary>
+								AncestorOfMapping = 3
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
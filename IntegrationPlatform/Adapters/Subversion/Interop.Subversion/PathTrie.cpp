@@ -0,0 +1,426 @@
+#include "Stdafx.h"
+#include "PathTrie.h"
+#include "Utils.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+generic<typename TValue>
+PathTrie<TValue>::PathTrie()
+{
+	m_comparer = StringComparer::Ordinal;
+	m_root = gcnew Node();
+	m_count = 0;
+}
+
+generic<typename TValue>
+PathTrie<TValue>::PathTrie(StringComparer^ comparer)
+{
+	if(nullptr == comparer)
+	{
+		throw gcnew ArgumentNullException("comparer");
+	}
+
+	m_comparer = comparer;
+	m_root = gcnew Node();
+	m_count = 0;
+}
+
+generic<typename TValue>
+array<String^>^
+PathTrie<TValue>::Split(String^ path)
+{
+	if(nullptr == path)
+	{
+		throw gcnew ArgumentNullException("path");
+	}
+
+	//Empty segments are ignored. Therefore trailing and double slashes do not make any difference
+	return path->Split(Utils::SeperatorCharArray, StringSplitOptions::RemoveEmptyEntries);
+}
+
+generic<typename TValue>
+typename PathTrie<TValue>::Node^
+PathTrie<TValue>::Find(String^ path)
+{
+	Node^ node = m_root;
+	for each(String^ segment in Split(path))
+	{
+		if(nullptr == node->Children || !node->Children->TryGetValue(segment, node))
+		{
+			return nullptr;
+		}
+	}
+
+	return node;
+}
+
+generic<typename TValue>
+typename PathTrie<TValue>::Node^
+PathTrie<TValue>::FindOrCreate(String^ path)
+{
+	Node^ node = m_root;
+	for each(String^ segment in Split(path))
+	{
+		if(nullptr == node->Children)
+		{
+			node->Children = gcnew Dictionary<String^, Node^>(m_comparer);
+		}
+
+		Node^ child;
+		if(!node->Children->TryGetValue(segment, child))
+		{
+			child = gcnew Node();
+			child->Parent = node;
+			child->Segment = segment;
+			node->Children->Add(segment, child);
+		}
+
+		node = child;
+	}
+
+	return node;
+}
+
+generic<typename TValue>
+void
+PathTrie<TValue>::Prune(Node^ node)
+{
+	//Removes all nodes up the chain that neither carry a value nor lead to one
+	while(nullptr != node->Parent && !node->HasValue && (nullptr == node->Children || 0 == node->Children->Count))
+	{
+		node->Parent->Children->Remove(node->Segment);
+		node = node->Parent;
+	}
+}
+
+generic<typename TValue>
+void
+PathTrie<TValue>::Collect(Node^ node, List<KeyValuePair<String^, TValue>>^ items)
+{
+	if(node->HasValue)
+	{
+		items->Add(KeyValuePair<String^, TValue>(node->Key, node->Value));
+	}
+
+	if(nullptr != node->Children)
+	{
+		for each(Node^ child in node->Children->Values)
+		{
+			Collect(child, items);
+		}
+	}
+}
+
+generic<typename TValue>
+int
+PathTrie<TValue>::CountValues(Node^ node)
+{
+	int count = node->HasValue ? 1 : 0;
+	if(nullptr != node->Children)
+	{
+		for each(Node^ child in node->Children->Values)
+		{
+			count += CountValues(child);
+		}
+	}
+
+	return count;
+}
+
+generic<typename TValue>
+int
+PathTrie<TValue>::Rekey(Node^ node, String^ key)
+{
+	int count = 0;
+	if(node->HasValue)
+	{
+		node->Key = key;
+		count++;
+	}
+
+	if(nullptr != node->Children)
+	{
+		String^ prefix = key->TrimEnd(Utils::SeperatorCharArray);
+		for each(Node^ child in node->Children->Values)
+		{
+			count += Rekey(child, String::Concat(prefix, Utils::Seperator, child->Segment));
+		}
+	}
+
+	return count;
+}
+
+generic<typename TValue>
+int
+PathTrie<TValue>::Count::get()
+{
+	return m_count;
+}
+
+generic<typename TValue>
+TValue
+PathTrie<TValue>::default::get(String^ path)
+{
+	TValue value;
+	if(!TryGetValue(path, value))
+	{
+		throw gcnew KeyNotFoundException(String::Format("The path '{0}' is not stored in the lookup table", path));
+	}
+
+	return value;
+}
+
+generic<typename TValue>
+void
+PathTrie<TValue>::default::set(String^ path, TValue value)
+{
+	Node^ node = FindOrCreate(path);
+	if(!node->HasValue)
+	{
+		node->HasValue = true;
+		m_count++;
+	}
+
+	node->Key = path;
+	node->Value = value;
+}
+
+generic<typename TValue>
+List<TValue>^
+PathTrie<TValue>::Values::get()
+{
+	List<KeyValuePair<String^, TValue>>^ items = gcnew List<KeyValuePair<String^, TValue>>(m_count);
+	Collect(m_root, items);
+
+	List<TValue>^ values = gcnew List<TValue>(items->Count);
+	for each(KeyValuePair<String^, TValue> item in items)
+	{
+		values->Add(item.Value);
+	}
+
+	return values;
+}
+
+generic<typename TValue>
+void
+PathTrie<TValue>::Add(String^ path, TValue value)
+{
+	Node^ node = FindOrCreate(path);
+	if(node->HasValue)
+	{
+		throw gcnew ArgumentException(String::Format("The path '{0}' is already stored in the lookup table", path), "path");
+	}
+
+	node->HasValue = true;
+	node->Key = path;
+	node->Value = value;
+	m_count++;
+}
+
+generic<typename TValue>
+bool
+PathTrie<TValue>::ContainsKey(String^ path)
+{
+	Node^ node = Find(path);
+	return nullptr != node && node->HasValue;
+}
+
+generic<typename TValue>
+bool
+PathTrie<TValue>::TryGetValue(String^ path, [Out] TValue% value)
+{
+	Node^ node = Find(path);
+	if(nullptr == node || !node->HasValue)
+	{
+		value = TValue();
+		return false;
+	}
+
+	value = node->Value;
+	return true;
+}
+
+generic<typename TValue>
+bool
+PathTrie<TValue>::Remove(String^ path)
+{
+	Node^ node = Find(path);
+	if(nullptr == node || !node->HasValue)
+	{
+		return false;
+	}
+
+	node->HasValue = false;
+	node->Key = nullptr;
+	node->Value = TValue();
+	m_count--;
+
+	Prune(node);
+	return true;
+}
+
+generic<typename TValue>
+int
+PathTrie<TValue>::RemoveSubtree(String^ path)
+{
+	Node^ node = Find(path);
+	if(nullptr == node)
+	{
+		return 0;
+	}
+
+	int count = CountValues(node);
+	if(nullptr == node->Parent)
+	{
+		//The root covers the whole table
+		Clear();
+		return count;
+	}
+
+	node->Parent->Children->Remove(node->Segment);
+	m_count -= count;
+
+	Prune(node->Parent);
+	return count;
+}
+
+generic<typename TValue>
+int
+PathTrie<TValue>::RemoveSubtree(String^ path, StringComparer^ comparer)
+{
+	if(nullptr == comparer)
+	{
+		throw gcnew ArgumentNullException("comparer");
+	}
+
+	//Several children may match a segment. Only the children along the path are compared, not the whole table
+	List<Node^>^ nodes = gcnew List<Node^>();
+	nodes->Add(m_root);
+	for each(String^ segment in Split(path))
+	{
+		List<Node^>^ matches = gcnew List<Node^>();
+		for each(Node^ node in nodes)
+		{
+			if(nullptr == node->Children)
+			{
+				continue;
+			}
+
+			for each(KeyValuePair<String^, Node^> child in node->Children)
+			{
+				if(comparer->Equals(child.Key, segment))
+				{
+					matches->Add(child.Value);
+				}
+			}
+		}
+
+		nodes = matches;
+	}
+
+	int count = 0;
+	for each(Node^ node in nodes)
+	{
+		if(nullptr == node->Parent)
+		{
+			//The root covers the whole table
+			count = m_count;
+			Clear();
+			return count;
+		}
+
+		count += CountValues(node);
+		node->Parent->Children->Remove(node->Segment);
+	}
+
+	m_count -= count;
+	for each(Node^ node in nodes)
+	{
+		Prune(node->Parent);
+	}
+
+	return count;
+}
+
+generic<typename TValue>
+List<KeyValuePair<String^, TValue>>^
+PathTrie<TValue>::GetSubtree(String^ path)
+{
+	List<KeyValuePair<String^, TValue>>^ items = gcnew List<KeyValuePair<String^, TValue>>();
+
+	Node^ node = Find(path);
+	if(nullptr != node)
+	{
+		Collect(node, items);
+	}
+
+	return items;
+}
+
+generic<typename TValue>
+int
+PathTrie<TValue>::RewritePrefix(String^ oldPrefix, String^ newPrefix)
+{
+	if(nullptr == newPrefix)
+	{
+		throw gcnew ArgumentNullException("newPrefix");
+	}
+
+	Node^ source = Find(oldPrefix);
+	if(nullptr == source || nullptr == source->Parent)
+	{
+		//There is nothing to move. The root itself cannot be moved because it is the ancestor of every location
+		return 0;
+	}
+
+	Node^ target = Find(newPrefix);
+	if(nullptr != target && (target->HasValue || (nullptr != target->Children && target->Children->Count > 0)))
+	{
+		throw gcnew ArgumentException(String::Format("The path '{0}' already contains items in the lookup table", newPrefix), "newPrefix");
+	}
+
+	//Detach the subtree from its current location and attach it as the node of the new location
+	source->Parent->Children->Remove(source->Segment);
+	Prune(source->Parent);
+
+	target = FindOrCreate(newPrefix);
+	if(nullptr == target->Parent)
+	{
+		throw gcnew ArgumentException("A subtree cannot be moved to the root of the lookup table", "newPrefix");
+	}
+
+	source->Parent = target->Parent;
+	source->Segment = target->Segment;
+	target->Parent->Children[target->Segment] = source;
+
+	return Rekey(source, newPrefix);
+}
+
+generic<typename TValue>
+void
+PathTrie<TValue>::Clear()
+{
+	m_root = gcnew Node();
+	m_count = 0;
+}
+
+generic<typename TValue>
+IEnumerator<KeyValuePair<String^, TValue>>^
+PathTrie<TValue>::GetEnumerator()
+{
+	List<KeyValuePair<String^, TValue>>^ items = gcnew List<KeyValuePair<String^, TValue>>(m_count);
+	Collect(m_root, items);
+
+	return items->GetEnumerator();
+}
+
+generic<typename TValue>
+System::Collections::IEnumerator^
+PathTrie<TValue>::GetEnumeratorNonGeneric()
+{
+	return GetEnumerator();
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace ObjectModel
+						{
+							/// <summary>
+							/// Lookup table for repository paths. The paths are split into their segments and stored in a trie.
+							/// Therefore a lookup, an insert or a removal costs O(depth) and all operations on a subtree only touch the items of that subtree
+							/// rather than all items in the table.
+							/// </summary>
+							/// <typeparam name="TValue">The type of the values that are stored for the paths</typeparam>
+							generic<typename TValue>
+							public ref class PathTrie : public IEnumerable<KeyValuePair<String^, TValue>>
+							{
+							private:
+								ref class Node
+								{
+								public:
+									Node^ Parent;
+									String^ Segment;
+									Dictionary<String^, Node^>^ Children;
+									String^ Key;
+									bool HasValue;
+									TValue Value;
+								};
+
+								Node^ m_root;
+								StringComparer^ m_comparer;
+								int m_count;
+
+								static array<String^>^ Split(String^ path);
+								Node^ Find(String^ path);
+								Node^ FindOrCreate(String^ path);
+								void Prune(Node^ node);
+								void Collect(Node^ node, List<KeyValuePair<String^, TValue>>^ items);
+								int CountValues(Node^ node);
+								int Rekey(Node^ node, String^ key);
+
+							public:
+								/// <summary>
+								/// Creates a trie that compares the path segments ordinal and case sensitive like subversion does
+								/// </summary>
+								PathTrie();
+
+								/// <summary>
+								/// Creates a trie that compares the path segments using the specified comparer
+								/// </summary>
+								/// <param name="comparer">The comparer that is used for the path segments</param>
+								PathTrie(StringComparer^ comparer);
+
+								/// <summary>
+								/// Gets the number of paths that are stored in the trie
+								/// </summary>
+								property int Count { int get(); }
+
+								/// <summary>
+								/// Gets or sets the value of a path
+								/// </summary>
+								/// <exception cref="KeyNotFoundException">Will be thrown if the path is not stored in the trie</exception>
+								property TValue default[String^] { TValue get(String^ path); void set(String^ path, TValue value); }
+
+								/// <summary>
+								/// Gets all values in the trie
+								/// </summary>
+								property List<TValue>^ Values { List<TValue>^ get(); }
+
+								/// <summary>
+								/// Adds a new path to the trie
+								/// </summary>
+								/// <exception cref="ArgumentException">Will be thrown if the path is already stored in the trie</exception>
+								void Add(String^ path, TValue value);
+
+								/// <summary>
+								/// Determines whether the path is stored in the trie
+								/// </summary>
+								bool ContainsKey(String^ path);
+
+								/// <summary>
+								/// Gets the value of a path
+								/// </summary>
+								/// <returns>true if the path is stored in the trie; false otherwise</returns>
+								bool TryGetValue(String^ path, [Out] TValue% value);
+
+								/// <summary>
+								/// Removes a single path from the trie. Children of the path are not affected
+								/// </summary>
+								/// <returns>true if the path has been removed; false if it was not stored in the trie</returns>
+								bool Remove(String^ path);
+
+								/// <summary>
+								/// Removes the path and all the paths below of it
+								/// </summary>
+								/// <returns>The number of paths that have been removed</returns>
+								int RemoveSubtree(String^ path);
+
+								/// <summary>
+								/// Removes every path that matches the path using the specified comparer and all the paths below of them.
+								/// Allows to remove case insensitive from a trie whose paths are case sensitive
+								/// </summary>
+								/// <param name="path">The path whose segments are matched</param>
+								/// <param name="comparer">The comparer that is used for the segments of the path</param>
+								/// <returns>The number of paths that have been removed</returns>
+								int RemoveSubtree(String^ path, StringComparer^ comparer);
+
+								/// <summary>
+								/// Gets the path and all the paths below of it
+								/// </summary>
+								List<KeyValuePair<String^, TValue>>^ GetSubtree(String^ path);
+
+								/// <summary>
+								/// Moves the path and all the paths below of it to a new location. This is what a rename of a folder does to the paths of its children
+								/// </summary>
+								/// <param name="oldPrefix">The current location of the subtree</param>
+								/// <param name="newPrefix">The new location of the subtree</param>
+								/// <returns>The number of paths that have been moved</returns>
+								/// <exception cref="ArgumentException">Will be thrown if the new location already contains paths</exception>
+								int RewritePrefix(String^ oldPrefix, String^ newPrefix);
+
+								/// <summary>
+								/// Removes all paths from the trie
+								/// </summary>
+								void Clear();
+
+								virtual IEnumerator<KeyValuePair<String^, TValue>>^ GetEnumerator();
+
+								virtual System::Collections::IEnumerator^ GetEnumeratorNonGeneric() = System::Collections::IEnumerable::GetEnumerator;
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,272 @@
+#include "Stdafx.h"
+#include "ChangeSet.h"
+#include "ContentDigest.h"
+#include "Item.h"
+#include "ItemInfo.h"
+#include "PathFilter.h"
+#include "RevisionFilter.h"
+#include "LiveBackend.h"
+#include "LocationSegment.h"
+#include "RecordingBackend.h"
+#include "SubversionClient.h"
+#include "TraceFile.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::IO::Compression;
+using namespace System::Collections::Generic;
+using namespace System::Threading;
+
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Backends;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+RecordingBackend::RecordingBackend(String^ traceFile)
+{
+	if(String::IsNullOrEmpty(traceFile))
+	{
+		throw gcnew ArgumentNullException("traceFile");
+	}
+
+	m_backend = gcnew LiveBackend();
+	m_traceFile = traceFile;
+}
+
+RecordingBackend::RecordingBackend(IRepositoryBackend^ backend, String^ traceFile)
+{
+	if(nullptr == backend)
+	{
+		throw gcnew ArgumentNullException("backend");
+	}
+
+	if(String::IsNullOrEmpty(traceFile))
+	{
+		throw gcnew ArgumentNullException("traceFile");
+	}
+
+	m_backend = backend;
+	m_traceFile = traceFile;
+}
+
+RecordingBackend::~RecordingBackend()
+{
+	Close();
+}
+
+void
+RecordingBackend::Record(TraceOperation operation, String^ key, MemoryStream^ payload)
+{
+	Monitor::Enter(this);
+	try
+	{
+		if(nullptr != m_writer)
+		{
+			TraceFile::WriteRecord(m_writer, operation, key, payload->ToArray());
+		}
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+void
+RecordingBackend::Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId)
+{
+	m_backend->Open(client, repository, credential, repositoryRoot, repositoryId);
+
+	Monitor::Enter(this);
+	try
+	{
+		if(nullptr == m_writer)
+		{
+			Stream^ stream = gcnew GZipStream(gcnew FileStream(m_traceFile, FileMode::Create, FileAccess::Write), CompressionMode::Compress);
+			m_writer = gcnew BinaryWriter(stream);
+			TraceFile::WriteHeader(m_writer);
+		}
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	BinaryWriter^ writer = gcnew BinaryWriter(payload);
+	writer->Write(repositoryRoot->AbsoluteUri);
+	writer->Write(repositoryId.ToByteArray());
+	Record(TraceOperation::Open, TraceFile::CreateKey(repository), payload);
+}
+
+void
+RecordingBackend::Close()
+{
+	m_backend->Close();
+
+	Monitor::Enter(this);
+	try
+	{
+		if(nullptr != m_writer)
+		{
+			m_writer->Write((Byte)TraceOperation::EndOfTrace);
+			m_writer->Close();
+			m_writer = nullptr;
+		}
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+long
+RecordingBackend::GetLatestRevisionNumber(Uri^ path)
+{
+	long result = m_backend->GetLatestRevisionNumber(path);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	BinaryWriter^ writer = gcnew BinaryWriter(payload);
+	writer->Write((Int32)result);
+	Record(TraceOperation::LatestRevisionNumber, TraceFile::CreateKey(path), payload);
+
+	return result;
+}
+
+Dictionary<long, ChangeSet^>^
+RecordingBackend::QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, PathFilter^ pathFilter, RevisionFilter^ revisionFilter)
+{
+	int skippedRevisions = (nullptr == revisionFilter) ? 0 : revisionFilter->SkippedRevisions;
+	Dictionary<long, ChangeSet^>^ changesets = m_backend->QueryHistory(path, pegRevisionNumber, startRevisionNumber, endRevisionNumber, limit, includeChanges, pathFilter, revisionFilter);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	BinaryWriter^ writer = gcnew BinaryWriter(payload);
+	TraceFile::WriteChangeSets(writer, changesets);
+	writer->Write((Int32)((nullptr == revisionFilter) ? 0 : revisionFilter->SkippedRevisions - skippedRevisions));
+	Record(TraceOperation::QueryHistory, TraceFile::CreateKey(path, pegRevisionNumber, startRevisionNumber, endRevisionNumber, limit, includeChanges, pathFilter, revisionFilter), payload);
+
+	return changesets;
+}
+
+List<ItemInfo^>^
+RecordingBackend::QueryItemInfo(Uri^ path, long revision, Depth depth)
+{
+	List<ItemInfo^>^ infos = m_backend->QueryItemInfo(path, revision, depth);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	TraceFile::WriteItemInfos(gcnew BinaryWriter(payload), infos);
+	Record(TraceOperation::QueryItemInfo, TraceFile::CreateKey(path, revision, depth), payload);
+
+	return infos;
+}
+
+void
+RecordingBackend::DownloadItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	m_backend->DownloadItem(fromPath, revision, toPath);
+
+	//The content is stored as it is. The gzip stream of the trace file takes care of the compression
+	MemoryStream^ payload = gcnew MemoryStream(File::ReadAllBytes(toPath));
+	Record(TraceOperation::DownloadItem, TraceFile::CreateKey(fromPath, revision), payload);
+}
+
+ContentDigest^
+RecordingBackend::DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	ContentDigest^ digest = m_backend->DownloadVerifiedItem(fromPath, revision, toPath);
+
+	//Both download methods store the same local file. Therefore the record can be replayed by either of them
+	MemoryStream^ payload = gcnew MemoryStream(File::ReadAllBytes(toPath));
+	Record(TraceOperation::DownloadItem, TraceFile::CreateKey(fromPath, revision), payload);
+
+	return digest;
+}
+
+bool
+RecordingBackend::AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	bool result = m_backend->AreEqual(path1, revision1, path2, revision2);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	BinaryWriter^ writer = gcnew BinaryWriter(payload);
+	writer->Write(result);
+	Record(TraceOperation::AreEqual, TraceFile::CreateKey(path1, revision1, path2, revision2), payload);
+
+	return result;
+}
+
+List<String^>^
+RecordingBackend::GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	List<String^>^ items = m_backend->GetModifiedItems(path1, revision1, path2, revision2);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	TraceFile::WritePaths(gcnew BinaryWriter(payload), items);
+	Record(TraceOperation::ModifiedItems, TraceFile::CreateKey(path1, revision1, path2, revision2), payload);
+
+	return items;
+}
+
+List<Item^>^
+RecordingBackend::ExportTree(Uri^ root, long revision, String^ localRoot, PathFilter^ filter)
+{
+	List<Item^>^ items = m_backend->ExportTree(root, revision, localRoot, filter);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	TraceFile::WriteItems(gcnew BinaryWriter(payload), items);
+	Record(TraceOperation::ExportTree, TraceFile::CreateKey(root, revision, filter), payload);
+
+	//The content is recorded per file. The same records serve the single downloads of these files
+	for each(Item^ item in items)
+	{
+		if(WellKnownContentType::VersionControlledFile == item->ItemType)
+		{
+			Record(TraceOperation::DownloadItem, TraceFile::CreateKey(gcnew Uri(item->FullServerPath), revision), gcnew MemoryStream(File::ReadAllBytes(TraceFile::GetLocalPath(root, localRoot, item))));
+		}
+	}
+
+	return items;
+}
+
+List<Item^>^
+RecordingBackend::GetItems(Uri^ path, long revision, Depth depth)
+{
+	List<Item^>^ items = m_backend->GetItems(path, revision, depth);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	TraceFile::WriteItems(gcnew BinaryWriter(payload), items);
+	Record(TraceOperation::GetItems, TraceFile::CreateKey(path, revision, depth), payload);
+
+	return items;
+}
+
+IEnumerable<Item^>^
+RecordingBackend::EnumerateItems(Uri^ path, long revision, Depth depth, DirentFields fields)
+{
+	//The listing is recorded as a whole. Otherwise an enumeration that is stopped early would leave an incomplete response in the trace
+	List<Item^>^ items = gcnew List<Item^>(m_backend->EnumerateItems(path, revision, depth, fields));
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	TraceFile::WriteItems(gcnew BinaryWriter(payload), items);
+	Record(TraceOperation::GetItems, TraceFile::CreateKey(path, revision, depth, fields), payload);
+
+	return items;
+}
+
+List<LocationSegment^>^
+RecordingBackend::GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision)
+{
+	List<LocationSegment^>^ segments = m_backend->GetLocationSegments(path, pegRevision, startRevision, endRevision);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	TraceFile::WriteLocationSegments(gcnew BinaryWriter(payload), segments);
+	Record(TraceOperation::LocationSegments, TraceFile::CreateKey(path, pegRevision, startRevision, endRevision), payload);
+
+	return segments;
+}
+
+long
+RecordingBackend::Commit(Uri^ repositoryRoot, IEnumerable<CommitItem^>^ items, String^ message)
+{
+	//A commit changes the repository. It is not recorded because a replay must never pretend to have written a revision
+	return m_backend->Commit(repositoryRoot, items, message);
+}
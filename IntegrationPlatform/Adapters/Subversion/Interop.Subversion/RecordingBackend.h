@@ -0,0 +1,92 @@
+#pragma once
+
+#include "IRepositoryBackend.h"
+#include "TraceFile.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Collections::Generic;
+using namespace System::Net;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Backends
+						{
+							/// <summary>
+							/// A backend that forwards all requests to an other backend and records every request and response in a trace file.
+							/// The trace can be served later on by the <see cref="ReplayBackend"/>
+							/// </summary>
+							public ref class RecordingBackend : public IRepositoryBackend
+							{
+							private:
+								IRepositoryBackend^ m_backend;
+								String^ m_traceFile;
+								BinaryWriter^ m_writer;
+
+								void Record(TraceOperation operation, String^ key, MemoryStream^ payload);
+
+							public:
+								/// <summary>
+								/// Creates a recording backend that records the requests of a <see cref="LiveBackend"/>
+								/// </summary>
+								/// <param name="traceFile">The path of the trace file. An existing file will be overwritten</param>
+								RecordingBackend(String^ traceFile);
+
+								/// <summary>
+								/// Creates a recording backend
+								/// </summary>
+								/// <param name="backend">The backend that actually executes the requests</param>
+								/// <param name="traceFile">The path of the trace file. An existing file will be overwritten</param>
+								RecordingBackend(IRepositoryBackend^ backend, String^ traceFile);
+
+								/// <summary>
+								/// Default destructor
+								/// </summary>
+								~RecordingBackend();
+
+								virtual void Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId);
+
+								virtual void Close();
+
+								virtual long GetLatestRevisionNumber(Uri^ path);
+
+								virtual Dictionary<long, ObjectModel::ChangeSet^>^ QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, ObjectModel::PathFilter^ pathFilter, ObjectModel::RevisionFilter^ revisionFilter);
+
+								virtual List<ObjectModel::ItemInfo^>^ QueryItemInfo(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								virtual void DownloadItem(Uri^ fromPath, long revision, String^ toPath);
+
+								virtual ObjectModel::ContentDigest^ DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath);
+
+								virtual bool AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								virtual List<String^>^ GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								virtual List<ObjectModel::Item^>^ ExportTree(Uri^ root, long revision, String^ localRoot, ObjectModel::PathFilter^ filter);
+
+								virtual List<ObjectModel::Item^>^ GetItems(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								virtual IEnumerable<ObjectModel::Item^>^ EnumerateItems(Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields);
+
+								virtual List<ObjectModel::LocationSegment^>^ GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision);
+
+								virtual long Commit(Uri^ repositoryRoot, IEnumerable<ObjectModel::CommitItem^>^ items, String^ message);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,269 @@
+#include "Stdafx.h"
+#include "ChangeSet.h"
+#include "ContentDigest.h"
+#include "Item.h"
+#include "ItemInfo.h"
+#include "LocationSegment.h"
+#include "PathFilter.h"
+#include "RevisionFilter.h"
+#include "ReplayBackend.h"
+#include "SubversionClient.h"
+#include "TraceFile.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::IO::Compression;
+using namespace System::Collections::Generic;
+using namespace System::Threading;
+
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Backends;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+ReplayBackend::ReplayBackend(String^ traceFile)
+{
+	if(String::IsNullOrEmpty(traceFile))
+	{
+		throw gcnew ArgumentNullException("traceFile");
+	}
+
+	m_responses = gcnew Dictionary<String^, List<array<Byte>^>^>(StringComparer::Ordinal);
+	m_cursors = gcnew Dictionary<String^, int>(StringComparer::Ordinal);
+	m_latency = TimeSpan::Zero;
+	m_bandwidth = 0;
+
+	Load(traceFile);
+}
+
+void
+ReplayBackend::Load(String^ traceFile)
+{
+	BinaryReader^ reader = gcnew BinaryReader(gcnew GZipStream(gcnew FileStream(traceFile, FileMode::Open, FileAccess::Read, FileShare::Read), CompressionMode::Decompress));
+	try
+	{
+		TraceFile::ReadHeader(reader);
+
+		TraceOperation operation;
+		String^ key;
+		array<Byte>^ payload;
+		while(TraceFile::ReadRecord(reader, operation, key, payload))
+		{
+			String^ lookupKey = String::Concat(((Byte)operation).ToString(), ":", key);
+
+			List<array<Byte>^>^ responses;
+			if(!m_responses->TryGetValue(lookupKey, responses))
+			{
+				responses = gcnew List<array<Byte>^>();
+				m_responses->Add(lookupKey, responses);
+			}
+
+			responses->Add(payload);
+		}
+	}
+	finally
+	{
+		reader->Close();
+	}
+}
+
+BinaryReader^
+ReplayBackend::Respond(TraceOperation operation, String^ key)
+{
+	String^ lookupKey = String::Concat(((Byte)operation).ToString(), ":", key);
+	array<Byte>^ payload;
+
+	Monitor::Enter(this);
+	try
+	{
+		List<array<Byte>^>^ responses;
+		if(!m_responses->TryGetValue(lookupKey, responses))
+		{
+			throw gcnew MigrationException(String::Format("The subversion trace file does not contain a response for the request {0} ({1})", operation, key));
+		}
+
+		//The same request may have been issued multiple times during the recording. The responses are served in the recorded order.
+		//As soon as all of them have been used, the last response is repeated
+		int cursor = 0;
+		m_cursors->TryGetValue(lookupKey, cursor);
+		payload = responses[Math::Min(cursor, responses->Count - 1)];
+		m_cursors[lookupKey] = cursor + 1;
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+
+	TimeSpan delay = m_latency;
+	if(m_bandwidth > 0)
+	{
+		delay = delay.Add(TimeSpan::FromMilliseconds((double)payload->Length * 1000 / m_bandwidth));
+	}
+
+	if(delay > TimeSpan::Zero)
+	{
+		Thread::Sleep(delay);
+	}
+
+	return gcnew BinaryReader(gcnew MemoryStream(payload, false));
+}
+
+TimeSpan
+ReplayBackend::Latency::get()
+{
+	return m_latency;
+}
+
+void
+ReplayBackend::Latency::set(TimeSpan value)
+{
+	if(value < TimeSpan::Zero)
+	{
+		throw gcnew ArgumentOutOfRangeException("value");
+	}
+
+	m_latency = value;
+}
+
+long
+ReplayBackend::Bandwidth::get()
+{
+	return m_bandwidth;
+}
+
+void
+ReplayBackend::Bandwidth::set(long value)
+{
+	if(value < 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("value");
+	}
+
+	m_bandwidth = value;
+}
+
+void
+ReplayBackend::Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId)
+{
+	if(nullptr == client)
+	{
+		throw gcnew ArgumentNullException("client");
+	}
+
+	if(nullptr == repository)
+	{
+		throw gcnew ArgumentNullException("repository");
+	}
+
+	BinaryReader^ reader = Respond(TraceOperation::Open, TraceFile::CreateKey(repository));
+	repositoryRoot = gcnew Uri(reader->ReadString());
+	repositoryId = Guid(reader->ReadBytes(16));
+
+	m_client = client;
+}
+
+void
+ReplayBackend::Close()
+{
+	m_client = nullptr;
+}
+
+long
+ReplayBackend::GetLatestRevisionNumber(Uri^ path)
+{
+	return Respond(TraceOperation::LatestRevisionNumber, TraceFile::CreateKey(path))->ReadInt32();
+}
+
+Dictionary<long, ChangeSet^>^
+ReplayBackend::QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, PathFilter^ pathFilter, RevisionFilter^ revisionFilter)
+{
+	BinaryReader^ reader = Respond(TraceOperation::QueryHistory, TraceFile::CreateKey(path, pegRevisionNumber, startRevisionNumber, endRevisionNumber, limit, includeChanges, pathFilter, revisionFilter));
+	Dictionary<long, ChangeSet^>^ changesets = TraceFile::ReadChangeSets(reader, m_client);
+
+	//The revisions that have been rejected during the recording are not part of the trace. Only their number is
+	int skippedRevisions = reader->ReadInt32();
+	if(nullptr != revisionFilter)
+	{
+		revisionFilter->AddSkippedRevisions(skippedRevisions);
+	}
+
+	return changesets;
+}
+
+List<ItemInfo^>^
+ReplayBackend::QueryItemInfo(Uri^ path, long revision, Depth depth)
+{
+	return TraceFile::ReadItemInfos(Respond(TraceOperation::QueryItemInfo, TraceFile::CreateKey(path, revision, depth)));
+}
+
+void
+ReplayBackend::DownloadItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	BinaryReader^ reader = Respond(TraceOperation::DownloadItem, TraceFile::CreateKey(fromPath, revision));
+	File::WriteAllBytes(toPath, reader->ReadBytes((int)reader->BaseStream->Length));
+}
+
+ContentDigest^
+ReplayBackend::DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	//There is no repository checksum to verify against. The digest is computed from the recorded content
+	DownloadItem(fromPath, revision, toPath);
+	return ContentDigest::Compute(toPath);
+}
+
+bool
+ReplayBackend::AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	return Respond(TraceOperation::AreEqual, TraceFile::CreateKey(path1, revision1, path2, revision2))->ReadBoolean();
+}
+
+List<String^>^
+ReplayBackend::GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	return TraceFile::ReadPaths(Respond(TraceOperation::ModifiedItems, TraceFile::CreateKey(path1, revision1, path2, revision2)));
+}
+
+List<Item^>^
+ReplayBackend::ExportTree(Uri^ root, long revision, String^ localRoot, PathFilter^ filter)
+{
+	List<Item^>^ items = TraceFile::ReadItems(Respond(TraceOperation::ExportTree, TraceFile::CreateKey(root, revision, filter)), m_client);
+
+	for each(Item^ item in items)
+	{
+		String^ localPath = TraceFile::GetLocalPath(root, localRoot, item);
+		if(WellKnownContentType::VersionControlledFolder == item->ItemType)
+		{
+			Directory::CreateDirectory(localPath);
+		}
+		else
+		{
+			DownloadItem(gcnew Uri(item->FullServerPath), revision, localPath);
+		}
+	}
+
+	return items;
+}
+
+List<Item^>^
+ReplayBackend::GetItems(Uri^ path, long revision, Depth depth)
+{
+	return TraceFile::ReadItems(Respond(TraceOperation::GetItems, TraceFile::CreateKey(path, revision, depth)), m_client);
+}
+
+IEnumerable<Item^>^
+ReplayBackend::EnumerateItems(Uri^ path, long revision, Depth depth, DirentFields fields)
+{
+	return TraceFile::ReadItems(Respond(TraceOperation::GetItems, TraceFile::CreateKey(path, revision, depth, fields)), m_client);
+}
+
+List<LocationSegment^>^
+ReplayBackend::GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision)
+{
+	return TraceFile::ReadLocationSegments(Respond(TraceOperation::LocationSegments, TraceFile::CreateKey(path, pegRevision, startRevision, endRevision)));
+}
+
+long
+ReplayBackend::Commit(Uri^ repositoryRoot, IEnumerable<CommitItem^>^ items, String^ message)
+{
+	throw gcnew NotSupportedException("A recorded trace cannot be committed to");
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "IRepositoryBackend.h"
+#include "TraceFile.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Collections::Generic;
+using namespace System::Net;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Backends
+						{
+							/// <summary>
+							/// A backend that serves all requests from a trace file that has been created by the <see cref="RecordingBackend"/>.
+							/// No subversion server is contacted. The network characteristics can be simulated by a latency and a bandwidth
+							/// </summary>
+							public ref class ReplayBackend : public IRepositoryBackend
+							{
+							private:
+								Dictionary<String^, List<array<Byte>^>^>^ m_responses;
+								Dictionary<String^, int>^ m_cursors;
+								SubversionClient^ m_client;
+								TimeSpan m_latency;
+								long m_bandwidth;
+
+								void Load(String^ traceFile);
+								BinaryReader^ Respond(TraceOperation operation, String^ key);
+
+							public:
+								/// <summary>
+								/// Creates a replay backend
+								/// </summary>
+								/// <param name="traceFile">The path of the trace file</param>
+								/// <exception cref="MigrationException">Will be thrown if the file is not a valid trace file</exception>
+								ReplayBackend(String^ traceFile);
+
+								/// <summary>
+								/// Gets or sets the simulated delay that is added to every request
+								/// </summary>
+								property TimeSpan Latency { TimeSpan get(); void set(TimeSpan value); }
+
+								/// <summary>
+								/// Gets or sets the simulated bandwidth in bytes per second. 0 disables the bandwidth simulation
+								/// </summary>
+								property long Bandwidth { long get(); void set(long value); }
+
+								virtual void Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId);
+
+								virtual void Close();
+
+								virtual long GetLatestRevisionNumber(Uri^ path);
+
+								virtual Dictionary<long, ObjectModel::ChangeSet^>^ QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, ObjectModel::PathFilter^ pathFilter, ObjectModel::RevisionFilter^ revisionFilter);
+
+								virtual List<ObjectModel::ItemInfo^>^ QueryItemInfo(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								virtual void DownloadItem(Uri^ fromPath, long revision, String^ toPath);
+
+								virtual ObjectModel::ContentDigest^ DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath);
+
+								virtual bool AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								virtual List<String^>^ GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								virtual List<ObjectModel::Item^>^ ExportTree(Uri^ root, long revision, String^ localRoot, ObjectModel::PathFilter^ filter);
+
+								virtual List<ObjectModel::Item^>^ GetItems(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								virtual IEnumerable<ObjectModel::Item^>^ EnumerateItems(Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields);
+
+								virtual List<ObjectModel::LocationSegment^>^ GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision);
+
+								virtual long Commit(Uri^ repositoryRoot, IEnumerable<ObjectModel::CommitItem^>^ items, String^ message);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,315 @@
+#include "Stdafx.h"
+#include "AprPool.h"
+#include "DI_Svn_Client-1.h"
+#include "DI_Svn_Ra-1.h"
+#include "LibraryLoader.h"
+#include "RepositoryWatcher.h"
+#include "SubversionContext.h"
+#include "SvnError.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::IO::Pipes;
+using namespace System::Net;
+using namespace System::Security::AccessControl;
+using namespace System::Security::Principal;
+using namespace System::Threading;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+
+RevisionsAvailableEventArgs::RevisionsAvailableEventArgs(long firstRevision, long lastRevision)
+{
+	m_firstRevision = firstRevision;
+	m_lastRevision = lastRevision;
+}
+
+long
+RevisionsAvailableEventArgs::FirstRevision::get()
+{
+	return m_firstRevision;
+}
+
+long
+RevisionsAvailableEventArgs::LastRevision::get()
+{
+	return m_lastRevision;
+}
+
+RepositoryWatcher::RepositoryWatcher(Uri^ repositoryRoot, NetworkCredential^ credential, String^ pipeName)
+{
+	if(nullptr == repositoryRoot)
+	{
+		throw gcnew ArgumentNullException("repositoryRoot");
+	}
+
+	m_repositoryRoot = repositoryRoot;
+	m_credential = credential;
+	m_pipeName = String::IsNullOrEmpty(pipeName) ? nullptr : pipeName;
+
+	m_context = nullptr;
+	m_sessionPool = nullptr;
+	m_session = NULL;
+
+	m_latestRevision = -1;
+	m_interval = MinimumInterval;
+	m_maximumInterval = DefaultMaximumInterval;
+
+	m_pipe = nullptr;
+	m_poller = nullptr;
+	m_listener = nullptr;
+	m_wakeup = gcnew AutoResetEvent(false);
+	m_stopped = true;
+}
+
+RepositoryWatcher::~RepositoryWatcher()
+{
+	Stop();
+}
+
+long
+RepositoryWatcher::LatestRevision::get()
+{
+	return m_latestRevision;
+}
+
+TimeSpan
+RepositoryWatcher::MaximumInterval::get()
+{
+	return TimeSpan::FromMilliseconds(m_maximumInterval);
+}
+
+void
+RepositoryWatcher::MaximumInterval::set(TimeSpan value)
+{
+	if(value.TotalMilliseconds < MinimumInterval || value.TotalMilliseconds > Int32::MaxValue)
+	{
+		throw gcnew ArgumentOutOfRangeException("value");
+	}
+
+	m_maximumInterval = (int)value.TotalMilliseconds;
+}
+
+String^
+RepositoryWatcher::PipeName::get()
+{
+	return m_pipeName;
+}
+
+void
+RepositoryWatcher::Start()
+{
+	if(nullptr != m_poller)
+	{
+		throw gcnew InvalidOperationException("The watcher has already been started");
+	}
+
+	m_context = gcnew SubversionContext(m_credential);
+	m_latestRevision = QueryLatestRevision();
+	m_interval = MinimumInterval;
+	m_stopped = false;
+
+	if(nullptr != m_pipeName)
+	{
+		//The hook runs under the account of the subversion server. A message only triggers a poll. Therefore every authenticated user may send one
+		PipeSecurity^ security = gcnew PipeSecurity();
+		security->AddAccessRule(gcnew PipeAccessRule(gcnew SecurityIdentifier(WellKnownSidType::AuthenticatedUserSid, nullptr), PipeAccessRights::ReadWrite, AccessControlType::Allow));
+		security->AddAccessRule(gcnew PipeAccessRule(WindowsIdentity::GetCurrent()->User, PipeAccessRights::FullControl, AccessControlType::Allow));
+
+		m_pipe = gcnew NamedPipeServerStream(m_pipeName, PipeDirection::In, 1, PipeTransmissionMode::Byte, PipeOptions::None, 0, 0, security);
+
+		m_listener = gcnew Thread(gcnew ThreadStart(this, &RepositoryWatcher::Listen));
+		m_listener->IsBackground = true;
+		m_listener->Start();
+	}
+
+	m_poller = gcnew Thread(gcnew ThreadStart(this, &RepositoryWatcher::Poll));
+	m_poller->IsBackground = true;
+	m_poller->Start();
+
+	TraceManager::TraceInformation("Subversion Client: Watching {0} for revisions after {1}", m_repositoryRoot, m_latestRevision);
+}
+
+void
+RepositoryWatcher::Stop()
+{
+	m_stopped = true;
+	m_wakeup->Set();
+
+	if(nullptr != m_listener)
+	{
+		//The listener is blocked until a client connects
+		NamedPipeClientStream^ client = gcnew NamedPipeClientStream(".", m_pipeName, PipeDirection::Out);
+		try
+		{
+			client->Connect(StopConnectTimeout);
+		}
+		catch(TimeoutException^)
+		{
+			//The listener is not waiting for a connection. It checks the stop flag before it waits for the next one
+		}
+		catch(IOException^)
+		{
+		}
+		finally
+		{
+			delete client;
+		}
+
+		m_listener->Join();
+		m_listener = nullptr;
+	}
+
+	if(nullptr != m_pipe)
+	{
+		delete m_pipe;
+		m_pipe = nullptr;
+	}
+
+	if(nullptr != m_poller)
+	{
+		m_poller->Join();
+		m_poller = nullptr;
+	}
+
+	CloseSession();
+
+	if(nullptr != m_context)
+	{
+		delete m_context;
+		m_context = nullptr;
+	}
+}
+
+void
+RepositoryWatcher::Notify()
+{
+	m_wakeup->Set();
+}
+
+void
+RepositoryWatcher::Poll()
+{
+	while(true)
+	{
+		m_wakeup->WaitOne(m_interval);
+		if(m_stopped)
+		{
+			return;
+		}
+
+		try
+		{
+			long latestRevision = QueryLatestRevision();
+			if(latestRevision > m_latestRevision)
+			{
+				Publish(latestRevision);
+				m_interval = MinimumInterval;
+			}
+			else
+			{
+				m_interval = Math::Min(m_maximumInterval, m_interval + m_interval / 2);
+			}
+		}
+		catch(Exception^ e)
+		{
+			//The watcher must survive a server that is temporarily unreachable. The session is reopened by the next poll
+			TraceManager::TraceWarning("Subversion Client: Polling the latest revision of {0} failed: {1}", m_repositoryRoot, e->Message);
+			CloseSession();
+			m_interval = Math::Min(m_maximumInterval, 2 * m_interval);
+		}
+	}
+}
+
+void
+RepositoryWatcher::Listen()
+{
+	array<Byte>^ buffer = gcnew array<Byte>(256);
+
+	while(!m_stopped)
+	{
+		try
+		{
+			m_pipe->WaitForConnection();
+			try
+			{
+				//The message is drained but not interpreted
+				while(m_pipe->Read(buffer, 0, buffer->Length) > 0)
+				{
+				}
+			}
+			finally
+			{
+				m_pipe->Disconnect();
+			}
+		}
+		catch(IOException^ e)
+		{
+			//A client that breaks the pipe still announces a commit
+			TraceManager::TraceWarning("Subversion Client: Receiving a commit notification on pipe {0} failed: {1}", m_pipeName, e->Message);
+		}
+
+		if(!m_stopped)
+		{
+			m_wakeup->Set();
+		}
+	}
+}
+
+long
+RepositoryWatcher::QueryLatestRevision()
+{
+	if(NULL == m_session)
+	{
+		m_sessionPool = gcnew AprPool();
+
+		svn_ra_session_t* session = NULL;
+		SvnError::Err(Svn_Client::Instance()->SVN_CLIENT_OPEN_RA_SESSION(&session, m_sessionPool->CopyString(m_repositoryRoot->AbsoluteUri), m_context->Handle, m_sessionPool->Handle));
+		m_session = session;
+	}
+
+	AprPool^ pool = gcnew AprPool();
+	try
+	{
+		svn_revnum_t latestRevision = SVN_INVALID_REVNUM;
+		SvnError::Err(Svn_Ra::Instance()->SVN_RA_GET_LATEST_REVNUM(m_session, &latestRevision, pool->Handle));
+		return (long)latestRevision;
+	}
+	finally
+	{
+		delete pool;
+	}
+}
+
+void
+RepositoryWatcher::CloseSession()
+{
+	//The session is allocated in its pool and closed with it
+	m_session = NULL;
+
+	if(nullptr != m_sessionPool)
+	{
+		delete m_sessionPool;
+		m_sessionPool = nullptr;
+	}
+}
+
+void
+RepositoryWatcher::Publish(long latestRevision)
+{
+	long firstRevision = m_latestRevision + 1;
+	m_latestRevision = latestRevision;
+
+	try
+	{
+		RevisionsAvailable(this, gcnew RevisionsAvailableEventArgs(firstRevision, latestRevision));
+	}
+	catch(Exception^ e)
+	{
+		//An exception of a handler would terminate the thread of the watcher and the process with it
+		TraceManager::TraceWarning("Subversion Client: A handler of the revisions {0} to {1} failed: {2}", firstRevision, latestRevision, e->Message);
+	}
+}
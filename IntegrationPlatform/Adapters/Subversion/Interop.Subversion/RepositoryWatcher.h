@@ -0,0 +1,152 @@
+#pragma once
+
+#include <svn_ra.h>
+
+using namespace System;
+using namespace System::IO::Pipes;
+using namespace System::Net;
+using namespace System::Threading;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							ref class AprPool;
+							ref class SubversionContext;
+						}
+
+						namespace ObjectModel
+						{
+							/// <summary>
+							/// Describes the revisions that have been committed since the last notification of a <see cref="RepositoryWatcher"/>
+							/// </summary>
+							public ref class RevisionsAvailableEventArgs : public EventArgs
+							{
+							private:
+								long m_firstRevision;
+								long m_lastRevision;
+
+							public:
+								RevisionsAvailableEventArgs(long firstRevision, long lastRevision);
+
+								/// <summary>
+								/// Gets the first new revision
+								/// </summary>
+								property long FirstRevision { long get(); }
+
+								/// <summary>
+								/// Gets the latest revision of the repository
+								/// </summary>
+								property long LastRevision { long get(); }
+							};
+
+							/// <summary>
+							/// Detects new revisions of a repository with low latency and at low cost for the server. The watcher keeps one RA session
+							/// open and asks it for the youngest revision only, which is a single cheap request instead of a log query. The poll
+							/// interval starts at one second and grows by half after every poll without a new revision up to the maximum interval.
+							/// It is reset as soon as a new revision has been found. Failed polls double the interval and reopen the session.
+							/// <para/>
+							/// Optionally the watcher listens on a local named pipe. A post-commit hook that writes anything to the pipe triggers an
+							/// immediate poll. The content of the message is not trusted; the revision is always read from the repository
+							/// </summary>
+							public ref class RepositoryWatcher
+							{
+							private:
+								static const int MinimumInterval = 1000;
+								static const int DefaultMaximumInterval = 60000;
+
+								//The listener is woken up by a connection of its own when the watcher stops
+								static const int StopConnectTimeout = 1000;
+
+								Uri^ m_repositoryRoot;
+								NetworkCredential^ m_credential;
+								String^ m_pipeName;
+
+								Helpers::SubversionContext^ m_context;
+								Helpers::AprPool^ m_sessionPool;
+								svn_ra_session_t* m_session;
+
+								long m_latestRevision;
+								int m_interval;
+								int m_maximumInterval;
+
+								NamedPipeServerStream^ m_pipe;
+								Thread^ m_poller;
+								Thread^ m_listener;
+								AutoResetEvent^ m_wakeup;
+								volatile bool m_stopped;
+
+								void Poll();
+								void Listen();
+								long QueryLatestRevision();
+								void CloseSession();
+								void Publish(long latestRevision);
+
+							internal:
+								/// <summary>
+								/// Creates a new watcher. The repository is not contacted before the watcher is started
+								/// </summary>
+								/// <param name="repositoryRoot">The root of the repository</param>
+								/// <param name="credential">The credentials that shall be used to authenticate the user on the repository</param>
+								/// <param name="pipeName">The name of the local pipe that receives the commit notifications; null if no notifications are expected</param>
+								RepositoryWatcher(Uri^ repositoryRoot, NetworkCredential^ credential, String^ pipeName);
+
+							public:
+								/// <summary>
+								/// Default destructor. Stops the watcher
+								/// </summary>
+								~RepositoryWatcher();
+
+								/// <summary>
+								/// Raised on the thread of the watcher whenever new revisions have been found
+								/// </summary>
+								event EventHandler<RevisionsAvailableEventArgs^>^ RevisionsAvailable;
+
+								/// <summary>
+								/// Gets the latest revision that has been found; -1 if the watcher has not been started yet
+								/// </summary>
+								property long LatestRevision { long get(); }
+
+								/// <summary>
+								/// Gets or sets the longest time between two polls of the repository
+								/// </summary>
+								property TimeSpan MaximumInterval { TimeSpan get(); void set(TimeSpan value); }
+
+								/// <summary>
+								/// Gets the name of the local pipe that receives the commit notifications; null if no notifications are expected
+								/// </summary>
+								property String^ PipeName { String^ get(); }
+
+								/// <summary>
+								/// Queries the latest revision once and starts to watch the repository
+								/// </summary>
+								/// <exception cref="MigrationException">Will be thrown if the repository cannot be reached</exception>
+								void Start();
+
+								/// <summary>
+								/// Stops to watch the repository and closes the session
+								/// </summary>
+								void Stop();
+
+								/// <summary>
+								/// Triggers an immediate poll of the repository
+								/// </summary>
+								void Notify();
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,196 @@
+#include "Stdafx.h"
+#include <svn_props.h>
+#include "DI_LibApr.h"
+#include "RevisionFilter.h"
+#include "RevisionMatcher.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Globalization;
+using namespace System::Text;
+using namespace System::Threading;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+//Converts a managed string to a zero terminated UTF-8 buffer that is valid as long as the returned array is pinned
+static array<Byte>^ ToUTF8(String^ value)
+{
+	array<Byte>^ bytes = gcnew array<Byte>(Encoding::UTF8->GetByteCount(value) + 1);
+	Encoding::UTF8->GetBytes(value, 0, value->Length, bytes, 0);
+	return bytes;
+}
+
+RevisionFilter::RevisionFilter()
+{
+	m_matcher = new RevisionMatcher();
+	m_includedAuthors = gcnew List<String^>();
+	m_excludedAuthors = gcnew List<String^>();
+	m_from = DateTime::MinValue;
+	m_to = DateTime::MaxValue;
+	m_skippedRevisions = 0;
+}
+
+RevisionFilter::~RevisionFilter()
+{
+	this->!RevisionFilter();
+}
+
+RevisionFilter::!RevisionFilter()
+{
+	if(NULL != m_matcher)
+	{
+		delete m_matcher;
+		m_matcher = NULL;
+	}
+}
+
+String^
+RevisionFilter::FormatDate(DateTime value)
+{
+	if(DateTimeKind::Local == value.Kind)
+	{
+		value = value.ToUniversalTime();
+	}
+
+	//This is the format subversion uses to store svn:date
+	return value.ToString("yyyy-MM-dd'T'HH:mm:ss.ffffff'Z'", CultureInfo::InvariantCulture);
+}
+
+String^
+RevisionFilter::SkipComment::get()
+{
+	return m_skipComment;
+}
+
+void
+RevisionFilter::SkipComment::set(String^ value)
+{
+	m_skipComment = String::IsNullOrEmpty(value) ? nullptr : value;
+
+	array<Byte>^ bytes = ToUTF8(nullptr == m_skipComment ? String::Empty : m_skipComment);
+	pin_ptr<Byte> pinned = &bytes[0];
+	m_matcher->SetSkipComment((const char*)pinned);
+}
+
+DateTime
+RevisionFilter::From::get()
+{
+	return m_from;
+}
+
+void
+RevisionFilter::From::set(DateTime value)
+{
+	m_from = value;
+
+	array<Byte>^ from = ToUTF8(DateTime::MinValue == m_from ? String::Empty : FormatDate(m_from));
+	array<Byte>^ to = ToUTF8(DateTime::MaxValue == m_to ? String::Empty : FormatDate(m_to));
+	pin_ptr<Byte> pinnedFrom = &from[0];
+	pin_ptr<Byte> pinnedTo = &to[0];
+	m_matcher->SetDateWindow((const char*)pinnedFrom, (const char*)pinnedTo);
+}
+
+DateTime
+RevisionFilter::To::get()
+{
+	return m_to;
+}
+
+void
+RevisionFilter::To::set(DateTime value)
+{
+	m_to = value;
+
+	//The window is always updated as a whole
+	From = m_from;
+}
+
+int
+RevisionFilter::SkippedRevisions::get()
+{
+	return m_skippedRevisions;
+}
+
+void
+RevisionFilter::IncludeAuthor(String^ author)
+{
+	if(nullptr == author)
+	{
+		throw gcnew ArgumentNullException("author");
+	}
+
+	m_includedAuthors->Add(author);
+
+	array<Byte>^ bytes = ToUTF8(author);
+	pin_ptr<Byte> pinned = &bytes[0];
+	m_matcher->IncludeAuthor((const char*)pinned);
+}
+
+void
+RevisionFilter::ExcludeAuthor(String^ author)
+{
+	if(nullptr == author)
+	{
+		throw gcnew ArgumentNullException("author");
+	}
+
+	m_excludedAuthors->Add(author);
+
+	array<Byte>^ bytes = ToUTF8(author);
+	pin_ptr<Byte> pinned = &bytes[0];
+	m_matcher->ExcludeAuthor((const char*)pinned);
+}
+
+bool
+RevisionFilter::Matches(svn_log_entry_t* log_entry)
+{
+	if(NULL == m_matcher)
+	{
+		throw gcnew ObjectDisposedException("RevisionFilter");
+	}
+
+	if(NULL == log_entry || NULL == log_entry->revprops)
+	{
+		//Without revision properties there is nothing to evaluate. Let the changeset deal with the entry
+		return true;
+	}
+
+	LibApr^ libApr = LibApr::Instance();
+	svn_string_t* log = (svn_string_t*)libApr->AprHashGet(log_entry->revprops, SVN_PROP_REVISION_LOG, APR_HASH_KEY_STRING);
+	svn_string_t* author = (svn_string_t*)libApr->AprHashGet(log_entry->revprops, SVN_PROP_REVISION_AUTHOR, APR_HASH_KEY_STRING);
+	svn_string_t* date = (svn_string_t*)libApr->AprHashGet(log_entry->revprops, SVN_PROP_REVISION_DATE, APR_HASH_KEY_STRING);
+
+	return Matches(NULL == log ? NULL : log->data, NULL == author ? NULL : author->data, NULL == date ? NULL : date->data);
+}
+
+bool
+RevisionFilter::Matches(const char* log, const char* author, const char* date)
+{
+	if(NULL == m_matcher)
+	{
+		throw gcnew ObjectDisposedException("RevisionFilter");
+	}
+
+	if(m_matcher->Matches(log, author, date))
+	{
+		return true;
+	}
+
+	Interlocked::Increment(m_skippedRevisions);
+	return false;
+}
+
+void
+RevisionFilter::AddSkippedRevisions(int count)
+{
+	Interlocked::Add(m_skippedRevisions, count);
+}
+
+String^
+RevisionFilter::ToString()
+{
+	return String::Format(CultureInfo::InvariantCulture, "skip={0};include={1};exclude={2};from={3:o};to={4:o}", 
+		m_skipComment, String::Join(",", m_includedAuthors->ToArray()), String::Join(",", m_excludedAuthors->ToArray()), m_from, m_to);
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <svn_client.h>
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							class RevisionMatcher;
+						}
+
+						namespace ObjectModel
+						{
+							/// <summary>
+							/// Predicate on the revision properties (log message, author and date) that is evaluated in the native log receiver.
+							/// Revisions that do not pass the filter are not materialized at all; they are only counted
+							/// </summary>
+							public ref class RevisionFilter
+							{
+							private:
+								Helpers::RevisionMatcher* m_matcher;
+								String^ m_skipComment;
+								List<String^>^ m_includedAuthors;
+								List<String^>^ m_excludedAuthors;
+								DateTime m_from;
+								DateTime m_to;
+								int m_skippedRevisions;
+
+								static String^ FormatDate(DateTime value);
+
+							internal:
+								/// <summary>
+								/// Determines whether the log entry passes the filter. Rejected entries are added to <see cref="SkippedRevisions"/>
+								/// </summary>
+								bool Matches(svn_log_entry_t* log_entry);
+
+								/// <summary>
+								/// Determines whether the UTF-8 encoded revision properties pass the filter. Missing properties are NULL.
+								/// Rejected revisions are added to <see cref="SkippedRevisions"/>
+								/// </summary>
+								bool Matches(const char* log, const char* author, const char* date);
+
+								/// <summary>
+								/// Adds revisions that have been rejected elsewhere, e.g. while a trace file is replayed
+								/// </summary>
+								void AddSkippedRevisions(int count);
+
+							public:
+								/// <summary>
+								/// Default Constructor. The filter accepts all revisions until it is configured
+								/// </summary>
+								RevisionFilter();
+
+								/// <summary>
+								/// Default destructor
+								/// </summary>
+								~RevisionFilter();
+
+								/// <summary>
+								/// Default Finalizer
+								/// </summary>
+								!RevisionFilter();
+
+								/// <summary>
+								/// Gets or sets the text that excludes every revision whose log message contains it. The comparison is case sensitive
+								/// </summary>
+								property String^ SkipComment { String^ get(); void set(String^ value); }
+
+								/// <summary>
+								/// Gets or sets the earliest commit time that is accepted; <see cref="DateTime::MinValue"/> if there is no lower bound
+								/// </summary>
+								property DateTime From { DateTime get(); void set(DateTime value); }
+
+								/// <summary>
+								/// Gets or sets the latest commit time that is accepted; <see cref="DateTime::MaxValue"/> if there is no upper bound
+								/// </summary>
+								property DateTime To { DateTime get(); void set(DateTime value); }
+
+								/// <summary>
+								/// Gets the number of revisions that have been rejected by this filter
+								/// </summary>
+								property int SkippedRevisions { int get(); }
+
+								/// <summary>
+								/// Only accept the revisions of this author. Can be called multiple times to accept several authors
+								/// </summary>
+								/// <param name="author">The name of the author as it is stored in svn:author</param>
+								void IncludeAuthor(String^ author);
+
+								/// <summary>
+								/// Rejects all revisions of this author
+								/// </summary>
+								/// <param name="author">The name of the author as it is stored in svn:author</param>
+								void ExcludeAuthor(String^ author);
+
+								/// <summary>
+								/// Returns a string that identifies the configuration of this filter
+								/// </summary>
+								virtual String^ ToString() override;
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
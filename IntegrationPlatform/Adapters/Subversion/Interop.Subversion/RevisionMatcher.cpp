@@ -0,0 +1,89 @@
+#include "Stdafx.h"
+#include "RevisionMatcher.h"
+
+#include <algorithm>
+#include <string.h>
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+
+RevisionMatcher::RevisionMatcher()
+{
+}
+
+void
+RevisionMatcher::SetSkipComment(const char* comment)
+{
+	m_skipComment = (NULL == comment) ? "" : comment;
+}
+
+void
+RevisionMatcher::IncludeAuthor(const char* author)
+{
+	Insert(m_includedAuthors, author);
+}
+
+void
+RevisionMatcher::ExcludeAuthor(const char* author)
+{
+	Insert(m_excludedAuthors, author);
+}
+
+void
+RevisionMatcher::SetDateWindow(const char* from, const char* to)
+{
+	m_from = (NULL == from) ? "" : from;
+	m_to = (NULL == to) ? "" : to;
+}
+
+void
+RevisionMatcher::Insert(std::vector<std::string>& authors, const char* author)
+{
+	//The authors are kept sorted so that a lookup is a binary search
+	std::string value((NULL == author) ? "" : author);
+	std::vector<std::string>::iterator position = std::lower_bound(authors.begin(), authors.end(), value);
+	if(position == authors.end() || *position != value)
+	{
+		authors.insert(position, value);
+	}
+}
+
+bool
+RevisionMatcher::Contains(const std::vector<std::string>& authors, const char* author)
+{
+	return std::binary_search(authors.begin(), authors.end(), std::string((NULL == author) ? "" : author));
+}
+
+bool
+RevisionMatcher::Matches(const char* log, const char* author, const char* date) const
+{
+	if(!m_skipComment.empty() && NULL != log && NULL != strstr(log, m_skipComment.c_str()))
+	{
+		return false;
+	}
+
+	if(!m_includedAuthors.empty() && !Contains(m_includedAuthors, author))
+	{
+		return false;
+	}
+
+	if(!m_excludedAuthors.empty() && Contains(m_excludedAuthors, author))
+	{
+		return false;
+	}
+
+	//svn:date is always stored as UTC in the fixed ISO 8601 format. Therefore the lexical order is the chronological order
+	if(NULL != date)
+	{
+		if(!m_from.empty() && strcmp(date, m_from.c_str()) < 0)
+		{
+			return false;
+		}
+
+		if(!m_to.empty() && strcmp(date, m_to.c_str()) > 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
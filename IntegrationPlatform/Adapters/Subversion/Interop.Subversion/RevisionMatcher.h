@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							/// <summary>
+							/// Native predicate on the revision properties of a log entry. All values are compared on the UTF-8 encoded strings
+							/// as they are delivered by subversion. Therefore a revision can be evaluated without allocating any memory
+							/// </summary>
+							class RevisionMatcher
+							{
+							public:
+								RevisionMatcher();
+
+								/// <summary>
+								/// Sets the text that excludes a revision if its log message contains it; an empty text disables the check
+								/// </summary>
+								void SetSkipComment(const char* comment);
+
+								/// <summary>
+								/// Adds an author to the include set. If the set is not empty, only revisions of these authors are accepted
+								/// </summary>
+								void IncludeAuthor(const char* author);
+
+								/// <summary>
+								/// Adds an author to the exclude set
+								/// </summary>
+								void ExcludeAuthor(const char* author);
+
+								/// <summary>
+								/// Sets the inclusive date window. The dates have to be in the svn:date format; empty strings leave the window open
+								/// </summary>
+								void SetDateWindow(const char* from, const char* to);
+
+								/// <summary>
+								/// Determines whether a revision with the specified properties is accepted. Missing properties are passed as NULL
+								/// </summary>
+								bool Matches(const char* log, const char* author, const char* date) const;
+
+							private:
+								std::string m_skipComment;
+								std::vector<std::string> m_includedAuthors;
+								std::vector<std::string> m_excludedAuthors;
+								std::string m_from;
+								std::string m_to;
+
+								static void Insert(std::vector<std::string>& authors, const char* author);
+								static bool Contains(const std::vector<std::string>& authors, const char* author);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,324 @@
+#include "Stdafx.h"
+#include "ChangeSet.h"
+#include "ContentDigest.h"
+#include "Item.h"
+#include "ItemInfo.h"
+#include "PathFilter.h"
+#include "RevisionFilter.h"
+#include "LocationSegment.h"
+#include "SharedCacheBackend.h"
+#include "SharedRegion.h"
+#include "SubversionClient.h"
+#include "TraceFile.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Collections::Generic;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Backends;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+SharedCacheBackend::SharedCacheBackend(IRepositoryBackend^ backend, long long capacity)
+{
+	if(nullptr == backend)
+	{
+		throw gcnew ArgumentNullException("backend");
+	}
+
+	if(capacity <= 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("capacity");
+	}
+
+	m_backend = backend;
+
+	//The records of the region are addressed by 32 bit offsets
+	m_capacity = (int)Math::Min(capacity, (long long)Int32::MaxValue);
+}
+
+SharedCacheBackend::~SharedCacheBackend()
+{
+	Close();
+}
+
+bool
+SharedCacheBackend::TryGet(TraceOperation operation, String^ key, [Out] BinaryReader^% reader)
+{
+	reader = nullptr;
+
+	Helpers::SharedRegion^ region = m_region;
+	array<Byte>^ payload;
+	if(nullptr == region || !region->TryGet(String::Concat(((Byte)operation).ToString(), ":", key), payload))
+	{
+		return false;
+	}
+
+	reader = gcnew BinaryReader(gcnew MemoryStream(payload, false));
+	return true;
+}
+
+void
+SharedCacheBackend::Add(TraceOperation operation, String^ key, MemoryStream^ payload)
+{
+	//A full region is not an error. The response is simply requested from the server again the next time
+	Helpers::SharedRegion^ region = m_region;
+	if(nullptr != region)
+	{
+		region->TryAdd(String::Concat(((Byte)operation).ToString(), ":", key), payload->ToArray());
+	}
+}
+
+void
+SharedCacheBackend::Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId)
+{
+	m_backend->Open(client, repository, credential, repositoryRoot, repositoryId);
+
+	m_client = client;
+	m_repositoryRoot = repositoryRoot;
+
+	//The region is named by the repository id. Every process that migrates the same repository uses the same region
+	if(nullptr == m_region)
+	{
+		m_region = gcnew Helpers::SharedRegion(String::Concat("Local\\SubversionAdapter.", repositoryId.ToString("N")), m_capacity);
+	}
+}
+
+void
+SharedCacheBackend::Close()
+{
+	m_backend->Close();
+
+	if(nullptr != m_region)
+	{
+		delete m_region;
+		m_region = nullptr;
+	}
+
+	m_client = nullptr;
+}
+
+long
+SharedCacheBackend::GetLatestRevisionNumber(Uri^ path)
+{
+	//The answer changes with every commit
+	return m_backend->GetLatestRevisionNumber(path);
+}
+
+Dictionary<long, ChangeSet^>^
+SharedCacheBackend::QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, PathFilter^ pathFilter, RevisionFilter^ revisionFilter)
+{
+	//An open range grows with every commit. A path that is resolved in the head revision may be replaced later on. Only the root of
+	//the repository is guaranteed to be the same item in every revision
+	if(startRevisionNumber < 0 || endRevisionNumber < 0 || (pegRevisionNumber < 0 && !Uri::Equals(path, m_repositoryRoot)))
+	{
+		return m_backend->QueryHistory(path, pegRevisionNumber, startRevisionNumber, endRevisionNumber, limit, includeChanges, pathFilter, revisionFilter);
+	}
+
+	String^ key = TraceFile::CreateKey(path, pegRevisionNumber, startRevisionNumber, endRevisionNumber, limit, includeChanges, pathFilter, revisionFilter);
+
+	BinaryReader^ reader;
+	if(TryGet(TraceOperation::QueryHistory, key, reader))
+	{
+		Dictionary<long, ChangeSet^>^ cached = TraceFile::ReadChangeSets(reader, m_client);
+
+		//The revisions that have been rejected by the filter are not part of the response. Only their number is
+		int skipped = reader->ReadInt32();
+		if(nullptr != revisionFilter)
+		{
+			revisionFilter->AddSkippedRevisions(skipped);
+		}
+
+		return cached;
+	}
+
+	int skippedRevisions = (nullptr == revisionFilter) ? 0 : revisionFilter->SkippedRevisions;
+	Dictionary<long, ChangeSet^>^ changesets = m_backend->QueryHistory(path, pegRevisionNumber, startRevisionNumber, endRevisionNumber, limit, includeChanges, pathFilter, revisionFilter);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	BinaryWriter^ writer = gcnew BinaryWriter(payload);
+	TraceFile::WriteChangeSets(writer, changesets);
+	writer->Write((Int32)((nullptr == revisionFilter) ? 0 : revisionFilter->SkippedRevisions - skippedRevisions));
+	Add(TraceOperation::QueryHistory, key, payload);
+
+	return changesets;
+}
+
+List<ItemInfo^>^
+SharedCacheBackend::QueryItemInfo(Uri^ path, long revision, Depth depth)
+{
+	if(revision < 0)
+	{
+		return m_backend->QueryItemInfo(path, revision, depth);
+	}
+
+	String^ key = TraceFile::CreateKey(path, revision, depth);
+
+	BinaryReader^ reader;
+	if(TryGet(TraceOperation::QueryItemInfo, key, reader))
+	{
+		return TraceFile::ReadItemInfos(reader);
+	}
+
+	List<ItemInfo^>^ infos = m_backend->QueryItemInfo(path, revision, depth);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	TraceFile::WriteItemInfos(gcnew BinaryWriter(payload), infos);
+	Add(TraceOperation::QueryItemInfo, key, payload);
+
+	return infos;
+}
+
+void
+SharedCacheBackend::DownloadItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	m_backend->DownloadItem(fromPath, revision, toPath);
+}
+
+ContentDigest^
+SharedCacheBackend::DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	return m_backend->DownloadVerifiedItem(fromPath, revision, toPath);
+}
+
+bool
+SharedCacheBackend::AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	if(revision1 < 0 || revision2 < 0)
+	{
+		return m_backend->AreEqual(path1, revision1, path2, revision2);
+	}
+
+	String^ key = TraceFile::CreateKey(path1, revision1, path2, revision2);
+
+	BinaryReader^ reader;
+	if(TryGet(TraceOperation::AreEqual, key, reader))
+	{
+		return reader->ReadBoolean();
+	}
+
+	bool result = m_backend->AreEqual(path1, revision1, path2, revision2);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	BinaryWriter^ writer = gcnew BinaryWriter(payload);
+	writer->Write(result);
+	Add(TraceOperation::AreEqual, key, payload);
+
+	return result;
+}
+
+List<String^>^
+SharedCacheBackend::GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	if(revision1 < 0 || revision2 < 0)
+	{
+		return m_backend->GetModifiedItems(path1, revision1, path2, revision2);
+	}
+
+	String^ key = TraceFile::CreateKey(path1, revision1, path2, revision2);
+
+	BinaryReader^ reader;
+	if(TryGet(TraceOperation::ModifiedItems, key, reader))
+	{
+		return TraceFile::ReadPaths(reader);
+	}
+
+	List<String^>^ items = m_backend->GetModifiedItems(path1, revision1, path2, revision2);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	TraceFile::WritePaths(gcnew BinaryWriter(payload), items);
+	Add(TraceOperation::ModifiedItems, key, payload);
+
+	return items;
+}
+
+List<Item^>^
+SharedCacheBackend::ExportTree(Uri^ root, long revision, String^ localRoot, PathFilter^ filter)
+{
+	//The export writes the content of the files to disk. Content is never served from the shared region
+	return m_backend->ExportTree(root, revision, localRoot, filter);
+}
+
+List<Item^>^
+SharedCacheBackend::GetItems(Uri^ path, long revision, Depth depth)
+{
+	if(revision < 0)
+	{
+		return m_backend->GetItems(path, revision, depth);
+	}
+
+	String^ key = TraceFile::CreateKey(path, revision, depth);
+
+	BinaryReader^ reader;
+	if(TryGet(TraceOperation::GetItems, key, reader))
+	{
+		return TraceFile::ReadItems(reader, m_client);
+	}
+
+	List<Item^>^ items = m_backend->GetItems(path, revision, depth);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	TraceFile::WriteItems(gcnew BinaryWriter(payload), items);
+	Add(TraceOperation::GetItems, key, payload);
+
+	return items;
+}
+
+IEnumerable<Item^>^
+SharedCacheBackend::EnumerateItems(Uri^ path, long revision, Depth depth, DirentFields fields)
+{
+	if(revision < 0)
+	{
+		return m_backend->EnumerateItems(path, revision, depth, fields);
+	}
+
+	String^ key = TraceFile::CreateKey(path, revision, depth, fields);
+
+	BinaryReader^ reader;
+	if(TryGet(TraceOperation::GetItems, key, reader))
+	{
+		return TraceFile::ReadItems(reader, m_client);
+	}
+
+	//The listing is cached as a whole. Otherwise an enumeration that is stopped early would leave an incomplete response in the region
+	List<Item^>^ items = gcnew List<Item^>(m_backend->EnumerateItems(path, revision, depth, fields));
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	TraceFile::WriteItems(gcnew BinaryWriter(payload), items);
+	Add(TraceOperation::GetItems, key, payload);
+
+	return items;
+}
+
+List<LocationSegment^>^
+SharedCacheBackend::GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision)
+{
+	if(pegRevision < 0 || startRevision < 0 || endRevision < 0)
+	{
+		return m_backend->GetLocationSegments(path, pegRevision, startRevision, endRevision);
+	}
+
+	String^ key = TraceFile::CreateKey(path, pegRevision, startRevision, endRevision);
+
+	BinaryReader^ reader;
+	if(TryGet(TraceOperation::LocationSegments, key, reader))
+	{
+		return TraceFile::ReadLocationSegments(reader);
+	}
+
+	List<LocationSegment^>^ segments = m_backend->GetLocationSegments(path, pegRevision, startRevision, endRevision);
+
+	MemoryStream^ payload = gcnew MemoryStream();
+	TraceFile::WriteLocationSegments(gcnew BinaryWriter(payload), segments);
+	Add(TraceOperation::LocationSegments, key, payload);
+
+	return segments;
+}
+
+long
+SharedCacheBackend::Commit(Uri^ repositoryRoot, IEnumerable<CommitItem^>^ items, String^ message)
+{
+	//The cache only holds immutable revisions. A new revision does not invalidate any of its entries
+	return m_backend->Commit(repositoryRoot, items, message);
+}
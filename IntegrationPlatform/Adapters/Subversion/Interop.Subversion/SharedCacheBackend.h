@@ -0,0 +1,94 @@
+#pragma once
+
+#include "IRepositoryBackend.h"
+#include "SharedRegion.h"
+#include "TraceFile.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Collections::Generic;
+using namespace System::Net;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Backends
+						{
+							/// <summary>
+							/// A backend that forwards all requests to an other backend and keeps the metadata responses in a shared memory region
+							/// of the repository. All migration processes of the same machine share this region. Therefore a process that
+							/// analyzes a repository that an other process has analyzed already gets the answers without a roundtrip to the server.
+							/// <para/>
+							/// Only responses that cannot change anymore are cached. These are the requests with explicit revision numbers.
+							/// The content of files is not cached at all
+							/// </summary>
+							public ref class SharedCacheBackend : public IRepositoryBackend
+							{
+							private:
+								IRepositoryBackend^ m_backend;
+								int m_capacity;
+								SubversionClient^ m_client;
+								Uri^ m_repositoryRoot;
+								Helpers::SharedRegion^ m_region;
+
+								bool TryGet(TraceOperation operation, String^ key, [Out] BinaryReader^% reader);
+								void Add(TraceOperation operation, String^ key, MemoryStream^ payload);
+
+							public:
+								/// <summary>
+								/// Creates a caching backend
+								/// </summary>
+								/// <param name="backend">The backend that actually executes the requests</param>
+								/// <param name="capacity">The size of the shared region in bytes</param>
+								SharedCacheBackend(IRepositoryBackend^ backend, long long capacity);
+
+								/// <summary>
+								/// Default destructor
+								/// </summary>
+								~SharedCacheBackend();
+
+								virtual void Open(SubversionClient^ client, Uri^ repository, NetworkCredential^ credential, [Out] Uri^% repositoryRoot, [Out] Guid% repositoryId);
+
+								virtual void Close();
+
+								virtual long GetLatestRevisionNumber(Uri^ path);
+
+								virtual Dictionary<long, ObjectModel::ChangeSet^>^ QueryHistory(Uri^ path, long pegRevisionNumber, long startRevisionNumber, long endRevisionNumber, int limit, bool includeChanges, ObjectModel::PathFilter^ pathFilter, ObjectModel::RevisionFilter^ revisionFilter);
+
+								virtual List<ObjectModel::ItemInfo^>^ QueryItemInfo(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								virtual void DownloadItem(Uri^ fromPath, long revision, String^ toPath);
+
+								virtual ObjectModel::ContentDigest^ DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath);
+
+								virtual bool AreEqual(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								virtual List<String^>^ GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2);
+
+								virtual List<ObjectModel::Item^>^ ExportTree(Uri^ root, long revision, String^ localRoot, ObjectModel::PathFilter^ filter);
+
+								virtual List<ObjectModel::Item^>^ GetItems(Uri^ path, long revision, ObjectModel::Depth depth);
+
+								virtual IEnumerable<ObjectModel::Item^>^ EnumerateItems(Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields);
+
+								virtual List<ObjectModel::LocationSegment^>^ GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision);
+
+								virtual long Commit(Uri^ repositoryRoot, IEnumerable<ObjectModel::CommitItem^>^ items, String^ message);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,258 @@
+#include "Stdafx.h"
+#include "SharedRegion.h"
+
+using namespace System;
+using namespace System::IO::MemoryMappedFiles;
+using namespace System::Text;
+using namespace System::Threading;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+
+SharedRegion::SharedRegion(String^ name, int capacity)
+{
+	if(String::IsNullOrEmpty(name))
+	{
+		throw gcnew ArgumentNullException("name");
+	}
+
+	if(capacity < 64 * 1024)
+	{
+		throw gcnew ArgumentOutOfRangeException("capacity");
+	}
+
+	m_file = MemoryMappedFile::CreateOrOpen(name, capacity);
+	m_view = m_file->CreateViewAccessor();
+	m_writer = gcnew Mutex(false, String::Concat(name, ".Writer"));
+
+	//An existing region keeps the size of the process that created it
+	m_capacity = (int)Math::Min((long long)Int32::MaxValue, m_view->Capacity);
+
+	if(!IsInitialized())
+	{
+		Initialize();
+	}
+}
+
+SharedRegion::~SharedRegion()
+{
+	if(nullptr != m_view)
+	{
+		delete m_view;
+		m_view = nullptr;
+	}
+
+	if(nullptr != m_file)
+	{
+		delete m_file;
+		m_file = nullptr;
+	}
+
+	if(nullptr != m_writer)
+	{
+		m_writer->Close();
+		m_writer = nullptr;
+	}
+}
+
+int
+SharedRegion::Hash(array<Byte>^ key)
+{
+	//FNV-1a. String::GetHashCode differs between 32 and 64 bit processes and cannot be shared
+	unsigned int hash = 2166136261;
+	for(int i = 0; i < key->Length; i++)
+	{
+		hash = (hash ^ key[i]) * 16777619;
+	}
+
+	return (int)hash;
+}
+
+bool
+SharedRegion::IsInitialized()
+{
+	return Magic == m_view->ReadInt32(MagicOffset) && Version == m_view->ReadInt32(VersionOffset);
+}
+
+void
+SharedRegion::Initialize()
+{
+	try
+	{
+		m_writer->WaitOne();
+	}
+	catch(AbandonedMutexException^)
+	{
+		//A writer has been terminated while it held the lock. Its record has not been published
+	}
+
+	try
+	{
+		//An other process may have initialized the region while this one was waiting
+		if(IsInitialized())
+		{
+			return;
+		}
+
+		//Every slot is expected to hold a record of one kilobyte on average
+		int slotCount = Math::Max(1024, m_capacity / 1024);
+
+		array<Byte>^ empty = gcnew array<Byte>(HeaderSize + slotCount * SlotSize);
+		m_view->WriteArray<Byte>(0, empty, 0, empty->Length);
+
+		m_view->Write(SlotCountOffset, slotCount);
+		m_view->Write(EndOffset, empty->Length);
+		m_view->Write(EntryCountOffset, 0);
+		m_view->Write(VersionOffset, Version);
+
+		Thread::MemoryBarrier();
+		m_view->Write(MagicOffset, Magic);
+	}
+	finally
+	{
+		m_writer->ReleaseMutex();
+	}
+}
+
+bool
+SharedRegion::Find(array<Byte>^ key, int hash, [Out] int% slot, [Out] int% record)
+{
+	int slotCount = m_view->ReadInt32(SlotCountOffset);
+	slot = (int)((unsigned int)hash % (unsigned int)slotCount);
+	record = 0;
+
+	for(int probe = 0; probe < slotCount; probe++)
+	{
+		int position = HeaderSize + slot * SlotSize;
+
+		//The offset publishes the slot. It is written after the hash and the record
+		int offset = m_view->ReadInt32(position + 4);
+		if(0 == offset)
+		{
+			return false;
+		}
+
+		Thread::MemoryBarrier();
+		if(hash == m_view->ReadInt32(position) && key->Length == m_view->ReadInt32(offset))
+		{
+			array<Byte>^ candidate = gcnew array<Byte>(key->Length);
+			m_view->ReadArray<Byte>(offset + 8, candidate, 0, candidate->Length);
+
+			bool equal = true;
+			for(int i = 0; i < key->Length && equal; i++)
+			{
+				equal = key[i] == candidate[i];
+			}
+
+			if(equal)
+			{
+				record = offset;
+				return true;
+			}
+		}
+
+		slot = (slot + 1) % slotCount;
+	}
+
+	return false;
+}
+
+int
+SharedRegion::Count::get()
+{
+	return m_view->ReadInt32(EntryCountOffset);
+}
+
+bool
+SharedRegion::TryGet(String^ key, [Out] array<Byte>^% value)
+{
+	if(nullptr == key)
+	{
+		throw gcnew ArgumentNullException("key");
+	}
+
+	value = nullptr;
+	if(!IsInitialized())
+	{
+		return false;
+	}
+
+	array<Byte>^ keyBytes = Encoding::UTF8->GetBytes(key);
+	int slot;
+	int record;
+	if(!Find(keyBytes, Hash(keyBytes), slot, record))
+	{
+		return false;
+	}
+
+	value = gcnew array<Byte>(m_view->ReadInt32(record + 4));
+	m_view->ReadArray<Byte>(record + 8 + keyBytes->Length, value, 0, value->Length);
+	return true;
+}
+
+bool
+SharedRegion::TryAdd(String^ key, array<Byte>^ value)
+{
+	if(nullptr == key)
+	{
+		throw gcnew ArgumentNullException("key");
+	}
+
+	if(nullptr == value)
+	{
+		throw gcnew ArgumentNullException("value");
+	}
+
+	try
+	{
+		if(!m_writer->WaitOne(WriterTimeout))
+		{
+			return false;
+		}
+	}
+	catch(AbandonedMutexException^)
+	{
+		//A writer has been terminated while it held the lock. Its record has not been published
+	}
+
+	try
+	{
+		array<Byte>^ keyBytes = Encoding::UTF8->GetBytes(key);
+		int hash = Hash(keyBytes);
+		int slot;
+		int record;
+		if(Find(keyBytes, hash, slot, record))
+		{
+			return true;
+		}
+
+		//The table is kept at most three quarters full. Otherwise the probe sequences of the readers get too long
+		int slotCount = m_view->ReadInt32(SlotCountOffset);
+		int count = m_view->ReadInt32(EntryCountOffset);
+		int end = m_view->ReadInt32(EndOffset);
+		long long size = 8LL + keyBytes->Length + value->Length;
+		if((long long)(count + 1) * 4 > (long long)slotCount * 3 || end + size > m_capacity)
+		{
+			return false;
+		}
+
+		m_view->Write(end, keyBytes->Length);
+		m_view->Write(end + 4, value->Length);
+		m_view->WriteArray<Byte>(end + 8, keyBytes, 0, keyBytes->Length);
+		m_view->WriteArray<Byte>(end + 8 + keyBytes->Length, value, 0, value->Length);
+
+		int position = HeaderSize + slot * SlotSize;
+		m_view->Write(position, hash);
+
+		//The record is claimed before it is published. A writer that is terminated in between leaves unused space behind, but
+		//never a visible record that the next writer would overwrite
+		m_view->Write(EndOffset, (int)(end + size));
+		m_view->Write(EntryCountOffset, count + 1);
+		Thread::MemoryBarrier();
+		m_view->Write(position + 4, end);
+		return true;
+	}
+	finally
+	{
+		m_writer->ReleaseMutex();
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+using namespace System;
+using namespace System::IO::MemoryMappedFiles;
+using namespace System::Runtime::InteropServices;
+using namespace System::Threading;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							/// <summary>
+							/// An append only dictionary of byte arrays in a named shared memory region. Every process on the machine that opens
+							/// a region of the same name sees the entries of all other processes.
+							/// <para/>
+							/// The region starts with a header and an open addressing table of slots that is followed by the records. A record
+							/// consists of the length of the key, the length of the value, the UTF-8 key and the value. Writers are serialized
+							/// by a named mutex. They append the record, advance the end of the records and publish the record by setting the
+							/// offset of its slot afterwards. Therefore readers never take a lock: a slot either points to a complete record
+							/// or it is empty
+							/// </summary>
+							private ref class SharedRegion
+							{
+							private:
+								static const int Magic = 0x43525653;
+								static const int Version = 2;
+
+								static const int MagicOffset = 0;
+								static const int VersionOffset = 4;
+								static const int SlotCountOffset = 8;
+								static const int EndOffset = 12;
+								static const int EntryCountOffset = 16;
+								static const int HeaderSize = 32;
+								static const int SlotSize = 8;
+
+								//Writers that wait longer skip the entry. The value can be fetched again the next time
+								static const int WriterTimeout = 1000;
+
+								MemoryMappedFile^ m_file;
+								MemoryMappedViewAccessor^ m_view;
+								Mutex^ m_writer;
+								int m_capacity;
+
+								static int Hash(array<Byte>^ key);
+								bool IsInitialized();
+								void Initialize();
+								bool Find(array<Byte>^ key, int hash, [Out] int% slot, [Out] int% record);
+
+							public:
+								/// <summary>
+								/// Opens the region of the name or creates it if no other process uses it yet
+								/// </summary>
+								/// <param name="name">The name of the region that is shared by all processes</param>
+								/// <param name="capacity">The size of the region in bytes if it has to be created</param>
+								SharedRegion(String^ name, int capacity);
+
+								/// <summary>
+								/// Default destructor
+								/// </summary>
+								~SharedRegion();
+
+								/// <summary>
+								/// Gets the number of entries of the region
+								/// </summary>
+								property int Count { int get(); }
+
+								/// <summary>
+								/// Gets the value of a key
+								/// </summary>
+								/// <returns>true if the region contains the key; false otherwise</returns>
+								bool TryGet(String^ key, [Out] array<Byte>^% value);
+
+								/// <summary>
+								/// Adds a value unless the key exists already
+								/// </summary>
+								/// <returns>true if the value is part of the region; false if the region is full or the writer lock could not be acquired in time</returns>
+								bool TryAdd(String^ key, array<Byte>^ value);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -1,34 +1,56 @@
 #include "stdafx.h"
-#include "AprPool.h"
+#include "DI_Svn_Client-1.h"
+#include "IRepositoryBackend.h"
+#include "LastChangedRevisionResolver.h"
 #include "LibraryLoader.h"
-#include "SvnError.h"
+#include "ListingCache.h"
+#include "LiveBackend.h"
+#include "PathFilter.h"
+#include "RevisionFilter.h"
 #include "SubversionClient.h"
-#include "SubversionContext.h"
-#include "Utils.h"
 
 #include "ChangeSet.h"
+#include "CommitItem.h"
+#include "ContentDigest.h"
+#include "CopyGraph.h"
 #include "Item.h"
-
-#include "DiffSummaryCommand.h"
-#include "DownloadCommand.h"
-#include "ItemInfoCommand.h"
-#include "LatestRevisionCommand.h"
-#include "ListCommand.h"
-#include "LogCommand.h"
-#include "SubversionInfoCommand.h"
+#include "LocationSegment.h"
+#include "RepositoryWatcher.h"
+#include "VersionedTree.h"
 
 using namespace System;
 using namespace System::Collections::Generic;
 
 using namespace Microsoft::TeamFoundation::Migration::Toolkit;
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
-using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Commands;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Backends;
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::LibraryAccess;
 using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
 
 SubversionClient::SubversionClient()
 {
 	Interlocked::Increment(s_references);
+
+	m_backend = gcnew LiveBackend();
+	m_connected = false;
+	m_listingCacheCapacity = DefaultListingCacheCapacity;
+	m_changeSpillThreshold = DefaultChangeSpillThreshold;
+}
+
+SubversionClient::SubversionClient(IRepositoryBackend^ backend)
+{
+	if(nullptr == backend)
+	{
+		throw gcnew ArgumentNullException("backend");
+	}
+
+	Interlocked::Increment(s_references);
+
+	m_backend = backend;
+	m_connected = false;
+	m_listingCacheCapacity = DefaultListingCacheCapacity;
+	m_changeSpillThreshold = DefaultChangeSpillThreshold;
 }
 
 SubversionClient::~SubversionClient()
@@ -43,6 +65,21 @@ SubversionClient::~SubversionClient()
 	Disconnect();
 }
 
+IRepositoryBackend^
+SubversionClient::Backend::get()
+{
+	return m_backend;
+}
+
+void
+SubversionClient::EnsureConnected()
+{
+	if(!IsConnected)
+	{
+		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
+	}
+}
+
 void 
 SubversionClient::Connect(Uri^ repository, NetworkCredential^ credential)
 {
@@ -53,11 +90,9 @@ SubversionClient::Connect(Uri^ repository, NetworkCredential^ credential)
 
 	try
 	{
-		m_context = gcnew SubversionContext(credential);
 		m_virtualRepositoryRoot = repository;
-		
-		SubversionInfoCommand^ command = gcnew SubversionInfoCommand(m_context, repository);
-		command->Execute(m_repositoryRoot, m_repositoryID);
+		m_backend->Open(this, repository, credential, m_repositoryRoot, m_repositoryID);
+		m_connected = true;
 	}
 	catch(Exception^)
 	{
@@ -72,27 +107,40 @@ SubversionClient::Disconnect()
 	m_virtualRepositoryRoot = nullptr;
 	m_repositoryRoot = nullptr;
 	m_repositoryID = Guid::Empty;
+	m_connected = false;
+	m_lastChangedRevisionResolver = nullptr;
+	m_listingCache = nullptr;
+	m_tree = nullptr;
 
-	if(nullptr != m_context)
-	{
-		delete m_context;
-		m_context = nullptr;
-	}
+	m_backend->Close();
 }
 
 bool
 SubversionClient::IsConnected::get()
 {
-	return nullptr != m_context;
+	return m_connected;
+}
+
+bool
+SubversionClient::ReportsModifications::get()
+{
+	if(!s_libraryVersionDetected)
+	{
+		const svn_version_t* version = Svn_Client::Instance()->SVN_CLIENT_VERSION();
+		TraceManager::TraceInformation("Subversion Client: Using libsvn_client {0}.{1}.{2}", version->major, version->minor, version->patch);
+
+		//svn_log_changed_path2_t has been extended by text_modified and props_modified in 1.7
+		s_reportsModifications = version->major > 1 || (1 == version->major && version->minor >= 7);
+		s_libraryVersionDetected = true;
+	}
+
+	return s_reportsModifications;
 }
 						
 Guid 
 SubversionClient::RepositoryId::get()
 {
-	if(!IsConnected)
-	{
-		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
-	}
+	EnsureConnected();
 
 	return m_repositoryID;
 }
@@ -100,10 +148,7 @@ SubversionClient::RepositoryId::get()
 Uri^ 
 SubversionClient::RepositoryRoot::get()
 { 
-	if(!IsConnected)
-	{
-		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
-	}
+	EnsureConnected();
 
 	return m_repositoryRoot;
 }
@@ -111,140 +156,275 @@ SubversionClient::RepositoryRoot::get()
 Uri^ 
 SubversionClient::VirtualRepositoryRoot::get()
 { 
-	if(!IsConnected)
+	EnsureConnected();
+
+	return m_virtualRepositoryRoot;
+}
+
+long long
+SubversionClient::ListingCacheCapacity::get()
+{
+	return m_listingCacheCapacity;
+}
+
+void
+SubversionClient::ListingCacheCapacity::set(long long value)
+{
+	if(value < 0)
 	{
-		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
+		throw gcnew ArgumentOutOfRangeException("value");
 	}
 
-	return m_virtualRepositoryRoot;
+	m_listingCacheCapacity = value;
+	if(nullptr != m_listingCache)
+	{
+		m_listingCache->Capacity = value;
+	}
 }
 
-long 
-SubversionClient::GetLatestRevisionNumber(Uri^ path)
+int
+SubversionClient::ChangeSpillThreshold::get()
 {
-	if(!IsConnected)
+	return m_changeSpillThreshold;
+}
+
+void
+SubversionClient::ChangeSpillThreshold::set(int value)
+{
+	if(value < 0)
 	{
-		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
+		throw gcnew ArgumentOutOfRangeException("value");
 	}
 
-	long result;
+	m_changeSpillThreshold = value;
+}
 
-	LatestRevisionCommand^ command = gcnew LatestRevisionCommand(m_context, path);
-	command->Execute(result);
+VersionedTree^
+SubversionClient::Tree::get()
+{
+	return m_tree;
+}
 
-	return result;
+void
+SubversionClient::Tree::set(VersionedTree^ value)
+{
+	m_tree = value;
 }
 
-SubversionContext^ 
-SubversionClient::Context::get()
-{ 
-	return m_context;
-} 
+long 
+SubversionClient::GetLatestRevisionNumber(Uri^ path)
+{
+	EnsureConnected();
+
+	return m_backend->GetLatestRevisionNumber(path);
+}
 
 Dictionary<long, ChangeSet^>^
 SubversionClient::QueryHistoryRange(Uri^ path, long startRevisionNumber, long endRevisionNumber, bool includeChanges)
 {
-	if(!IsConnected)
-	{
-		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
-	}
+	EnsureConnected();
 
-	Dictionary<long, ChangeSet^>^ changesets;
-
-	LogCommand^ command = gcnew LogCommand(this, path, startRevisionNumber, endRevisionNumber, includeChanges);
-	command->Execute(changesets);
+	return QueryHistoryRange(path, startRevisionNumber, endRevisionNumber, includeChanges, nullptr);
+}
 
-	return changesets;
+Dictionary<long, ChangeSet^>^
+SubversionClient::QueryHistoryRange(Uri^ path, long startRevisionNumber, long endRevisionNumber, bool includeChanges, PathFilter^ pathFilter)
+{
+	return QueryHistoryRange(path, startRevisionNumber, endRevisionNumber, includeChanges, pathFilter, nullptr);
 }
 
 Dictionary<long, ChangeSet^>^
-SubversionClient::QueryHistory(Uri^ path, long startRevisionNumber, int limit, bool includeChanges)
+SubversionClient::QueryHistoryRange(Uri^ path, long startRevisionNumber, long endRevisionNumber, bool includeChanges, PathFilter^ pathFilter, RevisionFilter^ revisionFilter)
 {
-	if(!IsConnected)
-	{
-		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
-	}
+	EnsureConnected();
 
-	Dictionary<long, ChangeSet^>^ changesets;
+	return m_backend->QueryHistory(path, -1, startRevisionNumber, endRevisionNumber, 0, includeChanges, pathFilter, revisionFilter);
+}
 
-	LogCommand^ command = gcnew LogCommand(this, path, startRevisionNumber, limit, includeChanges);
-	command->Execute(changesets);
+PathFilter^
+SubversionClient::CreatePathFilter(IEnumerable<Uri^>^ mappedPaths, IEnumerable<Uri^>^ cloakedPaths)
+{
+	EnsureConnected();
 
-	return changesets;
+	return gcnew PathFilter(m_repositoryRoot, mappedPaths, cloakedPaths);
 }
 
 Dictionary<long, ChangeSet^>^
-SubversionClient::QueryHistory(Uri^ path, int limit, bool includeChanges)
+SubversionClient::QueryHistory(Uri^ path, long startRevisionNumber, int limit, bool includeChanges)
 {
-	if(!IsConnected)
-	{
-		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
-	}
+	EnsureConnected();
 
-	Dictionary<long, ChangeSet^>^ changesets;
+	return m_backend->QueryHistory(path, startRevisionNumber, -1, -1, limit, includeChanges, nullptr, nullptr);
+}
 
-	LogCommand^ command = gcnew LogCommand(this, path, limit, includeChanges);
-	command->Execute(changesets);
+Dictionary<long, ChangeSet^>^
+SubversionClient::QueryHistory(Uri^ path, int limit, bool includeChanges)
+{
+	EnsureConnected();
 
-	return changesets;
+	return m_backend->QueryHistory(path, -1, -1, -1, limit, includeChanges, nullptr, nullptr);
 }
 
 List<ItemInfo^>^ 
 SubversionClient::QueryItemInfo(Uri^ path, long revision, Depth depth)
 {
-	if(!IsConnected)
-	{
-		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
-	}
-
-	List<ItemInfo^>^ items;
-
-	ItemInfoCommand^ command = gcnew ItemInfoCommand(this, path, revision, depth);
-	command->Execute(items);
+	EnsureConnected();
 
-	return items;
+	return m_backend->QueryItemInfo(path, revision, depth);
 }
 
 void
 SubversionClient::DownloadItem(Uri^ fromPath,  long revision, String^ toPath)
 {
-	if(!IsConnected)
-	{
-		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
-	}
+	EnsureConnected();
+
+	m_backend->DownloadItem(fromPath, revision, toPath);
+}
+
+ContentDigest^
+SubversionClient::DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath)
+{
+	EnsureConnected();
 
-	DownloadCommand^ command = gcnew DownloadCommand(m_context, fromPath, revision, toPath);
-	command->Execute();
+	return m_backend->DownloadVerifiedItem(fromPath, revision, toPath);
 }
 
 bool 
 SubversionClient::HasContentChange(Uri^ path1, long revision1, System::Uri^ path2, long revision2)
 {
-	if(!IsConnected)
-	{
-		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
-	}
+	EnsureConnected();
 
-	bool result;
+	return !m_backend->AreEqual(path1, revision1, path2, revision2);
+}
 
-	DiffSummaryCommand^ command = gcnew DiffSummaryCommand(m_context, path1, revision1, path2, revision2);
-	command->AreEqual(result);
+List<Item^>^
+SubversionClient::ExportTree(Uri^ root, long revision, String^ localRoot, PathFilter^ filter)
+{
+	EnsureConnected();
+
+	return m_backend->ExportTree(root, revision, localRoot, filter);
+}
+
+List<String^>^
+SubversionClient::GetModifiedItems(Uri^ path1, long revision1, Uri^ path2, long revision2)
+{
+	EnsureConnected();
 
-	return !result;
+	return m_backend->GetModifiedItems(path1, revision1, path2, revision2);
 }
 
 List<ObjectModel::Item^>^
 SubversionClient::GetItems(Uri^ path, long revision, Depth depth)
 {
-	if(!IsConnected)
+	EnsureConnected();
+
+	List<Item^>^ items;
+	if(nullptr != m_tree && m_tree->TryGetItems(path, revision, depth, items))
 	{
-		throw gcnew MigrationException("Subversion Client: There is currently no active connection");
+		return items;
 	}
 
-	List<Item^>^ items;
+	if(nullptr == m_listingCache)
+	{
+		m_listingCache = gcnew ListingCache(m_repositoryRoot, m_listingCacheCapacity);
+	}
 
-	ListCommand^ command = gcnew ListCommand(this, path, revision, depth);
-	command->Execute(items);
+	if(m_listingCache->TryGetItems(path, revision, depth, DirentFields::All, items))
+	{
+		return items;
+	}
 
+	items = m_backend->GetItems(path, revision, depth);
+	m_listingCache->Add(path, revision, depth, DirentFields::All, items);
+
+	//The cache keeps its own copy of the list. The caller is free to modify the result
 	return items;
 }
+
+IEnumerable<Item^>^
+SubversionClient::EnumerateItems(Uri^ path, long revision, Depth depth, DirentFields fields)
+{
+	EnsureConnected();
+
+	//A local listing already contains all fields
+	List<Item^>^ items;
+	if(nullptr != m_tree && m_tree->TryGetItems(path, revision, depth, items))
+	{
+		return items;
+	}
+
+	if(nullptr == m_listingCache)
+	{
+		m_listingCache = gcnew ListingCache(m_repositoryRoot, m_listingCacheCapacity);
+	}
+
+	if(m_listingCache->TryGetItems(path, revision, depth, fields, items))
+	{
+		return items;
+	}
+
+	//The expansion of several branches of the same source lists the same tree again. Therefore completed listings are cached as well
+	IEnumerable<Item^>^ result = m_backend->EnumerateItems(path, revision, depth, fields);
+
+	items = dynamic_cast<List<Item^>^>(result);
+	if(nullptr != items)
+	{
+		m_listingCache->Add(path, revision, depth, fields, items);
+		return items;
+	}
+
+	return m_listingCache->Record(path, revision, depth, fields, result);
+}
+
+List<LocationSegment^>^
+SubversionClient::GetLocationSegments(Uri^ path, long pegRevision, long startRevision, long endRevision)
+{
+	EnsureConnected();
+
+	return m_backend->GetLocationSegments(path, pegRevision, startRevision, endRevision);
+}
+
+long
+SubversionClient::GetLastChangedRevision(Uri^ path, long revision)
+{
+	EnsureConnected();
+
+	if(nullptr == m_lastChangedRevisionResolver)
+	{
+		m_lastChangedRevisionResolver = gcnew LastChangedRevisionResolver(m_backend);
+	}
+
+	return m_lastChangedRevisionResolver->Resolve(path, revision);
+}
+
+CopyGraph^
+SubversionClient::CreateCopyGraph(String^ directory)
+{
+	EnsureConnected();
+
+	return gcnew CopyGraph(m_repositoryRoot, m_repositoryID, directory);
+}
+
+VersionedTree^
+SubversionClient::CreateVersionedTree(Uri^ scope, long revision, PathFilter^ filter)
+{
+	EnsureConnected();
+
+	return gcnew VersionedTree(this, scope, revision, filter);
+}
+
+RepositoryWatcher^
+SubversionClient::CreateWatcher(NetworkCredential^ credential, String^ pipeName)
+{
+	EnsureConnected();
+
+	return gcnew RepositoryWatcher(m_repositoryRoot, credential, pipeName);
+}
+
+long
+SubversionClient::Commit(IEnumerable<CommitItem^>^ items, String^ message)
+{
+	EnsureConnected();
+
+	return m_backend->Commit(m_repositoryRoot, items, message);
+}
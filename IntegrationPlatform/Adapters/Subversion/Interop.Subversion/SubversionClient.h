@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Depth.h"
+#include "DirentFields.h"
 
 using namespace System;
 using namespace System::Collections::Generic;
@@ -17,41 +18,71 @@ namespace Microsoft
 				{
 					namespace Subversion
 					{
+						namespace Backends
+						{
+							interface class IRepositoryBackend;
+						}
+
 						namespace Helpers
 						{
-							ref class SubversionContext;
-						};
+							ref class LastChangedRevisionResolver;
+							ref class ListingCache;
+						}
 
 						namespace ObjectModel
 						{
 							ref class Item;
 							ref class ItemInfo;
 							ref class ChangeSet;
+							ref class CommitItem;
+							ref class ContentDigest;
+							ref class CopyGraph;
+							ref class LocationSegment;
+							ref class PathFilter;
+							ref class RepositoryWatcher;
+							ref class RevisionFilter;
+							ref class VersionedTree;
 						}
 
 						public ref class SubversionClient
 						{
 						private:
 							static int s_references = 0;
+							static const long long DefaultListingCacheCapacity = 64 * 1024 * 1024;
+							static const int DefaultChangeSpillThreshold = 100000;
+							static bool s_libraryVersionDetected = false;
+							static bool s_reportsModifications = false;
 							
-							Helpers::SubversionContext^ m_context;
+							Backends::IRepositoryBackend^ m_backend;
+							bool m_connected;
+							Helpers::LastChangedRevisionResolver^ m_lastChangedRevisionResolver;
+							Helpers::ListingCache^ m_listingCache;
+							long long m_listingCacheCapacity;
+							int m_changeSpillThreshold;
+							ObjectModel::VersionedTree^ m_tree;
 							
 							Uri^ m_virtualRepositoryRoot;
 							Uri^ m_repositoryRoot;
 							Guid m_repositoryID;
+
+							void EnsureConnected();
 							
-						internal:
+						public:
+							/// <summary>
+							/// Default Constructor. All requests are executed against the subversion server
+							/// </summary>
+							SubversionClient();
 
 							/// <summary>
-							/// Gets the context associated with this client session object
+							/// Creates a client that executes all requests through the specified backend
 							/// </summary>
-							property Helpers::SubversionContext^ Context { Helpers::SubversionContext^ get(); } 
+							/// <param name="backend">The backend that serves the repository requests</param>
+							SubversionClient(Backends::IRepositoryBackend^ backend);
 
-						public:
 							/// <summary>
-							/// Default Constructor
+							/// Gets the backend that serves the repository requests of this client
 							/// </summary>
-							SubversionClient();
+							property Backends::IRepositoryBackend^ Backend { Backends::IRepositoryBackend^ get(); }
 							
 							/// <summary>
 							/// Default destructor
@@ -75,6 +106,12 @@ namespace Microsoft
 							/// </summary>
 							property bool IsConnected { bool get(); }
 
+							/// <summary>
+							/// Gets whether the installed subversion libraries report separately if the text and the properties of a changed path have been modified.
+							/// This is the case since subversion 1.7. The version is detected once when the library is loaded
+							/// </summary>
+							static property bool ReportsModifications { bool get(); }
+
 							/// <summary>
 							/// Gets the latest revision number in the subversion repository
 							/// </summary>
@@ -97,6 +134,22 @@ namespace Microsoft
 							/// </summary>
 							property Uri^ VirtualRepositoryRoot{ Uri^ get(); }
 
+							/// <summary>
+							/// Gets or sets the estimated number of bytes that may be used to cache the results of <see cref="GetItems"/>. 0 disables the cache
+							/// </summary>
+							property long long ListingCacheCapacity { long long get(); void set(long long value); }
+
+							/// <summary>
+							/// Gets or sets the number of changed paths of a single revision that are kept in memory. The paths above this count are written
+							/// to a temporary file until the changeset is released. 0 keeps all changed paths in memory
+							/// </summary>
+							property int ChangeSpillThreshold { int get(); void set(int value); }
+
+							/// <summary>
+							/// Gets or sets the local tree that answers the listings of known revisions before the cache and the server are asked; null if there is none
+							/// </summary>
+							property ObjectModel::VersionedTree^ Tree { ObjectModel::VersionedTree^ get(); void set(ObjectModel::VersionedTree^ value); }
+
 							/// <summary>
 							/// Queries the history log for a specific item in the subversion repository
 							/// </summary>
@@ -106,6 +159,35 @@ namespace Microsoft
 							/// <param name="limit">Determines whether we also want to retrieve the changed paths</param>
 							Dictionary<long, ObjectModel::ChangeSet^>^ QueryHistoryRange(Uri^ path, long startRevisionNumber, long endRevisionNumber, bool includeChanges);
 
+							/// <summary>
+							/// Queries the history log for a specific item in the subversion repository and only materializes the changes that pass the filter
+							/// </summary>
+							/// <param name="path">The path for which we want to receive the history log</param>
+							/// <param name="startRevisionNumber">The start revision number for which we want to query the history log</param>
+							/// <param name="endRevisionNumber">The end revision number for which we want to query the history log</param>
+							/// <param name="includeChanges">Determines whether we also want to retrieve the changed paths</param>
+							/// <param name="pathFilter">The filter that decides which changed paths are materialized; null to materialize all changes</param>
+							Dictionary<long, ObjectModel::ChangeSet^>^ QueryHistoryRange(Uri^ path, long startRevisionNumber, long endRevisionNumber, bool includeChanges, ObjectModel::PathFilter^ pathFilter);
+
+							/// <summary>
+							/// Queries the history log for a specific item in the subversion repository and only materializes the revisions and changes that pass the filters.
+							/// The number of rejected revisions is accumulated in <see cref="ObjectModel::RevisionFilter::SkippedRevisions"/>
+							/// </summary>
+							/// <param name="path">The path for which we want to receive the history log</param>
+							/// <param name="startRevisionNumber">The start revision number for which we want to query the history log</param>
+							/// <param name="endRevisionNumber">The end revision number for which we want to query the history log</param>
+							/// <param name="includeChanges">Determines whether we also want to retrieve the changed paths</param>
+							/// <param name="pathFilter">The filter that decides which changed paths are materialized; null to materialize all changes</param>
+							/// <param name="revisionFilter">The filter that decides which revisions are materialized; null to materialize all revisions</param>
+							Dictionary<long, ObjectModel::ChangeSet^>^ QueryHistoryRange(Uri^ path, long startRevisionNumber, long endRevisionNumber, bool includeChanges, ObjectModel::PathFilter^ pathFilter, ObjectModel::RevisionFilter^ revisionFilter);
+
+							/// <summary>
+							/// Compiles the mapped and cloaked paths into a filter that can be passed to the history queries
+							/// </summary>
+							/// <param name="mappedPaths">The fully qualified paths that are mapped</param>
+							/// <param name="cloakedPaths">The fully qualified paths that are cloaked</param>
+							ObjectModel::PathFilter^ CreatePathFilter(IEnumerable<Uri^>^ mappedPaths, IEnumerable<Uri^>^ cloakedPaths);
+
 							/// <summary>
 							/// Queries the history log for a specific item in the subversion repository
 							/// </summary>
@@ -145,6 +227,17 @@ namespace Microsoft
 							/// <param name="toPath">The full local path where the downloaded item shall be stored</param>
 							void DownloadItem(Uri^ fromPath, long revision, String^ toPath);
 
+							/// <summary>
+							/// Downloads an item at a specific revision and computes its MD5 and SHA-1 hashes while the content is written.
+							/// Content that is stored as is in the repository is verified against the checksum of the repository during the transfer
+							/// </summary>
+							/// <param name="fromPath">The full item path in the subversion repository</param>
+							/// <param name="revision">The revision of the item that has to be downloaded</param>
+							/// <param name="toPath">The full local path where the downloaded item shall be stored</param>
+							/// <returns>The hashes of the downloaded file</returns>
+							/// <exception cref="MigrationException">Will be thrown if the content does not match the checksum of the repository</exception>
+							ObjectModel::ContentDigest^ DownloadVerifiedItem(Uri^ fromPath, long revision, String^ toPath);
+
 							/// <summary>
 							/// Compares two subversion item at specific revisions for content change
 							/// </summary>
@@ -155,6 +248,28 @@ namespace Microsoft
 							/// <returns>True if the items do not have any content change; false otherwise</returns>
 							bool HasContentChange(System::Uri^ path1, long revision1, System::Uri^ path2, long revision2);
 
+							/// <summary>
+							/// Writes the content of a folder at a specific revision to a local directory. All directories and files are transferred
+							/// by a single update report instead of one request per file
+							/// </summary>
+							/// <param name="root">The full path of the folder in the subversion repository</param>
+							/// <param name="revision">The revision of the folder</param>
+							/// <param name="localRoot">The local directory that receives the content of <paramref name="root"/></param>
+							/// <param name="filter">The filter that decides which items are written; null to write all items</param>
+							/// <returns>The directories and files that have been written</returns>
+							/// <exception cref="MigrationException">Will be thrown if a file could not be written or does not match the checksum of the repository</exception>
+							List<ObjectModel::Item^>^ ExportTree(Uri^ root, long revision, String^ localRoot, ObjectModel::PathFilter^ filter);
+
+							/// <summary>
+							/// Compares two folders recursively in a single pass and collects every item with a content change
+							/// </summary>
+							/// <param name="path1">The reference folder used for the comparison</param>
+							/// <param name="revision1">The revision of the reference folder</param>
+							/// <param name="path2">The folder that is compared to the reference folder</param>
+							/// <param name="revision2">The revision of the second folder</param>
+							/// <returns>The full server paths below of <paramref name="path2"/> of all items that have been added, modified or deleted</returns>
+							List<System::String^>^ GetModifiedItems(System::Uri^ path1, long revision1, System::Uri^ path2, long revision2);
+
 							/// <summary>
 							/// Lists the items below of specific path
 							/// </summary>
@@ -163,6 +278,68 @@ namespace Microsoft
 							/// <param name="depth">The recursion type used to retrieve the items</param>
 							/// <returns>A list with all retrieved items</returns>
 							List<ObjectModel::Item^>^ SubversionClient::GetItems(System::Uri^ path, long revision, ObjectModel::Depth depth);
+
+							/// <summary>
+							/// Lists the items below of specific path. The items are streamed while the listing is still in progress and the server
+							/// only computes the requested fields. Stopping the enumeration early cancels the listing. A listing that has been enumerated
+							/// completely is added to the listing cache, so expanding several copies of the same source lists the tree only once
+							/// </summary>
+							/// <param name="path">The path for which the items shall be listed</param>
+							/// <param name="revision">The revision for which the items shall be listed</param>
+							/// <param name="depth">The recursion type used to retrieve the items</param>
+							/// <param name="fields">The fields that have to be retrieved for every item. The kind and the path are always retrieved</param>
+							/// <returns>A sequence that can be enumerated once</returns>
+							IEnumerable<ObjectModel::Item^>^ EnumerateItems(System::Uri^ path, long revision, ObjectModel::Depth depth, ObjectModel::DirentFields fields);
+
+							/// <summary>
+							/// Queries the locations at which an item lived within a revision range
+							/// </summary>
+							/// <param name="path">The path of the item</param>
+							/// <param name="pegRevision">The revision in which the item is identified by the path; -1 for the head revision</param>
+							/// <param name="startRevision">The youngest revision of interest; -1 for the peg revision</param>
+							/// <param name="endRevision">The oldest revision of interest; -1 for the first revision of the item</param>
+							/// <returns>The segments ordered from the youngest to the oldest one</returns>
+							List<ObjectModel::LocationSegment^>^ GetLocationSegments(System::Uri^ path, long pegRevision, long startRevision, long endRevision);
+
+							/// <summary>
+							/// Gets the last revision in which an item has been changed. The results are cached per location segment of the item
+							/// for the lifetime of the connection. Repeated requests for the same item are resolved without a round trip to the server
+							/// </summary>
+							/// <param name="path">The path of the item</param>
+							/// <param name="revision">The revision in which the item is identified by the path</param>
+							/// <returns>The youngest revision that is older or equal to the revision in which the item has been changed; -1 if the item does not exist</returns>
+							long GetLastChangedRevision(System::Uri^ path, long revision);
+
+							/// <summary>
+							/// Creates the copy graph of the repository. The graph is persisted per repository id. 
+							/// An already persisted graph of this repository is loaded so that it only has to be extended by the new changesets
+							/// </summary>
+							/// <param name="directory">The directory in which the graph is persisted; null to keep the graph in memory only</param>
+							ObjectModel::CopyGraph^ CreateCopyGraph(String^ directory);
+
+							/// <summary>
+							/// Creates a local tree of a path that is seeded by one recursive listing. The tree has to be extended by every subsequent changeset
+							/// </summary>
+							/// <param name="scope">The root of the tree</param>
+							/// <param name="revision">The revision of the initial listing</param>
+							/// <param name="filter">The filter that defines the paths whose changes are added to the tree; null if all changes are added</param>
+							ObjectModel::VersionedTree^ CreateVersionedTree(Uri^ scope, long revision, ObjectModel::PathFilter^ filter);
+
+							/// <summary>
+							/// Creates a watcher that detects the new revisions of the repository. The watcher uses a session of its own and bypasses the backend
+							/// </summary>
+							/// <param name="credential">The credentials that shall be used to authenticate the user on the repository</param>
+							/// <param name="pipeName">The name of the local pipe on which a post-commit hook announces new revisions; null to poll only</param>
+							ObjectModel::RepositoryWatcher^ CreateWatcher(System::Net::NetworkCredential^ credential, String^ pipeName);
+
+							/// <summary>
+							/// Commits the items as a single revision. The content of the files is prepared while the preceding items are sent
+							/// </summary>
+							/// <param name="items">The changes of the revision. The paths are relative to the root of the repository</param>
+							/// <param name="message">The log message of the revision</param>
+							/// <returns>The number of the new revision</returns>
+							/// <exception cref="MigrationException">Will be thrown if the commit has been rejected or the content of an item is not available</exception>
+							long Commit(IEnumerable<ObjectModel::CommitItem^>^ items, String^ message);
 						};
 					}
 				}
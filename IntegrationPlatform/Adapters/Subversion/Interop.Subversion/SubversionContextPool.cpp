@@ -0,0 +1,226 @@
+#include "Stdafx.h"
+#include "ConcurrencyController.h"
+#include "SubversionContext.h"
+#include "SubversionContextPool.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Diagnostics;
+using namespace System::Net;
+using namespace System::Threading;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+
+SubversionContextPool::SubversionContextPool(NetworkCredential^ credential, int capacity)
+{
+	if(capacity <= 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("capacity");
+	}
+
+	m_credential = credential;
+	m_capacity = capacity;
+	m_idle = gcnew Stack<SubversionContext^>();
+	m_contexts = gcnew List<SubversionContext^>();
+	m_started = gcnew Dictionary<SubversionContext^, long long>();
+	m_controller = gcnew ConcurrencyController(capacity, 0);
+	m_disposed = false;
+}
+
+SubversionContextPool::SubversionContextPool(NetworkCredential^ credential, int capacity, long long bandwidth)
+{
+	if(capacity <= 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("capacity");
+	}
+
+	if(bandwidth < 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("bandwidth");
+	}
+
+	m_credential = credential;
+	m_capacity = capacity;
+	m_idle = gcnew Stack<SubversionContext^>();
+	m_contexts = gcnew List<SubversionContext^>();
+	m_started = gcnew Dictionary<SubversionContext^, long long>();
+	m_controller = gcnew ConcurrencyController(capacity, bandwidth);
+	m_disposed = false;
+}
+
+SubversionContextPool::~SubversionContextPool()
+{
+	Monitor::Enter(this);
+	try
+	{
+		//The contexts that are in use belong to other threads. They are released by Return
+		while(m_idle->Count > 0)
+		{
+			SubversionContext^ context = m_idle->Pop();
+			m_contexts->Remove(context);
+			delete context;
+		}
+
+		m_disposed = true;
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+int
+SubversionContextPool::Capacity::get()
+{
+	return m_capacity;
+}
+
+int
+SubversionContextPool::Limit::get()
+{
+	Monitor::Enter(this);
+	try
+	{
+		return m_controller->Limit;
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+SubversionContext^
+SubversionContextPool::Acquire()
+{
+	return Take(true);
+}
+
+SubversionContext^
+SubversionContextPool::AcquireUnmetered()
+{
+	return Take(false);
+}
+
+SubversionContext^
+SubversionContextPool::Take(bool metered)
+{
+	Monitor::Enter(this);
+	try
+	{
+		//A disposed pool still serves the threads that hold it. Their contexts are released when they are returned
+		while(true)
+		{
+			int delay = metered ? m_controller->GetDelay() : 0;
+			bool admitted = !metered || m_controller->CanEnter();
+
+			if(admitted && 0 == delay)
+			{
+				SubversionContext^ context = nullptr;
+				if(m_idle->Count > 0)
+				{
+					context = m_idle->Pop();
+				}
+				else if(m_contexts->Count < m_capacity)
+				{
+					context = gcnew SubversionContext(m_credential);
+					m_contexts->Add(context);
+				}
+
+				if(nullptr != context)
+				{
+					//Only the metered requests are counted by the controller
+					if(metered)
+					{
+						m_controller->Enter();
+						m_started[context] = Stopwatch::GetTimestamp();
+					}
+
+					return context;
+				}
+			}
+
+			if(delay > 0)
+			{
+				Monitor::Wait(this, delay);
+			}
+			else
+			{
+				Monitor::Wait(this);
+			}
+		}
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+void
+SubversionContextPool::Release(SubversionContext^ context)
+{
+	if(nullptr == context)
+	{
+		throw gcnew ArgumentNullException("context");
+	}
+
+	Monitor::Enter(this);
+	try
+	{
+		if(m_started->Remove(context))
+		{
+			m_controller->Leave();
+		}
+
+		Return(context);
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+void
+SubversionContextPool::Release(SubversionContext^ context, RequestKind kind, bool succeeded, long long bytes)
+{
+	if(nullptr == context)
+	{
+		throw gcnew ArgumentNullException("context");
+	}
+
+	Monitor::Enter(this);
+	try
+	{
+		long long started;
+		if(m_started->TryGetValue(context, started))
+		{
+			long long elapsed = Stopwatch::GetTimestamp() - started;
+			m_controller->Record(kind, TimeSpan::FromTicks((long long)((double)elapsed * TimeSpan::TicksPerSecond / Stopwatch::Frequency)), succeeded, bytes);
+			m_started->Remove(context);
+			m_controller->Leave();
+		}
+
+		Return(context);
+	}
+	finally
+	{
+		Monitor::Exit(this);
+	}
+}
+
+void
+SubversionContextPool::Return(SubversionContext^ context)
+{
+	//A disposed pool does not keep any connections open. The context is released as soon as its request is done
+	if(m_disposed)
+	{
+		m_contexts->Remove(context);
+		delete context;
+	}
+	else
+	{
+		m_idle->Push(context);
+	}
+
+	//The waiting threads may wait for the limit or for a context. Only one of them would be woken up otherwise
+	Monitor::PulseAll(this);
+}
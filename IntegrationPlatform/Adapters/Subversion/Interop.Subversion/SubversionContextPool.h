@@ -0,0 +1,114 @@
+#pragma once
+
+#include "ConcurrencyController.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Net;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							ref class SubversionContext;
+
+							/// <summary>
+							/// A bounded pool of subversion contexts. A context and its RA sessions must not be used by more than one thread at a time.
+							/// Therefore every thread that executes requests in parallel has to acquire a context of its own.
+							/// <para/>
+							/// The number of contexts that are in use at the same time is adjusted to the load of the server by a <see cref="ConcurrencyController"/>.
+							/// The capacity is the hard cap of the controller. A context whose request is held open by its consumer is bounded by the capacity
+							/// only. Otherwise a consumer that acquires further contexts while it holds a stream could dead lock itself on a low limit.
+							/// <para/>
+							/// A pool that is replaced or closed by its owner is disposed while other threads may still use it. Disposing releases the idle
+							/// contexts only. The threads that still hold the pool are served until they are done and every context is released as soon
+							/// as it is returned
+							/// </summary>
+							private ref class SubversionContextPool
+							{
+							private:
+								NetworkCredential^ m_credential;
+								Stack<SubversionContext^>^ m_idle;
+								List<SubversionContext^>^ m_contexts;
+								Dictionary<SubversionContext^, long long>^ m_started;
+								ConcurrencyController^ m_controller;
+								int m_capacity;
+								bool m_disposed;
+
+								SubversionContext^ Take(bool metered);
+								void Return(SubversionContext^ context);
+
+							public:
+								/// <summary>
+								/// Creates a new pool. The contexts are created on demand
+								/// </summary>
+								/// <param name="credential">The credentials that shall be used to authenticate the user on the repository</param>
+								/// <param name="capacity">The maximum number of contexts that will be created</param>
+								SubversionContextPool(NetworkCredential^ credential, int capacity);
+
+								/// <summary>
+								/// Creates a new pool that keeps a bandwidth ceiling. The contexts are created on demand
+								/// </summary>
+								/// <param name="credential">The credentials that shall be used to authenticate the user on the repository</param>
+								/// <param name="capacity">The maximum number of contexts that will be created</param>
+								/// <param name="bandwidth">The maximum number of bytes per second; 0 if the bandwidth is unlimited</param>
+								SubversionContextPool(NetworkCredential^ credential, int capacity, long long bandwidth);
+
+								/// <summary>
+								/// Default destructor. Releases the idle contexts. The contexts that are in use are released when they are returned
+								/// </summary>
+								~SubversionContextPool();
+
+								/// <summary>
+								/// Gets the maximum number of contexts that will be created
+								/// </summary>
+								property int Capacity { int get(); }
+
+								/// <summary>
+								/// Gets the number of contexts that may currently be in use with respect to the load of the server
+								/// </summary>
+								property int Limit { int get(); }
+
+								/// <summary>
+								/// Takes a context from the pool. Blocks until the number of requests in flight is below the limit, a context is
+								/// available and the bandwidth ceiling is kept
+								/// </summary>
+								SubversionContext^ Acquire();
+
+								/// <summary>
+								/// Takes a context for a request whose duration depends on its consumer. The request is not counted against the limit.
+								/// Blocks until a context is available
+								/// </summary>
+								SubversionContext^ AcquireUnmetered();
+
+								/// <summary>
+								/// Returns a context that has been acquired earlier without reporting the outcome of its request
+								/// </summary>
+								void Release(SubversionContext^ context);
+
+								/// <summary>
+								/// Returns a context that has been acquired earlier and reports the outcome of its request to the concurrency controller
+								/// </summary>
+								/// <param name="context">The context that has been acquired</param>
+								/// <param name="kind">The kind of the request whose latencies the request is compared with</param>
+								/// <param name="succeeded">false if the request failed</param>
+								/// <param name="bytes">The number of bytes that have been transferred; 0 if unknown</param>
+								void Release(SubversionContext^ context, RequestKind kind, bool succeeded, long long bytes);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,307 @@
+#include "Stdafx.h"
+#include "SvnDiffDecoder.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::IO::Compression;
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+
+SvnDiffDecoder::SvnDiffDecoder(Stream^ delta, long long length)
+{
+	if(nullptr == delta)
+	{
+		throw gcnew ArgumentNullException("delta");
+	}
+
+	if(length < 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("length");
+	}
+
+	m_delta = delta;
+	m_remaining = length;
+}
+
+int
+SvnDiffDecoder::ReadByte()
+{
+	int value = m_remaining > 0 ? m_delta->ReadByte() : -1;
+	if(value < 0)
+	{
+		throw gcnew MigrationException("The svndiff data ends unexpectedly");
+	}
+
+	m_remaining--;
+	return value;
+}
+
+void
+SvnDiffDecoder::ReadBytes(array<Byte>^ buffer, int count)
+{
+	if(count > m_remaining)
+	{
+		throw gcnew MigrationException("The svndiff data ends unexpectedly");
+	}
+
+	int offset = 0;
+	while(offset < count)
+	{
+		int read = m_delta->Read(buffer, offset, count - offset);
+		if(read <= 0)
+		{
+			throw gcnew MigrationException("The svndiff data ends unexpectedly");
+		}
+
+		offset += read;
+	}
+
+	m_remaining -= count;
+}
+
+long long
+SvnDiffDecoder::ReadNumber()
+{
+	//Numbers are stored big endian in groups of seven bits. The high bit is set on all bytes but the last one
+	long long value = 0;
+	for(int i = 0; i < MaximumNumberBytes; i++)
+	{
+		int current = ReadByte();
+		value = (value << 7) | (current & 0x7f);
+		if(0 == (current & 0x80))
+		{
+			return value;
+		}
+	}
+
+	throw gcnew MigrationException("The svndiff data contains an invalid number");
+}
+
+long long
+SvnDiffDecoder::ParseNumber(array<Byte>^ data, int% position)
+{
+	long long value = 0;
+	for(int i = 0; i < MaximumNumberBytes && position < data->Length; i++)
+	{
+		int current = data[position++];
+		value = (value << 7) | (current & 0x7f);
+		if(0 == (current & 0x80))
+		{
+			return value;
+		}
+	}
+
+	throw gcnew MigrationException("The svndiff data contains an invalid number");
+}
+
+int
+SvnDiffDecoder::ToLength(long long value)
+{
+	if(value < 0 || value > Int32::MaxValue)
+	{
+		throw gcnew MigrationException("The svndiff data contains an invalid length");
+	}
+
+	return (int)value;
+}
+
+array<Byte>^
+SvnDiffDecoder::ReadSection(int length, int version)
+{
+	array<Byte>^ section = gcnew array<Byte>(length);
+	ReadBytes(section, length);
+
+	if(0 == version)
+	{
+		return section;
+	}
+
+	//The section starts with its original length. It is only compressed if compression actually saved space
+	int position = 0;
+	int originalLength = ToLength(ParseNumber(section, position));
+	array<Byte>^ original = gcnew array<Byte>(originalLength);
+
+	if(length - position == originalLength)
+	{
+		Array::Copy(section, position, original, 0, originalLength);
+		return original;
+	}
+
+	//The data is a zlib stream. Its two byte header is skipped because the deflate stream reads the raw data only
+	if(length - position < 2)
+	{
+		throw gcnew MigrationException("The svndiff data contains an invalid compressed section");
+	}
+
+	DeflateStream^ inflater = gcnew DeflateStream(gcnew MemoryStream(section, position + 2, length - position - 2, false), CompressionMode::Decompress);
+	try
+	{
+		int offset = 0;
+		while(offset < originalLength)
+		{
+			int read = inflater->Read(original, offset, originalLength - offset);
+			if(read <= 0)
+			{
+				throw gcnew MigrationException("The svndiff data contains an invalid compressed section");
+			}
+
+			offset += read;
+		}
+	}
+	finally
+	{
+		delete inflater;
+	}
+
+	return original;
+}
+
+long long
+SvnDiffDecoder::Apply(Stream^ source, long long sourceOffset, long long sourceLength, Stream^ target)
+{
+	if(nullptr == target)
+	{
+		throw gcnew ArgumentNullException("target");
+	}
+
+	if(nullptr == source)
+	{
+		sourceLength = 0;
+	}
+
+	array<Byte>^ header = gcnew array<Byte>(4);
+	ReadBytes(header, header->Length);
+	if('S' != header[0] || 'V' != header[1] || 'N' != header[2])
+	{
+		throw gcnew MigrationException("The delta is not stored in the svndiff format");
+	}
+
+	int version = header[3];
+	if(version > 1)
+	{
+		throw gcnew MigrationException(String::Format("The svndiff version {0} is not supported. Create the dump with the deltas in version 0 or 1", version));
+	}
+
+	long long written = 0;
+	array<Byte>^ view = gcnew array<Byte>(0);
+	array<Byte>^ window = gcnew array<Byte>(0);
+
+	while(m_remaining > 0)
+	{
+		long long viewOffset = ReadNumber();
+		int viewLength = ToLength(ReadNumber());
+		int windowLength = ToLength(ReadNumber());
+		int instructionsLength = ToLength(ReadNumber());
+		int dataLength = ToLength(ReadNumber());
+
+		array<Byte>^ instructions = ReadSection(instructionsLength, version);
+		array<Byte>^ data = ReadSection(dataLength, version);
+
+		if(viewOffset + viewLength > sourceLength)
+		{
+			throw gcnew MigrationException("The svndiff data refers to a range outside of the source text");
+		}
+
+		//The windows of a delta are small. The buffers are reused for all windows
+		if(view->Length < viewLength)
+		{
+			view = gcnew array<Byte>(viewLength);
+		}
+
+		if(window->Length < windowLength)
+		{
+			window = gcnew array<Byte>(windowLength);
+		}
+
+		if(viewLength > 0)
+		{
+			source->Seek(sourceOffset + viewOffset, SeekOrigin::Begin);
+			int offset = 0;
+			while(offset < viewLength)
+			{
+				int read = source->Read(view, offset, viewLength - offset);
+				if(read <= 0)
+				{
+					throw gcnew MigrationException("The source text of the svndiff data ends unexpectedly");
+				}
+
+				offset += read;
+			}
+		}
+
+		int position = 0;
+		int dataPosition = 0;
+		int instruction = 0;
+		while(instruction < instructions->Length)
+		{
+			//The two high bits select the operation. The low bits hold the length unless it does not fit
+			int selector = instructions[instruction] >> 6;
+			long long length = instructions[instruction] & 0x3f;
+			instruction++;
+
+			if(0 == length)
+			{
+				length = ParseNumber(instructions, instruction);
+			}
+
+			long long offset = 0;
+			if(selector < 2)
+			{
+				offset = ParseNumber(instructions, instruction);
+			}
+
+			if(length > windowLength - position)
+			{
+				throw gcnew MigrationException("The svndiff data exceeds the length of the target window");
+			}
+
+			switch(selector)
+			{
+			case 0:
+				if(offset + length > viewLength)
+				{
+					throw gcnew MigrationException("The svndiff data refers to a range outside of the source view");
+				}
+
+				Array::Copy(view, (int)offset, window, position, (int)length);
+				break;
+			case 1:
+				if(offset >= position)
+				{
+					throw gcnew MigrationException("The svndiff data refers to a range outside of the target window");
+				}
+
+				//The ranges may overlap. A byte by byte copy repeats the pattern as subversion does
+				for(int i = 0; i < length; i++)
+				{
+					window[position + i] = window[(int)offset + i];
+				}
+				break;
+			case 2:
+				if(length > data->Length - dataPosition)
+				{
+					throw gcnew MigrationException("The svndiff data refers to a range outside of the new data");
+				}
+
+				Array::Copy(data, dataPosition, window, position, (int)length);
+				dataPosition += (int)length;
+				break;
+			default:
+				throw gcnew MigrationException("The svndiff data contains an invalid instruction");
+			}
+
+			position += (int)length;
+		}
+
+		if(position != windowLength)
+		{
+			throw gcnew MigrationException("The svndiff data does not fill the target window");
+		}
+
+		target->Write(window, 0, windowLength);
+		written += windowLength;
+	}
+
+	return written;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+using namespace System;
+using namespace System::IO;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							/// <summary>
+							/// Applies a delta in the svndiff format to a source text. Every window of the delta copies ranges of a view of the source,
+							/// ranges of the target window that has been built so far and new data. Version 0 stores the instructions and the new
+							/// data as they are. Version 1 compresses them with zlib. Version 2 (LZ4) is not supported
+							/// </summary>
+							private ref class SvnDiffDecoder
+							{
+							private:
+								//A number never takes more than 64 bits. Longer encodings are corrupt
+								static const int MaximumNumberBytes = 10;
+
+								Stream^ m_delta;
+								long long m_remaining;
+
+								int ReadByte();
+								void ReadBytes(array<Byte>^ buffer, int count);
+								long long ReadNumber();
+								array<Byte>^ ReadSection(int length, int version);
+
+								static long long ParseNumber(array<Byte>^ data, int% position);
+								static int ToLength(long long value);
+
+							public:
+								/// <summary>
+								/// Creates a decoder for a delta that is read from the current position of a stream
+								/// </summary>
+								/// <param name="delta">The stream that contains the delta</param>
+								/// <param name="length">The number of bytes of the delta</param>
+								SvnDiffDecoder(Stream^ delta, long long length);
+
+								/// <summary>
+								/// Reconstructs the target text and writes it to a stream
+								/// </summary>
+								/// <param name="source">The stream that contains the source text; null if the delta has no source</param>
+								/// <param name="sourceOffset">The position of the source text in <paramref name="source"/></param>
+								/// <param name="sourceLength">The number of bytes of the source text</param>
+								/// <param name="target">The stream that receives the target text</param>
+								/// <returns>The number of bytes of the target text</returns>
+								/// <exception cref="MigrationException">Will be thrown if the delta is corrupt or in an unsupported version</exception>
+								long long Apply(Stream^ source, long long sourceOffset, long long sourceLength, Stream^ target);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
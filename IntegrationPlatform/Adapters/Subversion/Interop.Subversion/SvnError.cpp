@@ -35,6 +35,18 @@ SvnError::Err(svn_error_t* svnError)
 {
 	if (NULL != svnError)
 	{
+		//A cancellation is requested by the adapter itself and is not an error. The layers of subversion may wrap it into errors of their own
+		svn_error_t* rootCause = svnError;
+		while(NULL != rootCause->child)
+		{
+			rootCause = rootCause->child;
+		}
+
+		if(SVN_ERR_CANCELLED == rootCause->apr_err)
+		{
+			throw gcnew OperationCanceledException(Utils::ConvertUTF8ToString(rootCause->message));
+		}
+
 		LogSvnError(svnError);
 
 		//Decode the supported error types
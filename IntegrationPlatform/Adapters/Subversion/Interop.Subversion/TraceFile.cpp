@@ -0,0 +1,363 @@
+#include "Stdafx.h"
+#include "Change.h"
+#include "ChangeBatch.h"
+#include "ChangeSet.h"
+#include "Item.h"
+#include "ItemInfo.h"
+#include "LocationSegment.h"
+#include "SubversionClient.h"
+#include "TraceFile.h"
+#include "Utils.h"
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Collections::Generic;
+
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+using namespace Microsoft::TeamFoundation::Migration::Toolkit::Services;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Backends;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+void
+TraceFile::WriteHeader(BinaryWriter^ writer)
+{
+	writer->Write(Signature);
+	writer->Write((Int32)Version);
+}
+
+void
+TraceFile::ReadHeader(BinaryReader^ reader)
+{
+	String^ signature = reader->ReadString();
+	if(!String::Equals(signature, Signature, StringComparison::Ordinal))
+	{
+		throw gcnew MigrationException("The file is not a valid subversion trace file");
+	}
+
+	int version = reader->ReadInt32();
+	if(version != Version)
+	{
+		throw gcnew MigrationException(String::Format("The subversion trace file version {0} is not supported", version));
+	}
+}
+
+String^
+TraceFile::CreateKey(... array<Object^>^ values)
+{
+	array<String^>^ parts = gcnew array<String^>(values->Length);
+	for(int i = 0; i < values->Length; i++)
+	{
+		Uri^ uri = dynamic_cast<Uri^>(values[i]);
+		parts[i] = nullptr != uri ? uri->AbsoluteUri : Convert::ToString(values[i], Globalization::CultureInfo::InvariantCulture);
+	}
+
+	return String::Join("|", parts);
+}
+
+void
+TraceFile::WriteRecord(BinaryWriter^ writer, TraceOperation operation, String^ key, array<Byte>^ payload)
+{
+	writer->Write((Byte)operation);
+	writer->Write(key);
+	writer->Write((Int32)payload->Length);
+	writer->Write(payload);
+}
+
+bool
+TraceFile::ReadRecord(BinaryReader^ reader, [Out] TraceOperation% operation, [Out] String^% key, [Out] array<Byte>^% payload)
+{
+	operation = TraceOperation::EndOfTrace;
+	key = nullptr;
+	payload = nullptr;
+
+	try
+	{
+		operation = (TraceOperation)reader->ReadByte();
+		if(TraceOperation::EndOfTrace == operation)
+		{
+			return false;
+		}
+
+		key = reader->ReadString();
+		payload = reader->ReadBytes(reader->ReadInt32());
+		return true;
+	}
+	catch(EndOfStreamException^)
+	{
+		//The recording process did not close the trace properly. Everything up to the last complete record is still usable
+		TraceManager::TraceWarning("The subversion trace file is truncated. Ignoring the incomplete record");
+		return false;
+	}
+}
+
+void
+TraceFile::WriteString(BinaryWriter^ writer, String^ value)
+{
+	writer->Write(nullptr != value);
+	if(nullptr != value)
+	{
+		writer->Write(value);
+	}
+}
+
+String^
+TraceFile::ReadString(BinaryReader^ reader)
+{
+	if(reader->ReadBoolean())
+	{
+		return reader->ReadString();
+	}
+
+	return nullptr;
+}
+
+void
+TraceFile::WriteModification(BinaryWriter^ writer, Nullable<bool> modification)
+{
+	writer->Write((Byte)(!modification.HasValue ? 0 : (modification.Value ? 2 : 1)));
+}
+
+Nullable<bool>
+TraceFile::ReadModification(BinaryReader^ reader)
+{
+	switch(reader->ReadByte())
+	{
+	case 1:
+		return Nullable<bool>(false);
+	case 2:
+		return Nullable<bool>(true);
+	default:
+		return Nullable<bool>();
+	}
+}
+
+void
+TraceFile::WriteContentType(BinaryWriter^ writer, ContentType^ itemType)
+{
+	if(WellKnownContentType::VersionControlledFolder == itemType)
+	{
+		writer->Write((Byte)svn_node_dir);
+	}
+	else
+	{
+		writer->Write((Byte)svn_node_file);
+	}
+}
+
+ContentType^
+TraceFile::ReadContentType(BinaryReader^ reader)
+{
+	if(svn_node_dir == (svn_node_kind_t)reader->ReadByte())
+	{
+		return WellKnownContentType::VersionControlledFolder;
+	}
+
+	return WellKnownContentType::VersionControlledFile;
+}
+
+void
+TraceFile::WriteChangeSets(BinaryWriter^ writer, Dictionary<long, ChangeSet^>^ changesets)
+{
+	writer->Write((Int32)changesets->Count);
+	for each(ChangeSet^ changeset in changesets->Values)
+	{
+		writer->Write((Int32)changeset->Revision);
+		WriteString(writer, changeset->Author);
+		WriteString(writer, changeset->Comment);
+		writer->Write(changeset->CommitTime.ToBinary());
+
+		writer->Write((Int32)changeset->ChangeCount);
+		for each(ChangeBatch^ batch in changeset->GetChangeBatches())
+		{
+			for(int j = 0; j < batch->Count; j++)
+			{
+				writer->Write(batch->GetFullServerPath(j));
+				writer->Write((Byte)batch->GetChangeAction(j));
+				writer->Write((Byte)batch->GetNodeKind(j));
+				WriteString(writer, batch->GetCopyFromFullServerPath(j));
+				writer->Write((Int32)batch->GetCopyFromRevision(j));
+				WriteModification(writer, batch->GetTextModification(j));
+				WriteModification(writer, batch->GetPropertyModification(j));
+			}
+		}
+	}
+}
+
+Dictionary<long, ChangeSet^>^
+TraceFile::ReadChangeSets(BinaryReader^ reader, SubversionClient^ client)
+{
+	int count = reader->ReadInt32();
+	Dictionary<long, ChangeSet^>^ changesets = gcnew Dictionary<long, ChangeSet^>(count);
+
+	for(int i = 0; i < count; i++)
+	{
+		long revision = reader->ReadInt32();
+		String^ author = ReadString(reader);
+		String^ comment = ReadString(reader);
+		DateTime commitTime = DateTime::FromBinary(reader->ReadInt64());
+		int changeCount = reader->ReadInt32();
+
+		ChangeSet^ changeset = gcnew ChangeSet(client, revision, author, comment, commitTime);
+		if(changeCount >= 0)
+		{
+			ChangeBatchBuilder^ builder = gcnew ChangeBatchBuilder(changeset, changeCount);
+			try
+			{
+				for(int j = 0; j < changeCount; j++)
+				{
+					String^ fullServerPath = reader->ReadString();
+					ObjectModel::ChangeAction changeAction = (ObjectModel::ChangeAction)reader->ReadByte();
+					svn_node_kind_t nodeKind = (svn_node_kind_t)reader->ReadByte();
+					String^ copyFromFullServerPath = ReadString(reader);
+					long copyFromRevision = reader->ReadInt32();
+					Nullable<bool> textModification = ReadModification(reader);
+					Nullable<bool> propertyModification = ReadModification(reader);
+
+					builder->Add(fullServerPath, changeAction, nodeKind, copyFromFullServerPath, copyFromRevision, textModification, propertyModification);
+				}
+
+				changeset->SetChanges(builder->ToBatch());
+			}
+			finally
+			{
+				delete builder;
+			}
+		}
+
+		changesets->Add(revision, changeset);
+	}
+
+	return changesets;
+}
+
+void
+TraceFile::WriteItems(BinaryWriter^ writer, List<Item^>^ items)
+{
+	//The repository of the items is the virtual root of the writing client. An other client may reach the same repository by
+	//a different url. Therefore it is not written and the reader attaches its own root
+	writer->Write((Int32)items->Count);
+	for each(Item^ item in items)
+	{
+		writer->Write(item->FullServerPath);
+		WriteContentType(writer, item->ItemType);
+		writer->Write((Int64)item->Size);
+		writer->Write((Int32)item->CreatedRev);
+		WriteString(writer, item->LastAuthor);
+	}
+}
+
+List<Item^>^
+TraceFile::ReadItems(BinaryReader^ reader, SubversionClient^ client)
+{
+	String^ repository = client->VirtualRepositoryRoot->ToString();
+
+	int count = reader->ReadInt32();
+	List<Item^>^ items = gcnew List<Item^>(count);
+
+	for(int i = 0; i < count; i++)
+	{
+		String^ fullServerPath = reader->ReadString();
+		ContentType^ itemType = ReadContentType(reader);
+		long long size = reader->ReadInt64();
+		long createdRev = reader->ReadInt32();
+		String^ lastAuthor = ReadString(reader);
+
+		items->Add(gcnew Item(fullServerPath, itemType, size, createdRev, lastAuthor, repository));
+	}
+
+	return items;
+}
+
+void
+TraceFile::WriteItemInfos(BinaryWriter^ writer, List<ItemInfo^>^ infos)
+{
+	writer->Write((Int32)infos->Count);
+	for each(ItemInfo^ info in infos)
+	{
+		writer->Write(info->Uri->AbsoluteUri);
+		WriteString(writer, nullptr == info->RepositoryRootUrl ? nullptr : info->RepositoryRootUrl->AbsoluteUri);
+		writer->Write((Int32)info->Revision);
+		WriteContentType(writer, info->ItemType);
+	}
+}
+
+List<ItemInfo^>^
+TraceFile::ReadItemInfos(BinaryReader^ reader)
+{
+	int count = reader->ReadInt32();
+	List<ItemInfo^>^ infos = gcnew List<ItemInfo^>(count);
+
+	for(int i = 0; i < count; i++)
+	{
+		Uri^ uri = gcnew Uri(reader->ReadString());
+		String^ repositoryRoot = ReadString(reader);
+		long revision = reader->ReadInt32();
+		ContentType^ itemType = ReadContentType(reader);
+
+		infos->Add(gcnew ItemInfo(uri, nullptr == repositoryRoot ? nullptr : gcnew Uri(repositoryRoot), revision, itemType));
+	}
+
+	return infos;
+}
+
+void
+TraceFile::WritePaths(BinaryWriter^ writer, List<String^>^ paths)
+{
+	writer->Write((Int32)paths->Count);
+	for each(String^ path in paths)
+	{
+		writer->Write(path);
+	}
+}
+
+List<String^>^
+TraceFile::ReadPaths(BinaryReader^ reader)
+{
+	int count = reader->ReadInt32();
+	List<String^>^ paths = gcnew List<String^>(count);
+
+	for(int i = 0; i < count; i++)
+	{
+		paths->Add(reader->ReadString());
+	}
+
+	return paths;
+}
+
+String^
+TraceFile::GetLocalPath(Uri^ root, String^ localRoot, Item^ item)
+{
+	String^ relative = Utils::ExtractPath(root->ToString(), item->FullServerPath)->Trim(Utils::SeperatorCharArray);
+	return Path::Combine(localRoot, relative->Replace('/', Path::DirectorySeparatorChar));
+}
+
+void
+TraceFile::WriteLocationSegments(BinaryWriter^ writer, List<LocationSegment^>^ segments)
+{
+	writer->Write((Int32)segments->Count);
+	for each(LocationSegment^ segment in segments)
+	{
+		writer->Write((Int32)segment->RangeStart);
+		writer->Write((Int32)segment->RangeEnd);
+		WriteString(writer, segment->FullServerPath);
+	}
+}
+
+List<LocationSegment^>^
+TraceFile::ReadLocationSegments(BinaryReader^ reader)
+{
+	int count = reader->ReadInt32();
+	List<LocationSegment^>^ segments = gcnew List<LocationSegment^>(count);
+
+	for(int i = 0; i < count; i++)
+	{
+		long rangeStart = reader->ReadInt32();
+		long rangeEnd = reader->ReadInt32();
+		String^ fullServerPath = ReadString(reader);
+
+		segments->Add(gcnew LocationSegment(rangeStart, rangeEnd, fullServerPath));
+	}
+
+	return segments;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <svn_types.h>
+
+using namespace System;
+using namespace System::IO;
+using namespace System::Collections::Generic;
+using namespace System::Runtime::InteropServices;
+using namespace Microsoft::TeamFoundation::Migration::Toolkit::Services;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						ref class SubversionClient;
+
+						namespace ObjectModel
+						{
+							ref class Item;
+							ref class ItemInfo;
+							ref class ChangeSet;
+							ref class LocationSegment;
+						}
+
+						namespace Backends
+						{
+							/// <summary>
+							/// The request types that are stored in a trace file
+							/// </summary>
+							private enum class TraceOperation : Byte
+							{
+								/// <summary>
+								/// Marks the end of the trace
+								/// </summary>
+								EndOfTrace = 0,
+								Open = 1,
+								LatestRevisionNumber = 2,
+								QueryHistory = 3,
+								QueryItemInfo = 4,
+								DownloadItem = 5,
+								AreEqual = 6,
+								GetItems = 7,
+								LocationSegments = 8,
+								ModifiedItems = 9,
+								ExportTree = 10
+							};
+
+							/// <summary>
+							/// Encodes and decodes the requests and responses of a trace file.
+							/// <para/>
+							/// A trace file is a gzip compressed stream that starts with a signature and a version number followed by records.
+							/// Every record consists of the operation, the request key and the length prefixed response payload
+							/// </summary>
+							private ref class TraceFile abstract sealed
+							{
+							private:
+								static String^ Signature = "SVNTRACE";
+								static const int Version = 8;
+
+								static void WriteString(BinaryWriter^ writer, String^ value);
+								static String^ ReadString(BinaryReader^ reader);
+
+								static void WriteModification(BinaryWriter^ writer, Nullable<bool> modification);
+								static Nullable<bool> ReadModification(BinaryReader^ reader);
+
+								static void WriteContentType(BinaryWriter^ writer, ContentType^ itemType);
+								static ContentType^ ReadContentType(BinaryReader^ reader);
+
+							public:
+								/// <summary>
+								/// Writes the header of a new trace file
+								/// </summary>
+								static void WriteHeader(BinaryWriter^ writer);
+
+								/// <summary>
+								/// Reads and verifies the header of a trace file
+								/// </summary>
+								/// <exception cref="MigrationException">Will be thrown if the stream is not a supported trace file</exception>
+								static void ReadHeader(BinaryReader^ reader);
+
+								/// <summary>
+								/// Creates the key that identifies a request by its parameters
+								/// </summary>
+								static String^ CreateKey(... array<Object^>^ values);
+
+								/// <summary>
+								/// Appends a record to the trace
+								/// </summary>
+								/// <param name="writer">The writer of the trace file</param>
+								/// <param name="operation">The operation of the request</param>
+								/// <param name="key">The key that identifies the request parameters</param>
+								/// <param name="payload">The encoded response</param>
+								static void WriteRecord(BinaryWriter^ writer, TraceOperation operation, String^ key, array<Byte>^ payload);
+
+								/// <summary>
+								/// Reads the next record of the trace
+								/// </summary>
+								/// <returns>False if the end of the trace has been reached; true otherwise</returns>
+								static bool ReadRecord(BinaryReader^ reader, [Out] TraceOperation% operation, [Out] String^% key, [Out] array<Byte>^% payload);
+
+								static void WriteChangeSets(BinaryWriter^ writer, Dictionary<long, ObjectModel::ChangeSet^>^ changesets);
+								static Dictionary<long, ObjectModel::ChangeSet^>^ ReadChangeSets(BinaryReader^ reader, SubversionClient^ client);
+
+								static void WriteItems(BinaryWriter^ writer, List<ObjectModel::Item^>^ items);
+								static List<ObjectModel::Item^>^ ReadItems(BinaryReader^ reader, SubversionClient^ client);
+
+								static void WriteItemInfos(BinaryWriter^ writer, List<ObjectModel::ItemInfo^>^ infos);
+								static List<ObjectModel::ItemInfo^>^ ReadItemInfos(BinaryReader^ reader);
+
+								static void WritePaths(BinaryWriter^ writer, List<String^>^ paths);
+								static List<String^>^ ReadPaths(BinaryReader^ reader);
+
+								/// <summary>
+								/// Gets the local path to which an item of an exported tree is written
+								/// </summary>
+								static String^ GetLocalPath(Uri^ root, String^ localRoot, ObjectModel::Item^ item);
+
+								static void WriteLocationSegments(BinaryWriter^ writer, List<ObjectModel::LocationSegment^>^ segments);
+								static List<ObjectModel::LocationSegment^>^ ReadLocationSegments(BinaryReader^ reader);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
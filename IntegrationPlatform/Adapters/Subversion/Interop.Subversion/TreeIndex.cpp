@@ -0,0 +1,482 @@
+#include "Stdafx.h"
+#include "TreeIndex.h"
+
+#include <svn_types.h>
+
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+
+TreeIndex::TreeIndex()
+{
+	m_workingRevision = -1;
+}
+
+long
+TreeIndex::FirstRevision() const
+{
+	return m_snapshots.empty() ? -1 : m_snapshots.begin()->first;
+}
+
+long
+TreeIndex::LatestRevision() const
+{
+	return m_snapshots.empty() ? -1 : m_snapshots.rbegin()->first;
+}
+
+size_t
+TreeIndex::SnapshotCount() const
+{
+	return m_snapshots.size();
+}
+
+bool
+TreeIndex::Begin(long revision)
+{
+	if(revision <= LatestRevision())
+	{
+		return false;
+	}
+
+	m_workingRevision = revision;
+	m_owned.clear();
+
+	if(m_snapshots.empty())
+	{
+		m_working = Allocate(true, revision);
+	}
+	else
+	{
+		//The root is the only node that is copied up front. Everything else is copied on the first write
+		m_working = m_snapshots.rbegin()->second;
+		Own(m_working, true);
+	}
+
+	return true;
+}
+
+void
+TreeIndex::Commit()
+{
+	if(m_working)
+	{
+		m_snapshots[m_workingRevision] = m_working;
+	}
+
+	Abort();
+}
+
+void
+TreeIndex::Abort()
+{
+	m_working.reset();
+	m_workingRevision = -1;
+	m_owned.clear();
+}
+
+std::shared_ptr<TreeIndex::Node>
+TreeIndex::Allocate(bool directory, long createdRevision)
+{
+	std::shared_ptr<Node> node = std::make_shared<Node>();
+	node->directory = directory;
+	node->createdRevision = createdRevision;
+	node->size = SVN_INVALID_FILESIZE;
+	node->content = -1;
+	node->properties = -1;
+
+	m_owned.insert(node.get());
+	return node;
+}
+
+TreeIndex::Node*
+TreeIndex::Own(std::shared_ptr<Node>& node, bool touch)
+{
+	if(m_owned.find(node.get()) == m_owned.end())
+	{
+		//The node is shared with older snapshots. The copy shares all children with the original node
+		node = std::make_shared<Node>(*node);
+		m_owned.insert(node.get());
+	}
+
+	if(touch)
+	{
+		//Subversion assigns a new node revision to every parent of a changed node
+		node->createdRevision = m_workingRevision;
+	}
+
+	return node.get();
+}
+
+TreeIndex::Node*
+TreeIndex::WalkToParent(const std::vector<std::string>& segments, bool create, bool touch)
+{
+	Node* node = Own(m_working, touch);
+	for(size_t i = 0; i + 1 < segments.size(); i++)
+	{
+		std::map<std::string, std::shared_ptr<Node> >::iterator position = node->children.find(segments[i]);
+		if(position == node->children.end())
+		{
+			if(!create)
+			{
+				return NULL;
+			}
+
+			position = node->children.insert(std::make_pair(segments[i], Allocate(true, m_workingRevision))).first;
+		}
+
+		node = Own(position->second, touch);
+		node->directory = true;
+	}
+
+	return node;
+}
+
+void
+TreeIndex::Seed(const std::string& path, bool directory, long createdRevision, long long size, const std::string& lastAuthor)
+{
+	std::vector<std::string> segments;
+	Split(path, segments);
+
+	Node* node;
+	if(segments.empty())
+	{
+		node = Own(m_working, false);
+	}
+	else
+	{
+		Node* parent = WalkToParent(segments, true, false);
+		std::shared_ptr<Node>& child = parent->children[segments.back()];
+		if(!child)
+		{
+			child = Allocate(directory, createdRevision);
+		}
+
+		node = Own(child, false);
+	}
+
+	node->directory = directory;
+	node->createdRevision = createdRevision;
+	node->size = size;
+	node->lastAuthor = lastAuthor;
+}
+
+void
+TreeIndex::Add(const std::string& path, bool directory, const std::string& lastAuthor)
+{
+	std::vector<std::string> segments;
+	Split(path, segments);
+	if(segments.empty())
+	{
+		return;
+	}
+
+	Node* parent = WalkToParent(segments, true, true);
+	std::shared_ptr<Node> node = Allocate(directory, m_workingRevision);
+	node->lastAuthor = lastAuthor;
+	parent->children[segments.back()] = node;
+}
+
+bool
+TreeIndex::Modify(const std::string& path, const std::string& lastAuthor)
+{
+	std::vector<std::string> segments;
+	Split(path, segments);
+
+	Node* node;
+	if(segments.empty())
+	{
+		node = Own(m_working, true);
+	}
+	else
+	{
+		Node* parent = WalkToParent(segments, false, true);
+		if(NULL == parent)
+		{
+			return false;
+		}
+
+		std::map<std::string, std::shared_ptr<Node> >::iterator position = parent->children.find(segments.back());
+		if(position == parent->children.end())
+		{
+			return false;
+		}
+
+		node = Own(position->second, true);
+	}
+
+	//The content of the file has changed. The new size is not reported by the log
+	node->lastAuthor = lastAuthor;
+	if(!node->directory)
+	{
+		node->size = SVN_INVALID_FILESIZE;
+	}
+
+	return true;
+}
+
+bool
+TreeIndex::Delete(const std::string& path)
+{
+	std::vector<std::string> segments;
+	Split(path, segments);
+	if(segments.empty())
+	{
+		return false;
+	}
+
+	Node* parent = WalkToParent(segments, false, true);
+	if(NULL == parent)
+	{
+		return false;
+	}
+
+	return parent->children.erase(segments.back()) > 0;
+}
+
+bool
+TreeIndex::Copy(const std::string& path, const std::string& copyFromPath, long copyFromRevision, const std::string& lastAuthor)
+{
+	std::vector<std::string> segments;
+	Split(path, segments);
+	if(segments.empty())
+	{
+		return false;
+	}
+
+	const std::shared_ptr<Node>* root = FindSnapshot(copyFromRevision);
+	if(NULL == root)
+	{
+		return false;
+	}
+
+	//Resolve the source in the old snapshot before the current snapshot is changed
+	std::vector<std::string> sourceSegments;
+	Split(copyFromPath, sourceSegments);
+
+	std::shared_ptr<Node> source = *root;
+	for(std::vector<std::string>::const_iterator segment = sourceSegments.begin(); segment != sourceSegments.end(); ++segment)
+	{
+		std::map<std::string, std::shared_ptr<Node> >::const_iterator position = source->children.find(*segment);
+		if(position == source->children.end())
+		{
+			return false;
+		}
+
+		source = position->second;
+	}
+
+	//The copy gets a node of its own. The complete subtree below of it is shared with the source
+	std::shared_ptr<Node> copy = std::make_shared<Node>(*source);
+	copy->createdRevision = m_workingRevision;
+	copy->lastAuthor = lastAuthor;
+	m_owned.insert(copy.get());
+
+	Node* parent = WalkToParent(segments, true, true);
+	parent->children[segments.back()] = copy;
+	return true;
+}
+
+const std::shared_ptr<TreeIndex::Node>*
+TreeIndex::FindSnapshot(long revision) const
+{
+	//Revisions without a snapshot did not change the tree. They are served by the next older snapshot
+	std::map<long, std::shared_ptr<Node> >::const_iterator position = m_snapshots.upper_bound(revision);
+	if(position == m_snapshots.begin())
+	{
+		return NULL;
+	}
+
+	--position;
+	return &position->second;
+}
+
+bool
+TreeIndex::SetContent(const std::string& path, long long content, long long size)
+{
+	std::vector<std::string> segments;
+	Split(path, segments);
+
+	Node* node;
+	if(segments.empty())
+	{
+		node = Own(m_working, false);
+	}
+	else
+	{
+		Node* parent = WalkToParent(segments, false, false);
+		if(NULL == parent)
+		{
+			return false;
+		}
+
+		std::map<std::string, std::shared_ptr<Node> >::iterator position = parent->children.find(segments.back());
+		if(position == parent->children.end())
+		{
+			return false;
+		}
+
+		node = Own(position->second, false);
+	}
+
+	node->content = content;
+	node->size = size;
+	return true;
+}
+
+bool
+TreeIndex::SetProperties(const std::string& path, long long properties)
+{
+	std::vector<std::string> segments;
+	Split(path, segments);
+
+	Node* node;
+	if(segments.empty())
+	{
+		node = Own(m_working, false);
+	}
+	else
+	{
+		Node* parent = WalkToParent(segments, false, false);
+		if(NULL == parent)
+		{
+			return false;
+		}
+
+		std::map<std::string, std::shared_ptr<Node> >::iterator position = parent->children.find(segments.back());
+		if(position == parent->children.end())
+		{
+			return false;
+		}
+
+		node = Own(position->second, false);
+	}
+
+	node->properties = properties;
+	return true;
+}
+
+const TreeIndex::Node*
+TreeIndex::FindCurrent(const std::string& path) const
+{
+	if(!m_working)
+	{
+		return NULL;
+	}
+
+	return Walk(m_working.get(), path);
+}
+
+const TreeIndex::Node*
+TreeIndex::Find(const std::string& path, long revision) const
+{
+	const std::shared_ptr<Node>* root = FindSnapshot(revision);
+	if(NULL == root)
+	{
+		return NULL;
+	}
+
+	return Walk(root->get(), path);
+}
+
+const TreeIndex::Node*
+TreeIndex::Walk(const Node* root, const std::string& path)
+{
+	std::vector<std::string> segments;
+	Split(path, segments);
+
+	const Node* node = root;
+	for(std::vector<std::string>::const_iterator segment = segments.begin(); segment != segments.end(); ++segment)
+	{
+		std::map<std::string, std::shared_ptr<Node> >::const_iterator position = node->children.find(*segment);
+		if(position == node->children.end())
+		{
+			return NULL;
+		}
+
+		node = position->second.get();
+	}
+
+	return node;
+}
+
+bool
+TreeIndex::List(const std::string& path, long revision, int depth, std::vector<Entry>& entries) const
+{
+	const Node* node = Find(path, revision);
+	if(NULL == node)
+	{
+		return false;
+	}
+
+	Collect(path, node, depth, true, entries);
+	return true;
+}
+
+void
+TreeIndex::Collect(const std::string& path, const Node* node, int depth, bool self, std::vector<Entry>& entries)
+{
+	if(self)
+	{
+		Entry entry;
+		entry.path = path;
+		entry.node = node;
+		entries.push_back(entry);
+	}
+
+	if(svn_depth_empty == depth || !node->directory)
+	{
+		return;
+	}
+
+	//The children are ordered bytewise which is the order in which subversion lists the entries of a directory
+	for(std::map<std::string, std::shared_ptr<Node> >::const_iterator child = node->children.begin(); child != node->children.end(); ++child)
+	{
+		if(svn_depth_files == depth && child->second->directory)
+		{
+			continue;
+		}
+
+		std::string childPath = Join(path, child->first);
+		if(svn_depth_infinity == depth)
+		{
+			Collect(childPath, child->second.get(), depth, true, entries);
+		}
+		else
+		{
+			Entry entry;
+			entry.path = childPath;
+			entry.node = child->second.get();
+			entries.push_back(entry);
+		}
+	}
+}
+
+void
+TreeIndex::Split(const std::string& path, std::vector<std::string>& segments)
+{
+	std::string::size_type start = 0;
+	while(start < path.length())
+	{
+		std::string::size_type end = path.find('/', start);
+		if(std::string::npos == end)
+		{
+			end = path.length();
+		}
+
+		if(end > start)
+		{
+			segments.push_back(path.substr(start, end - start));
+		}
+
+		start = end + 1;
+	}
+}
+
+std::string
+TreeIndex::Join(const std::string& parent, const std::string& name)
+{
+	if(parent.empty() || '/' != parent[parent.length() - 1])
+	{
+		return parent + "/" + name;
+	}
+
+	return parent + name;
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						namespace Helpers
+						{
+							/// <summary>
+							/// Native persistent tree of a repository. Every revision is an immutable snapshot and consecutive snapshots share all
+							/// nodes that have not been changed. A new snapshot only allocates the changed nodes and their parents.
+							/// The paths are the UTF-8 encoded paths relative to the repository root as they are reported by subversion
+							/// </summary>
+							class TreeIndex
+							{
+							public:
+								struct Node
+								{
+									bool directory;
+									long createdRevision;
+									long long size;
+									std::string lastAuthor;
+
+									//Identifies the text of a file for the owner of the index; -1 if the owner does not track the text
+									long long content;
+
+									//Identifies the properties of a node for the owner of the index; -1 if the owner does not track the properties
+									long long properties;
+									std::map<std::string, std::shared_ptr<Node> > children;
+								};
+
+								struct Entry
+								{
+									std::string path;
+									const Node* node;
+								};
+
+								TreeIndex();
+
+								/// <summary>
+								/// Starts a new snapshot on top of the youngest one. Returns false if the revision is not younger than the youngest snapshot
+								/// </summary>
+								bool Begin(long revision);
+
+								/// <summary>
+								/// Publishes the snapshot that has been started by <see cref="Begin"/>
+								/// </summary>
+								void Commit();
+
+								/// <summary>
+								/// Discards the snapshot that has been started by <see cref="Begin"/>
+								/// </summary>
+								void Abort();
+
+								/// <summary>
+								/// Stores a node exactly as it has been listed. Missing parents are created. The children of an existing node are kept
+								/// </summary>
+								void Seed(const std::string& path, bool directory, long createdRevision, long long size, const std::string& lastAuthor);
+
+								/// <summary>
+								/// Adds a new empty node. An existing node is replaced. Missing parents are created
+								/// </summary>
+								void Add(const std::string& path, bool directory, const std::string& lastAuthor);
+
+								/// <summary>
+								/// Marks a node as changed in the current snapshot. Returns false if the node does not exist
+								/// </summary>
+								bool Modify(const std::string& path, const std::string& lastAuthor);
+
+								/// <summary>
+								/// Removes a node and all of its children. Returns false if the node does not exist
+								/// </summary>
+								bool Delete(const std::string& path);
+
+								/// <summary>
+								/// Copies a node and all of its children from an older snapshot. An existing node is replaced.
+								/// Returns false if the source is not known in that snapshot
+								/// </summary>
+								bool Copy(const std::string& path, const std::string& copyFromPath, long copyFromRevision, const std::string& lastAuthor);
+
+								/// <summary>
+								/// Stores the text and the size of a file in the current snapshot. Returns false if the node does not exist
+								/// </summary>
+								bool SetContent(const std::string& path, long long content, long long size);
+
+								/// <summary>
+								/// Stores the properties of a node in the current snapshot. Returns false if the node does not exist
+								/// </summary>
+								bool SetProperties(const std::string& path, long long properties);
+
+								/// <summary>
+								/// Finds a node in the snapshot that has been started by <see cref="Begin"/>. Returns NULL if the node does not exist
+								/// </summary>
+								const Node* FindCurrent(const std::string& path) const;
+
+								/// <summary>
+								/// Finds a node in the snapshot of a revision. Returns NULL if the node does not exist or the revision is older than the first snapshot
+								/// </summary>
+								const Node* Find(const std::string& path, long revision) const;
+
+								/// <summary>
+								/// Collects the node and its children in the same order in which subversion lists them.
+								/// The depth follows svn_depth_t: 0 = the node only, 1 = files, 2 = immediates, 3 = infinity
+								/// </summary>
+								bool List(const std::string& path, long revision, int depth, std::vector<Entry>& entries) const;
+
+								/// <summary>
+								/// Gets the revision of the first snapshot; -1 if there is no snapshot
+								/// </summary>
+								long FirstRevision() const;
+
+								/// <summary>
+								/// Gets the revision of the youngest snapshot; -1 if there is no snapshot
+								/// </summary>
+								long LatestRevision() const;
+
+								size_t SnapshotCount() const;
+
+							private:
+								std::map<long, std::shared_ptr<Node> > m_snapshots;
+
+								//The snapshot that is built right now. Only the nodes that have been allocated for it may be changed in place
+								std::shared_ptr<Node> m_working;
+								long m_workingRevision;
+								std::set<const Node*> m_owned;
+
+								const std::shared_ptr<Node>* FindSnapshot(long revision) const;
+								static const Node* Walk(const Node* root, const std::string& path);
+								std::shared_ptr<Node> Allocate(bool directory, long createdRevision);
+								Node* Own(std::shared_ptr<Node>& node, bool touch);
+								Node* WalkToParent(const std::vector<std::string>& segments, bool create, bool touch);
+
+								static void Split(const std::string& path, std::vector<std::string>& segments);
+								static std::string Join(const std::string& parent, const std::string& name);
+								static void Collect(const std::string& path, const Node* node, int depth, bool self, std::vector<Entry>& entries);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
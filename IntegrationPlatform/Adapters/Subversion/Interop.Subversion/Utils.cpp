@@ -72,3 +72,21 @@ Utils::ConvertUTF8ToString(const char* value)
 
 	return gcnew String(value, 0, strlen(value), System::Text::Encoding::UTF8);
 }
+
+std::string
+Utils::ConvertStringToUTF8(String^ value)
+{
+	if(nullptr == value)
+	{
+		throw gcnew ArgumentNullException("value");
+	}
+
+	array<Byte>^ bytes = System::Text::Encoding::UTF8->GetBytes(value);
+	if(0 == bytes->Length)
+	{
+		return std::string();
+	}
+
+	pin_ptr<Byte> pinned = &bytes[0];
+	return std::string((const char*)pinned, bytes->Length);
+}
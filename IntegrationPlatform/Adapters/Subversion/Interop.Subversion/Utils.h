@@ -3,6 +3,8 @@
 #include "apr_time.h"
 #include "svn_types.h"
 
+#include <string>
+
 using namespace System;
 
 using namespace Microsoft::TeamFoundation::Migration::Toolkit;
@@ -64,6 +66,12 @@ namespace Microsoft
 									/// </summary>
 									/// <param name="value">The value that shall be converted</param>
 									static String^ ConvertUTF8ToString(const char* value);
+
+									/// <summary>
+									/// Converts a System::String to an UTF8 encoded standard string
+									/// </summary>
+									/// <param name="value">The value that shall be converted</param>
+									static std::string ConvertStringToUTF8(String^ value);
 							};
 						}
 					}
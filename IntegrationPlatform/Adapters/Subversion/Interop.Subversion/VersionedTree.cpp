@@ -0,0 +1,418 @@
+#include "Stdafx.h"
+#include "Change.h"
+#include "ChangeBatch.h"
+#include "ChangeSet.h"
+#include "IRepositoryBackend.h"
+#include "Item.h"
+#include "PathFilter.h"
+#include "SubversionClient.h"
+#include "TreeIndex.h"
+#include "Utils.h"
+#include "VersionedTree.h"
+
+#include <vector>
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+using namespace Microsoft::TeamFoundation::Migration::Toolkit;
+using namespace Microsoft::TeamFoundation::Migration::Toolkit::Services;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::Helpers;
+using namespace Microsoft::TeamFoundation::Migration::SubversionAdapter::Interop::Subversion::ObjectModel;
+
+VersionedTree::VersionedTree(SubversionClient^ client, Uri^ scope, long revision, PathFilter^ filter)
+{
+	if(nullptr == client)
+	{
+		throw gcnew ArgumentNullException("client");
+	}
+
+	if(nullptr == scope)
+	{
+		throw gcnew ArgumentNullException("scope");
+	}
+
+	if(revision < 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("revision");
+	}
+
+	m_client = client;
+	m_filter = filter;
+	m_repositoryRoot = client->RepositoryRoot->ToString()->TrimEnd(Utils::SeperatorCharArray);
+	m_itemRoot = client->VirtualRepositoryRoot->ToString();
+	m_scope = scope->ToString()->TrimEnd(Utils::SeperatorCharArray);
+	m_seedRevision = revision;
+	m_revision = revision;
+	m_valid = true;
+	m_verificationInterval = 0;
+	m_hits = 0;
+	m_mismatches = 0;
+	m_index = new TreeIndex();
+
+	Seed();
+}
+
+VersionedTree::~VersionedTree()
+{
+	this->!VersionedTree();
+}
+
+VersionedTree::!VersionedTree()
+{
+	if(NULL != m_index)
+	{
+		delete m_index;
+		m_index = NULL;
+	}
+}
+
+Uri^
+VersionedTree::Scope::get()
+{
+	return gcnew Uri(m_scope);
+}
+
+long
+VersionedTree::SeedRevision::get()
+{
+	return m_seedRevision;
+}
+
+long
+VersionedTree::Revision::get()
+{
+	return m_revision;
+}
+
+bool
+VersionedTree::IsValid::get()
+{
+	return m_valid && NULL != m_index;
+}
+
+int
+VersionedTree::VerificationInterval::get()
+{
+	return m_verificationInterval;
+}
+
+void
+VersionedTree::VerificationInterval::set(int value)
+{
+	if(value < 0)
+	{
+		throw gcnew ArgumentOutOfRangeException("value");
+	}
+
+	m_verificationInterval = value;
+}
+
+long long
+VersionedTree::Hits::get()
+{
+	return m_hits;
+}
+
+long long
+VersionedTree::Mismatches::get()
+{
+	return m_mismatches;
+}
+
+std::string
+VersionedTree::ToRelativePath(String^ fullServerPath)
+{
+	//The paths are stored the same way subversion reports them: relative to the root, with a leading slash and UTF-8 encoded
+	return Utils::ConvertStringToUTF8(Utils::ExtractPath(m_repositoryRoot, fullServerPath));
+}
+
+bool
+VersionedTree::IsInScope(String^ fullServerPath)
+{
+	String^ path = fullServerPath->TrimEnd(Utils::SeperatorCharArray);
+	if(!String::Equals(path, m_scope, StringComparison::Ordinal) && !path->StartsWith(String::Concat(m_scope, Utils::Seperator), StringComparison::Ordinal))
+	{
+		return false;
+	}
+
+	//The changes of paths that are not mapped are not added. Therefore these parts of the tree are outdated
+	return nullptr == m_filter || m_filter->IsMapped(gcnew Uri(path));
+}
+
+void
+VersionedTree::Seed()
+{
+	List<Item^>^ items = m_client->GetItems(gcnew Uri(m_scope), m_seedRevision, Depth::Infinity);
+
+	m_index->Begin(m_seedRevision);
+	try
+	{
+		for each(Item^ item in items)
+		{
+			m_index->Seed(
+				ToRelativePath(item->FullServerPath), 
+				WellKnownContentType::VersionControlledFolder == item->ItemType, 
+				item->CreatedRev, 
+				item->Size, 
+				nullptr == item->LastAuthor ? std::string() : Utils::ConvertStringToUTF8(item->LastAuthor));
+		}
+
+		m_index->Commit();
+	}
+	catch(Exception^)
+	{
+		m_index->Abort();
+		throw;
+	}
+
+	TraceManager::TraceInformation("Seeded the versioned tree of '{0}' with {1} items at revision {2}", m_scope, items->Count, m_seedRevision);
+}
+
+bool
+VersionedTree::IsDirectory(Change^ change)
+{
+	switch(change->NodeKind)
+	{
+	case svn_node_dir:
+		return true;
+	case svn_node_file:
+		return false;
+	default:
+		//Old servers do not report the node kind. The change resolves it by an additional request
+		return WellKnownContentType::VersionControlledFolder == change->ItemType;
+	}
+}
+
+void
+VersionedTree::Add(ChangeSet^ changeset)
+{
+	if(nullptr == changeset)
+	{
+		throw gcnew ArgumentNullException("changeset");
+	}
+
+	if(NULL == m_index)
+	{
+		throw gcnew ObjectDisposedException("VersionedTree");
+	}
+
+	if(!m_valid || changeset->Revision <= m_revision)
+	{
+		return;
+	}
+
+	if(changeset->ChangeCount <= 0)
+	{
+		m_revision = changeset->Revision;
+		return;
+	}
+
+	//Parents have to be applied before their children. A replaced folder is the base of the changes below of it
+	if(!changeset->IsOrdered)
+	{
+		//The changes that have been spilled to disk are in no particular order and they are too many to be sorted in memory
+		TraceManager::TraceWarning("Revision {0} changes too many paths to be applied to the versioned tree. The tree is not used anymore", changeset->Revision);
+		Invalidate();
+		return;
+	}
+
+	std::string author = nullptr == changeset->Author ? std::string() : Utils::ConvertStringToUTF8(changeset->Author);
+
+	m_index->Begin(changeset->Revision);
+	try
+	{
+		for each(ChangeBatch^ batch in changeset->GetChangeBatches())
+		{
+			for each(Change^ change in batch)
+			{
+				Apply(change, author);
+				if(!m_valid)
+				{
+					m_index->Abort();
+					return;
+				}
+			}
+		}
+
+		m_index->Commit();
+		m_revision = changeset->Revision;
+	}
+	catch(Exception^)
+	{
+		m_index->Abort();
+		Invalidate();
+		throw;
+	}
+}
+
+void
+VersionedTree::Apply(Change^ change, const std::string& author)
+{
+	String^ fullServerPath = change->FullServerPath->TrimEnd(Utils::SeperatorCharArray);
+	if(m_scope->StartsWith(String::Concat(fullServerPath, Utils::Seperator), StringComparison::Ordinal) && ChangeAction::Modify != change->ChangeAction)
+	{
+		//A parent of the scope has been deleted, replaced or moved. The tree cannot follow that
+		TraceManager::TraceWarning("The parent '{0}' of the versioned tree has been changed in revision {1}. The tree is not used anymore", fullServerPath, change->Changeset->Revision);
+		Invalidate();
+		return;
+	}
+
+	if(!IsInScope(fullServerPath))
+	{
+		return;
+	}
+
+	std::string path = ToRelativePath(fullServerPath);
+	bool applied = true;
+
+	switch(change->ChangeAction)
+	{
+	case ChangeAction::Delete:
+		applied = m_index->Delete(path);
+		break;
+	case ChangeAction::Modify:
+		applied = m_index->Modify(path, author);
+		break;
+	case ChangeAction::Replace:
+	case ChangeAction::Add:
+	case ChangeAction::Copy:
+		if(nullptr != change->CopyFromFullServerPath)
+		{
+			ApplyCopy(change, path, author);
+		}
+		else
+		{
+			m_index->Add(path, IsDirectory(change), author);
+		}
+		break;
+	}
+
+	if(!applied)
+	{
+		TraceManager::TraceWarning("The versioned tree does not contain '{0}' which has been changed in revision {1}. The tree is not used anymore", fullServerPath, change->Changeset->Revision);
+		Invalidate();
+	}
+}
+
+void
+VersionedTree::ApplyCopy(Change^ change, const std::string& path, const std::string& author)
+{
+	String^ source = change->CopyFromFullServerPath->TrimEnd(Utils::SeperatorCharArray);
+	long sourceRevision = change->CopyFromRevision;
+
+	if(IsInScope(source) && sourceRevision >= m_seedRevision && m_index->Copy(path, ToRelativePath(source), sourceRevision, author))
+	{
+		return;
+	}
+
+	//The source is not part of the local tree. Its subtree is listed once and grafted onto the destination
+	List<Item^>^ items = m_client->GetItems(gcnew Uri(source), sourceRevision, Depth::Infinity);
+	if(0 == items->Count)
+	{
+		Invalidate();
+		return;
+	}
+
+	m_index->Add(path, WellKnownContentType::VersionControlledFolder == items[0]->ItemType, author);
+	for(int i = 1; i < items->Count; i++)
+	{
+		Item^ item = items[i];
+		String^ relative = item->FullServerPath->Substring(source->Length);
+
+		m_index->Seed(
+			path + Utils::ConvertStringToUTF8(relative), 
+			WellKnownContentType::VersionControlledFolder == item->ItemType, 
+			item->CreatedRev, 
+			item->Size, 
+			nullptr == item->LastAuthor ? std::string() : Utils::ConvertStringToUTF8(item->LastAuthor));
+	}
+}
+
+void
+VersionedTree::Invalidate()
+{
+	m_valid = false;
+}
+
+bool
+VersionedTree::TryGetItems(Uri^ path, long revision, Depth depth, [Out] List<Item^>^% items)
+{
+	items = nullptr;
+
+	if(nullptr == path)
+	{
+		throw gcnew ArgumentNullException("path");
+	}
+
+	if(NULL == m_index || !m_valid || Depth::Unknown == depth)
+	{
+		return false;
+	}
+
+	//Revisions before the seed or after the last added changeset are not known. The head revision is never answered locally
+	if(revision < m_seedRevision || revision > m_revision)
+	{
+		return false;
+	}
+
+	String^ fullServerPath = path->ToString();
+	if(!IsInScope(fullServerPath))
+	{
+		return false;
+	}
+
+	std::vector<TreeIndex::Entry> entries;
+	if(!m_index->List(ToRelativePath(fullServerPath), revision, (int)depth, entries))
+	{
+		//The path does not exist. The server reports the proper error
+		return false;
+	}
+
+	items = gcnew List<Item^>((int)entries.size());
+	for(std::vector<TreeIndex::Entry>::const_iterator entry = entries.begin(); entry != entries.end(); ++entry)
+	{
+		const TreeIndex::Node* node = entry->node;
+		items->Add(gcnew Item(
+			Utils::Combine(m_repositoryRoot, Utils::ConvertUTF8ToString(entry->path.c_str())), 
+			node->directory ? WellKnownContentType::VersionControlledFolder : WellKnownContentType::VersionControlledFile, 
+			node->size, 
+			node->createdRevision, 
+			node->lastAuthor.empty() ? nullptr : Utils::ConvertUTF8ToString(node->lastAuthor.c_str()), 
+			m_itemRoot));
+	}
+
+	m_hits++;
+	if(m_verificationInterval > 0 && 0 == m_hits % m_verificationInterval)
+	{
+		Verify(path, revision, depth, items);
+	}
+
+	return true;
+}
+
+bool
+VersionedTree::Verify(Uri^ path, long revision, Depth depth, List<Item^>^% items)
+{
+	//The backend is asked directly. The caches of the client would answer with the same local data
+	List<Item^>^ expected = m_client->Backend->GetItems(path, revision, depth);
+
+	bool equal = expected->Count == items->Count;
+	for(int i = 0; equal && i < expected->Count; i++)
+	{
+		equal = String::Equals(expected[i]->FullServerPath->TrimEnd(Utils::SeperatorCharArray), items[i]->FullServerPath->TrimEnd(Utils::SeperatorCharArray), StringComparison::Ordinal) 
+			&& expected[i]->ItemType == items[i]->ItemType;
+	}
+
+	if(!equal)
+	{
+		m_mismatches++;
+		TraceManager::TraceWarning("The versioned tree does not match the listing of '{0}' at revision {1} ({2} local items, {3} server items). The tree is not used anymore", path, revision, items->Count, expected->Count);
+		Invalidate();
+
+		items = expected;
+	}
+
+	return equal;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <string>
+
+#include "Depth.h"
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Runtime::InteropServices;
+
+namespace Microsoft
+{
+	namespace TeamFoundation
+	{
+		namespace Migration
+		{
+			namespace SubversionAdapter
+			{
+				namespace Interop
+				{
+					namespace Subversion
+					{
+						ref class SubversionClient;
+
+						namespace Helpers
+						{
+							class TreeIndex;
+						}
+
+						namespace ObjectModel
+						{
+							ref class Change;
+							ref class ChangeSet;
+							ref class Item;
+							ref class PathFilter;
+
+							/// <summary>
+							/// Local copy of the tree of a repository at every analyzed revision. The tree is seeded by one recursive listing and
+							/// afterwards updated by the changed paths of every changeset. Copies are expanded from the own older snapshots.
+							/// Therefore listings of any known revision are answered without a round trip to the server.
+							/// <para/>
+							/// The tree only answers requests for paths that are within its scope and mapped by its filter. Every changeset that
+							/// changes such a path has to be added in order. Otherwise the tree has to be invalidated
+							/// </summary>
+							public ref class VersionedTree
+							{
+							private:
+								Helpers::TreeIndex* m_index;
+								SubversionClient^ m_client;
+								PathFilter^ m_filter;
+								String^ m_repositoryRoot;
+								String^ m_itemRoot;
+								String^ m_scope;
+								long m_seedRevision;
+								long m_revision;
+								bool m_valid;
+								int m_verificationInterval;
+								long long m_hits;
+								long long m_mismatches;
+
+								static bool IsDirectory(Change^ change);
+
+								std::string ToRelativePath(String^ fullServerPath);
+								bool IsInScope(String^ fullServerPath);
+								void Seed();
+								void Apply(Change^ change, const std::string& author);
+								void ApplyCopy(Change^ change, const std::string& path, const std::string& author);
+								bool Verify(Uri^ path, long revision, Depth depth, List<Item^>^% items);
+
+							internal:
+								/// <summary>
+								/// Creates the tree and seeds it by a recursive listing of the scope
+								/// </summary>
+								/// <param name="client">The client that is used to list the items that are not known locally</param>
+								/// <param name="scope">The root of the tree</param>
+								/// <param name="revision">The revision of the initial listing</param>
+								/// <param name="filter">The filter that defines the paths whose changes are added to the tree; null if all changes are added</param>
+								VersionedTree(SubversionClient^ client, Uri^ scope, long revision, PathFilter^ filter);
+
+							public:
+								/// <summary>
+								/// Default destructor
+								/// </summary>
+								~VersionedTree();
+
+								/// <summary>
+								/// Default Finalizer
+								/// </summary>
+								!VersionedTree();
+
+								/// <summary>
+								/// Gets the root of the tree
+								/// </summary>
+								property Uri^ Scope { Uri^ get(); }
+
+								/// <summary>
+								/// Gets the revision of the initial listing. Older revisions are not known
+								/// </summary>
+								property long SeedRevision { long get(); }
+
+								/// <summary>
+								/// Gets the youngest revision that has been added to the tree
+								/// </summary>
+								property long Revision { long get(); }
+
+								/// <summary>
+								/// Gets whether the tree is still in sync with the repository
+								/// </summary>
+								property bool IsValid { bool get(); }
+
+								/// <summary>
+								/// Gets or sets how often a listing is verified against the server. Every n-th listing is verified; 0 disables the verification
+								/// </summary>
+								property int VerificationInterval { int get(); void set(int value); }
+
+								/// <summary>
+								/// Gets the number of listings that have been answered by the tree
+								/// </summary>
+								property long long Hits { long long get(); }
+
+								/// <summary>
+								/// Gets the number of verified listings that did not match the server
+								/// </summary>
+								property long long Mismatches { long long get(); }
+
+								/// <summary>
+								/// Applies the changed paths of a changeset. Changesets that are not younger than <see cref="Revision"/> are ignored
+								/// </summary>
+								void Add(ChangeSet^ changeset);
+
+								/// <summary>
+								/// Marks the tree as out of sync. All subsequent requests have to be answered by the server
+								/// </summary>
+								void Invalidate();
+
+								/// <summary>
+								/// Lists the items below of a path from the local tree
+								/// </summary>
+								/// <param name="path">The path for which the items shall be listed</param>
+								/// <param name="revision">The revision for which the items shall be listed</param>
+								/// <param name="depth">The recursion type used to retrieve the items</param>
+								/// <param name="items">The items in the order in which the server lists them</param>
+								/// <returns>true if the tree knows the path at the revision; false if the request has to be answered by the server</returns>
+								bool TryGetItems(Uri^ path, long revision, Depth depth, [Out] List<Item^>^% items);
+							};
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -12,25 +12,47 @@ using Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM;
 
 namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
 {
+    /// <summary>
+    /// Queries the changesets of the mapped revisions page by page. A page consists of a number of mapped revisions. The revisions in
+    /// between are not requested unless the gap is small enough to be bridged by a single request.
+    /// <para/>
+    /// If a change budget is set, the number of revisions of the next page is derived from the number of changes per revision of the
+    /// pages that have been loaded so far. Sparse histories are queried with few large pages and dense histories with many small ones.
+    /// Either way a page holds about as many changes as the budget allows
+    /// </summary>
     internal class ChangeSetPageManager
     {
         #region Private Members
 
+        //The number of unmapped revisions between two mapped ones up to which both are queried by the same request
+        private const int MaximumGap = 32;
+
+        //The bounds of the number of revisions of a page
+        private const int MinimumPageSize = 1;
+        private const int MaximumPageSize = 10000;
+
         private Repository m_repository;
         
         //Array that contains all the revisions and a index that points to the current element
         private int[] m_revisions;
         private int m_currentIndex;
 
-        //describes how many records should be queried at a time
+        //describes how many revisions should be queried at a time. The size is adjusted after every page if there is a change budget
         private int m_pageSize;
+        private int m_initialPageSize;
+        private int m_changeBudget;
 
-        //the lowest and the highest revision that is in the current page
-        private int m_pageStartRevision;
-        private int m_pageEndRevision;
+        //the index of the first revision after the current page
+        private int m_pageEndIndex;
+
+        //the smoothed number of changes per revision of the pages that have been loaded so far; 0 if no page has been loaded yet
+        private double m_changesPerRevision;
 
         private Dictionary<int, ChangeSet> m_cache;
 
+        //the filter that drops all changes outside of the mapped scope while the page is queried
+        private PathFilter m_pathFilter;
+
         #endregion
 
         #region Constructor
@@ -41,7 +63,21 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         /// <param name="repository">The repository that is used to query the change details</param>
         /// <param name="revisions">All the revisions numbers of the changes that will be queried</param>
         /// <param name="pageSize">The page size of the cache</param>
-        internal ChangeSetPageManager(Repository repository, int[] revisions, int pageSize)
+        /// <param name="pathFilter">The filter that decides which changes are materialized; null to materialize all changes</param>
+        internal ChangeSetPageManager(Repository repository, int[] revisions, int pageSize, PathFilter pathFilter)
+            : this(repository, revisions, pageSize, 0, pathFilter)
+        {
+        }
+
+        /// <summary>
+        /// Creates a new instance of the cache manager that adjusts the size of the pages to a budget of changes
+        /// </summary>
+        /// <param name="repository">The repository that is used to query the change details</param>
+        /// <param name="revisions">All the revisions numbers of the changes that will be queried</param>
+        /// <param name="pageSize">The number of revisions of the first page</param>
+        /// <param name="changeBudget">The number of changes that a page should hold; 0 to keep the page size fixed</param>
+        /// <param name="pathFilter">The filter that decides which changes are materialized; null to materialize all changes</param>
+        internal ChangeSetPageManager(Repository repository, int[] revisions, int pageSize, int changeBudget, PathFilter pathFilter)
         {
             if (null == repository)
             {
@@ -61,7 +97,15 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
                 pageSize = 50;
             }
 
-            m_pageSize = pageSize;
+            if (changeBudget < 0)
+            {
+                changeBudget = 0;
+            }
+
+            m_pageSize = Math.Min(pageSize, MaximumPageSize);
+            m_initialPageSize = m_pageSize;
+            m_changeBudget = changeBudget;
+            m_pathFilter = pathFilter;
         }
 
         #endregion
@@ -128,6 +172,17 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
             }
         }
 
+        /// <summary>
+        /// Gets the number of revisions that will be queried by the next page
+        /// </summary>
+        internal int PageSize
+        {
+            get
+            {
+                return m_pageSize;
+            }
+        }
+
         /// <summary>
         /// Returns the index that points to the current element
         /// </summary>
@@ -169,7 +224,7 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
             }
 
             //check wether the next revision number is still in this page. If not, we have to load the next one
-            if (CurrentRevision > m_pageEndRevision)
+            if (CurrentIndex >= m_pageEndIndex)
             {
                 LoadPage();
             }
@@ -181,8 +236,9 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         {
             CurrentIndex = 0;
 
-            m_pageStartRevision = 0;
-            m_pageEndRevision = 0;
+            m_pageEndIndex = 0;
+            m_pageSize = m_initialPageSize;
+            m_changesPerRevision = 0;
 
             m_cache = null;
         }
@@ -193,22 +249,80 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
 
         private void LoadPage()
         {
+            m_cache = new Dictionary<int, ChangeSet>();
+
             if (0 == m_revisions.Length)
             {
-                m_pageStartRevision = 0;
-                m_pageEndRevision = 0;
+                m_pageEndIndex = 0;
+                return;
+            }
+
+            int pageStartIndex = CurrentIndex;
+            m_pageEndIndex = Math.Min(m_revisions.Length, pageStartIndex + m_pageSize);
+
+            //The mapped revisions of the page are split into ranges. A gap of unmapped revisions is bridged only if it is small,
+            //otherwise the changes of the unmapped revisions would cost more than an additional request
+            int rangeStartIndex = pageStartIndex;
+            for (int index = pageStartIndex + 1; index <= m_pageEndIndex; index++)
+            {
+                if (index < m_pageEndIndex && m_revisions[index] - m_revisions[index - 1] <= MaximumGap)
+                {
+                    continue;
+                }
 
-                m_cache = new Dictionary<int, ChangeSet>();
+                loadRange(rangeStartIndex, index - 1);
+                rangeStartIndex = index;
             }
-            else
+
+            adjustPageSize(m_pageEndIndex - pageStartIndex);
+        }
+
+        /// <summary>
+        /// Queries the changesets of a range of mapped revisions and adds the mapped ones to the cache
+        /// </summary>
+        /// <param name="firstIndex">The index of the first revision of the range</param>
+        /// <param name="lastIndex">The index of the last revision of the range</param>
+        private void loadRange(int firstIndex, int lastIndex)
+        {
+            //Query the log records and store it in a lookup table for fast access. The filter ensures that only changes
+            //within the mapped scope and recursive operations on parents of a mapping are materialized
+            Dictionary<int, ChangeSet> changesets = m_repository.QueryHistoryRange(m_repository.RepositoryRoot, m_revisions[firstIndex], m_revisions[lastIndex], true, m_pathFilter);
+
+            for (int index = firstIndex; index <= lastIndex; index++)
             {
-                m_pageStartRevision = m_revisions[CurrentIndex];
-                m_pageEndRevision = Math.Min(HeadRevision, m_pageStartRevision + m_pageSize);
+                ChangeSet changeSet;
+                if (changesets.TryGetValue(m_revisions[index], out changeSet))
+                {
+                    m_cache[m_revisions[index]] = changeSet;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Derives the size of the next page from the number of changes per revision of the pages that have been loaded so far
+        /// </summary>
+        /// <param name="loadedRevisions">The number of revisions of the page that has just been loaded</param>
+        private void adjustPageSize(int loadedRevisions)
+        {
+            if (0 == m_changeBudget)
+            {
+                return;
+            }
 
-                //Query the log records and store it in a lookup table for fast access
-                // Todo, should use mapping path here
-                m_cache = m_repository.QueryHistoryRange(m_repository.RepositoryRoot, m_pageStartRevision, m_pageEndRevision, true);
+            long loadedChanges = 0;
+            foreach (ChangeSet changeSet in m_cache.Values)
+            {
+                loadedChanges += Math.Max(1, changeSet.ChangeCount);
             }
+
+            //The recent pages weigh more than the old ones. The density of a history usually changes over time
+            double changesPerRevision = Math.Max(1.0, (double)loadedChanges / loadedRevisions);
+            m_changesPerRevision = 0 == m_changesPerRevision ? changesPerRevision : (m_changesPerRevision + changesPerRevision) / 2;
+
+            int pageSize = (int)Math.Min(MaximumPageSize, m_changeBudget / m_changesPerRevision);
+
+            //A page may shrink at once but it grows by doubling only. A single sparse page must not make the next page take too much memory
+            m_pageSize = Math.Max(MinimumPageSize, Math.Min(pageSize, m_pageSize * 2));
         }
 
         #endregion
@@ -0,0 +1,231 @@
+﻿// Copyright © Microsoft Corporation.  All Rights Reserved.
+// This code released under the terms of the 
+// Microsoft Public License (MS-PL, http://opensource.org/licenses/ms-pl.html.)
+
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+using Microsoft.TeamFoundation.Migration.SubversionAdapter.Interop.Subversion.ObjectModel;
+using Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM;
+
+namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
+{
+    /// <summary>
+    /// Delivers the changesets of a list of revisions in three stages that run concurrently. The first stage queries the history page
+    /// by page, the second stage resolves the details of the changes that require additional requests and the caller analyzes the
+    /// changesets in the third stage. The stages are connected by bounded queues and every stage processes the revisions in order.
+    /// Therefore the changesets are delivered in the order of the revisions while the next ones are already being fetched
+    /// </summary>
+    internal class ChangeSetPipeline : IDisposable
+    {
+        #region Private Members
+
+        private Repository m_repository;
+        private int[] m_revisions;
+        private int m_pageSize;
+        private int m_changeBudget;
+        private PathFilter m_pathFilter;
+
+        //The queues between the stages. Each queue holds at most one page of changesets
+        private BlockingCollection<KeyValuePair<int, ChangeSet>> m_fetched;
+        private BlockingCollection<KeyValuePair<int, ChangeSet>> m_prepared;
+
+        //Stops the producing stages if a stage fails or if the consumer does not need any further changesets
+        private CancellationTokenSource m_cancellation;
+
+        private Task m_fetchTask;
+        private Task m_prepareTask;
+
+        #endregion
+
+        #region Constructor
+
+        /// <summary>
+        /// Creates a new pipeline. The stages are started by <see cref="GetChangeSets"/>
+        /// </summary>
+        /// <param name="repository">The repository that is used to query the change details</param>
+        /// <param name="revisions">All the revisions numbers of the changes that will be queried in ascending order</param>
+        /// <param name="pageSize">The number of revisions that are queried by the first page</param>
+        /// <param name="changeBudget">The number of changes that a page should hold; 0 to query every page with <paramref name="pageSize"/> revisions</param>
+        /// <param name="pathFilter">The filter that decides which changes are materialized; null to materialize all changes</param>
+        internal ChangeSetPipeline(Repository repository, int[] revisions, int pageSize, int changeBudget, PathFilter pathFilter)
+        {
+            if (null == repository)
+            {
+                throw new ArgumentNullException("repository");
+            }
+
+            if (null == revisions)
+            {
+                throw new ArgumentNullException("revisions");
+            }
+
+            if (pageSize <= 0)
+            {
+                pageSize = 50;
+            }
+
+            m_repository = repository;
+            m_revisions = revisions;
+            m_pageSize = pageSize;
+            m_changeBudget = changeBudget;
+            m_pathFilter = pathFilter;
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Starts the stages and delivers the changesets in the order of the revisions. The value is null if the change details of a revision could not be retrieved
+        /// </summary>
+        /// <returns>The revision numbers and their changesets</returns>
+        /// <exception cref="InvalidOperationException">Will be thrown if the changesets have been requested already</exception>
+        internal IEnumerable<KeyValuePair<int, ChangeSet>> GetChangeSets()
+        {
+            if (null != m_cancellation)
+            {
+                throw new InvalidOperationException("The changesets of a pipeline can only be requested once");
+            }
+
+            m_cancellation = new CancellationTokenSource();
+            m_fetched = new BlockingCollection<KeyValuePair<int, ChangeSet>>(m_pageSize);
+            m_prepared = new BlockingCollection<KeyValuePair<int, ChangeSet>>(m_pageSize);
+
+            //The stages are started without the token. Each stage has to run in any case to complete the queue that it feeds
+            m_fetchTask = Task.Factory.StartNew(fetch, CancellationToken.None, TaskCreationOptions.LongRunning, TaskScheduler.Default);
+            m_prepareTask = Task.Factory.StartNew(prepare, CancellationToken.None, TaskCreationOptions.LongRunning, TaskScheduler.Default);
+
+            return deliver();
+        }
+
+        public void Dispose()
+        {
+            if (null == m_cancellation)
+            {
+                return;
+            }
+
+            //The consumer may have stopped before the last revision. The producing stages must not wait for it any longer
+            m_cancellation.Cancel();
+
+            try
+            {
+                Task.WaitAll(m_fetchTask, m_prepareTask);
+            }
+            catch (AggregateException)
+            {
+                //The failures have been reported to the consumer already or the consumer is not interested in them anymore
+            }
+
+            m_fetched.Dispose();
+            m_prepared.Dispose();
+            m_cancellation.Dispose();
+        }
+
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// Yields the prepared changesets and reports the failure of a stage once all changesets before the failure have been delivered
+        /// </summary>
+        private IEnumerable<KeyValuePair<int, ChangeSet>> deliver()
+        {
+            foreach (KeyValuePair<int, ChangeSet> entry in m_prepared.GetConsumingEnumerable())
+            {
+                yield return entry;
+            }
+
+            try
+            {
+                Task.WaitAll(m_fetchTask, m_prepareTask);
+            }
+            catch (AggregateException e)
+            {
+                //The stage that failed cancels the others. Their cancellation is a consequence and not the cause
+                Exception cause = e.Flatten().InnerExceptions.FirstOrDefault(x => !(x is OperationCanceledException));
+                if (null != cause)
+                {
+                    throw cause;
+                }
+
+                throw;
+            }
+        }
+
+        /// <summary>
+        /// The first stage. Queries the history page by page and decodes the log entries
+        /// </summary>
+        private void fetch()
+        {
+            try
+            {
+                if (0 == m_revisions.Length)
+                {
+                    return;
+                }
+
+                var pager = new ChangeSetPageManager(m_repository, m_revisions, m_pageSize, m_changeBudget, m_pathFilter);
+
+                do
+                {
+                    m_fetched.Add(new KeyValuePair<int, ChangeSet>(pager.CurrentRevision, pager.Current), m_cancellation.Token);
+                }
+                while (pager.MoveNext());
+
+                pager.Reset();
+            }
+            catch (Exception e)
+            {
+                if (!(e is OperationCanceledException))
+                {
+                    m_cancellation.Cancel();
+                }
+
+                throw;
+            }
+            finally
+            {
+                m_fetched.CompleteAdding();
+            }
+        }
+
+        /// <summary>
+        /// The second stage. Resolves the node kinds and modifications that subversion did not report along with the changes
+        /// </summary>
+        private void prepare()
+        {
+            try
+            {
+                foreach (KeyValuePair<int, ChangeSet> entry in m_fetched.GetConsumingEnumerable(m_cancellation.Token))
+                {
+                    if (null != entry.Value)
+                    {
+                        entry.Value.ResolveDetails();
+                    }
+
+                    m_prepared.Add(entry, m_cancellation.Token);
+                }
+            }
+            catch (Exception e)
+            {
+                if (!(e is OperationCanceledException))
+                {
+                    m_cancellation.Cancel();
+                }
+
+                throw;
+            }
+            finally
+            {
+                m_prepared.CompleteAdding();
+            }
+        }
+
+        #endregion
+    }
+}
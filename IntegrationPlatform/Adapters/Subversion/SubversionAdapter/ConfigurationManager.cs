@@ -7,6 +7,7 @@ using System.Collections.Generic;
 using System.Linq;
 using Microsoft.TeamFoundation.Migration.Toolkit;
 using Microsoft.TeamFoundation.Migration.BusinessModel;
+using Microsoft.TeamFoundation.Migration.SubversionAdapter.Interop.Subversion.Backends;
 
 namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
 {
@@ -14,6 +15,17 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
     {
         #region Private Members
 
+        //The number of changes per page of the history if the custom setting PageChangeBudget is not set
+        private const int DefaultPageChangeBudget = 10000;
+
+        //The staging size in megabytes and the number of parallel downloads of the content prefetcher if they are not configured.
+        //The prefetcher puts additional load on the server and the local disk. It is disabled unless the custom setting PrefetchSize is set
+        private const int DefaultPrefetchSize = 0;
+        private const int DefaultPrefetchConnections = 4;
+
+        //The size in megabytes of the committed content that is kept to send later edits as differences if it is not configured
+        private const int DefaultCommitBaseCacheSize = 256;
+
         private ConfigurationService m_configurationService;
 
         private Uri m_serverUri;
@@ -23,6 +35,29 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         private string m_userName;
         private string m_passowrd;
         private int m_cacheSize;
+        private int m_pageChangeBudget;
+
+        private string m_traceMode;
+        private string m_traceFile;
+        private int m_replayLatency;
+        private int m_replayBandwidth;
+
+        private string m_dumpFile;
+        private Uri m_dumpFileRoot;
+
+        private string m_copyGraphDirectory;
+        private int m_listingCacheSize;
+        private int m_changeSpillThreshold;
+        private int m_sharedCacheSize;
+        private int m_prefetchSize;
+        private int m_prefetchConnections;
+        private int m_listingConnections;
+        private int m_bandwidthLimit;
+        private int m_watchInterval;
+        private string m_commitNotificationPipe;
+        private int m_commitBaseCacheSize;
+        private bool m_useVersionedTree;
+        private int m_versionedTreeVerification;
 
         #endregion
 
@@ -90,6 +125,22 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
             }
         }
 
+        /// <summary>
+        /// Gets the number of changes that a page of the history should hold; 0 if every page consists of <see cref="ChangesetCacheSize"/> revisions
+        /// </summary>
+        internal int PageChangeBudget
+        {
+            get
+            {
+                if (null == m_userName)
+                {
+                    InitializeCustomSettings();
+                }
+
+                return m_pageChangeBudget;
+            }
+        }
+
         /// <summary>
         /// Returns the normalized server uri that will be used to connect to the svn repository
         /// </summary>
@@ -138,14 +189,284 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
             }
         }
 
+        /// <summary>
+        /// Gets the directory in which the copy graph of the repository is persisted; null if the graph is not persisted
+        /// </summary>
+        internal string CopyGraphDirectory
+        {
+            get
+            {
+                if (null == m_userName)
+                {
+                    InitializeCustomSettings();
+                }
+
+                return m_copyGraphDirectory;
+            }
+        }
+
+        /// <summary>
+        /// Gets whether the listings of analyzed revisions are answered by a local versioned tree
+        /// </summary>
+        internal bool UseVersionedTree
+        {
+            get
+            {
+                if (null == m_userName)
+                {
+                    InitializeCustomSettings();
+                }
+
+                return m_useVersionedTree;
+            }
+        }
+
+        /// <summary>
+        /// Gets how often a listing of the versioned tree is verified against the server; 0 if the listings are not verified
+        /// </summary>
+        internal int VersionedTreeVerification
+        {
+            get
+            {
+                if (null == m_userName)
+                {
+                    InitializeCustomSettings();
+                }
+
+                return m_versionedTreeVerification;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of megabytes that the subversion client may use to cache directory listings; -1 if the default of the client is used
+        /// </summary>
+        internal int ListingCacheSize
+        {
+            get
+            {
+                if (null == m_userName)
+                {
+                    InitializeCustomSettings();
+                }
+
+                return m_listingCacheSize;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of changed paths of a single revision that the subversion client keeps in memory; -1 if the default of the client is used
+        /// </summary>
+        internal int ChangeSpillThreshold
+        {
+            get
+            {
+                if (null == m_userName)
+                {
+                    InitializeCustomSettings();
+                }
+
+                return m_changeSpillThreshold;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of megabytes of content that may be downloaded ahead of the migration; 0 if the content is downloaded on demand only.
+        /// The content is downloaded on demand unless the custom setting PrefetchSize is configured
+        /// </summary>
+        internal int PrefetchSize
+        {
+            get
+            {
+                if (null == m_userName)
+                {
+                    InitializeCustomSettings();
+                }
+
+                return m_prefetchSize;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of files that are downloaded ahead of the migration in parallel
+        /// </summary>
+        internal int PrefetchConnections
+        {
+            get
+            {
+                if (null == m_userName)
+                {
+                    InitializeCustomSettings();
+                }
+
+                return m_prefetchConnections;
+            }
+        }
+
+        /// <summary>
+        /// Gets the longest time in seconds between two polls of the latest revision; 0 if new revisions are detected by querying the history
+        /// </summary>
+        internal int WatchInterval
+        {
+            get
+            {
+                if (null == m_userName)
+                {
+                    InitializeCustomSettings();
+                }
+
+                return m_watchInterval;
+            }
+        }
+
+        /// <summary>
+        /// Gets the name of the local pipe on which a post-commit hook announces new revisions; null if no hook is configured
+        /// </summary>
+        internal string CommitNotificationPipe
+        {
+            get
+            {
+                if (null == m_userName)
+                {
+                    InitializeCustomSettings();
+                }
+
+                return m_commitNotificationPipe;
+            }
+        }
+
+        /// <summary>
+        /// Gets the number of megabytes of committed content that is kept to send later edits as differences; 0 if every edit is sent as full text
+        /// </summary>
+        internal int CommitBaseCacheSize
+        {
+            get
+            {
+                if (null == m_userName)
+                {
+                    InitializeCustomSettings();
+                }
+
+                return m_commitBaseCacheSize;
+            }
+        }
+
+        #endregion
+
+        #region Internal Methods
+
+        /// <summary>
+        /// Creates the repository backend that is configured by the custom settings DumpFile, TraceMode, TraceFile, SharedCacheSize, ListingConnections and BandwidthLimit.
+        /// Repositories with a file:// url are read directly from the repository layer unless they are traced.
+        /// </summary>
+        /// <returns>A dump file backend if a dump file is configured; a recording or replay backend if tracing is configured; a local repository backend if the repository is located on this machine; a shared cache backend if the shared cache size is configured; a live backend if the listing connections or the bandwidth limit are configured; null if the default backend has to be used</returns>
+        internal IRepositoryBackend CreateBackend()
+        {
+            if (null == m_traceMode)
+            {
+                InitializeCustomSettings();
+            }
+
+            if (null != m_dumpFile)
+            {
+                TraceManager.TraceInformation("Reading the repository from the dump file '{0}'. No subversion server is contacted", m_dumpFile);
+                return new DumpFileBackend(m_dumpFile, m_dumpFileRoot);
+            }
+
+            if (string.IsNullOrEmpty(m_traceMode))
+            {
+                IRepositoryBackend backend = null;
+                if (RepositoryUri.IsFile)
+                {
+                    TraceManager.TraceInformation("Reading the local repository '{0}' directly from its file system", RepositoryUri.LocalPath);
+                    backend = new LocalRepositoryBackend(createLiveBackend() ?? new LiveBackend());
+                }
+
+                //A configured cache is shared by local repositories as well. The other processes may read the same repository
+                if (m_sharedCacheSize > 0)
+                {
+                    TraceManager.TraceInformation("Sharing the repository metadata with other processes in a cache of {0} MB", m_sharedCacheSize);
+                    return new SharedCacheBackend(backend ?? createLiveBackend() ?? new LiveBackend(), m_sharedCacheSize * 1024L * 1024L);
+                }
+
+                return backend ?? createLiveBackend();
+            }
+
+            if (string.IsNullOrEmpty(m_traceFile))
+            {
+                TraceManager.TraceWarning("The trace mode '{0}' requires the custom setting TraceFile. The repository is accessed directly", m_traceMode);
+                return createLiveBackend();
+            }
+
+            if (m_traceMode.Equals("Record", StringComparison.InvariantCultureIgnoreCase))
+            {
+                TraceManager.TraceInformation("Recording all subversion requests to '{0}'", m_traceFile);
+                return new RecordingBackend(createLiveBackend() ?? new LiveBackend(), m_traceFile);
+            }
+
+            if (m_traceMode.Equals("Replay", StringComparison.InvariantCultureIgnoreCase))
+            {
+                TraceManager.TraceInformation("Replaying all subversion requests from '{0}'", m_traceFile);
+
+                var backend = new ReplayBackend(m_traceFile);
+                backend.Latency = TimeSpan.FromMilliseconds(m_replayLatency);
+                backend.Bandwidth = m_replayBandwidth;
+                return backend;
+            }
+
+            TraceManager.TraceWarning("The trace mode '{0}' is not supported. Valid values are Record and Replay. The repository is accessed directly", m_traceMode);
+            return createLiveBackend();
+        }
+
         #endregion
 
         #region Private Helpers
 
+        /// <summary>
+        /// Creates a live backend if the number of listing connections or the bandwidth limit is configured
+        /// </summary>
+        /// <returns>The configured backend; null if the default backend can be used</returns>
+        private LiveBackend createLiveBackend()
+        {
+            if (m_listingConnections <= 0 && m_bandwidthLimit <= 0)
+            {
+                return null;
+            }
+
+            var backend = new LiveBackend();
+            if (m_listingConnections > 0)
+            {
+                backend.MaximumConnections = m_listingConnections;
+            }
+
+            if (m_bandwidthLimit > 0)
+            {
+                TraceManager.TraceInformation("Limiting the downloads to {0} KB per second", m_bandwidthLimit);
+                backend.Bandwidth = m_bandwidthLimit * 1024L;
+            }
+
+            return backend;
+        }
+
         private void InitializeCustomSettings()
         {
             m_userName = string.Empty;
             m_passowrd = string.Empty;
+            m_traceMode = string.Empty;
+            m_dumpFile = null;
+            m_dumpFileRoot = null;
+            m_listingCacheSize = -1;
+            m_changeSpillThreshold = -1;
+            m_pageChangeBudget = DefaultPageChangeBudget;
+            m_sharedCacheSize = 0;
+            m_prefetchSize = DefaultPrefetchSize;
+            m_prefetchConnections = DefaultPrefetchConnections;
+            m_listingConnections = 0;
+            m_bandwidthLimit = 0;
+            m_watchInterval = 0;
+            m_commitNotificationPipe = null;
+            m_commitBaseCacheSize = DefaultCommitBaseCacheSize;
+            m_useVersionedTree = false;
+            m_versionedTreeVerification = 0;
 
             foreach (var setting in m_configurationService.MigrationSource.CustomSettings.CustomSetting)
             {
@@ -171,6 +492,146 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
                         m_cacheSize = 50;
                     }
                 }
+                else if (setting.SettingKey.Equals("PageChangeBudget", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_pageChangeBudget) || m_pageChangeBudget < 0)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the page change budget. Defaulting to {0}", DefaultPageChangeBudget);
+                        m_pageChangeBudget = DefaultPageChangeBudget;
+                    }
+                }
+                else if (setting.SettingKey.Equals("TraceMode", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    m_traceMode = setting.SettingValue;
+                }
+                else if (setting.SettingKey.Equals("TraceFile", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    m_traceFile = setting.SettingValue;
+                }
+                else if (setting.SettingKey.Equals("ReplayLatency", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_replayLatency) || m_replayLatency < 0)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the replay latency. Defaulting to 0");
+                        m_replayLatency = 0;
+                    }
+                }
+                else if (setting.SettingKey.Equals("ReplayBandwidth", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_replayBandwidth) || m_replayBandwidth < 0)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the replay bandwidth. Defaulting to unlimited");
+                        m_replayBandwidth = 0;
+                    }
+                }
+                else if (setting.SettingKey.Equals("DumpFile", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    m_dumpFile = string.IsNullOrEmpty(setting.SettingValue) ? null : setting.SettingValue;
+                }
+                else if (setting.SettingKey.Equals("DumpFileRoot", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Uri.TryCreate(setting.SettingValue, UriKind.Absolute, out m_dumpFileRoot))
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the dump file root. Defaulting to the repository url");
+                        m_dumpFileRoot = null;
+                    }
+                }
+                else if (setting.SettingKey.Equals("CopyGraphDirectory", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    m_copyGraphDirectory = setting.SettingValue;
+                }
+                else if (setting.SettingKey.Equals("VersionedTree", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Boolean.TryParse(setting.SettingValue, out m_useVersionedTree))
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the versioned tree. Defaulting to false");
+                        m_useVersionedTree = false;
+                    }
+                }
+                else if (setting.SettingKey.Equals("VersionedTreeVerification", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_versionedTreeVerification) || m_versionedTreeVerification < 0)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the versioned tree verification. Defaulting to 0");
+                        m_versionedTreeVerification = 0;
+                    }
+                }
+                else if (setting.SettingKey.Equals("ListingConnections", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_listingConnections) || m_listingConnections <= 0)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the listing connections. Defaulting to the backend setting");
+                        m_listingConnections = 0;
+                    }
+                }
+                else if (setting.SettingKey.Equals("BandwidthLimit", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_bandwidthLimit) || m_bandwidthLimit < 0)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the bandwidth limit. Defaulting to unlimited");
+                        m_bandwidthLimit = 0;
+                    }
+                }
+                else if (setting.SettingKey.Equals("WatchInterval", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_watchInterval) || m_watchInterval < 0)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the watch interval. New revisions are detected by querying the history");
+                        m_watchInterval = 0;
+                    }
+                }
+                else if (setting.SettingKey.Equals("CommitNotificationPipe", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    m_commitNotificationPipe = string.IsNullOrEmpty(setting.SettingValue) ? null : setting.SettingValue;
+                }
+                else if (setting.SettingKey.Equals("CommitBaseCacheSize", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_commitBaseCacheSize) || m_commitBaseCacheSize < 0)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the commit base cache size. Defaulting to {0}", DefaultCommitBaseCacheSize);
+                        m_commitBaseCacheSize = DefaultCommitBaseCacheSize;
+                    }
+                }
+                else if (setting.SettingKey.Equals("ListingCacheSize", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_listingCacheSize) || m_listingCacheSize < 0)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the listing cache size. Defaulting to the client cache size");
+                        m_listingCacheSize = -1;
+                    }
+                }
+                else if (setting.SettingKey.Equals("ChangeSpillThreshold", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_changeSpillThreshold) || m_changeSpillThreshold < 0)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the change spill threshold. Defaulting to the client threshold");
+                        m_changeSpillThreshold = -1;
+                    }
+                }
+                else if (setting.SettingKey.Equals("PrefetchSize", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_prefetchSize) || m_prefetchSize < 0)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the prefetch size. Defaulting to {0}", DefaultPrefetchSize);
+                        m_prefetchSize = DefaultPrefetchSize;
+                    }
+                }
+                else if (setting.SettingKey.Equals("PrefetchConnections", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_prefetchConnections) || m_prefetchConnections <= 0)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the prefetch connections. Defaulting to {0}", DefaultPrefetchConnections);
+                        m_prefetchConnections = DefaultPrefetchConnections;
+                    }
+                }
+                else if (setting.SettingKey.Equals("SharedCacheSize", StringComparison.InvariantCultureIgnoreCase))
+                {
+                    if (!Int32.TryParse(setting.SettingValue, out m_sharedCacheSize) || m_sharedCacheSize < 0 || m_sharedCacheSize > 2047)
+                    {
+                        TraceManager.TraceWarning("Unable to parse the input string for the shared cache size. Valid values are 0 to 2047 megabytes. Defaulting to 0");
+                        m_sharedCacheSize = 0;
+                    }
+                }
             }
         }
 
@@ -35,11 +35,15 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
     {
         #region Private Members
 
+        //Copies of files that share the same source and destination roots are compared in a single diff if there are at least this many of them
+        private const int m_minimumContentChangeBatchSize = 4;
+
         private SubversionVCAnalysisProvider m_provider;
         private Dictionary<ChangeAction, SubversionAnalysisAlgorithm> m_subversionChangeTranslators = new Dictionary<ChangeAction, SubversionAnalysisAlgorithm>();
 
-        private Dictionary<string, Change> m_deleteLookupTable;
-        private Dictionary<string, string> m_renameLookupTable;
+        private PathTrie<Change> m_deleteLookupTable;
+        private PathTrie<string> m_renameLookupTable;
+        private Dictionary<string, bool> m_contentChangeLookupTable;
         private Repository m_currentRepository = null;
 
         internal ChangeSet CurrentChangeset
@@ -148,6 +152,7 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
             m_deleteLookupTable = null;
 
             m_renameLookupTable = null;
+            m_contentChangeLookupTable = null;
         }
 
         #endregion
@@ -209,6 +214,12 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
             //Subversion reports edit on folders as well if any property changed. Therfore we can skip this
             if (change.ItemType != WellKnownContentType.VersionControlledFolder)
             {
+                //The same applies to files whose properties changed only, e.g. the svn:mergeinfo updates of a merge. There is no content to migrate
+                if (change.ChangeAction == ChangeAction.Modify && !change.TextModified)
+                {
+                    return;
+                }
+
                 createMigrationAction(change, null, group, WellKnownChangeActionId.Edit);
             }
         }
@@ -265,8 +276,9 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         {
             if (null == m_deleteLookupTable)
             {
-                var deletes = changeSet.Changes.Where(x => x.ChangeAction == ChangeAction.Delete && m_provider.IsPathMapped(x.FullServerPath)).ToList();
-                m_deleteLookupTable = new Dictionary<string, Change>(deletes.Count);
+                var deletes = changeSet.GetChangeBatches().SelectMany(x => x).Where(x => x.ChangeAction == ChangeAction.Delete && m_provider.IsPathMapped(x.FullServerPath)).ToList();
+                //Deletes of paths that differ in case only are different deletes. Only the subtree removal ignores the case
+                m_deleteLookupTable = new PathTrie<Change>(StringComparer.Ordinal);
 
                 foreach (var delete in deletes)
                 {
@@ -361,39 +373,21 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         {
             //try to find the value within the mappedchanges array. This is the fastest way to get the value. If it is not 
             //in it then we have to query subversion for it
-            if (null != mappedChanges && mappedChanges.Length >= 0)
+            if (null != mappedChanges && mappedChanges.Length > 0)
             {
                 if (revision >= mappedChanges[0] && revision <= mappedChanges[mappedChanges.Length - 1])
                 {
                     //The value must be in the array because we are in the middle. Either we find it or it does not exists
-                    //furthermore we can start searching from the beginning because the array is ordered.
-                    int previous = -1;
-                    foreach (var value in mappedChanges)
-                    {
-                        if (value <= revision)
-                        {
-                            previous = value;
-                        }
-                        else
-                        {
-                            break;
-                        }
-                    }
-
-                    return previous;
+                    //The array is ordered. Therefore we can use a binary search. If the revision itself is not in the array
+                    //the complement of the result points to the next younger revision and we need the one before
+                    var index = Array.BinarySearch(mappedChanges, revision);
+                    return index >= 0 ? mappedChanges[index] : mappedChanges[~index - 1];
                 }
             }
 
-            //it must had been migrated earlier--> access the repository for it
-            var previousRecord = repositroy.QueryHistory(path, revision, 1, false).Keys;
-            if(previousRecord != null)
-            {
-                return previousRecord.First();
-            }
-            else
-            {
-                return -1;
-            }
+            //it must had been migrated earlier--> access the repository for it. The repository caches the history of the
+            //copy source so that branches from the same source do not cause additional log requests
+            return repositroy.GetLastChangedRevision(path, revision);
         }
 
         private void ProcessFolderBranch(Change change, ChangeGroup group)
@@ -407,7 +401,8 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
             //Subversion only pends one recursive branch action rather than a action for all files
             //Therefore we have to resolve this list manually
                 
-            var items = repository.GetItems(change.CopyFromFullServerPath, change.CopyFromRevision, true);
+            //Only the path and the kind of the items are needed. Therefore the server does not have to compute the other fields
+            var items = repository.EnumerateItems(change.CopyFromFullServerPath, change.CopyFromRevision, true, DirentFields.Kind);
 
             //pend an action for every single item
             //We do not have to handle the root folder individually since it is one item in the collection already
@@ -468,6 +463,15 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
                 return false;
             }
 
+            //Copies that are part of a larger branch or move have been compared in a single pass already
+            InitializeContentChangeLookupTable(CurrentChangeset);
+
+            bool hasContentChanges;
+            if (m_contentChangeLookupTable.TryGetValue(change.FullServerPath, out hasContentChanges))
+            {
+                return hasContentChanges;
+            }
+
             //check wether the file as an aditional edit. The method returns zero records if the files are equal; one record otherwise
             //Note, this method is a little bit ineffective. svn stores the md5 sums of the copy source and the copy destination
             //However, this information does not seem to be exported via the api and therefore we cant use it. Hopefully the diff summary calls
@@ -475,8 +479,98 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
             return CurrentRepository.GetDiffSumary(change.CopyFromFullServerPath, change.CopyFromRevision, change.FullServerPath, change.Changeset.Revision);
         }
 
+        private void InitializeContentChangeLookupTable(ChangeSet changeSet)
+        {
+            if (null != m_contentChangeLookupTable)
+            {
+                return;
+            }
+
+            m_contentChangeLookupTable = new Dictionary<string, bool>(StringComparer.Ordinal);
+
+            var copiedFiles = changeSet.GetChangeBatches().SelectMany(x => x).Where(x => x.ItemType == WellKnownContentType.VersionControlledFile &&
+                                                           x.ChangeAction == ChangeAction.Copy &&
+                                                           null != x.CopyFromFullServerPath &&
+                                                           m_provider.IsPathMapped(x.FullServerPath) &&
+                                                           m_provider.IsPathMapped(x.CopyFromFullServerPath));
+
+            //Only a folder copy of the same changeset bounds a recursive diff to the copied tree. Copies of files without such a folder are compared one by one
+            var copiedFolders = new Dictionary<string, Change>(StringComparer.Ordinal);
+            foreach (var folder in changeSet.GetChangeBatches().SelectMany(x => x).Where(x => x.ItemType == WellKnownContentType.VersionControlledFolder &&
+                                                                                          x.ChangeAction == ChangeAction.Copy &&
+                                                                                          null != x.CopyFromFullServerPath))
+            {
+                copiedFolders[folder.FullServerPath.TrimEnd(PathUtils.Separator)] = folder;
+            }
+
+            //A branch of a folder whose files are copied from other revisions results in many file copies below of the copied folder.
+            //Every such group is compared by one recursive diff instead of one diff per file
+            var groups = copiedFiles.Select(x => new { Change = x, Roots = getCopyRoots(x, copiedFolders) })
+                                    .Where(x => null != x.Roots)
+                                    .GroupBy(x => x.Roots, x => x.Change)
+                                    .Where(x => x.Count() >= m_minimumContentChangeBatchSize);
+            foreach (var group in groups)
+            {
+                var modifiedItems = CurrentRepository.GetModifiedItems(group.Key.Item1, group.Key.Item2, group.Key.Item3, changeSet.Revision);
+
+                foreach (var change in group)
+                {
+                    m_contentChangeLookupTable[change.FullServerPath] = modifiedItems.Contains(change.FullServerPath);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Finds the folder copy of the same changeset that contains the copy of a file. The file has to be copied from the same relative path below
+        /// of the source of the folder. E.g. trunk/src/a.txt@10 -> branches/b1/src/a.txt within the copy trunk@12 -> branches/b1 results in trunk@10 -> branches/b1
+        /// </summary>
+        /// <param name="change">The copy that is analyzed</param>
+        /// <param name="copiedFolders">The folder copies of the changeset by their destination</param>
+        /// <returns>The source root, the source revision and the destination root of the copy; null if the file is not copied as part of a folder copy</returns>
+        private static Tuple<string, int, string> getCopyRoots(Change change, Dictionary<string, Change> copiedFolders)
+        {
+            var source = change.CopyFromFullServerPath.TrimEnd(PathUtils.Separator);
+            var destination = change.FullServerPath.TrimEnd(PathUtils.Separator);
+            var relativePath = string.Empty;
+
+            while (true)
+            {
+                var destinationIndex = destination.LastIndexOf(PathUtils.Separator);
+                if (destinationIndex < 0)
+                {
+                    return null;
+                }
+
+                relativePath = destination.Substring(destinationIndex) + relativePath;
+                destination = destination.Substring(0, destinationIndex);
+
+                //The nearest folder copy determines where the file would have come from. A file from elsewhere is not part of its tree
+                Change folder;
+                if (copiedFolders.TryGetValue(destination, out folder))
+                {
+                    var sourceRoot = folder.CopyFromFullServerPath.TrimEnd(PathUtils.Separator);
+                    if (!string.Equals(sourceRoot + relativePath, source, StringComparison.Ordinal))
+                    {
+                        return null;
+                    }
+
+                    return Tuple.Create(sourceRoot, change.CopyFromRevision, destination);
+                }
+            }
+        }
+
         private void raiseBranchParentNotFoundConflictForBranch(ChangeGroup group, Change conflictChange)
         {
+            //The copy graph knows where the branch source comes from if it has been part of the analysis before. 
+            //This helps to understand why the parent could not be found
+            if (null != conflictChange.CopyFromFullServerPath)
+            {
+                foreach (var copy in m_provider.CopyGraph.GetAncestry(conflictChange.CopyFromFullServerPath, conflictChange.CopyFromRevision))
+                {
+                    TraceManager.TraceInformation("The branch source of {0} originates from {1}", conflictChange.FullServerPath, copy);
+                }
+            }
+
             MigrationConflict branchParentNotFoundConflict = VCBranchParentNotFoundConflictType.CreateConflict(conflictChange.Path);
             List<MigrationAction> retActions;
 
@@ -544,20 +638,9 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
 
         private void DropNotNeededDeleteActions(String path)
         {
-            var itemsToRemove = new List<string>();
-
-            foreach (var key in m_deleteLookupTable.Keys)
-            {
-                if (PathUtils.IsChildItem(path, key))
-                {
-                    itemsToRemove.Add(key);
-                }
-            }
-
-            foreach (var item in itemsToRemove)
-            {
-                m_deleteLookupTable.Remove(item);
-            }
+            //The path itself and all of its children are dropped. The trie only visits the affected subtree.
+            //The case of the paths is ignored just like PathUtils.IsChildItem does
+            m_deleteLookupTable.RemoveSubtree(path, StringComparer.OrdinalIgnoreCase);
         }
 
         #endregion
@@ -569,37 +652,32 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         /// E.g. rename fld1->fld2, rename fld1/1.txt->fld3/2.txt,
         /// If we already the pend rename for fld1->fld2, we need to revise the 2nd rename to fld2/1.txt->fld3/2.txt
         /// </summary>
-        /// <param name="root">The path string that defines the end of the recursion</param>
+        /// <param name="root">The path string where the revision of the path starts</param>
         /// <param name="item">The item that has to be revised</param>
         /// <returns>The revised path for the item</returns>
         private string reviseSourceName(string root, string item)
         {
+            var normalizedItem = item.TrimEnd(PathUtils.Separator);
+            var rootLength = root.TrimEnd(PathUtils.Separator).Length;
+
             //we start at the root level of the repository
-            if (string.Equals(root, item, StringComparison.OrdinalIgnoreCase))
-            {
-                //we reached the root. We can stop the recursion and traverse back up
-                return item;
-            }
-            else
-            {
-                var itemName = PathUtils.GetItemName(item);
-                var parent = PathUtils.GetParent(item);
+            var revisedPath = normalizedItem.Substring(0, rootLength);
+            var segments = normalizedItem.Substring(rootLength).Split(new[] { PathUtils.Separator }, StringSplitOptions.RemoveEmptyEntries);
 
-                //traverse down the tree until we reach the root. Then we can start reassembeling the path
-                var intermediate = reviseSourceName(root, parent);
-                var revisedPath = PathUtils.Combine(intermediate, itemName);
+            //walk down the tree and reassemble the path one level after the other
+            foreach (var segment in segments)
+            {
+                revisedPath = PathUtils.Combine(revisedPath, segment);
 
-                if (m_renameLookupTable.ContainsKey(revisedPath))
+                string renamedPath;
+                if (m_renameLookupTable.TryGetValue(revisedPath, out renamedPath))
                 {
-                    //The path has been renamed. we return the renamed path. This one will be used for reassembeling the renamed path
-                    return m_renameLookupTable[revisedPath];
-                }
-                else
-                {
-                    //The lookup table does not contain a record. Therefore we do not have to manipulate the path
-                    return revisedPath;
+                    //The path has been renamed. The renamed path is used for reassembeling the remaining levels
+                    revisedPath = renamedPath;
                 }
             }
+
+            return revisedPath;
         }
 
         private void InitializeRenameLookupTable(ChangeSet changeSet)
@@ -609,11 +687,11 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
                 return;
             }
 
-            m_renameLookupTable = new Dictionary<string, string>();
+            m_renameLookupTable = new PathTrie<string>();
 
             //we just have to analyze all folders that have been branched. 
             // Todo The source of the branch must be the previous revision because it cant be a rename otherwise
-            var branchedFolders = changeSet.Changes.Where(x => x.ItemType == WellKnownContentType.VersionControlledFolder &&
+            var branchedFolders = changeSet.GetChangeBatches().SelectMany(x => x).Where(x => x.ItemType == WellKnownContentType.VersionControlledFolder &&
                                                             x.ChangeAction == ChangeAction.Copy &&
                                                             //x.CopyFromRevision == changeSet.Revision - 1 &&
                                                             m_provider.IsPathMapped(x.FullServerPath));
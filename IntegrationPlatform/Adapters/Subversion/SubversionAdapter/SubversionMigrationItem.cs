@@ -200,7 +200,15 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         {
             if (!IsDirectory)
             {
-                Repository.DownloadFile(localPath, new Uri(m_itemUri), m_itemRevision);
+                //The content is usually staged by the prefetcher already. Otherwise it is requested now
+                Repository repository = Repository;
+                if (null != repository.Prefetcher && repository.Prefetcher.TryTake(this, localPath))
+                {
+                    return;
+                }
+
+                //A corrupt transfer fails here rather than being migrated silently
+                repository.DownloadVerifiedFile(localPath, new Uri(m_itemUri), m_itemRevision);
             }
             else
             {
@@ -0,0 +1,214 @@
+﻿// Copyright © Microsoft Corporation.  All Rights Reserved.
+// This code released under the terms of the 
+// Microsoft Public License (MS-PL, http://opensource.org/licenses/ms-pl.html.)
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using Microsoft.TeamFoundation.Migration.Toolkit;
+
+namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
+{
+    /// <summary>
+    /// Keeps the content of the files that have been committed by the migration. A later edit of such a file is sent to the server
+    /// as a difference to the cached content instead of its full text. The cache is bounded by a number of bytes and evicts the
+    /// files that have not been used for the longest time.
+    /// <para/>
+    /// A cached base is only valid as long as nobody else commits to the file. The server rejects a commit whose base does not match,
+    /// therefore the cache has to be cleared whenever a commit fails
+    /// </summary>
+    internal class CommitBaseCache : IDisposable
+    {
+        #region Private Types
+
+        private class Entry
+        {
+            internal string Path;
+            internal string LocalPath;
+            internal int Revision;
+            internal long Size;
+        }
+
+        #endregion
+
+        #region Private Members
+
+        private string m_directory;
+        private long m_capacity;
+        private long m_size;
+
+        //The entries by their repository path and in the order of their last use. The most recently used entry is the first one
+        private Dictionary<string, LinkedListNode<Entry>> m_entries;
+        private LinkedList<Entry> m_order;
+
+        #endregion
+
+        #region Constructor
+
+        /// <summary>
+        /// Creates a new cache
+        /// </summary>
+        /// <param name="directory">The directory that receives the cached files. It is created and deleted by the cache</param>
+        /// <param name="capacity">The number of bytes that may be cached at a time</param>
+        internal CommitBaseCache(string directory, long capacity)
+        {
+            if (string.IsNullOrEmpty(directory))
+            {
+                throw new ArgumentNullException("directory");
+            }
+
+            if (capacity <= 0)
+            {
+                throw new ArgumentOutOfRangeException("capacity");
+            }
+
+            m_directory = directory;
+            m_capacity = capacity;
+            m_entries = new Dictionary<string, LinkedListNode<Entry>>(StringComparer.Ordinal);
+            m_order = new LinkedList<Entry>();
+
+            Directory.CreateDirectory(m_directory);
+        }
+
+        #endregion
+
+        #region Internal Methods
+
+        /// <summary>
+        /// Looks up the committed content of a file
+        /// </summary>
+        /// <param name="path">The path of the file relative to the root of the repository</param>
+        /// <param name="localPath">The local file with the content</param>
+        /// <param name="revision">The revision in which the content has been committed</param>
+        /// <returns>true if the content is cached; false otherwise</returns>
+        internal bool TryGet(string path, out string localPath, out int revision)
+        {
+            LinkedListNode<Entry> node;
+            if (!m_entries.TryGetValue(path, out node))
+            {
+                localPath = null;
+                revision = -1;
+                return false;
+            }
+
+            m_order.Remove(node);
+            m_order.AddFirst(node);
+
+            localPath = node.Value.LocalPath;
+            revision = node.Value.Revision;
+            return true;
+        }
+
+        /// <summary>
+        /// Takes a local file as the committed content of a file. The cache owns the local file afterwards
+        /// </summary>
+        /// <param name="path">The path of the file relative to the root of the repository</param>
+        /// <param name="localPath">The local file with the content that has been committed</param>
+        /// <param name="revision">The revision in which the content has been committed</param>
+        internal void Add(string path, string localPath, int revision)
+        {
+            Remove(path);
+
+            var size = new FileInfo(localPath).Length;
+            if (size > m_capacity)
+            {
+                File.Delete(localPath);
+                return;
+            }
+
+            var entry = new Entry();
+            entry.Path = path;
+            entry.LocalPath = System.IO.Path.Combine(m_directory, System.IO.Path.GetRandomFileName());
+            entry.Revision = revision;
+            entry.Size = size;
+
+            File.Move(localPath, entry.LocalPath);
+            m_entries.Add(path, m_order.AddFirst(entry));
+            m_size += size;
+
+            while (m_size > m_capacity)
+            {
+                evict(m_order.Last);
+            }
+        }
+
+        /// <summary>
+        /// Forgets the content of a path and of all paths below it
+        /// </summary>
+        /// <param name="path">The path of the file or directory relative to the root of the repository</param>
+        internal void Remove(string path)
+        {
+            LinkedListNode<Entry> node;
+            if (m_entries.TryGetValue(path, out node))
+            {
+                evict(node);
+            }
+
+            var prefix = path + "/";
+            var children = new List<LinkedListNode<Entry>>();
+            foreach (var entry in m_entries)
+            {
+                if (entry.Key.StartsWith(prefix, StringComparison.Ordinal))
+                {
+                    children.Add(entry.Value);
+                }
+            }
+
+            foreach (var child in children)
+            {
+                evict(child);
+            }
+        }
+
+        /// <summary>
+        /// Forgets the content of all files
+        /// </summary>
+        internal void Clear()
+        {
+            while (null != m_order.Last)
+            {
+                evict(m_order.Last);
+            }
+        }
+
+        #endregion
+
+        #region Private Helpers
+
+        private void evict(LinkedListNode<Entry> node)
+        {
+            m_order.Remove(node);
+            m_entries.Remove(node.Value.Path);
+            m_size -= node.Value.Size;
+
+            try
+            {
+                File.Delete(node.Value.LocalPath);
+            }
+            catch (IOException e)
+            {
+                TraceManager.TraceWarning("Unable to delete the cached base '{0}': {1}", node.Value.LocalPath, e.Message);
+            }
+        }
+
+        #endregion
+
+        #region IDisposable implementation
+
+        public void Dispose()
+        {
+            Clear();
+
+            try
+            {
+                Directory.Delete(m_directory, true);
+            }
+            catch (IOException e)
+            {
+                TraceManager.TraceWarning("Unable to delete the commit base directory '{0}': {1}", m_directory, e.Message);
+            }
+        }
+
+        #endregion
+    }
+}
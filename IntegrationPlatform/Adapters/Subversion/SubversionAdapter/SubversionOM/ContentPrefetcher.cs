@@ -0,0 +1,403 @@
+﻿// Copyright © Microsoft Corporation.  All Rights Reserved.
+// This code released under the terms of the 
+// Microsoft Public License (MS-PL, http://opensource.org/licenses/ms-pl.html.)
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Threading;
+using Microsoft.TeamFoundation.Migration.Toolkit;
+
+namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
+{
+    /// <summary>
+    /// Downloads the content of migration items before the target system asks for it. The items are planned in the order in which
+    /// their actions will be migrated and are downloaded by several workers in parallel into a local staging directory. The staging
+    /// directory is bounded by a number of bytes. The workers pause while it is full and continue as soon as the migration takes the
+    /// staged content.
+    /// <para/>
+    /// The target system migrates the actions of a change group in an order of its own. Therefore staged content is only discarded
+    /// once the migration has moved on to a later change group.
+    /// <para/>
+    /// The prefetcher is an optimization only. An item that has not been staged (yet) or that could not be downloaded in advance
+    /// is downloaded on demand as before
+    /// </summary>
+    internal class ContentPrefetcher : IDisposable
+    {
+        #region Private Types
+
+        private enum EntryState
+        {
+            Planned,
+            Downloading,
+            Staged,
+            Discarded
+        }
+
+        private class Entry
+        {
+            internal long Sequence;
+            internal long Group;
+            internal string Key;
+            internal Uri ItemUri;
+            internal int Revision;
+            internal string StagedPath;
+            internal long Size;
+            internal EntryState State;
+        }
+
+        #endregion
+
+        #region Private Members
+
+        //The number of items that may be planned ahead. Planning runs ahead of the migration by whole revisions and must not grow without limit
+        private const int MaximumPlannedItems = 65536;
+
+        private Repository m_repository;
+        private string m_stagingDirectory;
+        private long m_capacity;
+
+        private object m_lock = new object();
+
+        //The planned items in the order of the migration and all items that have neither been taken nor discarded yet
+        private Queue<Entry> m_planned;
+        private Dictionary<string, Entry> m_entries;
+
+        //The staged items by their sequence number. Items of groups before the group of the last taken item have been skipped by the migration
+        private SortedDictionary<long, Entry> m_staged;
+        private long m_stagedBytes;
+
+        private long m_nextSequence;
+        private long m_takenGroup;
+
+        private List<Thread> m_workers;
+        private bool m_disposed;
+
+        #endregion
+
+        #region Constructor
+
+        /// <summary>
+        /// Creates a new prefetcher and starts its workers
+        /// </summary>
+        /// <param name="repository">The repository that is used to download the content</param>
+        /// <param name="stagingDirectory">The directory that receives the content. It is created and deleted by the prefetcher</param>
+        /// <param name="capacity">The number of bytes that may be staged at a time</param>
+        /// <param name="workers">The number of parallel downloads</param>
+        internal ContentPrefetcher(Repository repository, string stagingDirectory, long capacity, int workers)
+        {
+            if (null == repository)
+            {
+                throw new ArgumentNullException("repository");
+            }
+
+            if (string.IsNullOrEmpty(stagingDirectory))
+            {
+                throw new ArgumentNullException("stagingDirectory");
+            }
+
+            if (capacity <= 0)
+            {
+                throw new ArgumentOutOfRangeException("capacity");
+            }
+
+            if (workers <= 0)
+            {
+                throw new ArgumentOutOfRangeException("workers");
+            }
+
+            m_repository = repository;
+            m_stagingDirectory = stagingDirectory;
+            m_capacity = capacity;
+
+            m_planned = new Queue<Entry>();
+            m_entries = new Dictionary<string, Entry>(StringComparer.Ordinal);
+            m_staged = new SortedDictionary<long, Entry>();
+            m_takenGroup = long.MinValue;
+
+            Directory.CreateDirectory(m_stagingDirectory);
+
+            m_workers = new List<Thread>(workers);
+            for (int i = 0; i < workers; i++)
+            {
+                var worker = new Thread(download);
+                worker.IsBackground = true;
+                worker.Name = "Subversion content prefetch";
+                worker.Start();
+                m_workers.Add(worker);
+            }
+        }
+
+        #endregion
+
+        #region Methods
+
+        /// <summary>
+        /// Plans the download of the content of an item. Items have to be planned in the order in which they will be migrated
+        /// </summary>
+        /// <param name="item">The file whose content will be requested by the migration</param>
+        /// <param name="group">The execution order of the change group of the item. The groups have to be planned in ascending order</param>
+        internal void Enqueue(SubversionMigrationItem item, long group)
+        {
+            if (null == item)
+            {
+                throw new ArgumentNullException("item");
+            }
+
+            if (item.IsDirectory)
+            {
+                return;
+            }
+
+            lock (m_lock)
+            {
+                if (m_disposed || m_entries.ContainsKey(item.DisplayName))
+                {
+                    return;
+                }
+
+                //An item that does not fit into the plan is downloaded on demand. The queue also holds items that have been taken
+                //before a worker reached them
+                if (m_entries.Count >= MaximumPlannedItems || m_planned.Count >= MaximumPlannedItems)
+                {
+                    return;
+                }
+
+                var entry = new Entry();
+                entry.Sequence = m_nextSequence++;
+                entry.Group = group;
+                entry.Key = item.DisplayName;
+                entry.ItemUri = new Uri(item.ItemUri);
+                entry.Revision = item.Revision;
+                entry.State = EntryState.Planned;
+
+                m_entries.Add(entry.Key, entry);
+                m_planned.Enqueue(entry);
+
+                Monitor.PulseAll(m_lock);
+            }
+        }
+
+        /// <summary>
+        /// Moves the staged content of an item to the path that has been requested by the migration. Waits for the item if it is being downloaded
+        /// </summary>
+        /// <param name="item">The item whose content is requested</param>
+        /// <param name="localPath">The local file path where the content has to be stored</param>
+        /// <returns>true if the content has been stored; false if the item has to be downloaded on demand</returns>
+        internal bool TryTake(SubversionMigrationItem item, string localPath)
+        {
+            if (null == item)
+            {
+                throw new ArgumentNullException("item");
+            }
+
+            Entry entry;
+
+            lock (m_lock)
+            {
+                if (!m_entries.TryGetValue(item.DisplayName, out entry))
+                {
+                    return false;
+                }
+
+                //A second download of the same item would take as long as waiting for the first one
+                while (EntryState.Downloading == entry.State)
+                {
+                    Monitor.Wait(m_lock);
+                }
+
+                m_entries.Remove(entry.Key);
+                m_takenGroup = Math.Max(m_takenGroup, entry.Group);
+
+                //The migration does not request the items of the earlier groups anymore. Their space is needed for the upcoming items.
+                //The items of the same group are kept because the target migrates them in an order of its own
+                while (m_staged.Count > 0)
+                {
+                    Entry skipped = null;
+                    foreach (Entry staged in m_staged.Values)
+                    {
+                        skipped = staged;
+                        break;
+                    }
+
+                    if (skipped.Group >= m_takenGroup)
+                    {
+                        break;
+                    }
+
+                    unstage(skipped);
+                    forget(skipped);
+                    deleteFile(skipped.StagedPath);
+                }
+
+                if (EntryState.Staged != entry.State)
+                {
+                    //A planned item is skipped by the workers as soon as it has been taken
+                    entry.State = EntryState.Discarded;
+                    return false;
+                }
+
+                unstage(entry);
+            }
+
+            try
+            {
+                Repository.PrepareDownload(localPath);
+                if (File.Exists(localPath))
+                {
+                    File.Delete(localPath);
+                }
+
+                File.Move(entry.StagedPath, localPath);
+                return true;
+            }
+            catch (IOException e)
+            {
+                TraceManager.TraceWarning("The prefetched content of {0} could not be moved to '{1}': {2}", entry.Key, localPath, e.Message);
+                deleteFile(entry.StagedPath);
+                return false;
+            }
+        }
+
+        public void Dispose()
+        {
+            lock (m_lock)
+            {
+                if (m_disposed)
+                {
+                    return;
+                }
+
+                m_disposed = true;
+                Monitor.PulseAll(m_lock);
+            }
+
+            foreach (Thread worker in m_workers)
+            {
+                worker.Join();
+            }
+
+            try
+            {
+                Directory.Delete(m_stagingDirectory, true);
+            }
+            catch (IOException e)
+            {
+                TraceManager.TraceWarning("The prefetch directory '{0}' could not be deleted: {1}", m_stagingDirectory, e.Message);
+            }
+        }
+
+        #endregion
+
+        #region Private Methods
+
+        /// <summary>
+        /// The loop of a worker. Downloads the next planned item as long as the staging directory has room for it
+        /// </summary>
+        private void download()
+        {
+            while (true)
+            {
+                Entry entry;
+
+                lock (m_lock)
+                {
+                    while (!m_disposed && (0 == m_planned.Count || m_stagedBytes >= m_capacity))
+                    {
+                        Monitor.Wait(m_lock);
+                    }
+
+                    if (m_disposed)
+                    {
+                        return;
+                    }
+
+                    entry = m_planned.Dequeue();
+                    if (EntryState.Planned != entry.State || entry.Group < m_takenGroup)
+                    {
+                        forget(entry);
+                        continue;
+                    }
+
+                    entry.State = EntryState.Downloading;
+                }
+
+                string stagedPath = Path.Combine(m_stagingDirectory, entry.Sequence.ToString(CultureInfo.InvariantCulture));
+                bool downloaded = false;
+                try
+                {
+                    m_repository.DownloadVerifiedFile(stagedPath, entry.ItemUri, entry.Revision);
+                    downloaded = true;
+                }
+                catch (Exception e)
+                {
+                    //The migration downloads the item on demand and reports the failure if it persists
+                    TraceManager.TraceWarning("Unable to prefetch the content of {0}: {1}", entry.Key, e.Message);
+                }
+
+                lock (m_lock)
+                {
+                    if (downloaded && !m_disposed)
+                    {
+                        entry.StagedPath = stagedPath;
+                        entry.Size = new FileInfo(stagedPath).Length;
+                        entry.State = EntryState.Staged;
+
+                        m_staged.Add(entry.Sequence, entry);
+                        m_stagedBytes += entry.Size;
+                    }
+                    else
+                    {
+                        entry.State = EntryState.Discarded;
+                        forget(entry);
+                        deleteFile(stagedPath);
+                    }
+
+                    Monitor.PulseAll(m_lock);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Removes an item from the staged items and releases its space
+        /// </summary>
+        private void unstage(Entry entry)
+        {
+            m_staged.Remove(entry.Sequence);
+            m_stagedBytes -= entry.Size;
+            entry.State = EntryState.Discarded;
+
+            Monitor.PulseAll(m_lock);
+        }
+
+        /// <summary>
+        /// Removes an item from the lookup unless the item has been planned again in the meantime
+        /// </summary>
+        private void forget(Entry entry)
+        {
+            Entry current;
+            if (m_entries.TryGetValue(entry.Key, out current) && current == entry)
+            {
+                m_entries.Remove(entry.Key);
+            }
+        }
+
+        private static void deleteFile(string path)
+        {
+            try
+            {
+                if (File.Exists(path))
+                {
+                    File.Delete(path);
+                }
+            }
+            catch (IOException)
+            {
+                //The file is removed with the staging directory
+            }
+        }
+
+        #endregion
+    }
+}
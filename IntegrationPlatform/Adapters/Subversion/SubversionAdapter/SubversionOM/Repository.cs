@@ -9,6 +9,7 @@ using System.Diagnostics;
 using System.Collections.Generic;
 using System.Collections.ObjectModel;
 using Microsoft.TeamFoundation.Migration.SubversionAdapter.Interop.Subversion;
+using Microsoft.TeamFoundation.Migration.SubversionAdapter.Interop.Subversion.Backends;
 using Microsoft.TeamFoundation.Migration.SubversionAdapter.Interop.Subversion.ObjectModel;
 using Microsoft.TeamFoundation.Migration.Toolkit;
 using System.IO;
@@ -24,8 +25,11 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
 
         private NetworkCredential m_credential;
         
+        private IRepositoryBackend m_backend;
         private SubversionClient m_client;
 
+        private ContentPrefetcher m_prefetcher;
+
         #endregion
 
         #region Private Static Members
@@ -95,6 +99,18 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
         /// <param name="userName">The user to connect to the repository</param>
         /// <param name="password">The password to connect to the repository</param>
         public static Repository GetRepository(Uri uri, string userName, string password)
+        {
+            return GetRepository(uri, userName, password, null);
+        }
+
+        /// <summary>
+        /// Factory method to create a new instance of repository object
+        /// </summary>
+        /// <param name="uri">The URI of the repository</param>
+        /// <param name="userName">The user to connect to the repository</param>
+        /// <param name="password">The password to connect to the repository</param>
+        /// <param name="backend">The backend that serves the repository requests; null to access the repository directly</param>
+        public static Repository GetRepository(Uri uri, string userName, string password, IRepositoryBackend backend)
         {
             if (s_repositories.ContainsKey(uri))
             {
@@ -102,6 +118,7 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
             }
 
             var repo = new Repository(uri, userName, password);
+            repo.m_backend = backend;
 
             // User RepositoryRoot to verify the connection to SVN repository.
             if (repo.RepositoryRoot != null)
@@ -142,6 +159,42 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
             }
         }
 
+        /// <summary>
+        /// Gets or sets the local tree that answers the listings of known revisions; null if every listing is requested from the server
+        /// </summary>
+        public VersionedTree VersionedTree
+        {
+            get
+            {
+                return m_client.Tree;
+            }
+            set
+            {
+                m_client.Tree = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the prefetcher that downloads the content of the upcoming migration items in advance; null if every item is downloaded on demand.
+        /// A prefetcher that is replaced is disposed
+        /// </summary>
+        internal ContentPrefetcher Prefetcher
+        {
+            get
+            {
+                return m_prefetcher;
+            }
+            set
+            {
+                if (null != m_prefetcher && value != m_prefetcher)
+                {
+                    m_prefetcher.Dispose();
+                }
+
+                m_prefetcher = value;
+            }
+        }
+
         #endregion
 
         #region public Methods
@@ -153,6 +206,40 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
         /// <param name="svnUriTarget">The fully qualified path to the file in the repository</param>
         /// <param name="revision">The revision that has to be downloaded</param>
         public void DownloadFile(string localPath, Uri svnUriTarget, int revision)
+        {
+            PrepareDownload(localPath);
+            m_client.DownloadItem(svnUriTarget, revision, localPath);
+        }
+
+        /// <summary>
+        /// Downloads a file from the SVN repository and computes its hashes while it is written. 
+        /// The content is verified against the checksum of the repository during the transfer
+        /// </summary>
+        /// <param name="localPath">The local file path where the file has to be stored</param>
+        /// <param name="svnUriTarget">The fully qualified path to the file in the repository</param>
+        /// <param name="revision">The revision that has to be downloaded</param>
+        /// <returns>The MD5 and SHA-1 hashes of the local file</returns>
+        public ContentDigest DownloadVerifiedFile(string localPath, Uri svnUriTarget, int revision)
+        {
+            PrepareDownload(localPath);
+            return m_client.DownloadVerifiedItem(svnUriTarget, revision, localPath);
+        }
+
+        /// <summary>
+        /// Writes the content of a folder at a specific revision to a local directory. The whole tree is transferred by a single request
+        /// </summary>
+        /// <param name="localRoot">The local directory that receives the content of the folder</param>
+        /// <param name="svnUriRoot">The fully qualified path to the folder in the repository</param>
+        /// <param name="revision">The revision that has to be exported</param>
+        /// <param name="filter">The filter that decides which items are written; null to write all items</param>
+        /// <returns>The directories and files that have been written</returns>
+        public List<Item> ExportTree(string localRoot, Uri svnUriRoot, int revision, PathFilter filter)
+        {
+            EnsureAuthenticated();
+            return m_client.ExportTree(svnUriRoot, revision, localRoot, filter);
+        }
+
+        internal static void PrepareDownload(string localPath)
         {
             //ensure that the destination directory already exists
             var file = new FileInfo(localPath);
@@ -166,7 +253,6 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
             {
                 file.IsReadOnly = false;
             }
-            m_client.DownloadItem(svnUriTarget, revision, localPath);
         }
 
         /// <summary>
@@ -179,6 +265,40 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
             return m_client.GetLatestRevisionNumber(m_uri);
         }
 
+        /// <summary>
+        /// Creates a watcher that detects new revisions of the repository on a session of its own. The watcher has to be started by the caller
+        /// </summary>
+        /// <param name="pipeName">The name of the local pipe on which a post-commit hook announces new revisions; null to poll only</param>
+        /// <returns>The watcher of the repository</returns>
+        public RepositoryWatcher CreateWatcher(string pipeName)
+        {
+            EnsureAuthenticated();
+            return m_client.CreateWatcher(m_credential, pipeName);
+        }
+
+        /// <summary>
+        /// Commits the items as a single revision
+        /// </summary>
+        /// <param name="items">The changes of the revision. The paths are relative to the root of the repository</param>
+        /// <param name="comment">The log message of the revision</param>
+        /// <returns>The number of the new revision</returns>
+        public int Commit(IEnumerable<CommitItem> items, string comment)
+        {
+            EnsureAuthenticated();
+            return m_client.Commit(items, comment);
+        }
+
+        /// <summary>
+        /// Converts a fully qualified path to the path relative to the actual root of the repository as it is expected by <see cref="Commit"/>
+        /// </summary>
+        /// <param name="path">The fully qualified path of an item in the repository</param>
+        /// <returns>The unescaped path without leading or trailing separators; an empty string for the root itself</returns>
+        public string GetRelativePath(Uri path)
+        {
+            EnsureAuthenticated();
+            return Uri.UnescapeDataString(PathUtils.ExtractPath(m_client.RepositoryRoot, path).OriginalString).Trim('/');
+        }
+
         public Dictionary<int, ChangeSet> QueryHistory(Uri path, int startRevision, int limit, bool includeChanges)
         {
             EnsureAuthenticated();
@@ -191,6 +311,93 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
             return m_client.QueryHistoryRange(path, startRevision, endRevision, includeChanges);
         }
 
+        public Dictionary<int, ChangeSet> QueryHistoryRange(Uri path, int startRevision, int endRevision, bool includeChanges, PathFilter pathFilter)
+        {
+            EnsureAuthenticated();
+            return m_client.QueryHistoryRange(path, startRevision, endRevision, includeChanges, pathFilter);
+        }
+
+        public Dictionary<int, ChangeSet> QueryHistoryRange(Uri path, int startRevision, int endRevision, bool includeChanges, PathFilter pathFilter, RevisionFilter revisionFilter)
+        {
+            EnsureAuthenticated();
+            return m_client.QueryHistoryRange(path, startRevision, endRevision, includeChanges, pathFilter, revisionFilter);
+        }
+
+        /// <summary>
+        /// Compiles the mapped and cloaked paths into a filter that can be passed to the history queries
+        /// </summary>
+        /// <param name="mappedPaths">The fully qualified paths that are mapped</param>
+        /// <param name="cloakedPaths">The fully qualified paths that are cloaked</param>
+        public PathFilter CreatePathFilter(IEnumerable<Uri> mappedPaths, IEnumerable<Uri> cloakedPaths)
+        {
+            EnsureAuthenticated();
+            return m_client.CreatePathFilter(mappedPaths, cloakedPaths);
+        }
+
+        /// <summary>
+        /// Queries the last revision in which an item has been changed. The history of the item is cached per location segment
+        /// so that subsequent requests for the same item do not require a log request
+        /// </summary>
+        /// <param name="path">The path of the item</param>
+        /// <param name="revision">The revision in which the item is identified by the path</param>
+        /// <returns>The youngest revision that is older or equal to the revision in which the item has been changed; -1 if the item does not exist</returns>
+        public int GetLastChangedRevision(Uri path, int revision)
+        {
+            EnsureAuthenticated();
+            return m_client.GetLastChangedRevision(path, revision);
+        }
+
+        /// <summary>
+        /// Gets or sets the estimated number of bytes that the client may use to cache directory listings. 0 disables the cache
+        /// </summary>
+        public long ListingCacheCapacity
+        {
+            get
+            {
+                return m_client.ListingCacheCapacity;
+            }
+            set
+            {
+                m_client.ListingCacheCapacity = value;
+            }
+        }
+
+        /// <summary>
+        /// Gets or sets the number of changed paths of a single revision that the client keeps in memory. The remaining paths are written to a temporary file. 0 keeps all paths in memory
+        /// </summary>
+        public int ChangeSpillThreshold
+        {
+            get
+            {
+                return m_client.ChangeSpillThreshold;
+            }
+            set
+            {
+                m_client.ChangeSpillThreshold = value;
+            }
+        }
+
+        /// <summary>
+        /// Creates a local tree of the repository root that is seeded by one recursive listing
+        /// </summary>
+        /// <param name="revision">The revision of the initial listing</param>
+        /// <param name="filter">The filter that defines the paths whose changes are added to the tree; null if all changes are added</param>
+        public VersionedTree CreateVersionedTree(int revision, PathFilter filter)
+        {
+            EnsureAuthenticated();
+            return m_client.CreateVersionedTree(m_client.VirtualRepositoryRoot, revision, filter);
+        }
+
+        /// <summary>
+        /// Creates the copy graph of this repository. A graph that has been persisted earlier for this repository is loaded
+        /// </summary>
+        /// <param name="directory">The directory in which the graph is persisted; null to keep the graph in memory only</param>
+        public CopyGraph CreateCopyGraph(string directory)
+        {
+            EnsureAuthenticated();
+            return m_client.CreateCopyGraph(directory);
+        }
+
         /*/// <summary>
         /// Queries a range <see cref="LogRecord"/> objects from subversion. 
         /// </summary>
@@ -277,7 +484,7 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
             if (null == m_client)
             {
                 //Create a new instance of the svn client
-                m_client = new SubversionClient();
+                m_client = null == m_backend ? new SubversionClient() : new SubversionClient(m_backend);
                 m_client.Connect(m_uri, m_credential);
             }
         }
@@ -330,6 +537,26 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
             }
         }
 
+        /// <summary>
+        /// Traverses the subfiles and folders of a given base directory. The items are streamed while the listing is still in progress
+        /// </summary>
+        /// <param name="path">The base path of the directory to list all the subfiles and subfolders</param>
+        /// <param name="revision">The revision that has to be traversed</param>
+        /// <param name="recurse">Determines whether all descendants or only the immediate children are listed</param>
+        /// <param name="fields">The fields that the server has to compute for every item. The kind and the path are always available</param>
+        /// <returns>A sequence that can be enumerated once</returns>
+        public IEnumerable<Item> EnumerateItems(string path, int revision, bool recurse, DirentFields fields)
+        {
+            if (string.IsNullOrEmpty(path))
+            {
+                throw new ArgumentNullException("path");
+            }
+
+            EnsureAuthenticated();
+
+            return m_client.EnumerateItems(new Uri(path), revision, recurse ? Depth.Infinity : Depth.Immediates, fields);
+        }
+
         /// <summary>
         /// Retrieves a summary of the differences between two files or folders at a given revision
         /// </summary>
@@ -344,12 +571,29 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM
             return m_client.HasContentChange(new Uri(path1), revision1, new Uri(path2), revision2);           
         }
 
+        /// <summary>
+        /// Compares two folders recursively in a single server request and returns all items that differ
+        /// </summary>
+        /// <param name="path1">The reference folder for calculating the differences</param>
+        /// <param name="revision1">The revision of the reference folder</param>
+        /// <param name="path2">The folder which is compared to the reference folder</param>
+        /// <param name="revision2">The revision of the second folder</param>
+        /// <returns>The full server paths below of <paramref name="path2"/> of all added, modified or deleted items</returns>
+        internal HashSet<string> GetModifiedItems(string path1, int revision1, string path2, int revision2)
+        {
+            EnsureAuthenticated();
+            return new HashSet<string>(m_client.GetModifiedItems(new Uri(path1), revision1, new Uri(path2), revision2), StringComparer.Ordinal);
+        }
+
         #endregion
 
         #region IDisposable
 
         public void Dispose()
         {
+            //The workers of the prefetcher use the client. They have to be stopped first
+            Prefetcher = null;
+
             if (null != m_client)
             {
                 m_client.Dispose();
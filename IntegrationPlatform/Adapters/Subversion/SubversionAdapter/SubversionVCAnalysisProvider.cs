@@ -14,6 +14,7 @@ using Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM;
 using Microsoft.TeamFoundation.Migration.SubversionAdapter.Interop.Subversion;
 using System.Globalization;
 using System.Diagnostics;
+using System.IO;
 
 namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
 {
@@ -41,6 +42,10 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         private SubversionAnalysisAlgorithms m_algorithm;
 
         private Repository m_repository;
+        private PathFilter m_pathFilter;
+        private CopyGraph m_copyGraph;
+        private VersionedTree m_versionedTree;
+        private RepositoryWatcher m_watcher;
 
         #endregion
 
@@ -176,30 +181,45 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
                 return;
             }
 
-            var pager = new ChangeSetPageManager(m_repository, mappedChangesets, m_configurationManager.ChangesetCacheSize);
-
-            do
+            if (m_configurationManager.UseVersionedTree)
             {
-                TraceManager.TraceInformation("Analyzing Subversion revision {0} : {1}/{2}", pager.CurrentRevision, pager.CurrentIndex + 1, mappedChangesets.Length);
+                initializeVersionedTree(mappedChangesets[0] - 1);
+            }
 
-                ChangeSet changeSet = pager.Current;
-                if (null != changeSet)
-                {
-                    int actions = analyzeChangeset(changeSet, mappedChangesets);
-                    TraceManager.TraceInformation("Created {0} actions for subversion revision {1}", actions, pager.CurrentRevision);
-                }
-                else
+            //The history of the next revisions is fetched and prepared while the current revision is analyzed. The changesets are still
+            //delivered in the order of the revisions. Therefore the high water mark never passes a revision that has not been analyzed
+            using (var pipeline = new ChangeSetPipeline(m_repository, mappedChangesets, m_configurationManager.ChangesetCacheSize, m_configurationManager.PageChangeBudget, PathFilter))
+            {
+                int index = 0;
+                foreach (KeyValuePair<int, ChangeSet> entry in pipeline.GetChangeSets())
                 {
-                    //TODO Maybe add a conflict here so that the user can decide what to do. This condition should not occur though
-                    TraceManager.TraceWarning("Unable to retrieve the change details for revision {0}", pager.CurrentRevision);
-                }
+                    int revision = entry.Key;
+                    TraceManager.TraceInformation("Analyzing Subversion revision {0} : {1}/{2}", revision, ++index, mappedChangesets.Length);
+
+                    ChangeSet changeSet = entry.Value;
+                    if (null != changeSet)
+                    {
+                        int actions = analyzeChangeset(changeSet, mappedChangesets);
+                        TraceManager.TraceInformation("Created {0} actions for subversion revision {1}", actions, revision);
+                    }
+                    else
+                    {
+                        //TODO Maybe add a conflict here so that the user can decide what to do. This condition should not occur though
+                        TraceManager.TraceWarning("Unable to retrieve the change details for revision {0}", revision);
 
-                m_hwmDelta.Update(pager.CurrentRevision);
-                m_changeGroupService.PromoteDeltaToPending();
+                        //The versioned tree would miss the changes of this revision
+                        if (null != m_versionedTree)
+                        {
+                            m_versionedTree.Invalidate();
+                        }
+                    }
+
+                    m_hwmDelta.Update(revision);
+                    m_changeGroupService.PromoteDeltaToPending();
+                }
             }
-            while (pager.MoveNext());
 
-            pager.Reset();
+            CopyGraph.Save();
         }
 
         /// <summary>
@@ -254,12 +274,75 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
             }
         }
 
+        /// <summary>
+        /// Gets the compiled filter of the mapped and cloaked server paths
+        /// </summary>
+        internal PathFilter PathFilter
+        {
+            get
+            {
+                if (null == m_pathFilter)
+                {
+                    m_pathFilter = m_repository.CreatePathFilter(m_configurationManager.MappedServerPaths, m_configurationManager.CloakedServerPaths);
+                }
+
+                return m_pathFilter;
+            }
+        }
+
+        /// <summary>
+        /// Gets the index of all copy operations that have been analyzed so far
+        /// </summary>
+        internal CopyGraph CopyGraph
+        {
+            get
+            {
+                if (null == m_copyGraph)
+                {
+                    m_copyGraph = m_repository.CreateCopyGraph(m_configurationManager.CopyGraphDirectory);
+                }
+
+                return m_copyGraph;
+            }
+        }
+
         #endregion
 
         #region IDisposable
 
         public void Dispose()
         {
+            //The watcher polls on a session of its own. It is stopped before the repository is released
+            if (null != m_watcher)
+            {
+                m_watcher.RevisionsAvailable -= onRevisionsAvailable;
+                m_watcher.Dispose();
+                m_watcher = null;
+            }
+
+            if (null != m_pathFilter)
+            {
+                m_pathFilter.Dispose();
+                m_pathFilter = null;
+            }
+
+            if (null != m_copyGraph)
+            {
+                m_copyGraph.Dispose();
+                m_copyGraph = null;
+            }
+
+            if (null != m_versionedTree)
+            {
+                if (null != m_repository)
+                {
+                    m_repository.VersionedTree = null;
+                }
+
+                m_versionedTree.Dispose();
+                m_versionedTree = null;
+            }
+
             if (null != m_repository)
             {
                 m_repository.Dispose();
@@ -271,12 +354,42 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
 
         #region Private Helpers
 
+        /// <summary>
+        /// Seeds the versioned tree that answers the listings of the analyzed revisions. An existing tree is kept as long as it is in sync
+        /// </summary>
+        /// <param name="revision">The revision before the first revision that is analyzed</param>
+        private void initializeVersionedTree(int revision)
+        {
+            if (null != m_versionedTree && m_versionedTree.IsValid && m_versionedTree.Revision <= revision)
+            {
+                return;
+            }
+
+            //The changes below of cloaked paths are not analyzed. A listing of a mapped parent would contain outdated items
+            if (m_configurationManager.CloakedServerPaths.Any())
+            {
+                TraceManager.TraceWarning("The versioned tree is not supported for mappings with cloaked paths. All listings are requested from the server");
+                return;
+            }
+
+            if (null != m_versionedTree)
+            {
+                m_repository.VersionedTree = null;
+                m_versionedTree.Dispose();
+            }
+
+            m_versionedTree = m_repository.CreateVersionedTree(revision, PathFilter);
+            m_versionedTree.VerificationInterval = m_configurationManager.VersionedTreeVerification;
+            m_repository.VersionedTree = m_versionedTree;
+        }
+
         private int[] getMappedSubversionChanges()
         {
             m_hwmDelta.Reload();
             Debug.Assert(m_hwmDelta.Value >= 0, "High water mark of delta table must be non-negtive");
 
-            int latestChangeset = m_repository.GetLatestRevisionNumber();
+            //The watcher knows the latest revision already. An idle round trip does not contact the server at all
+            int latestChangeset = null != m_watcher ? m_watcher.LatestRevision : m_repository.GetLatestRevisionNumber();
             if (m_hwmDelta.Value >= latestChangeset)
             {
                 // No new changesets on server, return.
@@ -288,34 +401,33 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
 
             var lookup = new HashSet<int>();
 
-            foreach (var mappedPath in m_configurationManager.MappedServerPaths)
+            //The skip comment is evaluated in the native log receiver. Revisions that contain it, e.g. the mirrored changes created 
+            //by the migration tool itself, are never materialized and only counted by the filter
+            using (var revisionFilter = new RevisionFilter())
             {
-                var records = m_repository.QueryHistoryRange(mappedPath, startingChangeset, latestChangeset, false);
+                revisionFilter.SkipComment = skipComment;
 
-                // Todo: Skip mirrored changes created by migration tool itself
-
-                //Iterate across all records and filter out those records that are already in the list
-                foreach (var record in records.Values)
+                foreach (var mappedPath in m_configurationManager.MappedServerPaths)
                 {
-                    //check wether we alredy have this record. If this is the case, we can simply continue with the next record
-                    if (lookup.Contains(record.Revision))
-                    {
-                        continue;
-                    }
+                    var records = m_repository.QueryHistoryRange(mappedPath, startingChangeset, latestChangeset, false, null, revisionFilter);
 
-                    //The skip comment is empty. Therefore we can skip the evaluation of the skip comment
-                    if (!string.IsNullOrEmpty(skipComment))
+                    //Iterate across all records and filter out those records that are already in the list
+                    foreach (var record in records.Values)
                     {
-                        if (record.Comment != null && record.Comment.Contains(skipComment))
+                        //check wether we alredy have this record. If this is the case, we can simply continue with the next record
+                        if (lookup.Contains(record.Revision))
                         {
-                            //The record has the skip commnet. Just print an information and resume with the next one
-                            TraceManager.TraceInformation("LogRecord {0} contains the skip comment {1}", record.Revision, skipComment);
                             continue;
                         }
+
+                        //Add the record to the hashmap. We alredy verified that this is the first record
+                        lookup.Add(record.Revision);
                     }
+                }
 
-                    //Add the record to the hashmap. We alredy verified that this is the first record
-                    lookup.Add(record.Revision);
+                if (revisionFilter.SkippedRevisions > 0)
+                {
+                    TraceManager.TraceInformation("Skipped {0} log records that contain the skip comment {1}", revisionFilter.SkippedRevisions, skipComment);
                 }
             }
 
@@ -355,19 +467,33 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
             if (changeSet != null)
             {
                 m_algorithm.CurrentChangeset = changeSet;
-                foreach (Change change in changeSet.Changes)
+
+                //The listings of this revision are answered by the tree. Therefore it has to be updated before the changes are analyzed
+                if (null != m_versionedTree)
                 {
-                    // Either no snapshot start point is specified or we already passed the snapshot start point.
-                    if (IsPathMapped(change.FullServerPath))
-                    {
-                        m_algorithm.Execute(change, group);
-                    }
-                    else
+                    m_versionedTree.Add(changeSet);
+                }
+
+                //The changes are materialized batch by batch. A revision with a huge number of changed paths is never held in memory as a whole
+                foreach (ChangeBatch batch in changeSet.GetChangeBatches())
+                {
+                    foreach (Change change in batch)
                     {
-                        m_algorithm.ExecuteNonMapped(change, group, mappedChanges);
+                        // Either no snapshot start point is specified or we already passed the snapshot start point.
+                        if (IsPathMapped(change.FullServerPath))
+                        {
+                            m_algorithm.Execute(change, group);
+                        }
+                        else
+                        {
+                            m_algorithm.ExecuteNonMapped(change, group, mappedChanges);
+                        }
                     }
                 }
                 m_algorithm.Finish(group);
+
+                //The copies of this changeset are the ancestry of the subsequent changesets
+                CopyGraph.Add(changeSet);
             }
 
             changeCount = group.Actions.Count;
@@ -375,6 +501,7 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
             if (group.Actions.Count > 0)
             {
                 group.Save();
+                prefetchContent(group);
             }
 
             if (changeCount == 0)
@@ -384,6 +511,35 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
             return changeCount;
         }
 
+        /// <summary>
+        /// Plans the download of the files whose content will be requested when the actions of the group are migrated. The groups are
+        /// saved in the order of the revisions, which is the order in which they will be migrated
+        /// </summary>
+        /// <param name="group">The group that has just been saved</param>
+        private void prefetchContent(ChangeGroup group)
+        {
+            ContentPrefetcher prefetcher = m_repository.Prefetcher;
+            if (null == prefetcher)
+            {
+                return;
+            }
+
+            foreach (IMigrationAction action in group.Actions)
+            {
+                var item = action.SourceItem as SubversionMigrationItem;
+                if (null == item || item.IsDirectory)
+                {
+                    continue;
+                }
+
+                if (action.Action == WellKnownChangeActionId.Add || action.Action == WellKnownChangeActionId.Edit ||
+                    action.Action == WellKnownChangeActionId.Branch || action.Action == WellKnownChangeActionId.BranchMerge)
+                {
+                    prefetcher.Enqueue(item, group.ExecutionOrder);
+                }
+            }
+        }
+
         /// <summary>
         /// Populates the changegroup with the needed meta data like author, comments and so on
         /// </summary>
@@ -416,14 +572,8 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         /// <returns></returns>
         internal bool IsPathMapped(Uri serverPath)
         {
-            //Check whether any of the filter path is the prefix for the current items server path. First check is whether it is cloaked somewhere
-            if (m_configurationManager.CloakedServerPaths.Where(x => PathUtils.IsChildItem(x, serverPath)).Count() > 0)
-            {
-                return false;
-            }
-            
-            //the path is not cloaked. test whether it is part of any of the mapped paths
-            return m_configurationManager.MappedServerPaths.Where(x => PathUtils.IsChildItem(x, serverPath)).Count() > 0;
+            //The path is mapped if any of the mapped paths is a prefix of the server path and none of the cloaked paths is
+            return PathFilter.IsMapped(serverPath);
         }
 
         /// <summary>
@@ -433,15 +583,7 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         /// <returns></returns>
         internal bool IsPathMapped(string serverPath)
         {
-            Uri serverPathUri = new Uri(serverPath);
-            //Check whether any of the filter path is the prefix for the current items server path. First check is whether it is cloaked somewhere
-            if (m_configurationManager.CloakedServerPaths.Where(x => PathUtils.IsChildItem(x, serverPathUri)).Count() > 0)
-            {
-                return false;
-            }
-
-            //the path is not cloaked. test whether it is part of any of the mapped paths
-            return m_configurationManager.MappedServerPaths.Where(x => PathUtils.IsChildItem(x, serverPathUri)).Count() > 0;
+            return IsPathMapped(new Uri(serverPath));
         }
 
         /// <summary>
@@ -449,8 +591,60 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         /// </summary>
         private void initializeSubversionClient()
         {
-            m_repository = Repository.GetRepository(m_configurationManager.RepositoryUri, m_configurationManager.Username, m_configurationManager.Password);
+            m_repository = Repository.GetRepository(m_configurationManager.RepositoryUri, m_configurationManager.Username, m_configurationManager.Password, m_configurationManager.CreateBackend());
             m_repository.EnsureAuthenticated();
+
+            if (m_configurationManager.ListingCacheSize >= 0)
+            {
+                m_repository.ListingCacheCapacity = m_configurationManager.ListingCacheSize * 1024L * 1024L;
+            }
+
+            if (m_configurationManager.ChangeSpillThreshold >= 0)
+            {
+                m_repository.ChangeSpillThreshold = m_configurationManager.ChangeSpillThreshold;
+            }
+
+            if (m_configurationManager.PrefetchSize > 0 && null == m_repository.Prefetcher)
+            {
+                string stagingDirectory = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+                m_repository.Prefetcher = new ContentPrefetcher(m_repository, stagingDirectory, m_configurationManager.PrefetchSize * 1024L * 1024L, m_configurationManager.PrefetchConnections);
+            }
+
+            if (m_configurationManager.WatchInterval > 0 || null != m_configurationManager.CommitNotificationPipe)
+            {
+                startWatcher();
+            }
+        }
+
+        /// <summary>
+        /// Starts to watch the repository for new revisions. A watcher that cannot be started is not fatal; the new revisions are detected by querying the history instead
+        /// </summary>
+        private void startWatcher()
+        {
+            var watcher = m_repository.CreateWatcher(m_configurationManager.CommitNotificationPipe);
+            if (m_configurationManager.WatchInterval > 0)
+            {
+                watcher.MaximumInterval = TimeSpan.FromSeconds(m_configurationManager.WatchInterval);
+            }
+
+            try
+            {
+                watcher.Start();
+            }
+            catch (Exception e)
+            {
+                TraceManager.TraceWarning("Unable to watch the repository for new revisions: {0}. New revisions are detected by querying the history", e.Message);
+                watcher.Dispose();
+                return;
+            }
+
+            watcher.RevisionsAvailable += onRevisionsAvailable;
+            m_watcher = watcher;
+        }
+
+        private void onRevisionsAvailable(object sender, RevisionsAvailableEventArgs e)
+        {
+            TraceManager.TraceInformation("Detected the new Subversion revisions {0} to {1}", e.FirstRevision, e.LastRevision);
         }
 
         /// <summary>
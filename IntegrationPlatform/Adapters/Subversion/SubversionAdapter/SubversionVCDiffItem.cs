@@ -71,10 +71,9 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
                 }
                 else
                 {
-                    // Todo, find a way to get MD5 hash value from subversion repository
+                    //The hash is computed while the file is downloaded. Therefore the file does not have to be read a second time
                     string fileName = System.IO.Path.GetRandomFileName();
-                    m_repository.DownloadFile(fileName, new Uri(m_serverUri), m_revision);
-                    m_hashValue = Utility.CalculateMD5Hash(fileName);
+                    m_hashValue = m_repository.DownloadVerifiedFile(fileName, new Uri(m_serverUri), m_revision).MD5;
                     File.Delete(fileName);
                     return m_hashValue;
                 }
@@ -51,7 +51,7 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         /// </summary>
         private void initializeSubversionClient()
         {
-            m_repository = Repository.GetRepository(m_configurationManager.RepositoryUri, m_configurationManager.Username, m_configurationManager.Password);
+            m_repository = Repository.GetRepository(m_configurationManager.RepositoryUri, m_configurationManager.Username, m_configurationManager.Password, m_configurationManager.CreateBackend());
             m_repository.EnsureAuthenticated();
         }
 
@@ -6,6 +6,14 @@ using System;
 using System.Text;
 using Microsoft.TeamFoundation.Migration.Toolkit;
 using System.ComponentModel.Design;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+using Microsoft.TeamFoundation.Migration.SubversionAdapter.Interop.Subversion.ObjectModel;
+using Microsoft.TeamFoundation.Migration.SubversionAdapter.SubversionOM;
+using Microsoft.TeamFoundation.Migration.Toolkit.Services;
 
 namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
 {
@@ -15,14 +23,90 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
 
         private IServiceContainer m_analysisServiceContainer;
         private ChangeGroupService m_changeGroupService;
+        private ConfigurationService m_configurationService;
+        private ConfigurationManager m_configurationManager;
+        private ICommentDecorationService m_commentDecorationService;
+        private ConflictManager m_conflictManagementService;
+
+        private Repository m_repository;
+        private string m_stagingDirectory;
+        private CommitBaseCache m_baseCache;
 
         #endregion
 
         #region IMigrationProvider impelementation
 
+        /// <summary>
+        /// Commits the change group as a single revision. The content of the files is downloaded from the source system while the
+        /// preceding files are sent to the repository. Branches and renames are copied by the server
+        /// </summary>
         public ConversionResult ProcessChangeGroup(ChangeGroup changeGroup)
         {
-            throw new NotImplementedException();
+            ConversionResult rslt;
+
+            //The local files with the new content by their repository path
+            var stagedFiles = new Dictionary<string, string>(StringComparer.Ordinal);
+
+            try
+            {
+                var items = createCommitItems(changeGroup, stagedFiles);
+
+                int revision;
+                if (0 == items.Count)
+                {
+                    TraceManager.TraceInformation("The change group {0} does not contain any change for the repository", changeGroup.Name);
+                    revision = m_repository.GetLatestRevisionNumber();
+                }
+                else
+                {
+                    try
+                    {
+                        revision = m_repository.Commit(items, getComment(changeGroup));
+                    }
+                    catch (Exception)
+                    {
+                        //A rejected commit may be caused by a base that is out of date. None of the bases can be trusted anymore
+                        if (null != m_baseCache)
+                        {
+                            m_baseCache.Clear();
+                        }
+
+                        throw;
+                    }
+
+                    TraceManager.TraceInformation("Committed the change group {0} with {1} changes as revision {2}", changeGroup.Name, items.Count, revision);
+                    updateBaseCache(items, stagedFiles, revision);
+                }
+
+                rslt = new ConversionResult(m_configurationService.MigrationPeer, m_configurationService.SourceId);
+                rslt.ChangeId = revision.ToString(CultureInfo.InvariantCulture);
+                rslt.ItemConversionHistory.Add(new ItemConversionHistory(changeGroup.Name, string.Empty, rslt.ChangeId, string.Empty));
+            }
+            catch (MigrationUnresolvedConflictException)
+            {
+                rslt = new ConversionResult(Guid.Empty, changeGroup.SourceId);
+                rslt.ContinueProcessing = false;
+            }
+            catch (Exception e)
+            {
+                TraceManager.TraceException(e);
+
+                var errMgr = m_analysisServiceContainer.GetService(typeof(ErrorManager)) as ErrorManager;
+                Debug.Assert(errMgr != null, "Error Manager is not properly initialized");
+                errMgr.TryHandleException(e, m_conflictManagementService);
+
+                rslt = new ConversionResult(Guid.Empty, changeGroup.SourceId);
+                rslt.ContinueProcessing = false;
+            }
+            finally
+            {
+                foreach (var stagedFile in stagedFiles.Values)
+                {
+                    deleteStagedFile(stagedFile);
+                }
+            }
+
+            return rslt;
         }
 
         public void InitializeServices(IServiceContainer analysisServiceContainer)
@@ -31,15 +115,31 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
 
             m_changeGroupService = (ChangeGroupService)m_analysisServiceContainer.GetService(typeof(ChangeGroupService));
             m_changeGroupService.RegisterDefaultSourceSerializer(new SubversionMigrationItemSerialzier());
+
+            m_configurationService = (ConfigurationService)m_analysisServiceContainer.GetService(typeof(ConfigurationService));
+            m_configurationManager = new ConfigurationManager(m_configurationService);
+
+            m_commentDecorationService = (ICommentDecorationService)m_analysisServiceContainer.GetService(typeof(ICommentDecorationService));
+            Debug.Assert(m_commentDecorationService != null, "Comment decoration service is not initialized");
         }
 
         public void InitializeClient()
         {
+            m_repository = Repository.GetRepository(m_configurationManager.RepositoryUri, m_configurationManager.Username, m_configurationManager.Password, m_configurationManager.CreateBackend());
+            m_repository.EnsureAuthenticated();
+
+            m_stagingDirectory = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+            Directory.CreateDirectory(m_stagingDirectory);
+
+            if (m_configurationManager.CommitBaseCacheSize > 0)
+            {
+                m_baseCache = new CommitBaseCache(Path.Combine(m_stagingDirectory, "Bases"), m_configurationManager.CommitBaseCacheSize * 1024L * 1024L);
+            }
         }
 
         public void RegisterConflictTypes(ConflictManager conflictManager)
         {
-            
+            m_conflictManagementService = conflictManager;
         }
 
         public void EstablishContext(ChangeGroupService sourceSystemChangeGroupService)
@@ -64,7 +164,334 @@ namespace Microsoft.TeamFoundation.Migration.SubversionAdapter
         #region IDispose implementation
         public void Dispose()
         {
+            if (null != m_baseCache)
+            {
+                m_baseCache.Dispose();
+                m_baseCache = null;
+            }
+
+            if (null != m_stagingDirectory && Directory.Exists(m_stagingDirectory))
+            {
+                try
+                {
+                    Directory.Delete(m_stagingDirectory, true);
+                }
+                catch (IOException e)
+                {
+                    TraceManager.TraceWarning("Unable to delete the commit staging directory '{0}': {1}", m_stagingDirectory, e.Message);
+                }
+            }
+        }
+        #endregion
+
+        #region Private Helpers
+
+        /// <summary>
+        /// Translates the pending actions of a change group to the items of a single commit
+        /// </summary>
+        /// <param name="changeGroup">The change group that has to be migrated</param>
+        /// <param name="stagedFiles">Receives the local files that will hold the new content by their repository path</param>
+        /// <returns>The items of the commit</returns>
+        private List<CommitItem> createCommitItems(ChangeGroup changeGroup, Dictionary<string, string> stagedFiles)
+        {
+            var items = new List<CommitItem>();
+
+            //The directories that are copied by this commit with the path and the revision of their source. Their children are copied implicitly
+            var copies = new Dictionary<string, KeyValuePair<string, int>>(StringComparer.Ordinal);
+            int headRevision = -1;
+
+            //The files that are added by this commit. A subsequent edit of the same file only provides the content of the addition
+            var additions = new Dictionary<string, CommitItem>(StringComparer.Ordinal);
+
+            //The parents are handled before their children. Therefore the copy of a directory is known when the actions of its children are handled.
+            //The edits of a path follow its addition, so that they can provide the content of the added file
+            var actions = changeGroup.Actions
+                .Where(x => x.State == ActionState.Pending)
+                .Select(x => new KeyValuePair<string, IMigrationAction>(getRelativePath(x.Path), x))
+                .OrderBy(x => x.Key.Length)
+                .ThenBy(x => x.Value.Action == WellKnownChangeActionId.Edit || x.Value.Action == WellKnownChangeActionId.Merge ? 1 : 0)
+                .ToList();
+
+            foreach (var entry in actions)
+            {
+                var path = entry.Key;
+                var action = entry.Value;
+
+                bool isDirectory = string.Equals(action.ItemTypeReferenceName, WellKnownContentType.VersionControlledFolder.ReferenceName, StringComparison.Ordinal);
+                bool isFile = string.Equals(action.ItemTypeReferenceName, WellKnownContentType.VersionControlledFile.ReferenceName, StringComparison.Ordinal);
+                if ((!isDirectory && !isFile) || 0 == path.Length)
+                {
+                    TraceManager.TraceWarning("Skipped the action {0} on {1} of type {2}", action.Action, action.Path, action.ItemTypeReferenceName);
+                    continue;
+                }
+
+                if (action.Action == WellKnownChangeActionId.Add || action.Action == WellKnownChangeActionId.Undelete)
+                {
+                    var item = new CommitItem(path, CommitAction.Add, isDirectory);
+                    if (isFile)
+                    {
+                        item.ContentSource = stage(action, path, stagedFiles);
+                        additions[path] = item;
+                    }
+
+                    items.Add(item);
+                }
+                else if (action.Action == WellKnownChangeActionId.Edit || action.Action == WellKnownChangeActionId.Merge)
+                {
+                    //The subversion adapter does not migrate properties. A directory has no content that could be edited
+                    CommitItem addition;
+                    if (isFile && additions.TryGetValue(path, out addition))
+                    {
+                        addition.ContentSource = stage(action, path, stagedFiles);
+                    }
+                    else if (isFile)
+                    {
+                        items.Add(createModification(action, path, !isCopied(copies, path), stagedFiles));
+                    }
+                }
+                else if (action.Action == WellKnownChangeActionId.Delete)
+                {
+                    items.Add(new CommitItem(path, CommitAction.Delete, isDirectory));
+                }
+                else if (action.Action == WellKnownChangeActionId.Branch || action.Action == WellKnownChangeActionId.BranchMerge)
+                {
+                    bool contentChanged = action.Action == WellKnownChangeActionId.BranchMerge && isFile;
+                    var fromPath = getRelativePath(action.FromPath);
+
+                    int fromRevision;
+                    if (!tryGetMigratedRevision(action.Version, out fromRevision))
+                    {
+                        //The source of the branch has not been migrated. The item is added without its history
+                        TraceManager.TraceWarning("The branch source {0};{1} of {2} has not been migrated. The item is added without history", action.FromPath, action.Version, action.Path);
+
+                        var item = new CommitItem(path, CommitAction.Add, isDirectory);
+                        if (isFile)
+                        {
+                            item.ContentSource = stage(action, path, stagedFiles);
+                            additions[path] = item;
+                        }
+
+                        items.Add(item);
+                    }
+                    else
+                    {
+                        var item = addCopy(items, copies, action, path, fromPath, fromRevision, isDirectory, contentChanged, stagedFiles);
+                        if (null != item && isFile)
+                        {
+                            additions[path] = item;
+                        }
+                    }
+                }
+                else if (action.Action == WellKnownChangeActionId.Rename)
+                {
+                    //The source of a rename is the current state of the repository. The latest revision is queried once per change group
+                    if (headRevision < 0)
+                    {
+                        headRevision = m_repository.GetLatestRevisionNumber();
+                    }
+
+                    var fromPath = getRelativePath(action.FromPath);
+                    bool implicitRename = isCopiedFrom(copies, path, fromPath, headRevision);
+                    var item = addCopy(items, copies, action, path, fromPath, headRevision, isDirectory, false, stagedFiles);
+                    if (null != item && isFile)
+                    {
+                        additions[path] = item;
+                    }
+
+                    //The old location of a renamed child is already deleted together with the old location of its parent
+                    if (!implicitRename)
+                    {
+                        items.Add(new CommitItem(fromPath, CommitAction.Delete, isDirectory));
+                    }
+                }
+                else
+                {
+                    TraceManager.TraceWarning("Skipped the unsupported action {0} on {1}", action.Action, action.Path);
+                }
+            }
+
+            return items;
+        }
+
+        /// <summary>
+        /// Adds the copy of an item unless it is already copied implicitly with its parent. A file whose content differs from the source is modified after the copy
+        /// </summary>
+        /// <returns>The addition of the copied item; null if the item is copied implicitly</returns>
+        private CommitItem addCopy(List<CommitItem> items, Dictionary<string, KeyValuePair<string, int>> copies, IMigrationAction action, string path, string fromPath, int fromRevision, bool isDirectory, bool contentChanged, Dictionary<string, string> stagedFiles)
+        {
+            if (isCopiedFrom(copies, path, fromPath, fromRevision))
+            {
+                if (contentChanged)
+                {
+                    items.Add(createModification(action, path, false, stagedFiles));
+                }
+
+                return null;
+            }
+
+            var item = new CommitItem(path, CommitAction.Add, isDirectory);
+            item.CopyFromPath = fromPath;
+            item.CopyFromRevision = fromRevision;
+            if (contentChanged)
+            {
+                item.ContentSource = stage(action, path, stagedFiles);
+            }
+
+            items.Add(item);
+
+            if (isDirectory)
+            {
+                copies[path] = new KeyValuePair<string, int>(fromPath, fromRevision);
+            }
+
+            return item;
+        }
+
+        /// <summary>
+        /// Creates the modification of a file. The new content is sent as a difference if the committed content of the file is cached
+        /// </summary>
+        private CommitItem createModification(IMigrationAction action, string path, bool useBase, Dictionary<string, string> stagedFiles)
+        {
+            var item = new CommitItem(path, CommitAction.Modify, false);
+            item.ContentSource = stage(action, path, stagedFiles);
+
+            string baseFile;
+            int baseRevision;
+            if (useBase && null != m_baseCache && m_baseCache.TryGet(path, out baseFile, out baseRevision))
+            {
+                item.BaseFile = baseFile;
+                item.BaseRevision = baseRevision;
+            }
+
+            return item;
         }
+
+        /// <summary>
+        /// Determines whether a path lies below a directory that is copied by the commit
+        /// </summary>
+        private static bool isCopied(Dictionary<string, KeyValuePair<string, int>> copies, string path)
+        {
+            for (int index = path.LastIndexOf('/'); index > 0; index = path.LastIndexOf('/', index - 1))
+            {
+                if (copies.ContainsKey(path.Substring(0, index)))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /// <summary>
+        /// Determines whether a path is copied implicitly from the given source because its parent is copied from the parent of the source
+        /// </summary>
+        private static bool isCopiedFrom(Dictionary<string, KeyValuePair<string, int>> copies, string path, string fromPath, int fromRevision)
+        {
+            for (int index = path.LastIndexOf('/'); index > 0; index = path.LastIndexOf('/', index - 1))
+            {
+                KeyValuePair<string, int> source;
+                if (copies.TryGetValue(path.Substring(0, index), out source))
+                {
+                    return source.Value == fromRevision && string.Equals(source.Key + path.Substring(index), fromPath, StringComparison.Ordinal);
+                }
+            }
+
+            return false;
+        }
+
+        /// <summary>
+        /// Stages the content of the source item of an action. The download is deferred until the commit asks for the content
+        /// </summary>
+        private Func<string> stage(IMigrationAction action, string path, Dictionary<string, string> stagedFiles)
+        {
+            var localPath = Path.Combine(m_stagingDirectory, Path.GetRandomFileName());
+            var sourceItem = action.SourceItem;
+            stagedFiles[path] = localPath;
+
+            return () =>
+            {
+                sourceItem.Download(localPath);
+                return localPath;
+            };
+        }
+
+        /// <summary>
+        /// Keeps the committed content of the files as the base of their next modification
+        /// </summary>
+        private void updateBaseCache(List<CommitItem> items, Dictionary<string, string> stagedFiles, int revision)
+        {
+            if (null == m_baseCache)
+            {
+                return;
+            }
+
+            //The deletions are handled first. A replaced file gets its new content afterwards
+            foreach (var item in items.Where(x => x.Action == CommitAction.Delete))
+            {
+                m_baseCache.Remove(item.Path);
+            }
+
+            foreach (var item in items.Where(x => x.Action != CommitAction.Delete))
+            {
+                string stagedFile;
+                if (null != item.ContentSource && stagedFiles.TryGetValue(item.Path, out stagedFile) && File.Exists(stagedFile))
+                {
+                    m_baseCache.Add(item.Path, stagedFile, revision);
+                    stagedFiles.Remove(item.Path);
+                }
+                else
+                {
+                    //The content of a copied item is not known locally
+                    m_baseCache.Remove(item.Path);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Looks up the revision that a change of the other system has been migrated to
+        /// </summary>
+        private bool tryGetMigratedRevision(string version, out int revision)
+        {
+            bool contentChanged;
+            var changeId = m_changeGroupService.GetChangeIdFromConversionHistory(version, m_configurationService.MigrationPeer, out contentChanged);
+            return Int32.TryParse(changeId, NumberStyles.Integer, CultureInfo.InvariantCulture, out revision);
+        }
+
+        /// <summary>
+        /// Converts a path of a migration action to the path relative to the root of the repository
+        /// </summary>
+        private string getRelativePath(string path)
+        {
+            Uri uri;
+            if (!Uri.TryCreate(path, UriKind.Absolute, out uri))
+            {
+                //The paths of the mappings are relative to the configured repository URI
+                uri = PathUtils.Combine(m_configurationManager.RepositoryUri, path);
+            }
+
+            return m_repository.GetRelativePath(uri);
+        }
+
+        private string getComment(ChangeGroup changeGroup)
+        {
+            return changeGroup.Comment + " " + m_commentDecorationService.GetChangeGroupCommentSuffix(changeGroup.Name, changeGroup.ChangeTimeUtc);
+        }
+
+        private static void deleteStagedFile(string stagedFile)
+        {
+            try
+            {
+                if (File.Exists(stagedFile))
+                {
+                    File.Delete(stagedFile);
+                }
+            }
+            catch (IOException e)
+            {
+                TraceManager.TraceWarning("Unable to delete the staged file '{0}': {1}", stagedFile, e.Message);
+            }
+        }
+
         #endregion
     }
 }
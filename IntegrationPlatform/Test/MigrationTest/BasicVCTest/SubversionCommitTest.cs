@@ -0,0 +1,197 @@
+﻿// Copyright © Microsoft Corporation.  All Rights Reserved.
+// This code released under the terms of the 
+// Microsoft Public License (MS-PL, http://opensource.org/licenses/ms-pl.html.)
+
+using System;
+using System.Collections.Generic;
+using System.Collections.ObjectModel;
+using System.IO;
+using System.Linq;
+using System.Text;
+using Microsoft.TeamFoundation.Migration.SubversionAdapter.Interop.Subversion;
+using Microsoft.TeamFoundation.Migration.SubversionAdapter.Interop.Subversion.ObjectModel;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SharpSvn;
+
+namespace BasicVCTest
+{
+    /// <summary>
+    /// Commits change groups through the commit engine of the subversion adapter into a local file:// repository
+    /// and checks the resulting revision with an independent client
+    /// </summary>
+    [TestClass]
+    public class SubversionCommitTest
+    {
+        private const string CommitMessage = "Subversion commit engine";
+        private const string BaseContent = "line 1\nline 2\nline 3\n";
+        private const string EditedContent = "line 1\nline 2 edited\nline 3\n";
+        private const string RenamedContent = "renamed\n";
+        private const string ReplacedContent = "original\n";
+        private const string ReplacementContent = "replacement\n";
+        private const string LibraryContent = "library\n";
+        private const string AddedContent = "added\n";
+
+        private string m_root;
+        private Uri m_repositoryUri;
+        private SvnClient m_verifier;
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            m_root = Path.Combine(Path.GetTempPath(), "SvnCommitTest." + Guid.NewGuid().ToString("N"));
+            string repositoryPath = Path.Combine(m_root, "repository");
+            string workingCopy = Path.Combine(m_root, "wc");
+
+            using (SvnRepositoryClient repositoryClient = new SvnRepositoryClient())
+            {
+                repositoryClient.CreateRepository(repositoryPath);
+            }
+
+            m_repositoryUri = new Uri(repositoryPath);
+            m_verifier = new SvnClient();
+
+            //Revision 1 contains the items that the change group modifies
+            m_verifier.CheckOut(new SvnUriTarget(m_repositoryUri), workingCopy);
+            Directory.CreateDirectory(Path.Combine(workingCopy, @"trunk\lib"));
+            Directory.CreateDirectory(Path.Combine(workingCopy, "branches"));
+            File.WriteAllText(Path.Combine(workingCopy, @"trunk\edit.txt"), BaseContent);
+            File.WriteAllText(Path.Combine(workingCopy, @"trunk\rename.txt"), RenamedContent);
+            File.WriteAllText(Path.Combine(workingCopy, @"trunk\replace.txt"), ReplacedContent);
+            File.WriteAllText(Path.Combine(workingCopy, @"trunk\lib\lib.txt"), LibraryContent);
+
+            m_verifier.Add(Path.Combine(workingCopy, "trunk"), SvnDepth.Infinity);
+            m_verifier.Add(Path.Combine(workingCopy, "branches"), SvnDepth.Infinity);
+            m_verifier.Commit(workingCopy, new SvnCommitArgs() { LogMessage = "Initial revision" });
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            if (null != m_verifier)
+            {
+                m_verifier.Dispose();
+                m_verifier = null;
+            }
+
+            try
+            {
+                //The pristine copies of the working copy are read only
+                foreach (string file in Directory.GetFiles(m_root, "*", SearchOption.AllDirectories))
+                {
+                    File.SetAttributes(file, FileAttributes.Normal);
+                }
+
+                Directory.Delete(m_root, true);
+            }
+            catch (IOException)
+            {
+                //The repository may still be locked by the svn libraries. The temporary directory is cleaned up by the system later on
+            }
+        }
+
+        ///<summary>
+        ///Scenario: Commit an add, an edit with a base delta, a branch, a rename and a replace as one change group
+        ///Expected Result: All changes are part of a single revision with the expected actions, copy sources and contents
+        ///</summary>
+        [TestMethod(), Priority(1)]
+        [Description("Commit add, edit with base delta, branch, rename and replace as one revision")]
+        public void CommitChangeGroupTest()
+        {
+            string baseFile = writeLocalFile("base.txt", BaseContent);
+
+            var items = new List<CommitItem>();
+
+            var addition = new CommitItem("trunk/added.txt", CommitAction.Add, false);
+            addition.ContentSource = content(writeLocalFile("added.txt", AddedContent));
+            items.Add(addition);
+
+            //The new content is sent as a difference to the content of revision 1
+            var edit = new CommitItem("trunk/edit.txt", CommitAction.Modify, false);
+            edit.ContentSource = content(writeLocalFile("edit.txt", EditedContent));
+            edit.BaseFile = baseFile;
+            edit.BaseRevision = 1;
+            items.Add(edit);
+
+            var branch = new CommitItem("branches/lib", CommitAction.Add, true);
+            branch.CopyFromPath = "trunk/lib";
+            branch.CopyFromRevision = 1;
+            items.Add(branch);
+
+            var rename = new CommitItem("trunk/renamed.txt", CommitAction.Add, false);
+            rename.CopyFromPath = "trunk/rename.txt";
+            rename.CopyFromRevision = 1;
+            items.Add(rename);
+            items.Add(new CommitItem("trunk/rename.txt", CommitAction.Delete, false));
+
+            //A delete and an add of the same path form a replacement
+            items.Add(new CommitItem("trunk/replace.txt", CommitAction.Delete, false));
+            var replacement = new CommitItem("trunk/replace.txt", CommitAction.Add, false);
+            replacement.ContentSource = content(writeLocalFile("replace.txt", ReplacementContent));
+            items.Add(replacement);
+
+            long revision;
+            using (SubversionClient client = new SubversionClient())
+            {
+                client.Connect(m_repositoryUri, null);
+                revision = client.Commit(items, CommitMessage);
+            }
+
+            Assert.AreEqual(2L, revision, "The change group has to be committed as exactly one revision");
+
+            Collection<SvnLogEventArgs> logItems;
+            m_verifier.GetLog(m_repositoryUri, new SvnLogArgs() { Start = revision, End = revision, RetrieveChangedPaths = true }, out logItems);
+            Assert.AreEqual(1, logItems.Count);
+
+            SvnLogEventArgs log = logItems[0];
+            Assert.AreEqual(CommitMessage, log.LogMessage);
+            Assert.AreEqual(6, log.ChangedPaths.Count, "Unexpected changes: {0}", string.Join(", ", log.ChangedPaths.Select(x => x.Action + " " + x.Path).ToArray()));
+
+            assertChange(log, "/trunk/added.txt", SvnChangeAction.Add, null, -1);
+            assertChange(log, "/trunk/edit.txt", SvnChangeAction.Modify, null, -1);
+            assertChange(log, "/branches/lib", SvnChangeAction.Add, "/trunk/lib", 1);
+            assertChange(log, "/trunk/renamed.txt", SvnChangeAction.Add, "/trunk/rename.txt", 1);
+            assertChange(log, "/trunk/rename.txt", SvnChangeAction.Delete, null, -1);
+            assertChange(log, "/trunk/replace.txt", SvnChangeAction.Replace, null, -1);
+
+            Assert.AreEqual(AddedContent, readContent("trunk/added.txt", revision));
+            Assert.AreEqual(EditedContent, readContent("trunk/edit.txt", revision));
+            Assert.AreEqual(LibraryContent, readContent("branches/lib/lib.txt", revision));
+            Assert.AreEqual(RenamedContent, readContent("trunk/renamed.txt", revision));
+            Assert.AreEqual(ReplacementContent, readContent("trunk/replace.txt", revision));
+        }
+
+        private string writeLocalFile(string name, string text)
+        {
+            string path = Path.Combine(m_root, name);
+            File.WriteAllText(path, text);
+            return path;
+        }
+
+        private static Func<string> content(string path)
+        {
+            return () => path;
+        }
+
+        private static void assertChange(SvnLogEventArgs log, string path, SvnChangeAction action, string copyFromPath, long copyFromRevision)
+        {
+            SvnChangeItem change = log.ChangedPaths.SingleOrDefault(x => x.Path == path);
+            Assert.IsNotNull(change, "The revision does not contain {0}", path);
+            Assert.AreEqual(action, change.Action, "Unexpected action for {0}", path);
+            Assert.AreEqual(copyFromPath, change.CopyFromPath, "Unexpected copy source for {0}", path);
+
+            if (null != copyFromPath)
+            {
+                Assert.AreEqual(copyFromRevision, change.CopyFromRevision, "Unexpected copy revision for {0}", path);
+            }
+        }
+
+        private string readContent(string path, long revision)
+        {
+            using (MemoryStream stream = new MemoryStream())
+            {
+                m_verifier.Write(new SvnUriTarget(new Uri(m_repositoryUri.AbsoluteUri + "/" + path), revision), stream);
+                return Encoding.UTF8.GetString(stream.ToArray());
+            }
+        }
+    }
+}